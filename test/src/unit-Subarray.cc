@@ -31,6 +31,7 @@
  */
 
 #include "test/src/helpers.h"
+#include "tiledb/common/thread_pool.h"
 #include "tiledb/sm/c_api/tiledb_struct_def.h"
 #include "tiledb/sm/subarray/subarray_partitioner.h"
 
@@ -332,3 +333,79 @@ TEST_CASE_METHOD(
 
   close_array(ctx_, array_);
 }
+
+TEST_CASE_METHOD(
+    SubarrayFx,
+    "Subarray: Test relevant fragments, 1D",
+    "[Subarray][1d][relevant_fragments]") {
+  uint64_t domain[] = {1, 100};
+  uint64_t tile_extent = 10;
+  create_array(
+      ctx_,
+      array_name_,
+      TILEDB_SPARSE,
+      {"d"},
+      {TILEDB_UINT64},
+      {domain},
+      {&tile_extent},
+      {"a"},
+      {TILEDB_INT32},
+      {1},
+      {tiledb::test::Compressor(TILEDB_FILTER_NONE, -1)},
+      TILEDB_ROW_MAJOR,
+      TILEDB_ROW_MAJOR,
+      2);
+
+  // Fragment `f` holds cells `10 * f + 1` and `10 * f + 5`
+  const unsigned fragment_num = 10;
+  for (unsigned f = 0; f < fragment_num; ++f) {
+    tiledb::test::QueryBuffers buffers;
+    std::vector<uint64_t> coords = {10 * f + 1, 10 * f + 5};
+    std::vector<int> a = {(int)f, (int)f};
+    buffers[TILEDB_COORDS] = tiledb::test::QueryBuffer(
+        {&coords[0], coords.size() * sizeof(uint64_t), nullptr, 0});
+    buffers["a"] =
+        tiledb::test::QueryBuffer({&a[0], a.size() * sizeof(int), nullptr, 0});
+    write_array(ctx_, array_name_, TILEDB_UNORDERED, buffers);
+  }
+
+  open_array(ctx_, array_, TILEDB_READ);
+  const auto& fragment_index = array_->array_->fragment_index();
+  CHECK(fragment_index.leaf_num() == fragment_num);
+  CHECK(fragment_index.height() == 2);
+
+  Subarray subarray;
+  SubarrayRanges<uint64_t> ranges = {{6, 10, 15, 25, 71, 71}};
+  create_subarray(array_->array_, ranges, Layout::ROW_MAJOR, &subarray);
+  ThreadPool tp;
+  CHECK(tp.init(4).ok());
+  CHECK(subarray.compute_tile_overlap(&tp).ok());
+
+  // Only fragments 1, 2 and 7 overlap the ranges
+  const auto& tile_overlap = subarray.tile_overlap();
+  REQUIRE(tile_overlap.size() == fragment_num);
+  std::vector<unsigned> relevant;
+  for (unsigned f = 0; f < fragment_num; ++f) {
+    for (const auto& overlap : tile_overlap[f]) {
+      if (!overlap.tiles_.empty() || !overlap.tile_ranges_.empty()) {
+        relevant.push_back(f);
+        break;
+      }
+    }
+  }
+  CHECK(relevant == std::vector<unsigned>({1, 2, 7}));
+
+  // The index is rebuilt on reopen
+  std::vector<uint64_t> coords = {100};
+  std::vector<int> a = {10};
+  tiledb::test::QueryBuffers buffers;
+  buffers[TILEDB_COORDS] =
+      tiledb::test::QueryBuffer({&coords[0], sizeof(uint64_t), nullptr, 0});
+  buffers["a"] = tiledb::test::QueryBuffer({&a[0], sizeof(int), nullptr, 0});
+  write_array(ctx_, array_name_, TILEDB_UNORDERED, buffers);
+  CHECK(tiledb_array_reopen(ctx_, array_) == TILEDB_OK);
+  CHECK(array_->array_->fragment_index().leaf_num() == fragment_num + 1);
+
+  close_array(ctx_, array_);
+  CHECK(array_->array_->fragment_index().leaf_num() == 0);
+}
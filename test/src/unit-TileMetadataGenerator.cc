@@ -0,0 +1,157 @@
+/**
+ * @file unit-TileMetadataGenerator.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ * @section DESCRIPTION
+ *
+ * Tests the `TileMetadataGenerator` class.
+ */
+
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/tile/tile.h"
+#include "tiledb/sm/tile/tile_metadata_generator.h"
+
+#include <catch.hpp>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+
+using namespace tiledb::sm;
+
+namespace {
+
+/** Returns an unfiltered tile storing the input values. */
+template <class T>
+Tile make_tile(Datatype type, const std::vector<T>& values) {
+  Tile tile;
+  const uint64_t tile_size = values.size() * sizeof(T);
+  REQUIRE(tile.init_unfiltered(0, type, tile_size, sizeof(T), 0).ok());
+  REQUIRE(tile.write(values.data(), tile_size).ok());
+  return tile;
+}
+
+/** Returns the input raw bytes as a value of type `T`. */
+template <class T>
+T as(const std::vector<uint8_t>& bytes) {
+  REQUIRE(bytes.size() == sizeof(T));
+  T v;
+  std::memcpy(&v, bytes.data(), sizeof(T));
+  return v;
+}
+
+}  // namespace
+
+TEST_CASE(
+    "TileMetadataGenerator: Test applicability",
+    "[TileMetadataGenerator][applicability]") {
+  CHECK(TileMetadataGenerator::has_min_max_metadata(Datatype::INT32, false, 1));
+  CHECK(TileMetadataGenerator::has_sum_metadata(Datatype::INT32, false, 1));
+  CHECK(
+      !TileMetadataGenerator::has_min_max_metadata(Datatype::INT32, false, 2));
+  CHECK(!TileMetadataGenerator::has_sum_metadata(Datatype::INT32, false, 2));
+  CHECK(TileMetadataGenerator::has_min_max_metadata(Datatype::CHAR, false, 1));
+  CHECK(!TileMetadataGenerator::has_sum_metadata(Datatype::CHAR, false, 1));
+  CHECK(TileMetadataGenerator::has_min_max_metadata(
+      Datatype::STRING_ASCII, true, constants::var_num));
+  CHECK(!TileMetadataGenerator::has_sum_metadata(
+      Datatype::STRING_ASCII, true, constants::var_num));
+  CHECK(!TileMetadataGenerator::has_min_max_metadata(
+      Datatype::INT32, true, constants::var_num));
+  CHECK(!TileMetadataGenerator::has_min_max_metadata(Datatype::ANY, false, 1));
+}
+
+TEST_CASE(
+    "TileMetadataGenerator: Test fixed-sized tiles",
+    "[TileMetadataGenerator][fixed]") {
+  SECTION("- Signed integers") {
+    TileMetadataGenerator md(Datatype::INT32, false, 1);
+    auto tile = make_tile<int32_t>(Datatype::INT32, {3, -7, 12, 0, 5});
+    REQUIRE(md.process_tile(tile).ok());
+    CHECK(as<int32_t>(md.min()) == -7);
+    CHECK(as<int32_t>(md.max()) == 12);
+    CHECK(as<int64_t>(md.sum()) == 13);
+  }
+
+  SECTION("- Unsigned integers, saturating sum") {
+    TileMetadataGenerator md(Datatype::UINT64, false, 1);
+    const uint64_t max = std::numeric_limits<uint64_t>::max();
+    auto tile = make_tile<uint64_t>(Datatype::UINT64, {max - 1, 2, 1});
+    REQUIRE(md.process_tile(tile).ok());
+    CHECK(as<uint64_t>(md.min()) == 1);
+    CHECK(as<uint64_t>(md.max()) == max - 1);
+    CHECK(as<uint64_t>(md.sum()) == max);
+  }
+
+  SECTION("- Signed integers, saturated sum stays saturated") {
+    TileMetadataGenerator md(Datatype::INT64, false, 1);
+    const int64_t max = std::numeric_limits<int64_t>::max();
+    auto tile = make_tile<int64_t>(Datatype::INT64, {max, 5, -5});
+    REQUIRE(md.process_tile(tile).ok());
+    CHECK(as<int64_t>(md.sum()) == max);
+  }
+
+  SECTION("- Reals with NaN values") {
+    TileMetadataGenerator md(Datatype::FLOAT64, false, 1);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    auto tile = make_tile<double>(Datatype::FLOAT64, {nan, 1.5, nan, -2.5});
+    REQUIRE(md.process_tile(tile).ok());
+    CHECK(as<double>(md.min()) == -2.5);
+    CHECK(as<double>(md.max()) == 1.5);
+    CHECK(std::isnan(as<double>(md.sum())));
+
+    auto nan_tile = make_tile<double>(Datatype::FLOAT64, {nan, nan});
+    REQUIRE(md.process_tile(nan_tile).ok());
+    CHECK(std::isnan(as<double>(md.min())));
+    CHECK(std::isnan(as<double>(md.max())));
+  }
+
+  SECTION("- Unsupported cell value number") {
+    TileMetadataGenerator md(Datatype::INT32, false, 2);
+    auto tile = make_tile<int32_t>(Datatype::INT32, {1, 2, 3, 4});
+    REQUIRE(md.process_tile(tile).ok());
+    CHECK(md.min().empty());
+    CHECK(md.max().empty());
+    CHECK(md.sum().empty());
+  }
+}
+
+TEST_CASE(
+    "TileMetadataGenerator: Test var-sized tiles",
+    "[TileMetadataGenerator][var]") {
+  const std::string values = "bbaaaccab";
+  auto tile_off = make_tile<uint64_t>(Datatype::UINT64, {0, 2, 5, 7, 7});
+  auto tile_val =
+      make_tile<char>(Datatype::CHAR, {values.begin(), values.end()});
+
+  TileMetadataGenerator md(Datatype::STRING_ASCII, true, constants::var_num);
+  REQUIRE(md.process_tile_var(tile_off, tile_val).ok());
+  CHECK(md.min().empty());  // The empty string
+  CHECK(std::string(md.max().begin(), md.max().end()) == "cc");
+  CHECK(md.sum().empty());
+}
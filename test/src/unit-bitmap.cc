@@ -0,0 +1,143 @@
+/**
+ * @file   unit-bitmap.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the `Bitmap` class.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/misc/bitmap.h"
+
+#include <random>
+#include <vector>
+
+using namespace tiledb::sm;
+
+/** Checks `bitmap` against the bits in `expected`. */
+void check_bitmap(const Bitmap& bitmap, const std::vector<bool>& expected) {
+  REQUIRE(bitmap.size() == expected.size());
+  uint64_t count = 0;
+  for (uint64_t i = 0; i < expected.size(); ++i) {
+    CHECK(bitmap.get(i) == expected[i]);
+    count += expected[i];
+  }
+  CHECK(bitmap.count() == count);
+  CHECK(bitmap.none() == (count == 0));
+
+  // Iterate over the set bits, both with `next` and `for_each`
+  std::vector<uint64_t> set_bits, next_bits, range_bits;
+  for (uint64_t i = 0; i < expected.size(); ++i) {
+    if (expected[i])
+      set_bits.push_back(i);
+  }
+  for (auto pos = bitmap.next(0); pos < bitmap.size();
+       pos = bitmap.next(pos + 1))
+    next_bits.push_back(pos);
+  CHECK(next_bits == set_bits);
+  std::vector<uint64_t> for_each_bits;
+  bitmap.for_each([&](uint64_t pos) { for_each_bits.push_back(pos); });
+  CHECK(for_each_bits == set_bits);
+
+  // Iterate over the set bits of a sub-range
+  uint64_t start = expected.size() / 5, end = expected.size() - start / 2;
+  bitmap.for_each(start, end, [&](uint64_t pos) { range_bits.push_back(pos); });
+  std::vector<uint64_t> expected_range_bits;
+  for (auto pos : set_bits) {
+    if (pos >= start && pos < end)
+      expected_range_bits.push_back(pos);
+  }
+  CHECK(range_bits == expected_range_bits);
+}
+
+TEST_CASE("Bitmap: Test construction and bit access", "[bitmap]") {
+  for (uint64_t size : {0, 1, 63, 64, 65, 130, 1000}) {
+    Bitmap zeros(size, false), ones(size, true);
+    check_bitmap(zeros, std::vector<bool>(size, false));
+    check_bitmap(ones, std::vector<bool>(size, true));
+
+    // The unused bits of the last word stay zero
+    if (size % 64 != 0)
+      CHECK(ones.words()[ones.word_num() - 1] >> (size % 64) == 0);
+
+    std::mt19937 gen(size);
+    std::vector<bool> expected(size, false);
+    for (uint64_t i = 0; i < size; ++i) {
+      auto value = gen() % 3 == 0;
+      if (value)
+        zeros.set(i);
+      expected[i] = value;
+    }
+    check_bitmap(zeros, expected);
+
+    for (uint64_t i = 0; i < size; i += 3) {
+      zeros.and_bit(i, false);
+      expected[i] = false;
+      if (i + 1 < size) {
+        zeros.and_bit(i + 1, true);
+        zeros.clear(i + 1);
+        expected[i + 1] = false;
+      }
+    }
+    check_bitmap(zeros, expected);
+  }
+}
+
+TEST_CASE("Bitmap: Test ranges and word-wise operations", "[bitmap]") {
+  const uint64_t size = 300;
+  std::vector<std::pair<uint64_t, uint64_t>> ranges = {
+      {0, 0}, {0, 1}, {3, 60}, {10, 64}, {64, 128}, {60, 200}, {250, 300}};
+  for (const auto& r : ranges) {
+    Bitmap bitmap(size, false);
+    bitmap.set_range(r.first, r.second);
+    std::vector<bool> expected(size, false);
+    for (auto i = r.first; i < r.second; ++i)
+      expected[i] = true;
+    check_bitmap(bitmap, expected);
+  }
+
+  std::mt19937 gen(0);
+  Bitmap a(size, false), b(size, false);
+  std::vector<bool> a_bits(size), b_bits(size), and_bits(size),
+      and_not_bits(size);
+  for (uint64_t i = 0; i < size; ++i) {
+    a_bits[i] = gen() % 2 == 0;
+    b_bits[i] = gen() % 2 == 0;
+    if (a_bits[i])
+      a.set(i);
+    if (b_bits[i])
+      b.set(i);
+    and_bits[i] = a_bits[i] && b_bits[i];
+    and_not_bits[i] = a_bits[i] && !b_bits[i];
+  }
+
+  Bitmap c = a;
+  c &= b;
+  check_bitmap(c, and_bits);
+  a.and_not(b);
+  check_bitmap(a, and_not_bits);
+}
@@ -227,20 +227,26 @@ void check_save_to_file() {
   ss << "sm.consolidation.steps 4294967295\n";
   ss << "sm.dedup_coords false\n";
   ss << "sm.enable_signal_handlers true\n";
+  ss << "sm.fragment_metadata_cache_size 10000000\n";
   ss << "sm.io_concurrency_level " << std::thread::hardware_concurrency()
      << "\n";
   ss << "sm.memory_budget 5368709120\n";
   ss << "sm.memory_budget_var 10737418240\n";
   ss << "sm.num_tbb_threads -1\n";
   ss << "sm.skip_checksum_validation false\n";
+  ss << "sm.sparse_unordered_tile_window 256\n";
   ss << "sm.sub_partitioner_memory_budget 0\n";
+  ss << "sm.tile_cache_policy both\n";
+  ss << "sm.tile_cache_shards 8\n";
   ss << "sm.tile_cache_size 10000000\n";
+  ss << "sm.tile_cache_unfiltered_size 0\n";
   ss << "sm.vacuum.mode fragments\n";
   ss << "vfs.azure.block_list_block_size 5242880\n";
   ss << "vfs.azure.max_parallel_ops " << std::thread::hardware_concurrency()
      << "\n";
   ss << "vfs.azure.use_block_list_upload true\n";
   ss << "vfs.azure.use_https true\n";
+  ss << "vfs.disk_cache_size 10737418240\n";
   ss << "vfs.file.enable_filelocks true\n";
   ss << "vfs.file.max_parallel_ops " << std::thread::hardware_concurrency()
      << "\n";
@@ -431,9 +437,14 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   all_param_values["sm.check_coord_oob"] = "true";
   all_param_values["sm.check_global_order"] = "true";
   all_param_values["sm.tile_cache_size"] = "100";
+  all_param_values["sm.tile_cache_unfiltered_size"] = "0";
+  all_param_values["sm.tile_cache_policy"] = "both";
+  all_param_values["sm.tile_cache_shards"] = "8";
+  all_param_values["sm.fragment_metadata_cache_size"] = "10000000";
   all_param_values["sm.memory_budget"] = "5368709120";
   all_param_values["sm.memory_budget_var"] = "10737418240";
   all_param_values["sm.sub_partitioner_memory_budget"] = "0";
+  all_param_values["sm.sparse_unordered_tile_window"] = "256";
   all_param_values["sm.enable_signal_handlers"] = "true";
   all_param_values["sm.compute_concurrency_level"] =
       std::to_string(std::thread::hardware_concurrency());
@@ -457,6 +468,8 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   all_param_values["vfs.min_parallel_size"] = "10485760";
   all_param_values["vfs.read_ahead_size"] = "102400";
   all_param_values["vfs.read_ahead_cache_size"] = "10485760";
+  all_param_values["vfs.disk_cache_dir"] = "";
+  all_param_values["vfs.disk_cache_size"] = "10737418240";
   all_param_values["vfs.gcs.project_id"] = "";
   all_param_values["vfs.gcs.max_parallel_ops"] =
       std::to_string(std::thread::hardware_concurrency());
@@ -509,6 +522,8 @@ TEST_CASE("C API: Test config iter", "[capi], [config]") {
   vfs_param_values["min_parallel_size"] = "10485760";
   vfs_param_values["read_ahead_size"] = "102400";
   vfs_param_values["read_ahead_cache_size"] = "10485760";
+  vfs_param_values["disk_cache_dir"] = "";
+  vfs_param_values["disk_cache_size"] = "10737418240";
   vfs_param_values["gcs.project_id"] = "";
   vfs_param_values["gcs.max_parallel_ops"] =
       std::to_string(std::thread::hardware_concurrency());
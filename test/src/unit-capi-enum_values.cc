@@ -92,6 +92,7 @@ TEST_CASE("C API: Test enum values", "[capi], [enums]") {
   REQUIRE(TILEDB_COL_MAJOR == 1);
   REQUIRE(TILEDB_GLOBAL_ORDER == 2);
   REQUIRE(TILEDB_UNORDERED == 3);
+  REQUIRE(TILEDB_HILBERT == 4);
 
   /** Filter type */
   REQUIRE(TILEDB_FILTER_NONE == 0);
@@ -332,6 +333,12 @@ TEST_CASE("C API: Test enum string conversion", "[capi], [enums]") {
   REQUIRE(
       (tiledb_layout_from_str("unordered", &layout) == TILEDB_OK &&
        layout == TILEDB_UNORDERED));
+  REQUIRE(
+      (tiledb_layout_to_str(TILEDB_HILBERT, &c_str) == TILEDB_OK &&
+       std::string(c_str) == "hilbert"));
+  REQUIRE(
+      (tiledb_layout_from_str("hilbert", &layout) == TILEDB_OK &&
+       layout == TILEDB_HILBERT));
 
   tiledb_filter_type_t filter_type;
   REQUIRE(
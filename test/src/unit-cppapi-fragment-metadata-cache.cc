@@ -0,0 +1,290 @@
+/**
+ * @file   unit-cppapi-fragment-metadata-cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the retention of the array metadata after arrays are closed for
+ * reads and of reopening arrays through the C++ API.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cpp_api/tiledb"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <thread>
+
+using namespace tiledb;
+
+namespace {
+
+const std::string array_name = "cpp_unit_array_fragment_metadata_cache";
+
+const std::string key = "0123456789abcdeF0123456789abcdeF";
+
+void create_array(
+    const Context& ctx,
+    int32_t domain_hi,
+    tiledb_encryption_type_t encryption_type = TILEDB_NO_ENCRYPTION) {
+  Domain domain(ctx);
+  domain.add_dimension(
+      Dimension::create<int32_t>(ctx, "d", {{1, domain_hi}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(4);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  if (encryption_type == TILEDB_NO_ENCRYPTION)
+    Array::create(array_name, schema);
+  else
+    Array::create(array_name, schema, encryption_type, key);
+}
+
+std::unique_ptr<Array> open_array(
+    const Context& ctx,
+    tiledb_query_type_t query_type,
+    tiledb_encryption_type_t encryption_type) {
+  if (encryption_type == TILEDB_NO_ENCRYPTION)
+    return std::unique_ptr<Array>(new Array(ctx, array_name, query_type));
+  return std::unique_ptr<Array>(
+      new Array(ctx, array_name, query_type, encryption_type, key));
+}
+
+void write_array(
+    const Context& ctx,
+    std::vector<int32_t> d,
+    int32_t a_base,
+    std::map<int32_t, int32_t>* expected,
+    tiledb_encryption_type_t encryption_type = TILEDB_NO_ENCRYPTION) {
+  std::vector<int32_t> a;
+  for (auto c : d) {
+    a.push_back(a_base + c);
+    (*expected)[c] = a.back();
+  }
+
+  auto array = open_array(ctx, TILEDB_WRITE, encryption_type);
+  Query query(ctx, *array, TILEDB_WRITE);
+  query.set_layout(TILEDB_UNORDERED).set_buffer("d", d).set_buffer("a", a);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array->close();
+}
+
+/** Reads all the cells of the open array and checks them. */
+void check_array(
+    const Context& ctx,
+    Array& array,
+    int32_t domain_hi,
+    const std::map<int32_t, int32_t>& expected) {
+  std::vector<int32_t> d(100), a(100);
+  Query query(ctx, array, TILEDB_READ);
+  query.set_layout(TILEDB_GLOBAL_ORDER)
+      .add_range<int32_t>(0, 1, domain_hi)
+      .set_buffer("d", d)
+      .set_buffer("a", a);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  auto result_num = query.result_buffer_elements()["a"].second;
+
+  REQUIRE(result_num == expected.size());
+  uint64_t i = 0;
+  for (const auto& cell : expected) {
+    CHECK(d[i] == cell.first);
+    CHECK(a[i] == cell.second);
+    ++i;
+  }
+}
+
+/** Opens the array, reads all its cells, checks them and closes it. */
+void read_and_check(
+    const Context& ctx,
+    int32_t domain_hi,
+    const std::map<int32_t, int32_t>& expected,
+    tiledb_encryption_type_t encryption_type = TILEDB_NO_ENCRYPTION) {
+  auto array = open_array(ctx, TILEDB_READ, encryption_type);
+  check_array(ctx, *array, domain_hi, expected);
+  array->close();
+}
+
+void remove_array(const Context& ctx) {
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+}  // namespace
+
+TEST_CASE(
+    "C++ API: Test retaining fragment metadata after closing arrays",
+    "[cppapi][fragment-metadata-cache]") {
+  std::string cache_size =
+      GENERATE(std::string("0"), std::string("1000"), std::string("10000000"));
+  Config config;
+  config["sm.fragment_metadata_cache_size"] = cache_size;
+  Context ctx(config);
+  remove_array(ctx);
+
+  create_array(ctx, 100);
+  std::map<int32_t, int32_t> expected;
+  write_array(ctx, {1, 5, 9, 20, 33}, 0, &expected);
+  write_array(ctx, {5, 40, 41, 77}, 1000, &expected);
+
+  // Reopening the array reloads no fragment metadata if they are retained
+  Stats::enable();
+  for (int i = 0; i < 2; ++i) {
+    Stats::reset();
+    read_and_check(ctx, 100, expected);
+  }
+  std::string stats;
+  Stats::raw_dump(&stats);
+  Stats::disable();
+  auto reloaded = stats.find("\"READ_FRAG_META_SIZE\": 0,") ==
+                  std::string::npos;
+  CHECK(reloaded == (cache_size != "10000000"));
+
+  // New fragments are loaded
+  write_array(ctx, {2, 41}, 2000, &expected);
+  read_and_check(ctx, 100, expected);
+
+  // Consolidated and vacuumed fragments are dropped
+  Array::consolidate(ctx, array_name);
+  Array::vacuum(ctx, array_name);
+  read_and_check(ctx, 100, expected);
+  write_array(ctx, {3}, 3000, &expected);
+  read_and_check(ctx, 100, expected);
+
+  remove_array(ctx);
+}
+
+TEST_CASE(
+    "C++ API: Test retaining fragment metadata of re-created arrays",
+    "[cppapi][fragment-metadata-cache]") {
+  Context ctx;
+  remove_array(ctx);
+
+  create_array(ctx, 100);
+  std::map<int32_t, int32_t> expected;
+  write_array(ctx, {1, 50, 100}, 0, &expected);
+  read_and_check(ctx, 100, expected);
+
+  // The array is re-created behind the back of the context with a
+  // different domain
+  {
+    Context other_ctx;
+    remove_array(other_ctx);
+    create_array(other_ctx, 200);
+  }
+  std::map<int32_t, int32_t> expected2;
+  write_array(ctx, {150, 200}, 0, &expected2);
+  read_and_check(ctx, 200, expected2);
+
+  // The same, with the same schema
+  {
+    Context other_ctx;
+    remove_array(other_ctx);
+    create_array(other_ctx, 200);
+  }
+  std::map<int32_t, int32_t> expected3;
+  write_array(ctx, {7}, 0, &expected3);
+  read_and_check(ctx, 200, expected3);
+
+  // Removing the array through the context drops its metadata
+  Object::remove(ctx, array_name);
+  create_array(ctx, 100);
+  read_and_check(ctx, 100, {});
+
+  remove_array(ctx);
+}
+
+TEST_CASE(
+    "C++ API: Test retaining fragment metadata of encrypted arrays",
+    "[cppapi][fragment-metadata-cache]") {
+  Context ctx;
+  remove_array(ctx);
+
+  create_array(ctx, 100, TILEDB_AES_256_GCM);
+  std::map<int32_t, int32_t> expected;
+  write_array(ctx, {1, 50, 100}, 0, &expected, TILEDB_AES_256_GCM);
+  read_and_check(ctx, 100, expected, TILEDB_AES_256_GCM);
+
+  // The retained metadata are not available with a wrong key
+  CHECK_THROWS(Array(
+      ctx,
+      array_name,
+      TILEDB_READ,
+      TILEDB_AES_256_GCM,
+      std::string("abcdeF0123456789abcdeF0123456789")));
+  CHECK_THROWS(Array(ctx, array_name, TILEDB_READ));
+  read_and_check(ctx, 100, expected, TILEDB_AES_256_GCM);
+
+  remove_array(ctx);
+}
+
+TEST_CASE(
+    "C++ API: Test reopening arrays with new fragments",
+    "[cppapi][fragment-metadata-cache][reopen]") {
+  Context ctx;
+  remove_array(ctx);
+
+  create_array(ctx, 100);
+  std::map<int32_t, int32_t> expected;
+  write_array(ctx, {1, 50, 100}, 0, &expected);
+  write_array(ctx, {2, 3, 4, 5, 6}, 1000, &expected);
+  Config config;
+  config["sm.consolidation.mode"] = "fragment_meta";
+  Array::consolidate(ctx, array_name, &config);
+
+  // Follow the writes of single fragments by reopening the array
+  Array array(ctx, array_name, TILEDB_READ);
+  check_array(ctx, array, 100, expected);
+  auto first_timestamp = array.timestamp();
+  auto first_expected = expected;
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  for (int32_t i = 0; i < 12; ++i) {
+    write_array(ctx, {7 + 3 * i, 90 - i}, 2000 + 1000 * i, &expected);
+    array.reopen();
+    check_array(ctx, array, 100, expected);
+  }
+
+  // Reopening with no new fragments reads no fragment metadata
+  Stats::enable();
+  Stats::reset();
+  array.reopen();
+  std::string stats;
+  Stats::raw_dump(&stats);
+  Stats::disable();
+  CHECK(
+      stats.find("\"CONSOLIDATED_FRAG_META_SIZE\": 0,") != std::string::npos);
+  CHECK(stats.find("\"READ_FRAG_META_SIZE\": 0,") != std::string::npos);
+  check_array(ctx, array, 100, expected);
+
+  // Reopening at an earlier timestamp drops the later fragments, and
+  // reopening after that brings them back
+  array.reopen_at(first_timestamp);
+  check_array(ctx, array, 100, first_expected);
+  array.reopen();
+  check_array(ctx, array, 100, expected);
+  array.close();
+  remove_array(ctx);
+}
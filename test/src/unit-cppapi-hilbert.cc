@@ -0,0 +1,388 @@
+/**
+ * @file   unit-cppapi-hilbert.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the Hilbert cell order of sparse arrays.
+ */
+
+#include "catch.hpp"
+#include "helpers.h"
+#include "tiledb/sm/cpp_api/tiledb"
+#include "tiledb/sm/misc/hilbert.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <tuple>
+
+using namespace tiledb;
+
+namespace {
+
+const std::string array_name = "cpp_unit_array_hilbert";
+
+typedef std::pair<int32_t, double> Cell;
+
+void create_array(const Context& ctx) {
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "r", {{1, 100}}, 10))
+      .add_dimension(Dimension::create<double>(ctx, "c", {{0.0, 1.0}}, 0.1));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_HILBERT}});
+  schema.set_capacity(4);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  Array::create(array_name, schema);
+}
+
+/** Returns the Hilbert value of a cell of the array of `create_array()`. */
+uint64_t hilbert_value(const Cell& cell) {
+  sm::Hilbert hilbert(2);
+  auto max_bucket_val = hilbert.max_bucket_val();
+  uint64_t coords[2] = {(uint64_t)((cell.first - 1) / 99.0 * max_bucket_val),
+                        (uint64_t)(cell.second * max_bucket_val)};
+  return hilbert.coords_to_hilbert(coords);
+}
+
+/** Sorts the input cells on the Hilbert order. */
+void sort_hilbert(std::vector<Cell>* cells) {
+  std::sort(cells->begin(), cells->end(), [](const Cell& a, const Cell& b) {
+    return std::make_tuple(hilbert_value(a), a.first, a.second) <
+           std::make_tuple(hilbert_value(b), b.first, b.second);
+  });
+}
+
+/** Writes the input cells with value `a`, in the input layout. */
+void write_array(
+    const Context& ctx,
+    const std::vector<Cell>& cells,
+    int32_t a,
+    tiledb_layout_t layout) {
+  std::vector<int32_t> r, a_buff;
+  std::vector<double> c;
+  for (const auto& cell : cells) {
+    r.push_back(cell.first);
+    c.push_back(cell.second);
+    a_buff.push_back(a);
+  }
+
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array, TILEDB_WRITE);
+  query.set_layout(layout)
+      .set_buffer("r", r)
+      .set_buffer("c", c)
+      .set_buffer("a", a_buff);
+  query.submit();
+  query.finalize();
+  array.close();
+}
+
+/**
+ * Reads all the cells of the array in the input layout, with buffers of
+ * `buffer_cells` cells. Reads that do not fit the buffers are resubmitted
+ * until they complete.
+ */
+void read_array(
+    const Context& ctx,
+    tiledb_layout_t layout,
+    std::vector<Cell>* cells,
+    std::vector<int32_t>* a,
+    uint64_t buffer_cells = 1000) {
+  Array array(ctx, array_name, TILEDB_READ);
+  std::vector<int32_t> r(buffer_cells), a_buff(buffer_cells);
+  std::vector<double> c(buffer_cells);
+  Query query(ctx, array, TILEDB_READ);
+  query.set_layout(layout)
+      .add_range(0, 1, 100)
+      .add_range(1, 0.0, 1.0)
+      .set_buffer("r", r)
+      .set_buffer("c", c)
+      .set_buffer("a", a_buff);
+  cells->clear();
+  a->clear();
+  Query::Status status;
+  do {
+    status = query.submit();
+    auto num = query.result_buffer_elements()["a"].second;
+    REQUIRE((num > 0 || status == Query::Status::COMPLETE));
+    a->insert(a->end(), a_buff.begin(), a_buff.begin() + num);
+    for (uint64_t i = 0; i < num; ++i)
+      cells->emplace_back(r[i], c[i]);
+  } while (status == Query::Status::INCOMPLETE);
+  REQUIRE(status == Query::Status::COMPLETE);
+  array.close();
+}
+
+/**
+ * Writes `fragment_num` fragments of random cells, some overwriting the
+ * cells of the previous ones, and returns the value of every cell.
+ */
+std::map<Cell, int32_t> write_fragments(
+    const Context& ctx, int fragment_num, int cell_num) {
+  std::mt19937 gen(13);
+  std::uniform_int_distribution<int32_t> dist(1, 100);
+  std::map<Cell, int32_t> expected;
+  for (int f = 0; f < fragment_num; ++f) {
+    std::map<Cell, int32_t> fragment;
+    for (int i = 0; i < cell_num; ++i)
+      fragment[Cell(dist(gen), dist(gen) / 100.0)] = f;
+    std::vector<Cell> cells;
+    for (const auto& cell : fragment) {
+      cells.push_back(cell.first);
+      expected[cell.first] = f;
+    }
+    write_array(ctx, cells, f, TILEDB_UNORDERED);
+  }
+  return expected;
+}
+
+/** Checks that the input cells are the expected ones in Hilbert order. */
+void check_hilbert_order(
+    const std::vector<Cell>& cells,
+    const std::vector<int32_t>& a,
+    const std::map<Cell, int32_t>& expected) {
+  std::vector<Cell> expected_cells;
+  for (const auto& e : expected)
+    expected_cells.push_back(e.first);
+  sort_hilbert(&expected_cells);
+  CHECK(cells == expected_cells);
+  REQUIRE(a.size() == cells.size());
+  for (size_t i = 0; i < cells.size(); ++i)
+    CHECK(a[i] == expected.at(cells[i]));
+}
+
+}  // namespace
+
+TEST_CASE("Hilbert: Test coords to Hilbert values", "[hilbert]") {
+  // The first 4^k values of the 2D curve fill the 2^k x 2^k square at the
+  // origin, visiting adjacent cells in turn
+  sm::Hilbert hilbert(2);
+  CHECK(hilbert.bits() == 31);
+  std::map<uint64_t, std::pair<uint64_t, uint64_t>> cells;
+  for (uint64_t x = 0; x < 16; ++x) {
+    for (uint64_t y = 0; y < 16; ++y) {
+      uint64_t coords[2] = {x, y};
+      cells[hilbert.coords_to_hilbert(coords)] = std::make_pair(x, y);
+    }
+  }
+  REQUIRE(cells.size() == 256);
+  CHECK(cells.rbegin()->first == 255);
+  for (uint64_t h = 1; h < 256; ++h) {
+    auto dx = (int64_t)cells[h].first - (int64_t)cells[h - 1].first;
+    auto dy = (int64_t)cells[h].second - (int64_t)cells[h - 1].second;
+    CHECK(std::abs(dx) + std::abs(dy) == 1);
+  }
+
+  // Hilbert values map back to their points
+  for (const auto& cell : cells) {
+    uint64_t coords[2];
+    hilbert.hilbert_to_coords(cell.first, coords);
+    CHECK(coords[0] == cell.second.first);
+    CHECK(coords[1] == cell.second.second);
+  }
+  sm::Hilbert hilbert_3d(3);
+  std::mt19937_64 gen(5);
+  for (int i = 0; i < 100; ++i) {
+    uint64_t coords[3], point[3];
+    for (int d = 0; d < 3; ++d)
+      coords[d] = point[d] = gen() & hilbert_3d.max_bucket_val();
+    hilbert_3d.hilbert_to_coords(hilbert_3d.coords_to_hilbert(coords), coords);
+    CHECK(std::equal(coords, coords + 3, point));
+  }
+
+  // The 1D curve is the identity
+  sm::Hilbert hilbert_1d(1);
+  uint64_t coord = 12345;
+  CHECK(hilbert_1d.coords_to_hilbert(&coord) == 12345);
+  hilbert_1d.hilbert_to_coords(54321, &coord);
+  CHECK(coord == 54321);
+  CHECK(hilbert_1d.max_bucket_val() == (uint64_t(1) << 63) - 1);
+}
+
+TEST_CASE(
+    "C++ API: Test Hilbert cell order, write and read",
+    "[cppapi][hilbert]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx);
+  {
+    ArraySchema schema(ctx, array_name);
+    CHECK(schema.cell_order() == TILEDB_HILBERT);
+  }
+
+  // Two fragments, the second overwriting some cells of the first
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int32_t> dist(1, 100);
+  std::map<Cell, int32_t> expected;
+  std::vector<Cell> cells1, cells2;
+  for (int i = 0; i < 200; ++i) {
+    Cell cell(dist(gen), dist(gen) / 100.0);
+    if (expected.count(cell) != 0)
+      continue;
+    cells1.push_back(cell);
+    expected[cell] = 1;
+  }
+  for (size_t i = 0; i < cells1.size(); i += 3) {
+    cells2.push_back(cells1[i]);
+    expected[cells1[i]] = 2;
+  }
+  write_array(ctx, cells1, 1, TILEDB_UNORDERED);
+
+  // Global order writes must follow the Hilbert order
+  sort_hilbert(&cells2);
+  auto row_major = cells2;
+  std::sort(row_major.begin(), row_major.end());
+  REQUIRE(row_major != cells2);
+  CHECK_THROWS(write_array(ctx, row_major, 2, TILEDB_GLOBAL_ORDER));
+  write_array(ctx, cells2, 2, TILEDB_GLOBAL_ORDER);
+
+  // Global order reads return the cells in the Hilbert order
+  std::vector<Cell> cells;
+  std::vector<int32_t> a;
+  read_array(ctx, TILEDB_GLOBAL_ORDER, &cells, &a);
+  std::vector<Cell> expected_cells;
+  for (const auto& e : expected)
+    expected_cells.push_back(e.first);
+  sort_hilbert(&expected_cells);
+  CHECK(cells == expected_cells);
+  for (size_t i = 0; i < cells.size(); ++i)
+    CHECK(a[i] == expected[cells[i]]);
+
+  // Row-major reads are unaffected
+  read_array(ctx, TILEDB_ROW_MAJOR, &cells, &a);
+  std::sort(expected_cells.begin(), expected_cells.end());
+  CHECK(cells == expected_cells);
+  for (size_t i = 0; i < cells.size(); ++i)
+    CHECK(a[i] == expected[cells[i]]);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test Hilbert cell order, split global order reads",
+    "[cppapi][hilbert]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx);
+  auto expected = write_fragments(ctx, 3, 150);
+
+  // Reads split into many partitions return all the cells in the global
+  // order across the partitions
+  uint64_t buffer_cells = GENERATE(3, 17, 100);
+  std::vector<Cell> cells;
+  std::vector<int32_t> a;
+  read_array(ctx, TILEDB_GLOBAL_ORDER, &cells, &a, buffer_cells);
+  check_hilbert_order(cells, a, expected);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test Hilbert cell order, consolidation",
+    "[cppapi][hilbert][consolidation]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx);
+  auto expected = write_fragments(ctx, 4, 100);
+
+  // Consolidation reads the fragments in many partitions, and writes a
+  // single fragment in the global order
+  Config config;
+  config["sm.consolidation.buffer_size"] = "64";
+  Array::consolidate(ctx, array_name, &config);
+  Array::vacuum(ctx, array_name);
+  CHECK(tiledb::test::num_fragments(array_name) == 1);
+
+  std::vector<Cell> cells;
+  std::vector<int32_t> a;
+  read_array(ctx, TILEDB_GLOBAL_ORDER, &cells, &a);
+  check_hilbert_order(cells, a, expected);
+  read_array(ctx, TILEDB_GLOBAL_ORDER, &cells, &a, 7);
+  check_hilbert_order(cells, a, expected);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE("C++ API: Test Hilbert cell order, errors", "[cppapi][hilbert]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Dense arrays
+  {
+    Domain domain(ctx);
+    domain.add_dimension(Dimension::create<int32_t>(ctx, "r", {{1, 10}}, 5));
+    ArraySchema schema(ctx, TILEDB_DENSE);
+    schema.set_domain(domain).set_cell_order(TILEDB_HILBERT);
+    schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+    CHECK_THROWS(schema.check());
+  }
+
+  // String dimensions
+  {
+    Domain domain(ctx);
+    domain.add_dimension(
+        Dimension::create(ctx, "s", TILEDB_STRING_ASCII, nullptr, nullptr));
+    ArraySchema schema(ctx, TILEDB_SPARSE);
+    schema.set_domain(domain).set_cell_order(TILEDB_HILBERT);
+    schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+    CHECK_THROWS(schema.check());
+  }
+
+  // Hilbert tile order
+  {
+    Domain domain(ctx);
+    domain.add_dimension(Dimension::create<int32_t>(ctx, "r", {{1, 10}}, 5));
+    ArraySchema schema(ctx, TILEDB_SPARSE);
+    schema.set_domain(domain).set_tile_order(TILEDB_HILBERT);
+    schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+    CHECK_THROWS(schema.check());
+  }
+
+  // Query layouts
+  create_array(ctx);
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  CHECK_THROWS(query.set_layout(TILEDB_HILBERT));
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
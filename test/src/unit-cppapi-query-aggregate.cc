@@ -0,0 +1,446 @@
+/**
+ * @file   unit-cppapi-query-aggregate.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the C++ API for query aggregates.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cpp_api/tiledb"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace tiledb;
+
+namespace {
+
+const std::string array_name = "cpp_unit_array_query_aggregate";
+
+void create_array(
+    const Context& ctx, bool allows_dups = false, uint64_t capacity = 4) {
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  schema.set_allows_dups(allows_dups);
+  schema.set_capacity(capacity);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  schema.add_attribute(Attribute::create<double>(ctx, "b"));
+  schema.add_attribute(Attribute::create<uint8_t>(ctx, "u"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "s"));
+  Array::create(array_name, schema);
+}
+
+/**
+ * Writes cells `d`, with `a = a_base + d`, `b = d / 4`, `u = d` and
+ * `s = "s<d>"`.
+ */
+void write_array(
+    const Context& ctx, const std::vector<int32_t>& d, int32_t a_base) {
+  std::vector<int32_t> a;
+  std::vector<double> b;
+  std::vector<uint8_t> u;
+  std::string s;
+  std::vector<uint64_t> s_off;
+  for (auto c : d) {
+    a.push_back(a_base + c);
+    b.push_back(c / 4.0);
+    u.push_back((uint8_t)c);
+    s_off.push_back(s.size());
+    s += "s" + std::to_string(c);
+  }
+
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array, TILEDB_WRITE);
+  query.set_layout(TILEDB_UNORDERED)
+      .set_buffer("d", const_cast<std::vector<int32_t>&>(d))
+      .set_buffer("a", a)
+      .set_buffer("b", b)
+      .set_buffer("u", u)
+      .set_buffer("s", s_off, s);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+}
+
+/** The aggregates of a set of cells. */
+struct Aggregates {
+  uint64_t count_ = 0;
+  int64_t sum_a_ = 0;
+  int32_t min_a_ = 0;
+  int32_t max_a_ = 0;
+  double mean_a_ = 0;
+  double sum_b_ = 0;
+  uint64_t sum_u_ = 0;
+  uint8_t max_u_ = 0;
+  uint64_t count_s_ = 0;
+};
+
+/** Computes the aggregates with a regular read of attributes `a`, `b`. */
+Aggregates expected_aggregates(
+    const Context& ctx,
+    int32_t start,
+    int32_t end,
+    const QueryCondition* cond = nullptr) {
+  std::vector<int32_t> a(100);
+  std::vector<double> b(100);
+  std::vector<uint8_t> u(100);
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  query.set_layout(TILEDB_ROW_MAJOR)
+      .add_range(0, start, end)
+      .set_buffer("a", a)
+      .set_buffer("b", b)
+      .set_buffer("u", u);
+  if (cond != nullptr)
+    query.set_condition(*cond);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  auto result_num = query.result_buffer_elements()["a"].second;
+  array.close();
+
+  Aggregates r;
+  r.count_ = result_num;
+  r.count_s_ = result_num;
+  for (uint64_t i = 0; i < result_num; ++i) {
+    r.sum_a_ += a[i];
+    r.min_a_ = (i == 0) ? a[i] : std::min(r.min_a_, a[i]);
+    r.max_a_ = (i == 0) ? a[i] : std::max(r.max_a_, a[i]);
+    r.sum_b_ += b[i];
+    r.sum_u_ += u[i];
+    r.max_u_ = std::max(r.max_u_, u[i]);
+  }
+  r.mean_a_ = (double)r.sum_a_ / result_num;
+
+  return r;
+}
+
+/** Computes the aggregates inside the read. */
+Aggregates read_aggregates(
+    const Context& ctx,
+    int32_t start,
+    int32_t end,
+    const QueryCondition* cond = nullptr) {
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  query.set_layout(TILEDB_UNORDERED)
+      .add_range(0, start, end)
+      .add_aggregate("a", TILEDB_AGGREGATE_COUNT)
+      .add_aggregate("a", TILEDB_AGGREGATE_SUM)
+      .add_aggregate("a", TILEDB_AGGREGATE_MIN)
+      .add_aggregate("a", TILEDB_AGGREGATE_MAX)
+      .add_aggregate("a", TILEDB_AGGREGATE_MEAN)
+      .add_aggregate("b", TILEDB_AGGREGATE_SUM)
+      .add_aggregate("u", TILEDB_AGGREGATE_SUM)
+      .add_aggregate("u", TILEDB_AGGREGATE_MAX)
+      .add_aggregate("s", TILEDB_AGGREGATE_COUNT);
+  if (cond != nullptr)
+    query.set_condition(*cond);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+
+  Aggregates r;
+  r.count_ = query.aggregate<uint64_t>("a", TILEDB_AGGREGATE_COUNT);
+  r.sum_a_ = query.aggregate<int64_t>("a", TILEDB_AGGREGATE_SUM);
+  r.min_a_ = query.aggregate<int32_t>("a", TILEDB_AGGREGATE_MIN);
+  r.max_a_ = query.aggregate<int32_t>("a", TILEDB_AGGREGATE_MAX);
+  r.mean_a_ = query.aggregate<double>("a", TILEDB_AGGREGATE_MEAN);
+  r.sum_b_ = query.aggregate<double>("b", TILEDB_AGGREGATE_SUM);
+  r.sum_u_ = query.aggregate<uint64_t>("u", TILEDB_AGGREGATE_SUM);
+  r.max_u_ = query.aggregate<uint8_t>("u", TILEDB_AGGREGATE_MAX);
+  r.count_s_ = query.aggregate<uint64_t>("s", TILEDB_AGGREGATE_COUNT);
+  array.close();
+
+  return r;
+}
+
+void check_aggregates(
+    const Context& ctx,
+    int32_t start,
+    int32_t end,
+    const QueryCondition* cond = nullptr) {
+  auto expected = expected_aggregates(ctx, start, end, cond);
+  auto r = read_aggregates(ctx, start, end, cond);
+  CHECK(r.count_ == expected.count_);
+  CHECK(r.sum_a_ == expected.sum_a_);
+  CHECK(r.min_a_ == expected.min_a_);
+  CHECK(r.max_a_ == expected.max_a_);
+  CHECK(r.mean_a_ == expected.mean_a_);
+  CHECK(r.sum_b_ == expected.sum_b_);
+  CHECK(r.sum_u_ == expected.sum_u_);
+  CHECK(r.max_u_ == expected.max_u_);
+  CHECK(r.count_s_ == expected.count_s_);
+}
+
+}  // namespace
+
+TEST_CASE(
+    "C++ API: Test query aggregates, single fragment",
+    "[cppapi][query-aggregate]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx);
+  std::vector<int32_t> d;
+  for (int32_t i = 1; i <= 40; ++i)
+    d.push_back(i);
+  write_array(ctx, d, -20);
+
+  SECTION("- Whole domain") {
+    auto r = read_aggregates(ctx, 1, 100);
+    CHECK(r.count_ == 40);
+    CHECK(r.sum_a_ == 20);
+    CHECK(r.min_a_ == -19);
+    CHECK(r.max_a_ == 20);
+    CHECK(r.mean_a_ == 0.5);
+    CHECK(r.sum_b_ == 205);
+    CHECK(r.sum_u_ == 820);
+    CHECK(r.max_u_ == 40);
+    CHECK(r.count_s_ == 40);
+    check_aggregates(ctx, 1, 100);
+  }
+
+  SECTION("- Partially covered tiles") {
+    check_aggregates(ctx, 3, 37);
+    check_aggregates(ctx, 6, 7);
+  }
+
+  SECTION("- Query condition") {
+    QueryCondition cond(ctx);
+    int32_t value = 0;
+    cond.init("a", &value, sizeof(value), TILEDB_GT);
+    check_aggregates(ctx, 1, 100, &cond);
+    check_aggregates(ctx, 3, 37, &cond);
+  }
+
+  SECTION("- Empty result") {
+    auto r = read_aggregates(ctx, 50, 100);
+    CHECK(r.count_ == 0);
+    CHECK(r.sum_a_ == 0);
+    CHECK(std::isnan(r.mean_a_));
+  }
+
+  SECTION("- Multiple partitions") {
+    Config config;
+    config["sm.memory_budget"] = "64";
+    config["sm.memory_budget_var"] = "64";
+    Context ctx_budget(config);
+    for (auto range : std::vector<std::pair<int32_t, int32_t>>{{1, 100},
+                                                               {3, 37}}) {
+      auto expected = expected_aggregates(ctx, range.first, range.second);
+      auto r = read_aggregates(ctx_budget, range.first, range.second);
+      CHECK(r.count_ == expected.count_);
+      CHECK(r.sum_a_ == expected.sum_a_);
+      CHECK(r.min_a_ == expected.min_a_);
+      CHECK(r.max_a_ == expected.max_a_);
+      CHECK(r.sum_b_ == expected.sum_b_);
+      CHECK(r.count_s_ == expected.count_s_);
+    }
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query aggregates, multiple fragments",
+    "[cppapi][query-aggregate]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  for (bool allows_dups : {true, false}) {
+    if (vfs.is_dir(array_name))
+      vfs.remove_dir(array_name);
+
+    create_array(ctx, allows_dups);
+    std::vector<int32_t> d;
+    for (int32_t i = 1; i <= 40; ++i)
+      d.push_back(i);
+    write_array(ctx, d, 0);
+    write_array(ctx, {5, 6, 7, 8, 9, 10, 11, 12, 45}, 100);
+
+    auto r = read_aggregates(ctx, 1, 100);
+    CHECK(r.count_ == (allows_dups ? 49 : 41));
+    check_aggregates(ctx, 1, 100);
+    check_aggregates(ctx, 8, 42);
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query aggregates, errors", "[cppapi][query-aggregate]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx);
+  write_array(ctx, {1, 2, 3}, 0);
+
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+
+  // Unknown attribute and unsupported types
+  CHECK_THROWS(query.add_aggregate("foo", TILEDB_AGGREGATE_COUNT));
+  CHECK_THROWS(query.add_aggregate("d", TILEDB_AGGREGATE_SUM));
+  CHECK_THROWS(query.add_aggregate("s", TILEDB_AGGREGATE_MIN));
+
+  // Aggregates cannot be combined with buffers
+  std::vector<int32_t> a(10);
+  query.add_aggregate("a", TILEDB_AGGREGATE_SUM).set_buffer("a", a);
+  CHECK_THROWS(query.submit());
+
+  // The query must complete before the aggregates are retrieved
+  Query query2(ctx, array, TILEDB_READ);
+  query2.add_aggregate("a", TILEDB_AGGREGATE_SUM);
+  CHECK_THROWS(query2.aggregate<int64_t>("a", TILEDB_AGGREGATE_SUM));
+  CHECK(query2.submit() == Query::Status::COMPLETE);
+  CHECK(query2.aggregate<int64_t>("a", TILEDB_AGGREGATE_SUM) == 6);
+  CHECK_THROWS(query2.aggregate<int32_t>("a", TILEDB_AGGREGATE_SUM));
+  CHECK_THROWS(query2.aggregate<int64_t>("a", TILEDB_AGGREGATE_MAX));
+  CHECK_THROWS(query2.aggregate<uint64_t>("a", TILEDB_AGGREGATE_COUNT));
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query aggregates, integer sum overflow",
+    "[cppapi][query-aggregate]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Capacity 2, so that the sums overflow either within the second tile
+  // or when the tiles are merged
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(2);
+  schema.add_attribute(Attribute::create<int64_t>(ctx, "a"));
+  schema.add_attribute(Attribute::create<uint64_t>(ctx, "u"));
+  Array::create(array_name, schema);
+
+  const int64_t max = std::numeric_limits<int64_t>::max();
+  const int64_t min = std::numeric_limits<int64_t>::min();
+  const uint64_t umax = std::numeric_limits<uint64_t>::max();
+  std::vector<int32_t> d = {1, 2, 3, 4, 5, 6};
+  std::vector<int64_t> a;
+  std::vector<uint64_t> u;
+  SECTION("- Overflow within a tile") {
+    a = {0, 0, max, 1, 0, 0};
+    u = {0, 0, umax, 1, 0, 0};
+  }
+  SECTION("- Overflow across tiles") {
+    a = {0, 0, max - 1, 0, 1, 1};
+    u = {0, 0, umax - 1, 0, 1, 1};
+  }
+  SECTION("- Negative overflow") {
+    a = {0, 0, min, 0, -1, 0};
+    u = {0, 0, umax, 1, 0, 0};
+  }
+
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w, TILEDB_WRITE);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_buffer("d", d)
+      .set_buffer("a", a)
+      .set_buffer("u", u);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  // The whole tiles are aggregated from the tile statistics, the partial
+  // first one from the cells
+  for (int32_t start : {1, 2}) {
+    Array array(ctx, array_name, TILEDB_READ);
+    Query query(ctx, array, TILEDB_READ);
+    query.set_layout(TILEDB_UNORDERED)
+        .add_range(0, start, 6)
+        .add_aggregate("a", TILEDB_AGGREGATE_SUM)
+        .add_aggregate("a", TILEDB_AGGREGATE_MEAN)
+        .add_aggregate("a", TILEDB_AGGREGATE_MAX)
+        .add_aggregate("u", TILEDB_AGGREGATE_SUM);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    CHECK_THROWS(query.aggregate<int64_t>("a", TILEDB_AGGREGATE_SUM));
+    CHECK_THROWS(query.aggregate<double>("a", TILEDB_AGGREGATE_MEAN));
+    CHECK(
+        query.aggregate<int64_t>("a", TILEDB_AGGREGATE_MAX) ==
+        *std::max_element(a.begin() + start - 1, a.end()));
+    CHECK_THROWS(query.aggregate<uint64_t>("u", TILEDB_AGGREGATE_SUM));
+    array.close();
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query aggregates, integer sum at the type limit",
+    "[cppapi][query-aggregate]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(4);
+  schema.add_attribute(Attribute::create<int64_t>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // The tile sum equals the maximum, i.e., the saturated value, but is
+  // exact and must be computed from the cells
+  const int64_t max = std::numeric_limits<int64_t>::max();
+  std::vector<int32_t> d = {1, 2, 3, 4};
+  std::vector<int64_t> a = {max - 10, 5, 5, 0};
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w, TILEDB_WRITE);
+  query_w.set_layout(TILEDB_UNORDERED).set_buffer("d", d).set_buffer("a", a);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  query.set_layout(TILEDB_UNORDERED)
+      .add_range(0, 1, 4)
+      .add_aggregate("a", TILEDB_AGGREGATE_SUM);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  CHECK(query.aggregate<int64_t>("a", TILEDB_AGGREGATE_SUM) == max);
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
@@ -0,0 +1,329 @@
+/**
+ * @file   unit-cppapi-query-condition.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the C++ API for query conditions.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cpp_api/tiledb"
+
+#include <cstring>
+
+using namespace tiledb;
+
+namespace {
+
+const std::string array_name = "cpp_unit_array_query_condition";
+
+void create_array(
+    const Context& ctx, bool allows_dups = false, uint64_t capacity = 10000) {
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  schema.set_allows_dups(allows_dups);
+  schema.set_capacity(capacity);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  schema.add_attribute(Attribute::create<float>(ctx, "b"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "s"));
+  Array::create(array_name, schema);
+}
+
+/** Writes cells `d`, with `a = a_base + d`, `b = d / 2` and `s = "s<d>"`. */
+void write_array(
+    const Context& ctx, const std::vector<int32_t>& d, int32_t a_base) {
+  std::vector<int32_t> a;
+  std::vector<float> b;
+  std::string s;
+  std::vector<uint64_t> s_off;
+  for (auto c : d) {
+    a.push_back(a_base + c);
+    b.push_back(c / 2.0f);
+    s_off.push_back(s.size());
+    s += "s" + std::to_string(c);
+  }
+
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array, TILEDB_WRITE);
+  query.set_layout(TILEDB_UNORDERED)
+      .set_buffer("d", const_cast<std::vector<int32_t>&>(d))
+      .set_buffer("a", a)
+      .set_buffer("b", b)
+      .set_buffer("s", s_off, s);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+}
+
+/** Reads with the input condition and returns the result coordinates. */
+std::vector<int32_t> read_array(
+    const Context& ctx,
+    const QueryCondition& cond,
+    std::vector<int32_t>* a_out = nullptr) {
+  std::vector<int32_t> d(100);
+  std::vector<int32_t> a(100);
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  query.set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("d", d)
+      .set_buffer("a", a)
+      .set_condition(cond);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  auto result_num = query.result_buffer_elements()["d"].second;
+  d.resize(result_num);
+  a.resize(result_num);
+  if (a_out != nullptr)
+    *a_out = a;
+  array.close();
+  return d;
+}
+
+}  // namespace
+
+TEST_CASE(
+    "C++ API: Test query condition, single fragment",
+    "[cppapi][query-condition]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx);
+  std::vector<int32_t> d;
+  for (int32_t i = 1; i <= 40; ++i)
+    d.push_back(i);
+  write_array(ctx, d, 0);
+
+  SECTION("- Fixed-sized attribute") {
+    QueryCondition cond(ctx);
+    int32_t value = 35;
+    cond.init("a", &value, sizeof(value), TILEDB_GE);
+    std::vector<int32_t> a;
+    CHECK(
+        read_array(ctx, cond, &a) ==
+        std::vector<int32_t>{35, 36, 37, 38, 39, 40});
+    CHECK(a == std::vector<int32_t>{35, 36, 37, 38, 39, 40});
+  }
+
+  SECTION("- Combined conditions") {
+    QueryCondition cond1(ctx);
+    int32_t value1 = 4;
+    cond1.init("a", &value1, sizeof(value1), TILEDB_GT);
+    QueryCondition cond2(ctx);
+    float value2 = 4.0f;
+    cond2.init("b", &value2, sizeof(value2), TILEDB_LE);
+    QueryCondition cond = cond1.combine(cond2, TILEDB_AND);
+    CHECK(read_array(ctx, cond) == std::vector<int32_t>{5, 6, 7, 8});
+  }
+
+  SECTION("- String attribute") {
+    QueryCondition cond(ctx);
+    cond.init("s", "s12", TILEDB_EQ);
+    CHECK(read_array(ctx, cond) == std::vector<int32_t>{12});
+
+    QueryCondition cond_lt(ctx);
+    cond_lt.init("s", "s12", TILEDB_LT);
+    CHECK(read_array(ctx, cond_lt) == std::vector<int32_t>{1, 10, 11});
+  }
+
+  SECTION("- No results") {
+    QueryCondition cond(ctx);
+    int32_t value = 100;
+    cond.init("a", &value, sizeof(value), TILEDB_GT);
+    CHECK(read_array(ctx, cond).empty());
+  }
+
+  SECTION("- Invalid conditions") {
+    Array array(ctx, array_name, TILEDB_READ);
+    Query query(ctx, array, TILEDB_READ);
+
+    QueryCondition cond_attr(ctx);
+    int32_t value = 1;
+    cond_attr.init("foo", &value, sizeof(value), TILEDB_EQ);
+    CHECK_THROWS(query.set_condition(cond_attr));
+
+    QueryCondition cond_size(ctx);
+    int64_t value64 = 1;
+    cond_size.init("a", &value64, sizeof(value64), TILEDB_EQ);
+    CHECK_THROWS(query.set_condition(cond_size));
+
+    CHECK_THROWS(cond_attr.init("a", &value, sizeof(value), TILEDB_EQ));
+
+    array.close();
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query condition, multiple fragments",
+    "[cppapi][query-condition]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  bool allows_dups = false;
+  SECTION("- No duplicates") {
+    allows_dups = false;
+  }
+  SECTION("- Duplicates") {
+    allows_dups = true;
+  }
+
+  create_array(ctx, allows_dups);
+  write_array(ctx, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, 0);
+  write_array(ctx, {2, 4, 6}, 100);
+
+  QueryCondition cond(ctx);
+  int32_t value = 5;
+  cond.init("a", &value, sizeof(value), TILEDB_LT);
+  std::vector<int32_t> a;
+  auto d = read_array(ctx, cond, &a);
+
+  if (allows_dups) {
+    // Both versions of the overwritten cells are visible
+    CHECK(d == std::vector<int32_t>{1, 2, 3, 4});
+    CHECK(a == std::vector<int32_t>{1, 2, 3, 4});
+  } else {
+    // The condition is evaluated on the most recent version of each cell
+    CHECK(d == std::vector<int32_t>{1, 3});
+    CHECK(a == std::vector<int32_t>{1, 3});
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query condition, tile pruning",
+    "[cppapi][query-condition]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Ten tiles of four cells each, so that the tile minimum/maximum values
+  // rule out most tiles
+  bool allows_dups = false;
+  SECTION("- No duplicates") {
+    allows_dups = false;
+  }
+  SECTION("- Duplicates") {
+    allows_dups = true;
+  }
+
+  create_array(ctx, allows_dups, 4);
+  std::vector<int32_t> d;
+  for (int32_t i = 1; i <= 40; ++i)
+    d.push_back(i);
+  write_array(ctx, d, 0);
+
+  QueryCondition cond_ge(ctx);
+  int32_t value = 35;
+  cond_ge.init("a", &value, sizeof(value), TILEDB_GE);
+  CHECK(
+      read_array(ctx, cond_ge) ==
+      std::vector<int32_t>{35, 36, 37, 38, 39, 40});
+
+  QueryCondition cond_eq(ctx);
+  value = 6;
+  cond_eq.init("a", &value, sizeof(value), TILEDB_EQ);
+  CHECK(read_array(ctx, cond_eq) == std::vector<int32_t>{6});
+
+  QueryCondition cond_le(ctx);
+  value = 5;
+  cond_le.init("a", &value, sizeof(value), TILEDB_LE);
+  CHECK(read_array(ctx, cond_le) == std::vector<int32_t>{1, 2, 3, 4, 5});
+
+  QueryCondition cond_ne(ctx);
+  value = 5;
+  cond_ne.init("a", &value, sizeof(value), TILEDB_NE);
+  CHECK(read_array(ctx, cond_ne).size() == 39);
+
+  QueryCondition cond_b(ctx);
+  float value_b = 19.5f;
+  cond_b.init("b", &value_b, sizeof(value_b), TILEDB_GT);
+  CHECK(read_array(ctx, cond_b) == std::vector<int32_t>{40});
+
+  QueryCondition cond_s(ctx);
+  cond_s.init("s", "s4", TILEDB_GE);
+  CHECK(read_array(ctx, cond_s) == std::vector<int32_t>{4, 5, 6, 7, 8, 9, 40});
+
+  // With a second fragment, the cells of the pruned tiles of the first
+  // fragment must still be considered when deduplicating
+  write_array(ctx, {37, 38}, -100);
+  std::vector<int32_t> a;
+  auto result = read_array(ctx, cond_ge, &a);
+  if (allows_dups) {
+    CHECK(result == std::vector<int32_t>{35, 36, 37, 38, 39, 40});
+    CHECK(a == std::vector<int32_t>{35, 36, 37, 38, 39, 40});
+  } else {
+    CHECK(result == std::vector<int32_t>{35, 36, 39, 40});
+    CHECK(a == std::vector<int32_t>{35, 36, 39, 40});
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test query condition, dense array",
+    "[cppapi][query-condition]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 4}}, 4));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  std::vector<int32_t> a = {1, 2, 3, 4};
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w, TILEDB_WRITE);
+  query_w.set_layout(TILEDB_ROW_MAJOR).set_buffer("a", a);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  QueryCondition cond(ctx);
+  int32_t value = 2;
+  cond.init("a", &value, sizeof(value), TILEDB_GT);
+  query.set_subarray<int32_t>({1, 4}).set_buffer("a", a).set_condition(cond);
+  CHECK_THROWS(query.submit());
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
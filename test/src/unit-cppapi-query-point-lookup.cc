@@ -0,0 +1,331 @@
+/**
+ * @file   unit-cppapi-query-point-lookup.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the C++ API for batched point lookups.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cpp_api/tiledb"
+
+#include <map>
+#include <random>
+
+using namespace tiledb;
+
+namespace {
+
+const std::string array_name = "cpp_unit_array_query_point_lookup";
+
+const int32_t a_fill = -1;
+const std::string s_fill = "none";
+
+typedef std::pair<int32_t, int32_t> Cell;
+
+void create_array(const Context& ctx) {
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "r", {{1, 100}}, 10))
+      .add_dimension(Dimension::create<int32_t>(ctx, "c", {{1, 100}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  schema.set_capacity(8);
+  auto a = Attribute::create<int32_t>(ctx, "a");
+  a.set_fill_value(&a_fill, sizeof(a_fill));
+  auto s = Attribute::create<std::string>(ctx, "s");
+  s.set_fill_value(s_fill.data(), s_fill.size());
+  schema.add_attribute(a).add_attribute(s);
+  Array::create(array_name, schema);
+}
+
+/**
+ * Writes the input cells with `a = a_base + 100 * r + c` and `s = "s<a>"`,
+ * and records their values in `expected`.
+ */
+void write_array(
+    const Context& ctx,
+    const std::vector<Cell>& cells,
+    int32_t a_base,
+    std::map<Cell, int32_t>* expected) {
+  std::vector<int32_t> r, c, a;
+  std::string s;
+  std::vector<uint64_t> s_off;
+  for (const auto& cell : cells) {
+    r.push_back(cell.first);
+    c.push_back(cell.second);
+    a.push_back(a_base + 100 * cell.first + cell.second);
+    s_off.push_back(s.size());
+    s += "s" + std::to_string(a.back());
+    (*expected)[cell] = a.back();
+  }
+
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array, TILEDB_WRITE);
+  query.set_layout(TILEDB_UNORDERED)
+      .set_buffer("r", r)
+      .set_buffer("c", c)
+      .set_buffer("a", a)
+      .set_buffer("s", s_off, s);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+}
+
+/** Checks the results of a point lookup against `expected`. */
+void check_results(
+    const std::vector<int32_t>& rows,
+    const std::vector<int32_t>& cols,
+    const std::vector<uint8_t>& found,
+    const std::vector<int32_t>& a,
+    const std::vector<uint64_t>& s_off,
+    const std::string& s,
+    uint64_t s_size,
+    const std::map<Cell, int32_t>& expected) {
+  REQUIRE(found.size() == rows.size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    auto it = expected.find(Cell(rows[i], cols[i]));
+    auto end = (i + 1 < rows.size()) ? s_off[i + 1] : s_size;
+    auto value = s.substr(s_off[i], end - s_off[i]);
+    if (it == expected.end()) {
+      CHECK(found[i] == 0);
+      CHECK(a[i] == a_fill);
+      CHECK(value == s_fill);
+    } else {
+      CHECK(found[i] == 1);
+      CHECK(a[i] == it->second);
+      CHECK(value == "s" + std::to_string(it->second));
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("C++ API: Test point lookups", "[cppapi][query][point-lookup]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx);
+
+  // Two fragments, the second overwriting some cells of the first
+  std::map<Cell, int32_t> expected;
+  std::vector<Cell> cells1, cells2;
+  for (int32_t r = 1; r <= 100; r += 3) {
+    for (int32_t c = 1; c <= 100; c += 7)
+      cells1.emplace_back(r, c);
+  }
+  for (int32_t r = 1; r <= 50; r += 2) {
+    for (int32_t c = 1; c <= 100; c += 5)
+      cells2.emplace_back(r, c);
+  }
+  write_array(ctx, cells1, 0, &expected);
+  write_array(ctx, cells2, 100000, &expected);
+
+  // Random points, including duplicates and empty cells
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int32_t> dist(1, 100);
+  std::vector<int32_t> rows, cols;
+  for (int i = 0; i < 1000; ++i) {
+    rows.push_back(dist(gen));
+    cols.push_back(dist(gen));
+  }
+  for (int i = 0; i < 100; ++i) {
+    rows.push_back(cells2[i * 3].first);
+    cols.push_back(cells2[i * 3].second);
+    rows.push_back(rows[i]);
+    cols.push_back(cols[i]);
+  }
+
+  Array array(ctx, array_name, TILEDB_READ);
+  std::vector<uint8_t> found;
+  std::vector<int32_t> a(rows.size());
+  std::vector<uint64_t> s_off(rows.size());
+  std::string s;
+  s.resize(rows.size() * 16);
+  Query query(ctx, array, TILEDB_READ);
+  query.set_point_lookups<int32_t>({rows, cols}, found)
+      .set_buffer("a", a)
+      .set_buffer("s", s_off, s);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  auto result_elements = query.result_buffer_elements();
+  CHECK(result_elements["a"].second == rows.size());
+  CHECK(result_elements["s"].first == rows.size());
+  check_results(
+      rows,
+      cols,
+      found,
+      a,
+      s_off,
+      s,
+      result_elements["s"].second,
+      expected);
+
+  // The values must fit the buffers
+  std::vector<int32_t> small_a(10);
+  Query query2(ctx, array, TILEDB_READ);
+  query2.set_point_lookups<int32_t>({rows, cols}, found)
+      .set_buffer("a", small_a);
+  CHECK(query2.submit() == Query::Status::INCOMPLETE);
+  CHECK(query2.result_buffer_elements()["a"].second == 0);
+  query2.set_buffer("a", a);
+  REQUIRE(query2.submit() == Query::Status::COMPLETE);
+  CHECK(query2.result_buffer_elements()["a"].second == rows.size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    auto it = expected.find(Cell(rows[i], cols[i]));
+    CHECK(a[i] == ((it == expected.end()) ? a_fill : it->second));
+  }
+
+  // Lookups with only the found flags
+  Query query3(ctx, array, TILEDB_READ);
+  query3.set_point_lookups<int32_t>({rows, cols}, found);
+  REQUIRE(query3.submit() == Query::Status::COMPLETE);
+  for (size_t i = 0; i < rows.size(); ++i)
+    CHECK(found[i] == expected.count(Cell(rows[i], cols[i])));
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test point lookups on an empty array",
+    "[cppapi][query][point-lookup]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx);
+
+  std::vector<int32_t> rows = {5, 1}, cols = {2, 1};
+  std::vector<uint8_t> found;
+  std::vector<int32_t> a(2);
+  std::vector<uint64_t> s_off(2);
+  std::string s(16, ' ');
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  query.set_point_lookups<int32_t>({rows, cols}, found)
+      .set_buffer("a", a)
+      .set_buffer("s", s_off, s);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  check_results(
+      rows,
+      cols,
+      found,
+      a,
+      s_off,
+      s,
+      query.result_buffer_elements()["s"].second,
+      {});
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test point lookups, errors", "[cppapi][query][point-lookup]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx);
+  std::map<Cell, int32_t> expected;
+  write_array(ctx, {{1, 1}, {2, 2}}, 0, &expected);
+
+  Array array(ctx, array_name, TILEDB_READ);
+  std::vector<int32_t> rows = {1, 2}, cols = {1, 3};
+  std::vector<uint8_t> found;
+  std::vector<int32_t> a(2), r(2);
+
+  // Wrong number of dimensions, type and sizes
+  Query query(ctx, array, TILEDB_READ);
+  CHECK_THROWS(query.set_point_lookups<int32_t>({rows}, found));
+  CHECK_THROWS(query.set_point_lookups<int64_t>({{1, 2}, {1, 3}}, found));
+  CHECK_THROWS(query.set_point_lookups<int32_t>({rows, {1}}, found));
+
+  // Point lookups cannot be combined with coordinate buffers or subarrays
+  Query query2(ctx, array, TILEDB_READ);
+  query2.set_point_lookups<int32_t>({rows, cols}, found)
+      .set_buffer("a", a)
+      .set_buffer("r", r);
+  CHECK_THROWS(query2.submit());
+  Query query3(ctx, array, TILEDB_READ);
+  query3.set_point_lookups<int32_t>({rows, cols}, found)
+      .add_range(0, 1, 2)
+      .set_buffer("a", a);
+  CHECK_THROWS(query3.submit());
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test point lookups on real dimensions",
+    "[cppapi][query][point-lookup]") {
+  const std::string real_array_name = "cpp_unit_array_query_point_lookup_real";
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(real_array_name))
+    vfs.remove_dir(real_array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<double>(ctx, "x", {{-10, 10}}, 5));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(4);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  Array::create(real_array_name, schema);
+
+  // The cell at zero is written as either zero or negative zero
+  const double zero = GENERATE(0.0, -0.0);
+  std::vector<double> x = {-1.5, zero, 2.5};
+  std::vector<int32_t> a = {1, 2, 3};
+  Array array_w(ctx, real_array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w, TILEDB_WRITE);
+  query_w.set_layout(TILEDB_UNORDERED).set_buffer("x", x).set_buffer("a", a);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  // Zero and negative zero are equal coordinates
+  std::vector<double> points = {0.0, 2.5, -0.0, 1.0};
+  std::vector<uint8_t> found;
+  std::vector<int32_t> a_read(points.size());
+  Array array(ctx, real_array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  query.set_point_lookups<double>({points}, found).set_buffer("a", a_read);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  CHECK(found == std::vector<uint8_t>({1, 1, 1, 0}));
+  CHECK(a_read[0] == 2);
+  CHECK(a_read[1] == 3);
+  CHECK(a_read[2] == 2);
+  array.close();
+
+  if (vfs.is_dir(real_array_name))
+    vfs.remove_dir(real_array_name);
+}
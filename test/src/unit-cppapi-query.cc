@@ -34,6 +34,12 @@
 #include "tiledb/sm/cpp_api/tiledb"
 #include "tiledb/sm/misc/utils.h"
 
+#include <algorithm>
+#include <array>
+#include <map>
+#include <set>
+#include <tuple>
+
 using namespace tiledb;
 
 TEST_CASE("C++ API: Test get query layout", "[cppapi][query]") {
@@ -229,3 +235,866 @@ TEST_CASE(
   array1.close();
   array2.close();
 }
+
+TEST_CASE(
+    "C++ API: Test sorted sparse reads on 3D int64 domain",
+    "[cppapi][query][sort]") {
+  const std::string array_name = "cpp_unit_array_sort";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create the array
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int64_t>(ctx, "d1", {{-50, 49}}, 7))
+      .add_dimension(Dimension::create<int64_t>(ctx, "d2", {{-50, 49}}, 5))
+      .add_dimension(Dimension::create<int64_t>(ctx, "d3", {{-50, 49}}, 3));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_order({{TILEDB_COL_MAJOR, TILEDB_ROW_MAJOR}});
+  schema.set_capacity(16);
+  schema.add_attribute(Attribute::create<int64_t>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Write random distinct cells in two fragments
+  std::srand(7);
+  std::set<std::array<int64_t, 3>> cells;
+  while (cells.size() < 500) {
+    cells.insert(
+        {{std::rand() % 100 - 50, std::rand() % 100 - 50, std::rand() % 5}});
+  }
+  std::vector<std::array<int64_t, 3>> cells_vec(cells.begin(), cells.end());
+  std::random_shuffle(cells_vec.begin(), cells_vec.end());
+  for (size_t f = 0; f < 2; ++f) {
+    std::vector<int64_t> d1, d2, d3, a;
+    for (size_t i = f * 250; i < (f + 1) * 250; ++i) {
+      d1.push_back(cells_vec[i][0]);
+      d2.push_back(cells_vec[i][1]);
+      d3.push_back(cells_vec[i][2]);
+      a.push_back(cells_vec[i][0] * 10000 + cells_vec[i][1] * 100 +
+                  cells_vec[i][2]);
+    }
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_buffer("d1", d1)
+        .set_buffer("d2", d2)
+        .set_buffer("d3", d3)
+        .set_buffer("a", a);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+  }
+
+  // Expected orders
+  auto tile = [](const std::array<int64_t, 3>& c) {
+    return std::array<int64_t, 3>{
+        {(c[0] + 50) / 7, (c[1] + 50) / 5, (c[2] + 50) / 3}};
+  };
+  auto row_cmp = [](const std::array<int64_t, 3>& a,
+                    const std::array<int64_t, 3>& b) { return a < b; };
+  auto col_cmp = [](const std::array<int64_t, 3>& a,
+                    const std::array<int64_t, 3>& b) {
+    return std::make_tuple(a[2], a[1], a[0]) <
+           std::make_tuple(b[2], b[1], b[0]);
+  };
+  auto global_cmp = [&](const std::array<int64_t, 3>& a,
+                        const std::array<int64_t, 3>& b) {
+    auto ta = tile(a), tb = tile(b);
+    if (ta != tb)
+      return col_cmp(ta, tb);
+    return row_cmp(a, b);
+  };
+
+  for (auto layout :
+       {TILEDB_ROW_MAJOR, TILEDB_COL_MAJOR, TILEDB_GLOBAL_ORDER}) {
+    std::vector<std::array<int64_t, 3>> expected(cells.begin(), cells.end());
+    if (layout == TILEDB_ROW_MAJOR)
+      std::sort(expected.begin(), expected.end(), row_cmp);
+    else if (layout == TILEDB_COL_MAJOR)
+      std::sort(expected.begin(), expected.end(), col_cmp);
+    else
+      std::sort(expected.begin(), expected.end(), global_cmp);
+
+    Array array(ctx, array_name, TILEDB_READ);
+    Query query(ctx, array);
+    std::vector<int64_t> d1(1000), d2(1000), d3(1000), a(1000);
+    query.set_layout(layout)
+        .add_range<int64_t>(0, -50, 49)
+        .add_range<int64_t>(1, -50, 49)
+        .add_range<int64_t>(2, -50, 49)
+        .set_buffer("d1", d1)
+        .set_buffer("d2", d2)
+        .set_buffer("d3", d3)
+        .set_buffer("a", a);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    REQUIRE(query.result_buffer_elements()["a"].second == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      CHECK(d1[i] == expected[i][0]);
+      CHECK(d2[i] == expected[i][1]);
+      CHECK(d3[i] == expected[i][2]);
+      CHECK(a[i] == d1[i] * 10000 + d2[i] * 100 + d3[i]);
+    }
+    array.close();
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test sparse reads merging many overlapping fragments",
+    "[cppapi][query][sort][dedup]") {
+  const std::string array_name = "cpp_unit_array_merge";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create the array
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d1", {{1, 40}}, 8))
+      .add_dimension(Dimension::create<int32_t>(ctx, "d2", {{1, 40}}, 8));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_COL_MAJOR}});
+  schema.set_capacity(8);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Write fragments with overlapping cells, the most recent value of each
+  // cell is expected
+  std::srand(11);
+  std::map<std::pair<int32_t, int32_t>, int32_t> expected_cells;
+  for (int32_t f = 0; f < 8; ++f) {
+    std::set<std::pair<int32_t, int32_t>> cells;
+    while (cells.size() < 200)
+      cells.emplace(std::rand() % 40 + 1, std::rand() % 40 + 1);
+
+    std::vector<int32_t> d1, d2, a;
+    for (const auto& c : cells) {
+      d1.push_back(c.first);
+      d2.push_back(c.second);
+      a.push_back(f * 10000 + c.first * 100 + c.second);
+      expected_cells[c] = a.back();
+    }
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_buffer("d1", d1)
+        .set_buffer("d2", d2)
+        .set_buffer("a", a);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+  }
+
+  for (auto layout : {TILEDB_ROW_MAJOR,
+                      TILEDB_COL_MAJOR,
+                      TILEDB_GLOBAL_ORDER,
+                      TILEDB_UNORDERED}) {
+    Array array(ctx, array_name, TILEDB_READ);
+    Query query(ctx, array);
+    std::vector<int32_t> d1(2000), d2(2000), a(2000);
+    query.set_layout(layout)
+        .set_buffer("d1", d1)
+        .set_buffer("d2", d2)
+        .set_buffer("a", a);
+    query.add_range<int32_t>(0, 3, 30);
+    if (layout != TILEDB_GLOBAL_ORDER) {
+      query.add_range<int32_t>(0, 35, 38)
+          .add_range<int32_t>(1, 1, 10)
+          .add_range<int32_t>(1, 17, 40);
+    } else {
+      query.add_range<int32_t>(1, 1, 40);
+    }
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    auto result_num = query.result_buffer_elements()["a"].second;
+
+    // Check the results against the expected cells in the subarray
+    auto in_subarray = [&](int32_t c1, int32_t c2) {
+      if (layout == TILEDB_GLOBAL_ORDER)
+        return c1 >= 3 && c1 <= 30;
+      return ((c1 >= 3 && c1 <= 30) || (c1 >= 35 && c1 <= 38)) &&
+             ((c2 >= 1 && c2 <= 10) || (c2 >= 17 && c2 <= 40));
+    };
+    uint64_t expected_num = 0;
+    for (const auto& c : expected_cells)
+      expected_num += in_subarray(c.first.first, c.first.second) ? 1 : 0;
+    CHECK(result_num == expected_num);
+
+    std::vector<std::pair<int32_t, int32_t>> coords;
+    for (uint64_t i = 0; i < result_num; ++i) {
+      auto c = std::make_pair(d1[i], d2[i]);
+      CHECK(in_subarray(c.first, c.second));
+      CHECK(a[i] == expected_cells[c]);
+      coords.push_back(c);
+    }
+
+    // Check the order
+    if (layout == TILEDB_ROW_MAJOR) {
+      CHECK(std::is_sorted(coords.begin(), coords.end()));
+    } else if (layout == TILEDB_COL_MAJOR) {
+      CHECK(std::is_sorted(
+          coords.begin(),
+          coords.end(),
+          [](const std::pair<int32_t, int32_t>& x,
+             const std::pair<int32_t, int32_t>& y) {
+            return std::make_pair(x.second, x.first) <
+                   std::make_pair(y.second, y.first);
+          }));
+    } else if (layout == TILEDB_GLOBAL_ORDER) {
+      CHECK(std::is_sorted(
+          coords.begin(),
+          coords.end(),
+          [](const std::pair<int32_t, int32_t>& x,
+             const std::pair<int32_t, int32_t>& y) {
+            auto tx = std::make_pair((x.first - 1) / 8, (x.second - 1) / 8);
+            auto ty = std::make_pair((y.first - 1) / 8, (y.second - 1) / 8);
+            if (tx != ty)
+              return tx < ty;
+            return std::make_pair(x.second, x.first) <
+                   std::make_pair(y.second, y.first);
+          }));
+    }
+    array.close();
+  }
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test streaming unordered sparse reads",
+    "[cppapi][query][unordered]") {
+  const std::string array_name = "cpp_unit_array_unordered";
+  Config config;
+  config["sm.sparse_unordered_tile_window"] = "3";
+  Context ctx(config);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create the array
+  bool allows_dups = GENERATE(true, false);
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 1000}}, 10));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(4).set_allows_dups(allows_dups);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "s"));
+  Array::create(array_name, schema);
+
+  // Write two fragments. They overlap only if duplicates are allowed.
+  std::multiset<std::tuple<int32_t, int32_t, std::string>> expected;
+  for (int32_t f = 0; f < 2; ++f) {
+    std::vector<int32_t> d, a;
+    std::vector<uint64_t> s_offsets;
+    std::string s;
+    for (int32_t i = 1; i <= 100; ++i) {
+      d.push_back(allows_dups ? i : f * 100 + i);
+      a.push_back(f * 1000 + i);
+      s_offsets.push_back(s.size());
+      s += std::string(i % 7 + 1, 'a' + f);
+      expected.emplace(d.back(), a.back(), std::string(i % 7 + 1, 'a' + f));
+    }
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_buffer("d", d)
+        .set_buffer("a", a)
+        .set_buffer("s", s_offsets, s);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+  }
+
+  // Read with buffers large enough for all the results, or incompletely
+  // with buffers too small for a partition
+  uint64_t buffer_cells = GENERATE(1000, 30);
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array);
+  std::vector<int32_t> d(buffer_cells), a(buffer_cells);
+  std::vector<uint64_t> s_offsets(buffer_cells);
+  std::string s(buffer_cells * 8, '\0');
+  query.set_layout(TILEDB_UNORDERED)
+      .set_buffer("d", d)
+      .set_buffer("a", a)
+      .set_buffer("s", s_offsets, s);
+  query.add_range<int32_t>(0, 1, 1000);
+
+  std::multiset<std::tuple<int32_t, int32_t, std::string>> results;
+  Query::Status status;
+  do {
+    status = query.submit();
+    auto result_elements = query.result_buffer_elements();
+    auto result_num = result_elements["a"].second;
+    auto s_size = result_elements["s"].second;
+    for (uint64_t i = 0; i < result_num; ++i) {
+      auto end = (i + 1 < result_num) ? s_offsets[i + 1] : s_size;
+      results.emplace(d[i], a[i], s.substr(s_offsets[i], end - s_offsets[i]));
+    }
+  } while (status == Query::Status::INCOMPLETE);
+  CHECK(status == Query::Status::COMPLETE);
+  CHECK(results == expected);
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test streaming unordered sparse reads resuming after overflow",
+    "[cppapi][query][unordered]") {
+  const std::string array_name = "cpp_unit_array_unordered_resume";
+  const std::string tile_window = GENERATE("1", "3");
+  Config config;
+  config["sm.sparse_unordered_tile_window"] = tile_window;
+  Context ctx(config);
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create the array
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 1000}}, 40));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(4);
+  schema.add_attribute(Attribute::create<std::string>(ctx, "s"));
+  Array::create(array_name, schema);
+
+  // Each tile stores cells 1, 2, 3 and 40 of its space tile, with long
+  // strings in the odd tiles. The ranges cover the first three cells of
+  // every tile, so the result sizes are estimated at a tenth of the actual
+  // ones, and the results of an odd tile take 1200 bytes.
+  std::vector<int32_t> d;
+  std::vector<uint64_t> s_offsets;
+  std::string s;
+  std::multiset<std::pair<int32_t, std::string>> expected;
+  for (int32_t t = 0; t < 25; ++t) {
+    for (int32_t c : {1, 2, 3, 40}) {
+      d.push_back(t * 40 + c);
+      s_offsets.push_back(s.size());
+      auto value = std::string((t % 2) ? 400 : 10, 'a' + c % 26);
+      s += value;
+      if (c != 40)
+        expected.emplace(d.back(), value);
+    }
+  }
+  Array array_w(ctx, array_name, TILEDB_WRITE);
+  Query query_w(ctx, array_w);
+  query_w.set_layout(TILEDB_UNORDERED)
+      .set_buffer("d", d)
+      .set_buffer("s", s_offsets, s);
+  REQUIRE(query_w.submit() == Query::Status::COMPLETE);
+  array_w.close();
+
+  // Read with var-sized buffers that fit the results of an odd tile, or
+  // not, in which case the tile is returned in parts
+  const uint64_t s_buffer_size = GENERATE(1300, 1000);
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array);
+  d.assign(1000, 0);
+  s_offsets.assign(1000, 0);
+  s.assign(s_buffer_size, '\0');
+  query.set_layout(TILEDB_UNORDERED)
+      .set_buffer("d", d)
+      .set_buffer("s", s_offsets, s);
+  for (int32_t t = 0; t < 25; ++t)
+    query.add_range<int32_t>(0, t * 40 + 1, t * 40 + 4);
+
+  Stats::enable();
+  Stats::reset();
+  std::multiset<std::pair<int32_t, std::string>> results;
+  Query::Status status;
+  do {
+    status = query.submit();
+    auto result_elements = query.result_buffer_elements();
+    auto result_num = result_elements["d"].second;
+    auto s_size = result_elements["s"].second;
+    CHECK(result_num > 0);
+    for (uint64_t i = 0; i < result_num; ++i) {
+      auto end = (i + 1 < result_num) ? s_offsets[i + 1] : s_size;
+      results.emplace(d[i], s.substr(s_offsets[i], end - s_offsets[i]));
+    }
+  } while (status == Query::Status::INCOMPLETE);
+  std::string stats;
+  Stats::raw_dump(&stats);
+  Stats::disable();
+  CHECK(status == Query::Status::COMPLETE);
+  CHECK(results == expected);
+  array.close();
+
+  // If every single-tile window fits the buffers, no partition is split,
+  // since the read resumes from the window that overflowed
+  auto counter = [&stats](const std::string& name) {
+    auto pos = stats.find("\"" + name + "\": ");
+    REQUIRE(pos != std::string::npos);
+    return std::stoull(stats.substr(pos + name.size() + 4));
+  };
+  if (tile_window == "1" && s_buffer_size == 1300)
+    CHECK(counter("READ_LOOP_NUM") == counter("READ_NUM"));
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test sparse reads in tile batches with a small memory budget",
+    "[cppapi][query][memory-budget]") {
+  const std::string array_name = "cpp_unit_array_memory_budget";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create the array
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d", {{1, 1000}}, 50));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_capacity(4);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  auto s_attr = Attribute::create<std::string>(ctx, "s");
+  auto compressor = GENERATE(TILEDB_FILTER_NONE, TILEDB_FILTER_ZSTD);
+  FilterList filters(ctx);
+  filters.add_filter({ctx, compressor});
+  s_attr.set_filter_list(filters);
+  schema.add_attribute(s_attr);
+  Array::create(array_name, schema);
+
+  // Write two overlapping fragments, the second one on even cells
+  std::map<int32_t, std::pair<int32_t, std::string>> expected;
+  for (int32_t f = 0; f < 2; ++f) {
+    std::vector<int32_t> d, a;
+    std::vector<uint64_t> s_offsets;
+    std::string s;
+    for (int32_t i = 1 + f; i <= 100; i += 1 + f) {
+      d.push_back(i);
+      a.push_back(f * 1000 + i);
+      s_offsets.push_back(s.size());
+      s += std::string(i % 5 + 1, 'a' + f);
+      expected[i] = std::make_pair(a.back(), std::string(i % 5 + 1, 'a' + f));
+    }
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_buffer("d", d)
+        .set_buffer("a", a)
+        .set_buffer("s", s_offsets, s);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+  }
+
+  // Read with a memory budget of a few tiles
+  Config config;
+  config["sm.memory_budget"] = "256";
+  config["sm.memory_budget_var"] = "256";
+  Context ctx_budget(config);
+  auto layout = GENERATE(TILEDB_ROW_MAJOR, TILEDB_GLOBAL_ORDER);
+  Array array(ctx_budget, array_name, TILEDB_READ);
+  Query query(ctx_budget, array);
+  std::vector<int32_t> d(200), a(200);
+  std::vector<uint64_t> s_offsets(200);
+  std::string s(1000, '\0');
+  query.set_layout(layout)
+      .set_buffer("d", d)
+      .set_buffer("a", a)
+      .set_buffer("s", s_offsets, s);
+  query.add_range<int32_t>(0, 1, 1000);
+
+  std::vector<int32_t> result_d;
+  Query::Status status;
+  do {
+    status = query.submit();
+    auto result_elements = query.result_buffer_elements();
+    auto result_num = result_elements["a"].second;
+    auto s_size = result_elements["s"].second;
+    for (uint64_t i = 0; i < result_num; ++i) {
+      auto end = (i + 1 < result_num) ? s_offsets[i + 1] : s_size;
+      CHECK(a[i] == expected[d[i]].first);
+      CHECK(
+          s.substr(s_offsets[i], end - s_offsets[i]) == expected[d[i]].second);
+      result_d.push_back(d[i]);
+    }
+  } while (status == Query::Status::INCOMPLETE);
+  CHECK(status == Query::Status::COMPLETE);
+  CHECK(result_d.size() == expected.size());
+  CHECK(std::is_sorted(result_d.begin(), result_d.end()));
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test sparse reads with string dimension ranges",
+    "[cppapi][query][string-dims]") {
+  const std::string array_name = "cpp_unit_array_string_ranges";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create the array, with small tiles so that most of them only
+  // partially overlap the query ranges
+  Domain domain(ctx);
+  domain.add_dimension(
+      Dimension::create(ctx, "key", TILEDB_STRING_ASCII, nullptr, nullptr));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain);
+  schema.set_capacity(4);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Write two fragments of keys sharing long prefixes with the range
+  // bounds, the second one overwriting some keys of the first
+  const std::vector<std::string> prefixes = {
+      "ab", "us", "use", "user", "user_", "userb", "v"};
+  std::srand(7);
+  std::map<std::string, int32_t> expected_cells;
+  for (int32_t f = 0; f < 2; ++f) {
+    std::map<std::string, int32_t> cells;
+    for (int32_t i = 0; i < 150; ++i) {
+      auto key = prefixes[std::rand() % prefixes.size()];
+      auto suffix_size = std::rand() % 4;
+      for (int32_t c = 0; c < suffix_size; ++c)
+        key += "ab_"[std::rand() % 3];
+      cells[key] = f * 1000 + i;
+    }
+
+    std::vector<uint64_t> key_offsets;
+    std::string keys;
+    std::vector<int32_t> a;
+    for (const auto& c : cells) {
+      key_offsets.push_back(keys.size());
+      keys += c.first;
+      a.push_back(c.second);
+      expected_cells[c.first] = c.second;
+    }
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_buffer("key", key_offsets, keys)
+        .set_buffer("a", a);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+  }
+
+  // Disjoint ranges, bounded by prefixes of each other and of the keys
+  const std::vector<std::pair<std::string, std::string>> ranges = {
+      {"ab", "abb"}, {"us", "user"}, {"user_a", "user_b"}, {"userb", "v"}};
+  auto layout = GENERATE(TILEDB_ROW_MAJOR, TILEDB_UNORDERED);
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array);
+  std::vector<uint64_t> key_offsets(1000);
+  std::string keys(10000, '\0');
+  std::vector<int32_t> a(1000);
+  query.set_layout(layout)
+      .set_buffer("key", key_offsets, keys)
+      .set_buffer("a", a);
+  for (const auto& r : ranges)
+    query.add_range(0, r.first, r.second);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  auto result_elements = query.result_buffer_elements();
+  auto result_num = result_elements["a"].second;
+  auto keys_size = result_elements["key"].second;
+
+  std::map<std::string, int32_t> expected_results;
+  for (const auto& c : expected_cells) {
+    for (const auto& r : ranges) {
+      if (c.first >= r.first && c.first <= r.second)
+        expected_results.insert(c);
+    }
+  }
+  REQUIRE(!expected_results.empty());
+
+  std::map<std::string, int32_t> results;
+  for (uint64_t i = 0; i < result_num; ++i) {
+    auto end = (i + 1 < result_num) ? key_offsets[i + 1] : keys_size;
+    auto key = keys.substr(key_offsets[i], end - key_offsets[i]);
+    CHECK(results.count(key) == 0);
+    results[key] = a[i];
+  }
+  CHECK(results == expected_results);
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test sparse reads with narrow ranges on the leading dimension",
+    "[cppapi][query][sorted-tiles]") {
+  const std::string array_name = "cpp_unit_array_sorted_tiles";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create the array. The data tiles hold cells of one or two space tiles,
+  // so only some of them are sorted on the leading dimension.
+  auto cell_order = GENERATE(TILEDB_ROW_MAJOR, TILEDB_COL_MAJOR);
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int64_t>(ctx, "d1", {{1, 400}}, 100))
+      .add_dimension(Dimension::create<int64_t>(ctx, "d2", {{1, 400}}, 100));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, cell_order}});
+  schema.set_capacity(50);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Write two fragments, the second one overwriting some cells
+  std::srand(3);
+  std::map<std::pair<int64_t, int64_t>, int32_t> expected_cells;
+  for (int32_t f = 0; f < 2; ++f) {
+    std::map<std::pair<int64_t, int64_t>, int32_t> cells;
+    while (cells.size() < 1000)
+      cells[std::make_pair(std::rand() % 400 + 1, std::rand() % 400 + 1)] =
+          f * 10000 + (int32_t)cells.size();
+
+    std::vector<int64_t> d1, d2;
+    std::vector<int32_t> a;
+    for (const auto& c : cells) {
+      d1.push_back(c.first.first);
+      d2.push_back(c.first.second);
+      a.push_back(c.second);
+      expected_cells[c.first] = c.second;
+    }
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_buffer("d1", d1)
+        .set_buffer("d2", d2)
+        .set_buffer("a", a);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+  }
+
+  // Narrow ranges on either dimension, one of them on a row/column with
+  // no cells at all
+  std::vector<std::array<int64_t, 4>> subarrays = {{37, 41, 1, 400},
+                                                   {1, 400, 250, 252},
+                                                   {150, 150, 1, 400},
+                                                   {1, 400, 399, 399},
+                                                   {120, 180, 90, 110}};
+  auto layout = GENERATE(TILEDB_ROW_MAJOR, TILEDB_UNORDERED);
+  Array array(ctx, array_name, TILEDB_READ);
+  for (const auto& sub : subarrays) {
+    Query query(ctx, array);
+    std::vector<int64_t> d1(2000), d2(2000);
+    std::vector<int32_t> a(2000);
+    query.set_layout(layout)
+        .set_buffer("d1", d1)
+        .set_buffer("d2", d2)
+        .set_buffer("a", a);
+    query.add_range<int64_t>(0, sub[0], sub[1])
+        .add_range<int64_t>(1, sub[2], sub[3]);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    auto result_num = query.result_buffer_elements()["a"].second;
+
+    std::map<std::pair<int64_t, int64_t>, int32_t> expected_results;
+    for (const auto& c : expected_cells) {
+      if (c.first.first >= sub[0] && c.first.first <= sub[1] &&
+          c.first.second >= sub[2] && c.first.second <= sub[3])
+        expected_results.insert(c);
+    }
+
+    std::map<std::pair<int64_t, int64_t>, int32_t> results;
+    for (uint64_t i = 0; i < result_num; ++i)
+      results[std::make_pair(d1[i], d2[i])] = a[i];
+    CHECK(result_num == results.size());
+    CHECK(results == expected_results);
+  }
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test unordered sparse reads with fully covered tiles",
+    "[cppapi][query][full-tiles]") {
+  const std::string array_name = "cpp_unit_array_full_tiles";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  // Create an array allowing duplicates, so that unordered reads with
+  // multiple fragments need no deduplication
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d1", {{1, 200}}, 50))
+      .add_dimension(Dimension::create<int32_t>(ctx, "d2", {{1, 200}}, 50));
+  ArraySchema schema(ctx, TILEDB_SPARSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  schema.set_capacity(20);
+  schema.set_allows_dups(true);
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  schema.add_attribute(Attribute::create<std::string>(ctx, "b"));
+  Array::create(array_name, schema);
+
+  // Write two fragments. The attribute values encode the coordinates.
+  std::srand(5);
+  std::vector<std::pair<int32_t, int32_t>> cells;
+  for (int f = 0; f < 2; ++f) {
+    std::vector<int32_t> d1, d2, a;
+    std::string b;
+    std::vector<uint64_t> b_off;
+    for (int i = 0; i < 500; ++i) {
+      d1.push_back(std::rand() % 200 + 1);
+      d2.push_back(std::rand() % 200 + 1);
+      a.push_back(d1.back() * 1000 + d2.back());
+      b_off.push_back(b.size());
+      b += std::to_string(a.back());
+      cells.emplace_back(d1.back(), d2.back());
+    }
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_buffer("d1", d1)
+        .set_buffer("d2", d2)
+        .set_buffer("a", a)
+        .set_buffer("b", b_off, b);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    array.close();
+  }
+
+  // Wide ranges cover most tiles fully, and partially overlap the rest
+  std::vector<std::vector<std::array<int32_t, 2>>> d1_ranges = {
+      {{1, 200}}, {{3, 130}}, {{1, 60}, {90, 199}}};
+  auto with_coords = GENERATE(true, false);
+  Array array(ctx, array_name, TILEDB_READ);
+  for (const auto& ranges : d1_ranges) {
+    Query query(ctx, array);
+    std::vector<int32_t> d1(1000), d2(1000), a(1000);
+    std::vector<uint64_t> b_off(1000);
+    std::string b;
+    b.resize(10000);
+    query.set_layout(TILEDB_UNORDERED)
+        .set_buffer("a", a)
+        .set_buffer("b", b_off, b);
+    if (with_coords)
+      query.set_buffer("d1", d1).set_buffer("d2", d2);
+    for (const auto& r : ranges)
+      query.add_range<int32_t>(0, r[0], r[1]);
+    query.add_range<int32_t>(1, 2, 200);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    auto result_el = query.result_buffer_elements();
+    auto result_num = result_el["a"].second;
+
+    std::vector<int32_t> expected;
+    for (const auto& r : ranges) {
+      for (const auto& c : cells) {
+        if (c.first >= r[0] && c.first <= r[1] && c.second >= 2)
+          expected.push_back(c.first * 1000 + c.second);
+      }
+    }
+    std::sort(expected.begin(), expected.end());
+
+    std::vector<int32_t> results(a.begin(), a.begin() + result_num);
+    std::sort(results.begin(), results.end());
+    CHECK(results == expected);
+
+    REQUIRE(result_el["b"].first == result_num);
+    for (uint64_t i = 0; i < result_num; ++i) {
+      auto end = (i + 1 < result_num) ? b_off[i + 1] : result_el["b"].second;
+      CHECK(b.substr(b_off[i], end - b_off[i]) == std::to_string(a[i]));
+      if (with_coords)
+        CHECK(a[i] == d1[i] * 1000 + d2[i]);
+    }
+  }
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test dense reads with sparse fragments and many dense updates",
+    "[cppapi][query][dense-overwrites]") {
+  const std::string array_name = "cpp_unit_array_dense_overwrites";
+  Context ctx;
+  VFS vfs(ctx);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "d1", {{1, 40}}, 10))
+      .add_dimension(Dimension::create<int32_t>(ctx, "d2", {{1, 40}}, 10));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  schema.add_attribute(Attribute::create<int32_t>(ctx, "a"));
+  Array::create(array_name, schema);
+
+  // Interleave sparse writes with dense writes of random subarrays, some
+  // of them nested in others
+  std::srand(7);
+  std::vector<int32_t> expected(40 * 40, INT32_MIN);
+  for (int32_t f = 0; f < 24; ++f) {
+    Array array(ctx, array_name, TILEDB_WRITE);
+    Query query(ctx, array);
+    if (f % 3 == 0) {
+      std::vector<int32_t> d1, d2, a;
+      std::set<std::pair<int32_t, int32_t>> cells;
+      while (cells.size() < 200)
+        cells.emplace(std::rand() % 40 + 1, std::rand() % 40 + 1);
+      for (const auto& c : cells) {
+        d1.push_back(c.first);
+        d2.push_back(c.second);
+        a.push_back(f * 10000 + (int32_t)a.size());
+        expected[(c.first - 1) * 40 + c.second - 1] = a.back();
+      }
+      query.set_layout(TILEDB_UNORDERED)
+          .set_buffer("d1", d1)
+          .set_buffer("d2", d2)
+          .set_buffer("a", a);
+      REQUIRE(query.submit() == Query::Status::COMPLETE);
+    } else {
+      int32_t r0 = std::rand() % 40 + 1, c0 = std::rand() % 40 + 1;
+      int32_t r1 = std::min(40, r0 + std::rand() % 12);
+      int32_t c1 = std::min(40, c0 + std::rand() % 12);
+      std::vector<int32_t> a;
+      for (int32_t i = r0; i <= r1; ++i) {
+        for (int32_t j = c0; j <= c1; ++j) {
+          a.push_back(f * 10000 + (int32_t)a.size());
+          expected[(i - 1) * 40 + j - 1] = a.back();
+        }
+      }
+      query.set_layout(TILEDB_ROW_MAJOR)
+          .set_subarray<int32_t>({r0, r1, c0, c1})
+          .set_buffer("a", a);
+      REQUIRE(query.submit() == Query::Status::COMPLETE);
+    }
+    array.close();
+  }
+
+  std::vector<std::array<int32_t, 4>> subarrays = {
+      {1, 40, 1, 40}, {5, 27, 13, 38}, {22, 22, 1, 40}};
+  Array array(ctx, array_name, TILEDB_READ);
+  for (const auto& sub : subarrays) {
+    Query query(ctx, array);
+    std::vector<int32_t> a(40 * 40);
+    query.set_layout(TILEDB_ROW_MAJOR)
+        .set_subarray<int32_t>({sub[0], sub[1], sub[2], sub[3]})
+        .set_buffer("a", a);
+    REQUIRE(query.submit() == Query::Status::COMPLETE);
+    auto result_num = query.result_buffer_elements()["a"].second;
+    REQUIRE(
+        result_num == (uint64_t)(sub[1] - sub[0] + 1) * (sub[3] - sub[2] + 1));
+
+    uint64_t pos = 0;
+    for (int32_t i = sub[0]; i <= sub[1]; ++i) {
+      for (int32_t j = sub[2]; j <= sub[3]; ++j)
+        CHECK(a[pos++] == expected[(i - 1) * 40 + j - 1]);
+    }
+  }
+  array.close();
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
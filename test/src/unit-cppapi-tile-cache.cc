@@ -0,0 +1,171 @@
+/**
+ * @file   unit-cppapi-tile-cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the tiers of the tile cache through the C++ API.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/cpp_api/tiledb"
+
+using namespace tiledb;
+
+namespace {
+
+const std::string array_name = "cpp_unit_array_tile_cache";
+
+void create_array(const Context& ctx) {
+  Domain domain(ctx);
+  domain.add_dimension(Dimension::create<int32_t>(ctx, "r", {{1, 40}}, 10))
+      .add_dimension(Dimension::create<int32_t>(ctx, "c", {{1, 40}}, 10));
+  ArraySchema schema(ctx, TILEDB_DENSE);
+  schema.set_domain(domain).set_order({{TILEDB_ROW_MAJOR, TILEDB_ROW_MAJOR}});
+  FilterList filters(ctx);
+  filters.add_filter({ctx, TILEDB_FILTER_ZSTD});
+  auto a = Attribute::create<int32_t>(ctx, "a");
+  a.set_filter_list(filters);
+  auto s = Attribute::create<std::string>(ctx, "s");
+  s.set_filter_list(filters);
+  schema.add_attribute(a).add_attribute(s);
+  Array::create(array_name, schema);
+}
+
+/** Returns the value of `a` at `(r, c)`. */
+int32_t a_value(int32_t r, int32_t c) {
+  return 100 * r + c;
+}
+
+/** Returns the value of `s` at `(r, c)`. */
+std::string s_value(int32_t r, int32_t c) {
+  return "s" + std::to_string(a_value(r, c));
+}
+
+void write_array(const Context& ctx) {
+  std::vector<int32_t> a;
+  std::vector<uint64_t> s_off;
+  std::string s;
+  for (int32_t r = 1; r <= 40; ++r) {
+    for (int32_t c = 1; c <= 40; ++c) {
+      a.push_back(a_value(r, c));
+      s_off.push_back(s.size());
+      s += s_value(r, c);
+    }
+  }
+
+  Array array(ctx, array_name, TILEDB_WRITE);
+  Query query(ctx, array, TILEDB_WRITE);
+  query.set_layout(TILEDB_ROW_MAJOR)
+      .set_buffer("a", a)
+      .set_buffer("s", s_off, s);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  array.close();
+}
+
+/** Reads `[r0, r1] x [c0, c1]` and checks the values. */
+void read_and_check(
+    const Context& ctx, int32_t r0, int32_t r1, int32_t c0, int32_t c1) {
+  auto cell_num = (uint64_t)(r1 - r0 + 1) * (c1 - c0 + 1);
+  std::vector<int32_t> a(cell_num);
+  std::vector<uint64_t> s_off(cell_num);
+  std::string s(cell_num * 16, ' ');
+
+  Array array(ctx, array_name, TILEDB_READ);
+  Query query(ctx, array, TILEDB_READ);
+  query.set_layout(TILEDB_ROW_MAJOR)
+      .set_subarray<int32_t>({r0, r1, c0, c1})
+      .set_buffer("a", a)
+      .set_buffer("s", s_off, s);
+  REQUIRE(query.submit() == Query::Status::COMPLETE);
+  auto s_size = query.result_buffer_elements()["s"].second;
+  array.close();
+
+  uint64_t i = 0;
+  for (int32_t r = r0; r <= r1; ++r) {
+    for (int32_t c = c0; c <= c1; ++c, ++i) {
+      CHECK(a[i] == a_value(r, c));
+      auto end = (i + 1 < cell_num) ? s_off[i + 1] : s_size;
+      CHECK(s.substr(s_off[i], end - s_off[i]) == s_value(r, c));
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE(
+    "C++ API: Test the unfiltered tile cache tier",
+    "[cppapi][tile-cache]") {
+  Context ctx;
+  VFS vfs(ctx);
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+
+  create_array(ctx);
+  write_array(ctx);
+
+  std::string policy = GENERATE(
+      std::string("filtered"), std::string("unfiltered"), std::string("both"));
+  std::string unfiltered_size = GENERATE(
+      std::string("0"), std::string("1000"), std::string("100000000"));
+  Config config;
+  config["sm.tile_cache_policy"] = policy;
+  config["sm.tile_cache_unfiltered_size"] = unfiltered_size;
+  Context cache_ctx(config);
+
+  // Reads of partial tiles unfilter them selectively, and reads that
+  // hit the unfiltered tier skip unfiltering
+  Stats::enable();
+  for (int i = 0; i < 2; ++i) {
+    Stats::reset();
+    read_and_check(cache_ctx, 3, 17, 5, 25);
+    read_and_check(cache_ctx, 1, 40, 1, 40);
+    read_and_check(cache_ctx, 12, 12, 1, 40);
+  }
+  std::string stats;
+  Stats::dump(&stats);
+  Stats::disable();
+
+  // The second round of reads hits the unfiltered tier if it is enabled
+  auto unfiltered_hits = stats.find("from the unfiltered tile cache") !=
+                         std::string::npos;
+  if (policy == "filtered" || unfiltered_size == "0")
+    CHECK(!unfiltered_hits);
+  else if (unfiltered_size == "100000000")
+    CHECK(unfiltered_hits);
+
+  if (vfs.is_dir(array_name))
+    vfs.remove_dir(array_name);
+}
+
+TEST_CASE(
+    "C++ API: Test the unfiltered tile cache tier, errors",
+    "[cppapi][tile-cache]") {
+  Config config;
+  config["sm.tile_cache_policy"] = "none";
+  CHECK_THROWS(Context(config));
+  CHECK_THROWS(config["sm.tile_cache_unfiltered_size"] = "-1");
+}
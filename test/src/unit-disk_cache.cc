@@ -0,0 +1,265 @@
+/**
+ * @file unit-disk_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file unit-tests class DiskCache.
+ */
+
+#include "catch.hpp"
+#include "tiledb/common/thread_pool.h"
+#include "tiledb/sm/cache/disk_cache.h"
+#include "tiledb/sm/config/config.h"
+#include "tiledb/sm/filesystem/vfs.h"
+
+#include <algorithm>
+
+using namespace tiledb::common;
+using namespace tiledb::sm;
+
+struct DiskCacheFx {
+  const URI cache_dir_ = URI("disk_cache_test_dir");
+  const URI object_ = URI("disk_cache_test_object");
+  ThreadPool compute_tp_;
+  ThreadPool io_tp_;
+  VFS vfs_;
+  std::vector<char> data_;
+
+  DiskCacheFx() {
+    REQUIRE(compute_tp_.init(2).ok());
+    REQUIRE(io_tp_.init(2).ok());
+    Config config;
+    REQUIRE(vfs_.init(&compute_tp_, &io_tp_, &config, nullptr).ok());
+    remove_all();
+
+    // The cached object
+    for (int i = 0; i < 1000; ++i)
+      data_.push_back((char)(i % 127));
+    REQUIRE(vfs_.write(object_, data_.data(), data_.size()).ok());
+    REQUIRE(vfs_.close_file(object_).ok());
+  }
+
+  ~DiskCacheFx() {
+    remove_all();
+  }
+
+  void remove_all() {
+    bool is_dir = false;
+    REQUIRE(vfs_.is_dir(cache_dir_, &is_dir).ok());
+    if (is_dir)
+      REQUIRE(vfs_.remove_dir(cache_dir_).ok());
+    bool is_file = false;
+    REQUIRE(vfs_.is_file(object_, &is_file).ok());
+    if (is_file)
+      REQUIRE(vfs_.remove_file(object_).ok());
+  }
+
+  /** Returns `true` if `[offset, offset + nbytes)` is read from the cache. */
+  bool read(DiskCache* cache, uint64_t offset, uint64_t nbytes) {
+    std::vector<char> buffer(nbytes);
+    bool success = false;
+    REQUIRE(cache->read(object_, offset, buffer.data(), nbytes, &success).ok());
+    if (success)
+      CHECK(std::equal(buffer.begin(), buffer.end(), &data_[offset]));
+    return success;
+  }
+
+  void insert(DiskCache* cache, uint64_t offset, uint64_t nbytes) {
+    REQUIRE(cache->insert(object_, offset, &data_[offset], nbytes).ok());
+  }
+
+  /** Returns the number of files in the cache directory. */
+  size_t file_num() {
+    std::vector<URI> uris;
+    REQUIRE(vfs_.ls(cache_dir_, &uris).ok());
+    return uris.size();
+  }
+};
+
+TEST_CASE_METHOD(DiskCacheFx, "Unit-test class DiskCache", "[disk_cache]") {
+  DiskCache cache(&vfs_, cache_dir_, 10000);
+  REQUIRE(cache.init().ok());
+  CHECK(cache.size() == 0);
+
+  // Only the inserted ranges are cached
+  CHECK(!read(&cache, 0, 100));
+  insert(&cache, 0, 100);
+  insert(&cache, 100, 200);
+  CHECK(read(&cache, 0, 100));
+  CHECK(read(&cache, 100, 200));
+  CHECK(!read(&cache, 0, 50));
+  CHECK(!read(&cache, 100, 100));
+  CHECK(file_num() == 2);
+  auto size = cache.size();
+  CHECK(size > 300);
+
+  // Inserting a cached range again is a no-op
+  insert(&cache, 0, 100);
+  CHECK(cache.size() == size);
+
+  // The ranges of an object are dropped with the object or its prefix
+  cache.remove_prefix(URI(object_.to_string() + "_other"));
+  cache.remove_prefix(URI("disk_cache_test"));
+  CHECK(read(&cache, 0, 100));
+  cache.remove_prefix(object_);
+  CHECK(!read(&cache, 0, 100));
+  CHECK(!read(&cache, 100, 200));
+  CHECK(cache.size() == 0);
+  CHECK(file_num() == 0);
+  insert(&cache, 0, 100);
+  cache.remove_prefix(object_.parent());
+  CHECK(!read(&cache, 0, 100));
+}
+
+TEST_CASE_METHOD(
+    DiskCacheFx, "Unit-test class DiskCache, collisions", "[disk_cache]") {
+  {
+    DiskCache cache(&vfs_, cache_dir_, 10000);
+    REQUIRE(cache.init().ok());
+    insert(&cache, 0, 100);
+    insert(&cache, 100, 200);
+  }
+
+  // Give the entry of the second range the key hash of the first one
+  std::vector<URI> uris;
+  REQUIRE(vfs_.ls(cache_dir_, &uris).ok());
+  REQUIRE(uris.size() == 2);
+  std::sort(uris.begin(), uris.end(), [](const URI& a, const URI& b) {
+    return a.last_path_part().substr(17) < b.last_path_part().substr(17);
+  });
+  auto name = uris[0].last_path_part().substr(0, 17) +
+              uris[1].last_path_part().substr(17);
+  REQUIRE(vfs_.move_file(uris[1], cache_dir_.join_path(name)).ok());
+
+  // The colliding entry does not serve the first range and is replaced
+  // by it
+  DiskCache cache(&vfs_, cache_dir_, 10000);
+  REQUIRE(cache.init().ok());
+  CHECK(file_num() == 1);
+  CHECK(!read(&cache, 0, 100));
+  CHECK(file_num() == 0);
+  insert(&cache, 0, 100);
+  CHECK(read(&cache, 0, 100));
+  CHECK(!read(&cache, 100, 200));
+}
+
+TEST_CASE("Unit-test class DiskCache, cacheable objects", "[disk_cache]") {
+  const std::string uuid = "0123456789abcdef0123456789abcdef";
+  const std::string array = "s3://bucket/array/";
+  const std::string frag = array + "__1_2_" + uuid;
+  CHECK(DiskCache::cacheable(URI(frag + "_5/a.tdb")));
+  CHECK(DiskCache::cacheable(URI(frag + "_5/__fragment_metadata.tdb")));
+  CHECK(DiskCache::cacheable(URI(frag + "/a.tdb")));
+  CHECK(!DiskCache::cacheable(URI(frag + "/__fragment_metadata.tdb")));
+  CHECK(DiskCache::cacheable(URI(array + "__" + uuid + "_1/a.tdb")));
+  CHECK(DiskCache::cacheable(URI(frag + ".meta")));
+  CHECK(DiskCache::cacheable(URI(array + "__meta/__1_2_" + uuid)));
+  CHECK(!DiskCache::cacheable(URI(array + "__array_schema.tdb")));
+  CHECK(!DiskCache::cacheable(URI(array + "__lock.tdb")));
+  CHECK(!DiskCache::cacheable(URI(array + "__1_2_0123/a.tdb")));
+}
+
+TEST_CASE_METHOD(
+    DiskCacheFx, "Unit-test class DiskCache, eviction", "[disk_cache]") {
+  DiskCache cache(&vfs_, cache_dir_, 1000);
+  REQUIRE(cache.init().ok());
+
+  // Ranges larger than the cache are not stored
+  insert(&cache, 0, 1000);
+  CHECK(cache.size() == 0);
+
+  // Each entry takes a bit more than 300 bytes, so only two fit and the
+  // least recently used one is evicted
+  insert(&cache, 0, 300);
+  insert(&cache, 300, 300);
+  insert(&cache, 600, 300);
+  CHECK(file_num() == 2);
+  CHECK(!read(&cache, 0, 300));
+  CHECK(read(&cache, 300, 300));
+  insert(&cache, 0, 300);
+  CHECK(read(&cache, 300, 300));
+  CHECK(!read(&cache, 600, 300));
+  CHECK(read(&cache, 0, 300));
+  CHECK(cache.size() <= 1000);
+}
+
+TEST_CASE_METHOD(
+    DiskCacheFx, "Unit-test class DiskCache, persistence", "[disk_cache]") {
+  uint64_t size = 0;
+  {
+    DiskCache cache(&vfs_, cache_dir_, 10000);
+    REQUIRE(cache.init().ok());
+    for (uint64_t i = 0; i < 10; ++i)
+      insert(&cache, i * 100, 100);
+    size = cache.size();
+  }
+
+  // Leftovers of interrupted insertions and unknown files are ignored
+  char c = 0;
+  auto tmp = cache_dir_.join_path("0123456789abcdef_0000000000000000_x.tmp");
+  REQUIRE(vfs_.write(tmp, &c, 1).ok());
+  REQUIRE(vfs_.close_file(tmp).ok());
+  auto other = cache_dir_.join_path("other");
+  REQUIRE(vfs_.write(other, &c, 1).ok());
+  REQUIRE(vfs_.close_file(other).ok());
+
+  // A new cache adopts the entries
+  DiskCache cache(&vfs_, cache_dir_, 10000);
+  REQUIRE(cache.init().ok());
+  CHECK(cache.size() == size);
+  CHECK(file_num() == 11);
+  for (uint64_t i = 0; i < 10; ++i)
+    CHECK(read(&cache, i * 100, 100));
+
+  // A smaller cache evicts the oldest entries on initialization
+  DiskCache small_cache(&vfs_, cache_dir_, size / 2);
+  REQUIRE(small_cache.init().ok());
+  CHECK(small_cache.size() <= size / 2);
+  CHECK(!read(&small_cache, 0, 100));
+  CHECK(read(&small_cache, 900, 100));
+
+  // The cache directory must be local
+  DiskCache remote_cache(&vfs_, URI("s3://bucket/cache"), 10000);
+  CHECK(!remote_cache.init().ok());
+}
+
+TEST_CASE_METHOD(
+    DiskCacheFx, "Unit-test class DiskCache, VFS", "[disk_cache]") {
+  Config config;
+  REQUIRE(config.set("vfs.disk_cache_dir", cache_dir_.to_string()).ok());
+  VFS vfs;
+  REQUIRE(vfs.init(&compute_tp_, &io_tp_, &config, nullptr).ok());
+  bool is_dir = false;
+  REQUIRE(vfs_.is_dir(cache_dir_, &is_dir).ok());
+  CHECK(is_dir);
+
+  // Local reads bypass the cache
+  std::vector<char> buffer(100);
+  REQUIRE(vfs.read(object_, 0, buffer.data(), 100).ok());
+  CHECK(std::equal(buffer.begin(), buffer.end(), data_.begin()));
+  CHECK(file_num() == 0);
+}
@@ -226,6 +226,36 @@ TEST_CASE_METHOD(
   CHECK(it == it_end);
 }
 
+TEST_CASE_METHOD(
+    BufferLRUCacheFx, "BufferLRUCache whole item reads", "[lru_cache]") {
+  Buffer v1;
+  Buffer v2;
+  CHECK(v1.write("abc", 3).ok());
+  CHECK(v2.write("de", 2).ok());
+  Buffer v1_cp(v1);
+  Status st = lru_cache_->insert("v1", std::move(v1_cp));
+  CHECK(st.ok());
+  Buffer v2_cp(v2);
+  st = lru_cache_->insert("v2", std::move(v2_cp));
+  CHECK(st.ok());
+  CHECK(check_key_order("v1v2"));
+
+  // Read non-existent item
+  Buffer v_buf;
+  bool success;
+  st = lru_cache_->read("v", &v_buf, &success);
+  CHECK(st.ok());
+  CHECK(!success);
+
+  // Read v1, which becomes the most recently used item
+  st = lru_cache_->read("v1", &v_buf, &success);
+  CHECK(st.ok());
+  CHECK(success);
+  CHECK(v_buf.size() == 3);
+  CHECK(!memcmp(v_buf.data(), "abc", 3));
+  CHECK(check_key_order("v2v1"));
+}
+
 TEST_CASE("BufferLRUCache of 0 capacity", "[lru_cache]") {
   // Create 0 size cache
   BufferLRUCache* lru_cache = new BufferLRUCache(CACHE_ZERO_SIZE);
@@ -0,0 +1,155 @@
+/**
+ * @file   unit-range-filter.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * Tests the range filter kernels used to check sparse coordinates.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/misc/range_filter.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace tiledb::sm;
+
+/**
+ * Checks the kernels against a plain loop on random coordinates around
+ * `[lo, hi]`, for every length up to a few words and for sub-ranges that
+ * start and end within a word, so that both the full-word loop and the
+ * partial words are exercised.
+ */
+template <class T>
+void check_in_range(T lo, T hi, const std::vector<T>& candidates) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<size_t> pick(0, candidates.size() - 1);
+  std::uniform_int_distribution<int> bit(0, 1);
+
+  for (uint64_t num = 0; num <= 200; ++num) {
+    std::vector<T> coords(num);
+    Bitmap bitmap(num, false);
+    for (uint64_t i = 0; i < num; ++i) {
+      coords[i] = candidates[pick(gen)];
+      if (bit(gen))
+        bitmap.set(i);
+    }
+
+    for (uint64_t start : {(uint64_t)0, num / 3}) {
+      for (uint64_t end : {num, num - num / 4}) {
+        Bitmap result = bitmap, scalar = bitmap;
+        range_filter::in_range(coords.data(), start, end, lo, hi, &result);
+        range_filter::in_range_scalar(
+            coords.data(), start, end, lo, hi, &scalar);
+        for (uint64_t i = 0; i < num; ++i) {
+          bool in = i < start || i >= end ||
+                    (coords[i] >= lo && coords[i] <= hi);
+          CHECK(result.get(i) == (bitmap.get(i) && in));
+          CHECK(scalar.get(i) == result.get(i));
+        }
+      }
+    }
+  }
+}
+
+template <class T>
+void check_in_range_integral() {
+  const T min = std::numeric_limits<T>::min();
+  const T max = std::numeric_limits<T>::max();
+  const T lo = (T)(min / 2 + 3);
+  const T hi = (T)(max / 2 - 3);
+  check_in_range<T>(
+      lo,
+      hi,
+      {min,
+       (T)(min + 1),
+       (T)(lo - 1),
+       lo,
+       (T)(lo + 1),
+       (T)0,
+       (T)1,
+       (T)(hi - 1),
+       hi,
+       (T)(hi + 1),
+       (T)(max - 1),
+       max});
+  check_in_range<T>(min, max, {min, (T)0, max});
+  check_in_range<T>(max, max, {min, (T)(max - 1), max});
+}
+
+template <class T>
+void check_in_range_real() {
+  const T inf = std::numeric_limits<T>::infinity();
+  const T nan = std::numeric_limits<T>::quiet_NaN();
+  const T lo = (T)-1.5;
+  const T hi = (T)2.25;
+  check_in_range<T>(
+      lo,
+      hi,
+      {-inf,
+       std::nextafter(lo, -inf),
+       lo,
+       std::nextafter(lo, inf),
+       (T)-0.0,
+       (T)0.0,
+       std::nextafter(hi, -inf),
+       hi,
+       std::nextafter(hi, inf),
+       inf,
+       nan});
+  check_in_range<T>(-inf, inf, {-inf, (T)0, inf, nan});
+}
+
+TEST_CASE("Range filter: Test integral types", "[range-filter]") {
+  check_in_range_integral<int8_t>();
+  check_in_range_integral<uint8_t>();
+  check_in_range_integral<int16_t>();
+  check_in_range_integral<uint16_t>();
+  check_in_range_integral<int32_t>();
+  check_in_range_integral<uint32_t>();
+  check_in_range_integral<int64_t>();
+  check_in_range_integral<uint64_t>();
+}
+
+TEST_CASE("Range filter: Test floating point types", "[range-filter]") {
+  check_in_range_real<float>();
+  check_in_range_real<double>();
+}
+
+TEST_CASE("Range filter: Test against explicit results", "[range-filter]") {
+  std::vector<uint32_t> coords = {0, 5, 10, 4294967295u, 7, 6, 11, 9, 10};
+  Bitmap bitmap(coords.size(), true);
+  bitmap.clear(5);
+  range_filter::in_range<uint32_t>(
+      coords.data(), 0, coords.size(), 5, 10, &bitmap);
+  std::vector<bool> expected = {0, 1, 1, 0, 1, 0, 0, 1, 1};
+  for (uint64_t i = 0; i < coords.size(); ++i)
+    CHECK(bitmap.get(i) == expected[i]);
+  CHECK(bitmap.count() == 5);
+}
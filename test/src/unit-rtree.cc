@@ -31,11 +31,15 @@
  */
 
 #include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/enums/datatype.h"
 #include "tiledb/sm/enums/layout.h"
+#include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/rtree/rtree.h"
 
 #include <catch.hpp>
+#include <cstring>
 #include <iostream>
 
 using namespace tiledb::sm;
@@ -477,6 +481,81 @@ TEST_CASE("RTree: Test 2D R-tree, height 3", "[rtree][2d][3h]") {
   CHECK(overlap.tiles_[0].second == 2.0 / 3);
 }
 
+TEST_CASE("RTree: Test 2D R-tree, multiple ranges", "[rtree][2d][ranges]") {
+  // Build tree
+  int32_t dim_dom[] = {1, 1000};
+  int32_t dim_extent = 10;
+  Domain dom2 = create_domain(
+      {"d1", "d2"},
+      {Datatype::INT32, Datatype::INT32},
+      {dim_dom, dim_dom},
+      {&dim_extent, &dim_extent});
+  std::vector<NDRange> mbrs = create_mbrs<int32_t, 2>(
+      {1,  3,  2,  4,  5,  7,  6,  9,  10, 12, 10, 15, 11, 15, 20, 22, 16, 16,
+       23, 23, 19, 20, 24, 26, 25, 28, 30, 32, 30, 35, 35, 37, 40, 42, 40, 42});
+  RTree rtree(&dom2, 3);
+  rtree.set_leaves(mbrs);
+  rtree.build_tree();
+  CHECK(rtree.height() == 3);
+
+  // The overlap of every range must match that of a single-range query
+  std::vector<NDRange> ranges = create_mbrs<int32_t, 2>(
+      {0,  0,  0,  0,  1,  50, 1,  50, 10, 14, 12, 21, 11, 42, 20, 42,
+       19, 50, 25, 50, 2,  6,  3,  7,  41, 41, 41, 41, 1,  3,  2,  4});
+  auto overlaps = rtree.get_tile_overlap(ranges);
+  REQUIRE(overlaps.size() == ranges.size());
+  for (size_t r = 0; r < ranges.size(); ++r) {
+    auto overlap = rtree.get_tile_overlap(ranges[r]);
+    CHECK(overlaps[r].tile_ranges_ == overlap.tile_ranges_);
+    CHECK(overlaps[r].tiles_ == overlap.tiles_);
+  }
+  CHECK(overlaps[0].tiles_.empty());
+  CHECK(overlaps[0].tile_ranges_.empty());
+  CHECK(overlaps[1].tile_ranges_.size() == 1);
+  CHECK(overlaps[5].tiles_.size() == 2);
+  CHECK(overlaps[7].tile_ranges_.size() == 1);
+  CHECK(overlaps[7].tile_ranges_[0].first == 0);
+  CHECK(overlaps[7].tile_ranges_[0].second == 0);
+
+  // No ranges
+  CHECK(rtree.get_tile_overlap(std::vector<NDRange>()).empty());
+}
+
+TEST_CASE("RTree: Test 2D R-tree, point tiles", "[rtree][2d][points]") {
+  // Build tree
+  int32_t dim_dom[] = {1, 1000};
+  int32_t dim_extent = 10;
+  Domain dom2 = create_domain(
+      {"d1", "d2"},
+      {Datatype::INT32, Datatype::INT32},
+      {dim_dom, dim_dom},
+      {&dim_extent, &dim_extent});
+  std::vector<NDRange> mbrs = create_mbrs<int32_t, 2>(
+      {1,  3,  2,  4,  5,  7,  6,  9,  10, 12, 10, 15, 11, 15, 20, 22, 16, 16,
+       23, 23, 19, 20, 24, 26, 25, 28, 30, 32, 30, 35, 35, 37, 40, 42, 40, 42});
+  RTree rtree(&dom2, 3);
+  rtree.set_leaves(mbrs);
+  rtree.build_tree();
+  CHECK(rtree.height() == 3);
+
+  // Points inside some MBRs, outside all MBRs, and duplicates
+  int32_t d1[] = {41, 2, 11, 8, 16, 11, 2, 0};
+  int32_t d2[] = {40, 3, 12, 8, 23, 21, 3, 0};
+  std::vector<const void*> coords = {d1, d2};
+  auto tiles = rtree.get_point_tiles(coords, {0, 1, 2, 3, 4, 5, 6, 7});
+  CHECK(tiles == std::vector<uint64_t>({0, 2, 3, 4, 8}));
+  tiles = rtree.get_point_tiles(coords, {0});
+  CHECK(tiles == std::vector<uint64_t>({8}));
+  tiles = rtree.get_point_tiles(coords, {3, 7});
+  CHECK(tiles.empty());
+  tiles = rtree.get_point_tiles(coords, {});
+  CHECK(tiles.empty());
+
+  // Empty tree
+  RTree rtree0;
+  CHECK(rtree0.get_point_tiles(coords, {0, 1}).empty());
+}
+
 TEST_CASE(
     "RTree: Test R-Tree, heterogeneous (uint8, int32), basic functions",
     "[rtree][basic][heter]") {
@@ -1169,3 +1248,107 @@ TEST_CASE(
   CHECK(overlap.tiles_[1].second == 1.0 / 3);
   */
 }
+
+TEST_CASE(
+    "RTree: Test 2D R-tree (string, int), serialization",
+    "[rtree][2d][string-dims][heter][serialization]") {
+  // Build tree
+  int32_t dom_int32[] = {1, 20};
+  int32_t tile_extent = 5;
+  Domain dom = create_domain(
+      {"d1", "d2"},
+      {Datatype::STRING_ASCII, Datatype::INT32},
+      {nullptr, dom_int32},
+      {nullptr, &tile_extent});
+  std::vector<NDRange> mbrs = create_str_int32_mbrs(
+      {"aa", "b", "eee", "g", "gggg", "ii", "j", "jj", "k", "m"},
+      {1, 5, 7, 8, 10, 14, 2, 3, 15, 20});
+  RTree rtree(&dom, 2);
+  rtree.set_leaves(mbrs);
+  rtree.build_tree();
+  CHECK(rtree.height() == 4);
+  CHECK(rtree.leaf_num() == 5);
+
+  // Serialize and deserialize
+  Buffer buff;
+  CHECK(rtree.serialize(&buff).ok());
+  ConstBuffer cbuff(&buff);
+  RTree rtree2;
+  CHECK(rtree2.deserialize(&cbuff, &dom, constants::format_version).ok());
+  CHECK(rtree2.height() == 4);
+  CHECK(rtree2.fanout() == 2);
+  REQUIRE(rtree2.leaf_num() == 5);
+  for (uint64_t m = 0; m < mbrs.size(); ++m) {
+    auto leaf = rtree2.leaf(m);
+    CHECK(range_to_str(leaf[0]) == range_to_str(mbrs[m][0]));
+    CHECK(leaf[1] == mbrs[m][1]);
+  }
+
+  // Copies answer the same queries
+  RTree rtree3(rtree2);
+  NDRange range(2);
+  std::string start = "b", end = "jj";
+  range[0].set_range_var(start.data(), start.size(), end.data(), end.size());
+  int32_t r[] = {3, 9};
+  range[1].set_range(r, sizeof(r));
+  auto overlap = rtree.get_tile_overlap(range);
+  auto overlap3 = rtree3.get_tile_overlap(range);
+  CHECK(overlap.tiles_ == overlap3.tiles_);
+  CHECK(overlap.tile_ranges_ == overlap3.tile_ranges_);
+  REQUIRE(overlap.tiles_.size() == 2);
+  CHECK(overlap.tiles_[0].first == 0);
+  CHECK(overlap.tiles_[1].first == 3);
+  REQUIRE(overlap.tile_ranges_.size() == 1);
+  CHECK(overlap.tile_ranges_[0].first == 1);
+  CHECK(overlap.tile_ranges_[0].second == 1);
+}
+
+TEST_CASE(
+    "RTree: Test adding leaves to a built R-tree",
+    "[rtree][2d][string-dims][heter][add-leaves]") {
+  int32_t dom_int32[] = {1, 100};
+  int32_t tile_extent = 5;
+  Domain dom = create_domain(
+      {"d1", "d2"},
+      {Datatype::STRING_ASCII, Datatype::INT32},
+      {nullptr, dom_int32},
+      {nullptr, &tile_extent});
+  std::vector<std::string> d1;
+  std::vector<int32_t> d2;
+  for (int32_t i = 0; i < 30; ++i) {
+    d1.push_back(std::string(1, (char)('a' + (i * 7) % 26)));
+    d1.push_back(d1.back() + "z");
+    d2.push_back((i * 13) % 90 + 1);
+    d2.push_back(d2.back() + i % 5);
+  }
+  auto mbrs = create_str_int32_mbrs(d1, d2);
+
+  // Trees extended in batches are the same as trees built in bulk
+  unsigned fanout = GENERATE(2, 3, 10);
+  uint64_t batch = GENERATE(1, 4, 30);
+  RTree rtree(&dom, fanout);
+  for (uint64_t n = 0; n < mbrs.size(); n += batch) {
+    auto end = std::min<uint64_t>(n + batch, mbrs.size());
+    std::vector<NDRange> new_mbrs(mbrs.begin() + n, mbrs.begin() + end);
+    REQUIRE(rtree.add_leaves(new_mbrs).ok());
+
+    RTree expected(&dom, fanout);
+    std::vector<NDRange> all_mbrs(mbrs.begin(), mbrs.begin() + end);
+    expected.set_leaves(all_mbrs);
+    expected.build_tree();
+    CHECK(rtree.height() == expected.height());
+    REQUIRE(rtree.leaf_num() == end);
+
+    Buffer buff, expected_buff;
+    CHECK(rtree.serialize(&buff).ok());
+    CHECK(expected.serialize(&expected_buff).ok());
+    REQUIRE(buff.size() == expected_buff.size());
+    CHECK(std::memcmp(buff.data(), expected_buff.data(), buff.size()) == 0);
+  }
+
+  // Adding no leaves leaves the tree unchanged
+  auto height = rtree.height();
+  CHECK(rtree.add_leaves({}).ok());
+  CHECK(rtree.height() == height);
+  CHECK(rtree.leaf_num() == mbrs.size());
+}
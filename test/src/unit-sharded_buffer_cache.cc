@@ -0,0 +1,217 @@
+/**
+ * @file unit-sharded_buffer_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file unit-tests class ShardedBufferCache.
+ */
+
+#include "catch.hpp"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/cache/sharded_buffer_cache.h"
+#include "tiledb/sm/stats/stats.h"
+
+#include <thread>
+
+using namespace tiledb::common;
+using namespace tiledb::sm;
+
+#define CACHE_SIZE 10 * sizeof(int)
+
+namespace {
+
+/** Inserts a buffer storing `v` with the input key. */
+void insert(ShardedBufferCache* cache, const std::string& key, int v) {
+  Buffer buffer;
+  REQUIRE(buffer.realloc(sizeof(int)).ok());
+  REQUIRE(buffer.write(&v, sizeof(int)).ok());
+  REQUIRE(cache->insert(key, std::move(buffer)).ok());
+}
+
+/** Returns `true` if `key` is cached, checking its value against `v`. */
+bool read(ShardedBufferCache* cache, const std::string& key, int v) {
+  Buffer buffer;
+  bool success = false;
+  REQUIRE(cache->read(key, &buffer, &success).ok());
+  if (success) {
+    REQUIRE(buffer.size() == sizeof(int));
+    CHECK(*(int*)buffer.data() == v);
+  }
+  return success;
+}
+
+}  // namespace
+
+TEST_CASE(
+    "Unit-test class ShardedBufferCache, scan resistance",
+    "[sharded_buffer_cache]") {
+  ShardedBufferCache cache("TEST_CACHE", CACHE_SIZE, 1);
+
+  // Objects read twice are protected from a scan
+  insert(&cache, "a", 1);
+  insert(&cache, "b", 2);
+  CHECK(read(&cache, "a", 1));
+  CHECK(read(&cache, "b", 2));
+  for (int i = 0; i < 20; ++i)
+    insert(&cache, "s" + std::to_string(i), i);
+  CHECK(read(&cache, "a", 1));
+  CHECK(read(&cache, "b", 2));
+  CHECK(!read(&cache, "s0", 0));
+  CHECK(read(&cache, "s19", 19));
+  CHECK(cache.size() == CACHE_SIZE);
+
+  // The protected segment holds 8 objects, so promoting 9 objects demotes
+  // the least recently used one, which is evicted first
+  cache.clear();
+  CHECK(cache.size() == 0);
+  for (int i = 0; i < 9; ++i) {
+    insert(&cache, "p" + std::to_string(i), i);
+    CHECK(read(&cache, "p" + std::to_string(i), i));
+  }
+  insert(&cache, "n0", 0);
+  insert(&cache, "n1", 1);
+  CHECK(!read(&cache, "p0", 0));
+  for (int i = 1; i < 9; ++i)
+    CHECK(read(&cache, "p" + std::to_string(i), i));
+  CHECK(read(&cache, "n1", 1));
+}
+
+TEST_CASE(
+    "Unit-test class ShardedBufferCache, shards", "[sharded_buffer_cache]") {
+  ShardedBufferCache cache("TEST_CACHE", 100 * CACHE_SIZE, 4);
+  CHECK(cache.shard_num() == 4);
+
+  // The keys are spread over the shards, none of which overflows
+  for (int i = 0; i < 100; ++i)
+    insert(&cache, "k" + std::to_string(i), i);
+  CHECK(cache.size() == 100 * sizeof(int));
+  for (int i = 0; i < 100; ++i)
+    CHECK(read(&cache, "k" + std::to_string(i), i));
+
+  // Partial reads and overwrites
+  Buffer buffer;
+  bool success = false;
+  CHECK(cache.read("k7", &buffer, 1, 2, &success).ok());
+  CHECK(success);
+  CHECK(buffer.size() == 2);
+  CHECK(!cache.read("k7", &buffer, 2, 4, &success).ok());
+  Buffer other;
+  CHECK(other.realloc(sizeof(int)).ok());
+  CHECK(cache.insert("k7", std::move(other), false).ok());
+  CHECK(read(&cache, "k7", 7));
+  insert(&cache, "k7", 70);
+  CHECK(read(&cache, "k7", 70));
+
+  // Invalidation
+  CHECK(cache.invalidate("k8", &success).ok());
+  CHECK(success);
+  CHECK(!read(&cache, "k8", 8));
+  CHECK(cache.invalidate("k8", &success).ok());
+  CHECK(!success);
+  CHECK(cache.size() == 99 * sizeof(int));
+
+  // Objects larger than a shard are not cached
+  Buffer large;
+  CHECK(large.realloc(30 * CACHE_SIZE).ok());
+  CHECK(cache.insert("large", std::move(large)).ok());
+  CHECK(cache.read("large", &buffer, &success).ok());
+  CHECK(!success);
+
+  cache.clear();
+  CHECK(cache.size() == 0);
+  CHECK(!read(&cache, "k0", 0));
+}
+
+TEST_CASE(
+    "Unit-test class ShardedBufferCache, concurrency",
+    "[sharded_buffer_cache]") {
+  ShardedBufferCache cache("TEST_CACHE", 100 * CACHE_SIZE, 8);
+
+  // Threads insert and read disjoint keys
+  std::vector<std::thread> threads;
+  std::vector<int> found(4, 0);
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache, &found, t]() {
+      for (int i = 0; i < 1000; ++i) {
+        auto key = std::to_string(t) + "_" + std::to_string(i % 50);
+        Buffer buffer;
+        bool success = false;
+        if (cache.read(key, &buffer, &success).ok() && success) {
+          found[t] += *(int*)buffer.data() == i % 50;
+        } else {
+          int v = i % 50;
+          Buffer value;
+          if (value.write(&v, sizeof(int)).ok())
+            cache.insert(key, std::move(value));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  for (int t = 0; t < 4; ++t)
+    CHECK(found[t] > 0);
+  CHECK(cache.size() <= 100 * CACHE_SIZE);
+}
+
+TEST_CASE(
+    "Unit-test class ShardedBufferCache, stats", "[sharded_buffer_cache]") {
+  ShardedBufferCache cache("TEST_STATS_CACHE", 2 * sizeof(int), 1);
+  auto counters =
+      stats::all_stats.cache_shard_counters("TEST_STATS_CACHE", 0);
+
+  stats::all_stats.set_enabled(true);
+  stats::all_stats.reset();
+  insert(&cache, "a", 1);
+  insert(&cache, "b", 2);
+  insert(&cache, "c", 3);
+  CHECK(!read(&cache, "a", 1));
+  CHECK(read(&cache, "b", 2));
+  CHECK(read(&cache, "c", 3));
+  CHECK(counters->hits_ == 2);
+  CHECK(counters->misses_ == 1);
+  CHECK(counters->evictions_ == 1);
+
+  std::string dump;
+  stats::all_stats.dump(&dump);
+  CHECK(
+      dump.find("- TEST_STATS_CACHE, shard 0: 2 hits, 1 misses, 1 evictions") !=
+      std::string::npos);
+  stats::all_stats.raw_dump(&dump);
+  CHECK(dump.find("\"TEST_STATS_CACHE_SHARD_0_HITS\": 2") != std::string::npos);
+
+  stats::all_stats.reset();
+  CHECK(counters->hits_ == 0);
+  CHECK(counters->misses_ == 0);
+  CHECK(counters->evictions_ == 0);
+
+  // Nothing is counted when the stats are disabled
+  stats::all_stats.set_enabled(false);
+  CHECK(read(&cache, "b", 2));
+  CHECK(counters->hits_ == 0);
+}
@@ -225,6 +225,9 @@ std::string Status::code_to_string() const {
     case StatusCode::ThreadPoolError:
       type = "[TileDB::ThreadPool] Error";
       break;
+    case StatusCode::QueryConditionError:
+      type = "[TileDB::QueryCondition] Error";
+      break;
     default:
       type = "[TileDB::?] Error:";
   }
@@ -123,7 +123,8 @@ enum class StatusCode : char {
   RestError,
   SerializationError,
   ChecksumError,
-  ThreadPoolError
+  ThreadPoolError,
+  QueryConditionError
 };
 
 class Status {
@@ -396,6 +397,11 @@ class Status {
     return Status(StatusCode::ThreadPoolError, msg, -1);
   }
 
+  /** Return a QueryConditionError error class Status with a given message **/
+  static Status QueryConditionError(const std::string& msg) {
+    return Status(StatusCode::QueryConditionError, msg, -1);
+  }
+
   /** Returns true iff the status indicates success **/
   bool ok() const {
     return (state_ == nullptr);
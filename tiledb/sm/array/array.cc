@@ -42,10 +42,12 @@
 #include "tiledb/sm/enums/query_type.h"
 #include "tiledb/sm/enums/serialization_type.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/rest/rest_client.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -127,6 +129,7 @@ Status Array::open(
         encryption_key_,
         &array_schema_,
         &fragment_metadata_));
+    build_fragment_index();
   } else {
     RETURN_NOT_OK(storage_manager_->array_open_for_writes(
         array_uri_, encryption_key_, &array_schema_));
@@ -185,6 +188,7 @@ Status Array::open(
         encryption_key_,
         &array_schema_,
         &fragment_metadata_));
+    build_fragment_index();
   }
 
   is_open_ = true;
@@ -231,6 +235,7 @@ Status Array::open(
         encryption_key_,
         &array_schema_,
         &fragment_metadata_));
+    build_fragment_index();
   } else {
     RETURN_NOT_OK(storage_manager_->array_open_for_writes(
         array_uri_, encryption_key_, &array_schema_));
@@ -254,6 +259,7 @@ Status Array::close() {
   non_empty_domain_computed_ = false;
   clear_last_max_buffer_sizes();
   fragment_metadata_.clear();
+  fragment_index_ = RTree();
 
   if (remote_) {
     // Update array metadata for write queries if metadata was written by the
@@ -307,6 +313,11 @@ std::vector<FragmentMetadata*> Array::fragment_metadata() const {
   return fragment_metadata_;
 }
 
+const RTree& Array::fragment_index() const {
+  std::unique_lock<std::mutex> lck(mtx_);
+  return fragment_index_;
+}
+
 Status Array::get_array_schema(ArraySchema** array_schema) const {
   std::unique_lock<std::mutex> lck(mtx_);
 
@@ -470,6 +481,9 @@ Status Array::reopen(uint64_t timestamp) {
 
   clear_last_max_buffer_sizes();
 
+  // The fragment metadata remain loaded in the storage manager while the
+  // array is open, so the previous fragments can be compared by pointer
+  auto prev_fragment_metadata = std::move(fragment_metadata_);
   timestamp_ = timestamp;
   fragment_metadata_.clear();
   metadata_.clear();
@@ -491,6 +505,7 @@ Status Array::reopen(uint64_t timestamp) {
       encryption_key_,
       &array_schema_,
       &fragment_metadata_));
+  update_fragment_index(prev_fragment_metadata);
 
   return Status::Ok();
 }
@@ -702,6 +717,38 @@ void Array::set_non_empty_domain(const NDRange& non_empty_domain) {
 /*          PRIVATE METHODS          */
 /* ********************************* */
 
+void Array::build_fragment_index() {
+  fragment_index_ = RTree(array_schema_->domain(), constants::rtree_fanout);
+  if (fragment_metadata_.empty())
+    return;
+
+  std::vector<NDRange> non_empty_domains;
+  non_empty_domains.reserve(fragment_metadata_.size());
+  for (const auto& meta : fragment_metadata_)
+    non_empty_domains.emplace_back(meta->non_empty_domain());
+  fragment_index_.set_leaves(non_empty_domains);
+  fragment_index_.build_tree();
+}
+
+void Array::update_fragment_index(
+    const std::vector<FragmentMetadata*>& prev_fragment_metadata) {
+  auto prev_num = prev_fragment_metadata.size();
+  if (prev_num == 0 || prev_num > fragment_metadata_.size() ||
+      !std::equal(
+          prev_fragment_metadata.begin(),
+          prev_fragment_metadata.end(),
+          fragment_metadata_.begin())) {
+    build_fragment_index();
+    return;
+  }
+
+  std::vector<NDRange> non_empty_domains;
+  non_empty_domains.reserve(fragment_metadata_.size() - prev_num);
+  for (auto i = prev_num; i < fragment_metadata_.size(); ++i)
+    non_empty_domains.emplace_back(fragment_metadata_[i]->non_empty_domain());
+  fragment_index_.add_leaves(non_empty_domains);
+}
+
 void Array::clear_last_max_buffer_sizes() {
   last_max_buffer_sizes_.clear();
   last_max_buffer_sizes_subarray_.clear();
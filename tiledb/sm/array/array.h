@@ -41,6 +41,7 @@
 #include "tiledb/sm/crypto/encryption_key.h"
 #include "tiledb/sm/fragment/fragment_info.h"
 #include "tiledb/sm/metadata/metadata.h"
+#include "tiledb/sm/rtree/rtree.h"
 
 using namespace tiledb::common;
 
@@ -150,6 +151,17 @@ class Array {
    */
   std::vector<FragmentMetadata*> fragment_metadata() const;
 
+  /**
+   * Returns an R-tree over the non-empty domains of the fragments of the
+   * array, where leaf `i` is the non-empty domain of the fragment with
+   * index `i` in `fragment_metadata()`. It is built when the array is
+   * opened for reads, and extended with the new fragments when it is
+   * reopened, so that the fragments relevant to a query are found
+   * without checking every fragment. The R-tree is empty if the array is
+   * not open for reads.
+   */
+  const RTree& fragment_index() const;
+
   /**
    * Returns `true` if the array is empty at the time it is opened.
    * The funciton returns `false` if the array is not open.
@@ -336,6 +348,9 @@ class Array {
   /** The metadata of the fragments the array was opened with. */
   std::vector<FragmentMetadata*> fragment_metadata_;
 
+  /** The R-tree over the non-empty domains of the fragments. */
+  RTree fragment_index_;
+
   /** `True` if the array has been opened. */
   std::atomic<bool> is_open_;
 
@@ -383,6 +398,18 @@ class Array {
   /*          PRIVATE METHODS          */
   /* ********************************* */
 
+  /** Builds `fragment_index_` from the loaded fragment metadata. */
+  void build_fragment_index();
+
+  /**
+   * Updates `fragment_index_` after the array is reopened. If the
+   * fragments the array was open with, `prev_fragment_metadata`, are the
+   * first of the loaded fragments, only the new fragments are added to
+   * the index. Otherwise the index is rebuilt.
+   */
+  void update_fragment_index(
+      const std::vector<FragmentMetadata*>& prev_fragment_metadata);
+
   /** Clears the cached max buffer sizes and subarray. */
   void clear_last_max_buffer_sizes();
 
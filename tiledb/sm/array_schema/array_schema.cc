@@ -43,6 +43,7 @@
 #include "tiledb/sm/enums/filter_type.h"
 #include "tiledb/sm/enums/layout.h"
 #include "tiledb/sm/filter/compression_filter.h"
+#include "tiledb/sm/misc/hilbert.h"
 
 #include <cassert>
 #include <iostream>
@@ -218,6 +219,25 @@ Status ArraySchema::check() const {
     }
   }
 
+  if (tile_order_ == Layout::HILBERT)
+    return LOG_STATUS(Status::ArraySchemaError(
+        "Array schema check failed; The tile order cannot be Hilbert"));
+
+  if (cell_order_ == Layout::HILBERT) {
+    if (array_type_ == ArrayType::DENSE)
+      return LOG_STATUS(Status::ArraySchemaError(
+          "Array schema check failed; The Hilbert cell order is applicable "
+          "only to sparse arrays"));
+    if (dim_num() > Hilbert::max_dim_num)
+      return LOG_STATUS(Status::ArraySchemaError(
+          "Array schema check failed; The Hilbert cell order supports up to " +
+          std::to_string(Hilbert::max_dim_num) + " dimensions"));
+    if (!domain_->all_dims_fixed())
+      return LOG_STATUS(Status::ArraySchemaError(
+          "Array schema check failed; The Hilbert cell order is not "
+          "applicable to string dimensions"));
+  }
+
   RETURN_NOT_OK(check_double_delta_compressor());
 
   if (!check_attribute_dimension_names())
@@ -46,6 +46,24 @@ using namespace tiledb::common;
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/** Returns the value halfway between integers `a <= b`, rounded down. */
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, T>::type mid_value(
+    T a, T b) {
+  return (T)((uint64_t)a + ((uint64_t)b - (uint64_t)a) / 2);
+}
+
+/** Returns the value halfway between reals `a <= b`. */
+template <class T>
+typename std::enable_if<std::is_floating_point<T>::value, T>::type mid_value(
+    T a, T b) {
+  return (T)(a + ((long double)b - a) / 2);
+}
+
+}  // namespace
+
 /* ********************************* */
 /*     CONSTRUCTORS & DESTRUCTORS    */
 /* ********************************* */
@@ -67,6 +85,8 @@ Dimension::Dimension(const std::string& name, Datatype type)
   set_expand_range_func();
   set_expand_range_v_func();
   set_expand_to_tile_func();
+  set_map_to_uint64_func();
+  set_hilbert_splitting_value_func();
   set_oob_func();
   set_covered_func();
   set_overlap_func();
@@ -90,11 +110,14 @@ Dimension::Dimension(const Dimension* dim) {
   check_range_func_ = dim->check_range_func_;
   coincides_with_tiles_func_ = dim->coincides_with_tiles_func_;
   compute_mbr_func_ = dim->compute_mbr_func_;
+  compute_mbr_var_func_ = dim->compute_mbr_var_func_;
   crop_range_func_ = dim->crop_range_func_;
   domain_range_func_ = dim->domain_range_func_;
   expand_range_v_func_ = dim->expand_range_v_func_;
   expand_range_func_ = dim->expand_range_func_;
   expand_to_tile_func_ = dim->expand_to_tile_func_;
+  map_to_uint64_func_ = dim->map_to_uint64_func_;
+  hilbert_splitting_value_func_ = dim->hilbert_splitting_value_func_;
   oob_func_ = dim->oob_func_;
   covered_func_ = dim->covered_func_;
   overlap_func_ = dim->overlap_func_;
@@ -266,6 +289,8 @@ Status Dimension::deserialize(
   set_expand_range_func();
   set_expand_range_v_func();
   set_expand_to_tile_func();
+  set_map_to_uint64_func();
+  set_hilbert_splitting_value_func();
   set_oob_func();
   set_covered_func();
   set_overlap_func();
@@ -385,15 +410,12 @@ Status Dimension::compute_mbr(const Tile& tile, Range* mbr) {
   RETURN_NOT_OK(chunked_buffer->get_contiguous(&tile_buffer));
   assert(tile_buffer != nullptr);
 
-  // Initialize MBR with the first tile values
+  // Reduce the tile values to their bounds, setting the MBR once
   const T* const data = static_cast<T*>(tile_buffer);
-  T res[] = {data[0], data[0]};
+  T res[2];
+  utils::geometry::min_max(data, cell_num, &res[0], &res[1]);
   mbr->set_range(res, sizeof(res));
 
-  // Expand the MBR with the rest tile values
-  for (uint64_t c = 1; c < cell_num; ++c)
-    expand_range_v<T>(&data[c], mbr);
-
   return Status::Ok();
 }
 
@@ -425,16 +447,24 @@ Status Dimension::compute_mbr_var<char>(
   uint64_t* const d_off = static_cast<uint64_t*>(tile_buffer_off);
   char* const d_val = static_cast<char*>(tile_buffer_val);
 
-  // Initialize MBR with the first tile values
-  auto size_0 = (cell_num == 1) ? d_val_size : d_off[1];
-  mbr->set_range_var(d_val, size_0, d_val, size_0);
-
-  // Expand the MBR with the rest tile values
+  // Track the minimum and maximum values in place, setting the MBR once
+  const char* min = d_val;
+  uint64_t min_size = (cell_num == 1) ? d_val_size : d_off[1];
+  const char* max = min;
+  uint64_t max_size = min_size;
   for (uint64_t c = 1; c < cell_num; ++c) {
+    auto v = &d_val[d_off[c]];
     auto size =
         (c == cell_num - 1) ? d_val_size - d_off[c] : d_off[c + 1] - d_off[c];
-    expand_range_var_v(&d_val[d_off[c]], size, mbr);
+    if (utils::parse::compare(v, size, min, min_size) < 0) {
+      min = v;
+      min_size = size;
+    } else if (utils::parse::compare(v, size, max, max_size) > 0) {
+      max = v;
+      max_size = size;
+    }
   }
+  mbr->set_range_var(min, min_size, max, max_size);
 
   return Status::Ok();
 }
@@ -504,12 +534,22 @@ void Dimension::expand_range_var_v(const char* v, uint64_t v_size, Range* r) {
   assert(!r->empty());
   assert(v_size != 0);
 
-  auto start = r->start_str();
-  auto end = r->end_str();
-  auto v_str = std::string(v, v_size);
+  auto start = (const char*)r->start();
+  auto start_size = r->start_size();
+  auto end = (const char*)r->end();
+  auto end_size = r->end_size();
+  bool expand_start = utils::parse::compare(v, v_size, start, start_size) < 0;
+  bool expand_end = utils::parse::compare(v, v_size, end, end_size) > 0;
+  if (!expand_start && !expand_end)
+    return;
 
-  r->set_str_range(
-      (v_str < start) ? v_str : start, (v_str > end) ? v_str : end);
+  // The new bounds may point into `r`, so they are assembled separately
+  Range expanded;
+  if (expand_start)
+    expanded.set_range_var(v, v_size, end, end_size);
+  else
+    expanded.set_range_var(start, start_size, v, v_size);
+  *r = std::move(expanded);
 }
 
 template <class T>
@@ -532,16 +572,31 @@ void Dimension::expand_range_var(const Range& r1, Range* r2) const {
   assert(!r1.empty());
   assert(!r2->empty());
 
-  auto r1_start = r1.start_str();
-  auto r1_end = r1.end_str();
-
-  auto r2_start = r2->start_str();
-  auto r2_end = r2->end_str();
-
-  auto min = (r1_start < r2_start) ? r1_start : r2_start;
-  auto max = (r1_end < r2_end) ? r2_end : r1_end;
+  auto r1_start = (const char*)r1.start();
+  auto r1_start_size = r1.start_size();
+  auto r1_end = (const char*)r1.end();
+  auto r1_end_size = r1.end_size();
+
+  auto r2_start = (const char*)r2->start();
+  auto r2_start_size = r2->start_size();
+  auto r2_end = (const char*)r2->end();
+  auto r2_end_size = r2->end_size();
+
+  bool expand_start = utils::parse::compare(
+                          r1_start, r1_start_size, r2_start, r2_start_size) < 0;
+  bool expand_end =
+      utils::parse::compare(r1_end, r1_end_size, r2_end, r2_end_size) > 0;
+  if (!expand_start && !expand_end)
+    return;
 
-  r2->set_str_range(min, max);
+  // The new bounds may point into `r2`, so they are assembled separately
+  Range expanded;
+  expanded.set_range_var(
+      expand_start ? r1_start : r2_start,
+      expand_start ? r1_start_size : r2_start_size,
+      expand_end ? r1_end : r2_end,
+      expand_end ? r1_end_size : r2_end_size);
+  *r2 = std::move(expanded);
 }
 
 template <class T>
@@ -570,6 +625,65 @@ void Dimension::expand_to_tile(Range* range) const {
   expand_to_tile_func_(this, range);
 }
 
+template <class T>
+uint64_t Dimension::map_to_uint64(
+    const Dimension* dim, const void* coord, uint64_t max_bucket_val) {
+  assert(!dim->domain().empty());
+
+  auto dom = (const T*)dim->domain().data();
+  double dom_start = dom[0];
+  double dom_range = (double)dom[1] - dom_start;
+  if (!(dom_range > 0))
+    return 0;
+
+  auto norm = ((double)*(const T*)coord - dom_start) / dom_range;
+  norm = std::max(0.0, std::min(norm, 1.0));
+  return std::min((uint64_t)(norm * max_bucket_val), max_bucket_val);
+}
+
+uint64_t Dimension::map_to_uint64(
+    const void* coord, uint64_t max_bucket_val) const {
+  assert(map_to_uint64_func_ != nullptr);
+  return map_to_uint64_func_(this, coord, max_bucket_val);
+}
+
+template <class T>
+void Dimension::hilbert_splitting_value(
+    const Dimension* dim,
+    const Range& r,
+    uint64_t bucket,
+    uint64_t max_bucket_val,
+    ByteVecValue* v) {
+  assert(!r.empty());
+  assert(v != nullptr);
+
+  // Bisect `r`, keeping `lo` below `bucket` and `hi` at or above it, until
+  // they are adjacent values
+  auto r_t = (const T*)r.data();
+  T lo = r_t[0], hi = r_t[1];
+  assert(map_to_uint64<T>(dim, &lo, max_bucket_val) < bucket);
+  assert(map_to_uint64<T>(dim, &hi, max_bucket_val) >= bucket);
+  for (T mid = mid_value(lo, hi); mid != lo && mid != hi;
+       mid = mid_value(lo, hi)) {
+    if (map_to_uint64<T>(dim, &mid, max_bucket_val) < bucket)
+      lo = mid;
+    else
+      hi = mid;
+  }
+
+  v->resize(sizeof(T));
+  std::memcpy(&(*v)[0], &lo, sizeof(T));
+}
+
+void Dimension::hilbert_splitting_value(
+    const Range& r,
+    uint64_t bucket,
+    uint64_t max_bucket_val,
+    ByteVecValue* v) const {
+  assert(hilbert_splitting_value_func_ != nullptr);
+  hilbert_splitting_value_func_(this, r, bucket, max_bucket_val, v);
+}
+
 template <class T>
 bool Dimension::oob(
     const Dimension* dim, const void* coord, std::string* err_msg) {
@@ -2012,6 +2126,112 @@ void Dimension::set_expand_to_tile_func() {
   }
 }
 
+void Dimension::set_map_to_uint64_func() {
+  switch (type_) {
+    case Datatype::INT32:
+      map_to_uint64_func_ = map_to_uint64<int32_t>;
+      break;
+    case Datatype::INT64:
+      map_to_uint64_func_ = map_to_uint64<int64_t>;
+      break;
+    case Datatype::INT8:
+      map_to_uint64_func_ = map_to_uint64<int8_t>;
+      break;
+    case Datatype::UINT8:
+      map_to_uint64_func_ = map_to_uint64<uint8_t>;
+      break;
+    case Datatype::INT16:
+      map_to_uint64_func_ = map_to_uint64<int16_t>;
+      break;
+    case Datatype::UINT16:
+      map_to_uint64_func_ = map_to_uint64<uint16_t>;
+      break;
+    case Datatype::UINT32:
+      map_to_uint64_func_ = map_to_uint64<uint32_t>;
+      break;
+    case Datatype::UINT64:
+      map_to_uint64_func_ = map_to_uint64<uint64_t>;
+      break;
+    case Datatype::FLOAT32:
+      map_to_uint64_func_ = map_to_uint64<float>;
+      break;
+    case Datatype::FLOAT64:
+      map_to_uint64_func_ = map_to_uint64<double>;
+      break;
+    case Datatype::DATETIME_YEAR:
+    case Datatype::DATETIME_MONTH:
+    case Datatype::DATETIME_WEEK:
+    case Datatype::DATETIME_DAY:
+    case Datatype::DATETIME_HR:
+    case Datatype::DATETIME_MIN:
+    case Datatype::DATETIME_SEC:
+    case Datatype::DATETIME_MS:
+    case Datatype::DATETIME_US:
+    case Datatype::DATETIME_NS:
+    case Datatype::DATETIME_PS:
+    case Datatype::DATETIME_FS:
+    case Datatype::DATETIME_AS:
+      map_to_uint64_func_ = map_to_uint64<int64_t>;
+      break;
+    default:
+      map_to_uint64_func_ = nullptr;
+      break;
+  }
+}
+
+void Dimension::set_hilbert_splitting_value_func() {
+  switch (type_) {
+    case Datatype::INT32:
+      hilbert_splitting_value_func_ = hilbert_splitting_value<int32_t>;
+      break;
+    case Datatype::INT64:
+      hilbert_splitting_value_func_ = hilbert_splitting_value<int64_t>;
+      break;
+    case Datatype::INT8:
+      hilbert_splitting_value_func_ = hilbert_splitting_value<int8_t>;
+      break;
+    case Datatype::UINT8:
+      hilbert_splitting_value_func_ = hilbert_splitting_value<uint8_t>;
+      break;
+    case Datatype::INT16:
+      hilbert_splitting_value_func_ = hilbert_splitting_value<int16_t>;
+      break;
+    case Datatype::UINT16:
+      hilbert_splitting_value_func_ = hilbert_splitting_value<uint16_t>;
+      break;
+    case Datatype::UINT32:
+      hilbert_splitting_value_func_ = hilbert_splitting_value<uint32_t>;
+      break;
+    case Datatype::UINT64:
+      hilbert_splitting_value_func_ = hilbert_splitting_value<uint64_t>;
+      break;
+    case Datatype::FLOAT32:
+      hilbert_splitting_value_func_ = hilbert_splitting_value<float>;
+      break;
+    case Datatype::FLOAT64:
+      hilbert_splitting_value_func_ = hilbert_splitting_value<double>;
+      break;
+    case Datatype::DATETIME_YEAR:
+    case Datatype::DATETIME_MONTH:
+    case Datatype::DATETIME_WEEK:
+    case Datatype::DATETIME_DAY:
+    case Datatype::DATETIME_HR:
+    case Datatype::DATETIME_MIN:
+    case Datatype::DATETIME_SEC:
+    case Datatype::DATETIME_MS:
+    case Datatype::DATETIME_US:
+    case Datatype::DATETIME_NS:
+    case Datatype::DATETIME_PS:
+    case Datatype::DATETIME_FS:
+    case Datatype::DATETIME_AS:
+      hilbert_splitting_value_func_ = hilbert_splitting_value<int64_t>;
+      break;
+    default:
+      hilbert_splitting_value_func_ = nullptr;
+      break;
+  }
+}
+
 void Dimension::set_oob_func() {
   switch (type_) {
     case Datatype::INT32:
@@ -33,11 +33,13 @@
 #ifndef TILEDB_DIMENSION_H
 #define TILEDB_DIMENSION_H
 
+#include <cassert>
 #include <sstream>
 #include <string>
 
 #include "tiledb/common/logger.h"
 #include "tiledb/common/status.h"
+#include "tiledb/sm/enums/datatype.h"
 #include "tiledb/sm/misc/types.h"
 #include "tiledb/sm/tile/tile.h"
 
@@ -51,7 +53,6 @@ class ConstBuffer;
 class FilterPipeline;
 
 enum class Compressor : uint8_t;
-enum class Datatype : uint8_t;
 
 /** Manipulates a TileDB dimension. */
 class Dimension {
@@ -277,6 +278,54 @@ class Dimension {
   template <class T>
   static void crop_range(const Dimension* dim, Range* range);
 
+  /**
+   * Invokes `f->template run<T>()`, where `T` is the coordinate type of
+   * the dimension. This lets callers pick a type-specialized routine once
+   * for all the values of a dimension, instead of calling through the
+   * function members per value. Applicable only to fixed-sized dimensions.
+   */
+  template <class F>
+  void dispatch_fixed(F* f) const {
+    switch (type_) {
+      case Datatype::INT8:
+        return f->template run<int8_t>();
+      case Datatype::UINT8:
+        return f->template run<uint8_t>();
+      case Datatype::INT16:
+        return f->template run<int16_t>();
+      case Datatype::UINT16:
+        return f->template run<uint16_t>();
+      case Datatype::INT32:
+        return f->template run<int32_t>();
+      case Datatype::UINT32:
+        return f->template run<uint32_t>();
+      case Datatype::INT64:
+        return f->template run<int64_t>();
+      case Datatype::UINT64:
+        return f->template run<uint64_t>();
+      case Datatype::FLOAT32:
+        return f->template run<float>();
+      case Datatype::FLOAT64:
+        return f->template run<double>();
+      case Datatype::DATETIME_YEAR:
+      case Datatype::DATETIME_MONTH:
+      case Datatype::DATETIME_WEEK:
+      case Datatype::DATETIME_DAY:
+      case Datatype::DATETIME_HR:
+      case Datatype::DATETIME_MIN:
+      case Datatype::DATETIME_SEC:
+      case Datatype::DATETIME_MS:
+      case Datatype::DATETIME_US:
+      case Datatype::DATETIME_NS:
+      case Datatype::DATETIME_PS:
+      case Datatype::DATETIME_FS:
+      case Datatype::DATETIME_AS:
+        return f->template run<int64_t>();
+      default:
+        assert(false);
+    }
+  }
+
   /**
    * Returns the domain range (high - low + 1) of the input
    * 1D range. It returns 0 in case the dimension datatype
@@ -328,6 +377,46 @@ class Dimension {
   template <class T>
   static void expand_to_tile(const Dimension* dim, Range* range);
 
+  /**
+   * Maps the input coordinate to a bucket in `[0, max_bucket_val]`, by
+   * normalizing it against the dimension domain. Coordinates outside the
+   * domain are clamped to its bounds. This is used to compute the Hilbert
+   * value of a cell.
+   *
+   * @param coord The coordinate to map. It will properly be type-cast to
+   *     the dimension datatype.
+   * @param max_bucket_val The largest bucket value.
+   * @return The bucket of the coordinate.
+   */
+  uint64_t map_to_uint64(const void* coord, uint64_t max_bucket_val) const;
+
+  /** Maps the input coordinate to a bucket in `[0, max_bucket_val]`. */
+  template <class T>
+  static uint64_t map_to_uint64(
+      const Dimension* dim, const void* coord, uint64_t max_bucket_val);
+
+  /**
+   * Computes the largest value `v` of `r` that `map_to_uint64` maps to a
+   * bucket smaller than `bucket`, so that splitting `r` at `v` separates
+   * its values of the buckets smaller than `bucket` from the rest. The
+   * start of `r` must map to a bucket smaller than `bucket`, and its end
+   * must not.
+   */
+  void hilbert_splitting_value(
+      const Range& r,
+      uint64_t bucket,
+      uint64_t max_bucket_val,
+      ByteVecValue* v) const;
+
+  /** Computes the value of `r` splitting it before `bucket`. */
+  template <class T>
+  static void hilbert_splitting_value(
+      const Dimension* dim,
+      const Range& r,
+      uint64_t bucket,
+      uint64_t max_bucket_val,
+      ByteVecValue* v);
+
   /**
    * Returns error if the input coordinate is out-of-bounds with respect
    * to the dimension domain.
@@ -493,115 +582,126 @@ class Dimension {
    * Stores the appropriate templated ceil_to_tile() function based on the
    * dimension datatype.
    */
-  std::function<void(const Dimension*, const Range&, uint64_t, ByteVecValue*)>
-      ceil_to_tile_func_;
+  void (*ceil_to_tile_func_)(
+      const Dimension*, const Range&, uint64_t, ByteVecValue*);
 
   /**
    * Stores the appropriate templated check_range() function based on the
    * dimension datatype.
    */
-  std::function<bool(const Dimension*, const Range&, std::string*)>
-      check_range_func_;
+  bool (*check_range_func_)(const Dimension*, const Range&, std::string*);
 
   /**
    * Stores the appropriate templated coincides_with_tiles() function based on
    * the dimension datatype.
    */
-  std::function<bool(const Dimension*, const Range&)>
-      coincides_with_tiles_func_;
+  bool (*coincides_with_tiles_func_)(const Dimension*, const Range&);
 
   /**
    * Stores the appropriate templated compute_mbr() function based on the
    * dimension datatype.
    */
-  std::function<Status(const Tile&, Range*)> compute_mbr_func_;
+  Status (*compute_mbr_func_)(const Tile&, Range*);
 
   /**
    * Stores the appropriate templated compute_mbr_var() function based on the
    * dimension datatype.
    */
-  std::function<Status(const Tile&, const Tile&, Range*)> compute_mbr_var_func_;
+  Status (*compute_mbr_var_func_)(const Tile&, const Tile&, Range*);
 
   /**
    * Stores the appropriate templated crop_range() function based on the
    * dimension datatype.
    */
-  std::function<void(const Dimension* dim, Range*)> crop_range_func_;
+  void (*crop_range_func_)(const Dimension* dim, Range*);
 
   /**
    * Stores the appropriate templated crop_range() function based on the
    * dimension datatype.
    */
-  std::function<uint64_t(const Range&)> domain_range_func_;
+  uint64_t (*domain_range_func_)(const Range&);
 
   /**
    * Stores the appropriate templated expand_range() function based on the
    * dimension datatype.
    */
-  std::function<void(const void*, Range*)> expand_range_v_func_;
+  void (*expand_range_v_func_)(const void*, Range*);
 
   /**
    * Stores the appropriate templated expand_range() function based on the
    * dimension datatype.
    */
-  std::function<void(const Range&, Range*)> expand_range_func_;
+  void (*expand_range_func_)(const Range&, Range*);
 
   /**
    * Stores the appropriate templated expand_to_tile() function based on the
    * dimension datatype.
    */
-  std::function<void(const Dimension* dim, Range*)> expand_to_tile_func_;
+  void (*expand_to_tile_func_)(const Dimension* dim, Range*);
+
+  /**
+   * Stores the appropriate templated map_to_uint64() function based on the
+   * dimension datatype.
+   */
+  uint64_t (*map_to_uint64_func_)(
+      const Dimension* dim, const void*, uint64_t);
+
+  /**
+   * Stores the appropriate templated hilbert_splitting_value() function
+   * based on the dimension datatype.
+   */
+  void (*hilbert_splitting_value_func_)(
+      const Dimension* dim, const Range&, uint64_t, uint64_t, ByteVecValue*);
 
   /**
    * Stores the appropriate templated oob() function based on the
    * dimension datatype.
    */
-  std::function<bool(const Dimension* dim, const void*, std::string*)>
-      oob_func_;
+  bool (*oob_func_)(const Dimension* dim, const void*, std::string*);
 
   /**
    * Stores the appropriate templated covered() function based on the
    * dimension datatype.
    */
-  std::function<bool(const Range&, const Range&)> covered_func_;
+  bool (*covered_func_)(const Range&, const Range&);
 
   /**
    * Stores the appropriate templated overlap() function based on the
    * dimension datatype.
    */
-  std::function<bool(const Range&, const Range&)> overlap_func_;
+  bool (*overlap_func_)(const Range&, const Range&);
 
   /**
    * Stores the appropriate templated overlap_ratio() function based on the
    * dimension datatype.
    */
-  std::function<double(const Range&, const Range&)> overlap_ratio_func_;
+  double (*overlap_ratio_func_)(const Range&, const Range&);
 
   /**
    * Stores the appropriate templated split_range() function based on the
    * dimension datatype.
    */
-  std::function<void(const Range&, const ByteVecValue&, Range*, Range*)>
-      split_range_func_;
+  void (*split_range_func_)(
+      const Range&, const ByteVecValue&, Range*, Range*);
 
   /**
    * Stores the appropriate templated splitting_value() function based on the
    * dimension datatype.
    */
-  std::function<void(const Range&, ByteVecValue*, bool* unsplittable)>
-      splitting_value_func_;
+  void (*splitting_value_func_)(
+      const Range&, ByteVecValue*, bool* unsplittable);
 
   /**
    * Stores the appropriate templated tile_num() function based on the
    * dimension datatype.
    */
-  std::function<uint64_t(const Dimension* dim, const Range&)> tile_num_func_;
+  uint64_t (*tile_num_func_)(const Dimension* dim, const Range&);
 
   /**
    * Stores the appropriate templated value_in_range() function based on the
    * dimension datatype.
    */
-  std::function<bool(const void*, const Range&)> value_in_range_func_;
+  bool (*value_in_range_func_)(const void*, const Range&);
 
   /* ********************************* */
   /*          PRIVATE METHODS          */
@@ -723,6 +823,12 @@ class Dimension {
   /** Sets the templated expand_to_tile() function. */
   void set_expand_to_tile_func();
 
+  /** Sets the templated map_to_uint64() function. */
+  void set_map_to_uint64_func();
+
+  /** Sets the templated hilbert_splitting_value() function. */
+  void set_hilbert_splitting_value_func();
+
   /** Sets the templated oob() function. */
   void set_oob_func();
 
@@ -37,6 +37,7 @@
 #include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/enums/datatype.h"
 #include "tiledb/sm/enums/layout.h"
+#include "tiledb/sm/misc/hilbert.h"
 #include "tiledb/sm/misc/utils.h"
 
 #include <cassert>
@@ -216,14 +217,12 @@ int Domain::cell_order_cmp(
     unsigned dim_idx, const ResultCoords& a, const ResultCoords& b) const {
   // Handle variable-sized dimensions
   if (dimensions_[dim_idx]->var_size()) {
-    auto s_a = a.coord_string(dim_idx);
-    auto s_b = b.coord_string(dim_idx);
-
-    if (s_a == s_b)
-      return 0;
-    if (s_a < s_b)
-      return -1;
-    return 1;
+    const char* s_a = nullptr;
+    const char* s_b = nullptr;
+    uint64_t size_a = 0, size_b = 0;
+    a.tile_->coord_string(a.pos_, dim_idx, &s_a, &size_a);
+    b.tile_->coord_string(b.pos_, dim_idx, &s_b, &size_b);
+    return utils::parse::compare(s_a, size_a, s_b, size_b);
   }
 
   assert(cell_order_cmp_func_2_[dim_idx] != nullptr);
@@ -247,7 +246,15 @@ int Domain::cell_order_cmp(
     const std::vector<const QueryBuffer*>& coord_buffs,
     uint64_t a,
     uint64_t b) const {
-  if (cell_order_ == Layout::ROW_MAJOR) {
+  // Compare the Hilbert values first, and break ties in row-major order
+  if (cell_order_ == Layout::HILBERT) {
+    auto ha = hilbert_value(coord_buffs, a);
+    auto hb = hilbert_value(coord_buffs, b);
+    if (ha != hb)
+      return (ha < hb) ? -1 : 1;
+  }
+
+  if (cell_order_ == Layout::ROW_MAJOR || cell_order_ == Layout::HILBERT) {
     for (unsigned d = 0; d < dim_num_; ++d) {
       auto dim = dimension(d);
       auto res = cell_order_cmp_func_[d](dim, coord_buffs[d], a, b);
@@ -512,6 +519,32 @@ Status Domain::has_dimension(const std::string& name, bool* has_dim) const {
   return Status::Ok();
 }
 
+uint64_t Domain::hilbert_value(
+    const std::vector<const QueryBuffer*>& coord_buffs, uint64_t pos) const {
+  Hilbert hilbert(dim_num_);
+  auto max_bucket_val = hilbert.max_bucket_val();
+  uint64_t coords[Hilbert::max_dim_num];
+  for (unsigned d = 0; d < dim_num_; ++d) {
+    auto dim = dimensions_[d];
+    auto buff = (const unsigned char*)coord_buffs[d]->buffer_;
+    coords[d] =
+        dim->map_to_uint64(&buff[pos * dim->coord_size()], max_bucket_val);
+  }
+
+  return hilbert.coords_to_hilbert(coords);
+}
+
+uint64_t Domain::hilbert_value(const ResultCoords& coords) const {
+  Hilbert hilbert(dim_num_);
+  auto max_bucket_val = hilbert.max_bucket_val();
+  uint64_t bucket_coords[Hilbert::max_dim_num];
+  for (unsigned d = 0; d < dim_num_; ++d)
+    bucket_coords[d] =
+        dimensions_[d]->map_to_uint64(coords.coord(d), max_bucket_val);
+
+  return hilbert.coords_to_hilbert(bucket_coords);
+}
+
 Status Domain::init(Layout cell_order, Layout tile_order) {
   // Set cell and tile order
   cell_order_ = cell_order;
@@ -682,6 +715,10 @@ int Domain::tile_order_cmp(
     const std::vector<const QueryBuffer*>& coord_buffs,
     uint64_t a,
     uint64_t b) const {
+  // The space tiles do not participate in the Hilbert order
+  if (cell_order_ == Layout::HILBERT)
+    return 0;
+
   if (tile_order_ == Layout::ROW_MAJOR) {
     for (unsigned d = 0; d < dim_num_; ++d) {
       auto dim = dimension(d);
@@ -397,6 +397,24 @@ class Domain {
    */
   Status has_dimension(const std::string& name, bool* has_dim) const;
 
+  /**
+   * Returns the Hilbert value of the input coordinates, i.e., their position
+   * on the Hilbert curve that traverses the domain. Every coordinate is
+   * first mapped to one of `2^bits` buckets of its dimension domain, where
+   * `bits` is the number of bits per dimension of the curve.
+   *
+   * @param coord_buffs The input coordinates, given n separate buffers,
+   *     one per dimension. The buffers are sorted in the same order of the
+   *     dimensions as defined in the array schema.
+   * @param pos The position of the coordinate tuple across all buffers.
+   * @return The Hilbert value.
+   */
+  uint64_t hilbert_value(
+      const std::vector<const QueryBuffer*>& coord_buffs, uint64_t pos) const;
+
+  /** Returns the Hilbert value of the input result coordinates. */
+  uint64_t hilbert_value(const ResultCoords& coords) const;
+
   /**
    * Initializes the domain.
    *
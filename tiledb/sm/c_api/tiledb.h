@@ -150,6 +150,30 @@ typedef enum {
 #undef TILEDB_VFS_MODE_ENUM
 } tiledb_vfs_mode_t;
 
+/** Query condition comparison operator. */
+typedef enum {
+/** Helper macro for defining query condition operator enums. */
+#define TILEDB_QUERY_CONDITION_OP_ENUM(id) TILEDB_##id
+#include "tiledb_enum.h"
+#undef TILEDB_QUERY_CONDITION_OP_ENUM
+} tiledb_query_condition_op_t;
+
+/** Query condition combination operator. */
+typedef enum {
+/** Helper macro for defining query condition combination operator enums. */
+#define TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM(id) TILEDB_##id
+#include "tiledb_enum.h"
+#undef TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM
+} tiledb_query_condition_combination_op_t;
+
+/** Query aggregate. */
+typedef enum {
+/** Helper macro for defining query aggregate enums. */
+#define TILEDB_AGGREGATE_ENUM(id) TILEDB_##id
+#include "tiledb_enum.h"
+#undef TILEDB_AGGREGATE_ENUM
+} tiledb_aggregate_t;
+
 /* ****************************** */
 /*       ENUMS TO/FROM STR        */
 /* ****************************** */
@@ -517,6 +541,9 @@ typedef struct tiledb_filter_list_t tiledb_filter_list_t;
 /** A TileDB query. */
 typedef struct tiledb_query_t tiledb_query_t;
 
+/** A TileDB query condition. */
+typedef struct tiledb_query_condition_t tiledb_query_condition_t;
+
 /** A virtual filesystem object. */
 typedef struct tiledb_vfs_t tiledb_vfs_t;
 
@@ -920,6 +947,28 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  * - `sm.tile_cache_size` <br>
  *    The tile cache size in bytes. Any `uint64_t` value is acceptable. <br>
  *    **Default**: 10,000,000
+ * - `sm.tile_cache_unfiltered_size` <br>
+ *    The size in bytes of the tile cache tier that stores tiles after
+ *    they have been unfiltered (e.g. decompressed), so that the reads
+ *    hitting it skip unfiltering. `0` disables the tier. <br>
+ *    **Default**: 0
+ * - `sm.tile_cache_policy` <br>
+ *    The tile cache tiers that reads fill. `filtered` stores the tiles
+ *    only as read from disk. `unfiltered` stores the tiles that are
+ *    unfiltered whole only in the unfiltered tier, and the rest in the
+ *    filtered tier. `both` stores the tiles in both tiers. <br>
+ *    **Default**: both
+ * - `sm.tile_cache_shards` <br>
+ *    The number of shards of each tile cache tier. Each shard holds an equal
+ *    part of the tier size behind its own lock, and tiles larger than a
+ *    shard are not cached. Must be at least `1`. <br>
+ *    **Default**: 8
+ * - `sm.fragment_metadata_cache_size` <br>
+ *    The maximum memory in bytes taken by the array schemas and fragment
+ *    metadata that are retained after arrays are closed for reads, so that
+ *    opening the arrays again does not reload them. `0` disables the
+ *    retention. <br>
+ *    **Default**: 10,000,000
  * - `sm.enable_signal_handlers` <br>
  *    Determines whether or not TileDB will install signal handlers. <br>
  *    **Default**: true
@@ -975,6 +1024,12 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  *    The memory budget for tiles of var-sized attributes
  *    to be fetched during reads.<br>
  *    **Default**: 10GB
+ * - `sm.sparse_unordered_tile_window` <br>
+ *    The number of result tiles whose results are copied to the user
+ *    buffers at a time by unordered sparse reads that do not deduplicate
+ *    cells. If `0`, the results of the whole partition are computed
+ *    before being copied.<br>
+ *    **Default**: 256
  * - `vfs.num_threads` <br>
  *    The number of threads allocated for VFS operations (any backend), per VFS
  *    instance. <br>
@@ -990,6 +1045,17 @@ TILEDB_EXPORT void tiledb_config_free(tiledb_config_t** config);
  * - `vfs.min_batch_gap` <br>
  *    The minimum number of bytes between two VFS read batches.<br>
  *    **Default**: 500KB
+ * - `vfs.disk_cache_dir` <br>
+ *    A local directory where the reads from S3, Azure, GCS and HDFS are
+ *    cached across processes, keyed by object URI and byte range. Only
+ *    the files of fragments, array metadata and consolidated fragment
+ *    metadata are cached, since their names are unique. If empty, the
+ *    disk cache is disabled. <br>
+ *    **Default**: ""
+ * - `vfs.disk_cache_size` <br>
+ *    The maximum size in bytes of the disk cache, beyond which the least
+ *    recently used reads are evicted. <br>
+ *    **Default**: 10GB
  * - `vfs.file.posix_file_permissions` <br>
  *    permissions to use for posix file system with file creation.<br>
  *    **Default**: 644
@@ -2676,7 +2742,9 @@ TILEDB_EXPORT int32_t tiledb_array_schema_set_capacity(
  *
  * @param ctx The TileDB context.
  * @param array_schema The array schema.
- * @param cell_order The cell order to be set.
+ * @param cell_order The cell order to be set. `TILEDB_HILBERT` sorts the
+ *     cells of sparse arrays on the Hilbert curve that traverses the domain,
+ *     ignoring the space tiles, and is not applicable to string dimensions.
  * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
  */
 TILEDB_EXPORT int32_t tiledb_array_schema_set_cell_order(
@@ -3331,6 +3399,147 @@ TILEDB_EXPORT int32_t tiledb_query_get_buffer_var(
 TILEDB_EXPORT int32_t tiledb_query_set_layout(
     tiledb_ctx_t* ctx, tiledb_query_t* query, tiledb_layout_t layout);
 
+/**
+ * Sets the query condition to be applied on a read. Only the cells that
+ * satisfy the condition are returned in the query buffers. The condition
+ * is copied into the query, so the input object may be freed right after
+ * this call.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_condition_t* cond;
+ * tiledb_query_condition_alloc(ctx, &cond);
+ * int32_t value = 5;
+ * tiledb_query_condition_init(ctx, cond, "a", &value, sizeof(value), TILEDB_GT);
+ * tiledb_query_set_condition(ctx, query, cond);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param cond The query condition.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ *
+ * @note Query conditions are applicable only to read queries on sparse
+ *     arrays.
+ */
+TILEDB_EXPORT int32_t tiledb_query_set_condition(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const tiledb_query_condition_t* cond);
+
+/**
+ * Adds an aggregate to be computed over the cells of the query subarray
+ * (that also satisfy the query condition, if set). The aggregates are
+ * computed inside the read, without returning any cells, so the query must
+ * not have any buffers set. The query completes in a single submission,
+ * after which the aggregate values are retrieved with
+ * `tiledb_query_get_aggregate`.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_add_aggregate(ctx, query, "a", TILEDB_AGGREGATE_SUM);
+ * tiledb_query_submit(ctx, query);
+ * int64_t sum;
+ * tiledb_query_get_aggregate(ctx, query, "a", TILEDB_AGGREGATE_SUM, &sum);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param name The attribute name.
+ * @param aggregate The aggregate to compute. `TILEDB_AGGREGATE_COUNT`
+ *     applies to any attribute. The other aggregates apply only to numeric
+ *     and datetime attributes storing a single value per cell.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ *
+ * @note Aggregates are applicable only to read queries on sparse arrays.
+ */
+TILEDB_EXPORT int32_t tiledb_query_add_aggregate(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const char* name,
+    tiledb_aggregate_t aggregate);
+
+/**
+ * Retrieves the value of an aggregate added with
+ * `tiledb_query_add_aggregate`, after the query has completed. The value
+ * types are:
+ *    - `TILEDB_AGGREGATE_COUNT`: `uint64_t`
+ *    - `TILEDB_AGGREGATE_SUM`: `int64_t` for signed integer and datetime
+ *      attributes, `uint64_t` for unsigned integer attributes and `double`
+ *      for real attributes. It is an error if an integer sum overflows.
+ *    - `TILEDB_AGGREGATE_MIN`, `TILEDB_AGGREGATE_MAX`: the attribute type.
+ *      NaN values are ignored. `value` is left unchanged if the count is 0.
+ *    - `TILEDB_AGGREGATE_MEAN`: `double`, NaN if the count is 0. It is an
+ *      error if the integer sum of the values overflows.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * uint64_t count;
+ * tiledb_query_get_aggregate(ctx, query, "a", TILEDB_AGGREGATE_COUNT, &count);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param name The attribute name.
+ * @param aggregate The aggregate.
+ * @param value The aggregate value to be retrieved.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_get_aggregate(
+    tiledb_ctx_t* ctx,
+    const tiledb_query_t* query,
+    const char* name,
+    tiledb_aggregate_t aggregate,
+    void* value);
+
+/**
+ * Turns a read query into a batch of point lookups. Each point selects the
+ * cell with its coordinates, and the values of the attributes with buffers
+ * set are returned for all the points, in the input order. The points that
+ * have no cell get the fill values of the attributes, and are marked in
+ * `found`. The points are looked up together: every tile that may contain
+ * some of them is read once, regardless of the number of points.
+ *
+ * A point-lookup query must not have a subarray, query condition,
+ * aggregates or coordinate buffers set. It completes in a single
+ * submission if the buffers fit the values of all the points, and
+ * otherwise it is incomplete and returns no results.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * int32_t rows[] = {1, 4, 2};
+ * int32_t cols[] = {3, 1, 2};
+ * const void* coords[] = {rows, cols};
+ * uint8_t found[3];
+ * tiledb_query_set_point_lookups(ctx, query, coords, 3, found);
+ * tiledb_query_set_buffer(ctx, query, "a", a, &a_size);
+ * tiledb_query_submit(ctx, query);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param query The TileDB query.
+ * @param coords The point coordinates, one buffer per dimension in the
+ *     order of the array schema, each storing `point_num` coordinates.
+ *     The coordinates are copied into the query.
+ * @param point_num The number of points.
+ * @param found Set to `1` for every point that has a cell, and to `0`
+ *     otherwise. It must be able to hold `point_num` values.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ *
+ * @note Point lookups are applicable only to read queries on sparse arrays
+ *     with fixed-sized dimensions.
+ */
+TILEDB_EXPORT int32_t tiledb_query_set_point_lookups(
+    tiledb_ctx_t* ctx,
+    tiledb_query_t* query,
+    const void** coords,
+    uint64_t point_num,
+    uint8_t* found);
+
 /**
  * Flushes all internal state of a query object and finalizes the query.
  * This is applicable only to global layout writes. It has no effect for
@@ -3829,6 +4038,97 @@ TILEDB_EXPORT int32_t tiledb_query_get_fragment_timestamp_range(
     uint64_t* t1,
     uint64_t* t2);
 
+/* ********************************* */
+/*          QUERY CONDITION          */
+/* ********************************* */
+
+/**
+ * Allocates a TileDB query condition object.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_condition_t* cond;
+ * tiledb_query_condition_alloc(ctx, &cond);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param cond The allocated query condition object.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_condition_alloc(
+    tiledb_ctx_t* ctx, tiledb_query_condition_t** cond);
+
+/**
+ * Frees a TileDB query condition object.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_condition_free(&cond);
+ * @endcode
+ *
+ * @param cond The query condition object to be freed.
+ */
+TILEDB_EXPORT void tiledb_query_condition_free(tiledb_query_condition_t** cond);
+
+/**
+ * Initializes a TileDB query condition object that compares the values
+ * of an attribute against a single value.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * int32_t value = 5;
+ * tiledb_query_condition_init(ctx, cond, "a", &value, sizeof(value), TILEDB_LT);
+ *
+ * const char* str = "foo";
+ * tiledb_query_condition_init(ctx, cond2, "b", str, strlen(str), TILEDB_EQ);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param cond The allocated query condition object.
+ * @param attribute_name The name of the attribute to compare against.
+ * @param condition_value The value to compare against. For fixed-sized
+ *     attributes this must hold a single cell value. For var-sized string
+ *     attributes it holds the string characters.
+ * @param condition_value_size The byte size of `condition_value`.
+ * @param op The comparison operator.
+ * @return `TILEDB_OK` for success and `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_condition_init(
+    tiledb_ctx_t* ctx,
+    tiledb_query_condition_t* cond,
+    const char* attribute_name,
+    const void* condition_value,
+    uint64_t condition_value_size,
+    tiledb_query_condition_op_t op);
+
+/**
+ * Combines two query conditions into a newly allocated query condition.
+ * The caller is responsible for freeing the combined object.
+ *
+ * **Example:**
+ *
+ * @code{.c}
+ * tiledb_query_condition_t* combined;
+ * tiledb_query_condition_combine(ctx, cond1, cond2, TILEDB_AND, &combined);
+ * @endcode
+ *
+ * @param ctx The TileDB context.
+ * @param left_cond The first input condition.
+ * @param right_cond The second input condition.
+ * @param combination_op The combination operator.
+ * @param combined_cond The allocated, combined condition.
+ * @return `TILEDB_OK` for success and `TILEDB_OOM` or `TILEDB_ERR` for error.
+ */
+TILEDB_EXPORT int32_t tiledb_query_condition_combine(
+    tiledb_ctx_t* ctx,
+    const tiledb_query_condition_t* left_cond,
+    const tiledb_query_condition_t* right_cond,
+    tiledb_query_condition_combination_op_t combination_op,
+    tiledb_query_condition_t** combined_cond);
+
 /* ********************************* */
 /*               ARRAY               */
 /* ********************************* */
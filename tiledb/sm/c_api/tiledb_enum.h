@@ -135,6 +135,8 @@
     TILEDB_LAYOUT_ENUM(GLOBAL_ORDER) = 2,
     /** Unordered layout */
     TILEDB_LAYOUT_ENUM(UNORDERED) = 3,
+    /** Hilbert curve cell order (sparse arrays only) */
+    TILEDB_LAYOUT_ENUM(HILBERT) = 4,
 #endif
 
 #ifdef TILEDB_FILTER_TYPE_ENUM
@@ -219,3 +221,36 @@
     /** Append mode */
     TILEDB_VFS_MODE_ENUM(VFS_APPEND) = 2,
 #endif
+
+#ifdef TILEDB_QUERY_CONDITION_OP_ENUM
+    /** Less-than operator */
+    TILEDB_QUERY_CONDITION_OP_ENUM(LT) = 0,
+    /** Less-than-or-equal operator */
+    TILEDB_QUERY_CONDITION_OP_ENUM(LE) = 1,
+    /** Greater-than operator */
+    TILEDB_QUERY_CONDITION_OP_ENUM(GT) = 2,
+    /** Greater-than-or-equal operator */
+    TILEDB_QUERY_CONDITION_OP_ENUM(GE) = 3,
+    /** Equal operator */
+    TILEDB_QUERY_CONDITION_OP_ENUM(EQ) = 4,
+    /** Not-equal operator */
+    TILEDB_QUERY_CONDITION_OP_ENUM(NE) = 5,
+#endif
+
+#ifdef TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM
+    /** Logical AND of two conditions */
+    TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM(AND) = 0,
+#endif
+
+#ifdef TILEDB_AGGREGATE_ENUM
+    /** Number of cells */
+    TILEDB_AGGREGATE_ENUM(AGGREGATE_COUNT) = 0,
+    /** Sum of the cell values */
+    TILEDB_AGGREGATE_ENUM(AGGREGATE_SUM) = 1,
+    /** Minimum cell value */
+    TILEDB_AGGREGATE_ENUM(AGGREGATE_MIN) = 2,
+    /** Maximum cell value */
+    TILEDB_AGGREGATE_ENUM(AGGREGATE_MAX) = 3,
+    /** Arithmetic mean of the cell values */
+    TILEDB_AGGREGATE_ENUM(AGGREGATE_MEAN) = 4,
+#endif
@@ -43,6 +43,7 @@
 #include "tiledb/sm/filter/compression_filter.h"
 #include "tiledb/sm/filter/filter_pipeline.h"
 #include "tiledb/sm/query/query.h"
+#include "tiledb/sm/query/query_condition.h"
 #include "tiledb/sm/storage_manager/context.h"
 #include "tiledb/sm/subarray/subarray.h"
 #include "tiledb/sm/subarray/subarray_partitioner.h"
@@ -104,6 +105,10 @@ struct tiledb_query_t {
   tiledb::sm::Query* query_ = nullptr;
 };
 
+struct tiledb_query_condition_t {
+  tiledb::sm::QueryCondition* query_condition_ = nullptr;
+};
+
 struct tiledb_vfs_t {
   tiledb::sm::VFS* vfs_ = nullptr;
 };
@@ -91,6 +91,29 @@ Status BufferLRUCache::read(
   return Status::Ok();
 }
 
+Status BufferLRUCache::read(
+    const std::string& key, Buffer* const buffer, bool* const success) {
+  assert(buffer);
+  assert(success);
+  *success = false;
+
+  std::lock_guard<std::mutex> lg(lru_mtx_);
+
+  // Check if the cache contains the item at `key`.
+  if (!has_item(key))
+    return Status::Ok();
+
+  // Copy the cached buffer into the output `buffer`.
+  const Buffer* const cached_buffer = get_item(key);
+  RETURN_NOT_OK(buffer->write(cached_buffer->data(), cached_buffer->size()));
+
+  // Touch the item to make it the most recently used item.
+  touch_item(key);
+
+  *success = true;
+  return Status::Ok();
+}
+
 void BufferLRUCache::clear() {
   std::lock_guard<std::mutex> lg(lru_mtx_);
   return LRUCache<std::string, Buffer>::clear();
@@ -105,6 +105,17 @@ class BufferLRUCache : public LRUCache<std::string, Buffer> {
       uint64_t nbytes,
       bool* success);
 
+  /**
+   * Reads the whole object labeled by `key`.
+   *
+   * @param key The label of the object to be read.
+   * @param buffer The buffer that will store the data to be read.
+   * @param success `true` if the data were read from the cache and `false`
+   *     otherwise.
+   * @return Status.
+   */
+  Status read(const std::string& key, Buffer* buffer, bool* success);
+
   /** Clears the cache, deleting all cached items. */
   void clear();
 
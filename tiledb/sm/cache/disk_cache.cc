@@ -0,0 +1,396 @@
+/**
+ * @file   disk_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class DiskCache.
+ */
+
+#include "tiledb/sm/cache/disk_cache.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/filesystem/vfs.h"
+#include "tiledb/sm/misc/constants.h"
+#include "tiledb/sm/misc/uuid.h"
+#include "tiledb/sm/stats/stats.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** Suffix of the entry files that are being written. */
+const std::string tmp_suffix = ".tmp";
+
+/**
+ * Returns the 64-bit FNV-1a hash of `key`, which unlike `std::hash` is
+ * stable across processes and builds.
+ */
+uint64_t fnv1a(const std::string& key) {
+  uint64_t hash = 14695981039346656037ull;
+  for (auto c : key) {
+    hash ^= (uint8_t)c;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+/** Formats `v` as a 16-digit hexadecimal number. */
+std::string to_hex(uint64_t v) {
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << v;
+  return ss.str();
+}
+
+/**
+ * Parses the key hash and sequence number from the name of an entry file.
+ * Returns `false` if the name does not have the entry file format.
+ */
+bool parse_name(const std::string& name, uint64_t* hash, uint64_t* seq) {
+  if (name.size() < 34 || name[16] != '_' || name[33] != '_')
+    return false;
+  const char* digits = "0123456789abcdef";
+  auto is_hex = [&](size_t pos) {
+    return name.find_first_not_of(digits, pos) >= pos + 16;
+  };
+  if (!is_hex(0) || !is_hex(17))
+    return false;
+  *hash = std::stoull(name.substr(0, 16), nullptr, 16);
+  *seq = std::stoull(name.substr(17, 16), nullptr, 16);
+  return true;
+}
+
+/**
+ * Returns `true` if `name` is a fragment, consolidated fragment metadata
+ * or array metadata name, i.e. `__<...>_<uuid>[_<version>][.<suffix>]`.
+ * `versioned` is set to `true` if the name carries a format version, as
+ * the fragment names of format version 5 or higher (see
+ * `utils::parse::get_fragment_name_version`).
+ */
+bool is_unique_name(const std::string& name, bool* versioned) {
+  if (name.compare(0, 2, "__") != 0)
+    return false;
+  auto base = name.substr(0, name.find('.'));
+  std::vector<std::string> tokens;
+  std::stringstream ss(base.substr(2));
+  for (std::string token; std::getline(ss, token, '_');)
+    tokens.push_back(token);
+  for (const auto& t : tokens) {
+    if (t.size() == 32 && std::all_of(t.begin(), t.end(), [](char c) {
+          return isxdigit((unsigned char)c) != 0;
+        })) {
+      *versioned = std::count(base.begin(), base.end(), '_') == 5;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+DiskCache::DiskCache(VFS* vfs, const URI& dir, const uint64_t max_size)
+    : vfs_(vfs)
+    , dir_(dir)
+    , max_size_(max_size)
+    , size_(0)
+    , next_seq_(0) {
+}
+
+/* ********************************* */
+/*                API                */
+/* ********************************* */
+
+Status DiskCache::init() {
+  if (!dir_.is_file())
+    return LOG_STATUS(Status::VFSError(
+        "Cannot initialize disk cache; The cache directory '" +
+        dir_.to_string() + "' must be local"));
+  RETURN_NOT_OK(uuid::generate_uuid(&token_, false));
+
+  bool is_dir = false;
+  RETURN_NOT_OK(vfs_->is_dir(dir_, &is_dir));
+  if (!is_dir)
+    RETURN_NOT_OK(vfs_->create_dir(dir_));
+
+  // Collect the entries, dropping the files left over by interrupted
+  // insertions
+  std::vector<URI> uris;
+  RETURN_NOT_OK(vfs_->ls(dir_, &uris));
+  std::vector<std::pair<uint64_t, Entry>> found;
+  for (const auto& uri : uris) {
+    auto name = uri.last_path_part();
+    uint64_t hash = 0, seq = 0;
+    if (name.size() > tmp_suffix.size() &&
+        name.compare(
+            name.size() - tmp_suffix.size(), tmp_suffix.size(), tmp_suffix) ==
+            0) {
+      RETURN_NOT_OK(vfs_->remove_file(uri));
+      continue;
+    }
+    if (!parse_name(name, &hash, &seq))
+      continue;
+    std::string key;
+    if (!read_key(name, &key).ok()) {
+      RETURN_NOT_OK(vfs_->remove_file(uri));
+      continue;
+    }
+    uint64_t size = 0;
+    RETURN_NOT_OK(vfs_->file_size(uri, &size));
+    found.emplace_back(
+        seq, Entry{hash, key.substr(0, key.find('\n')), name, size});
+  }
+
+  // Adopt the entries in sequence order, keeping the latest entry of each
+  // key hash
+  std::sort(
+      found.begin(),
+      found.end(),
+      [](const std::pair<uint64_t, Entry>& a,
+         const std::pair<uint64_t, Entry>& b) { return a.first < b.first; });
+  std::unique_lock<std::mutex> lck(mtx_);
+  for (const auto& f : found) {
+    auto it = index_.find(f.second.hash_);
+    if (it != index_.end())
+      remove(it->second);
+    entries_.push_back(f.second);
+    index_[f.second.hash_] = std::prev(entries_.end());
+    size_ += f.second.size_;
+    next_seq_ = f.first + 1;
+  }
+  while (size_ > max_size_)
+    remove(entries_.begin());
+
+  return Status::Ok();
+}
+
+Status DiskCache::read(
+    const URI& uri,
+    const uint64_t offset,
+    void* const buffer,
+    const uint64_t nbytes,
+    bool* const success) {
+  assert(success);
+  *success = false;
+
+  const auto key = this->key(uri, offset, nbytes);
+  const uint64_t hash = fnv1a(key);
+  const uint64_t header_size = sizeof(uint64_t) + key.size();
+
+  // Find the entry and make it the most recently used one. An entry of
+  // a different size stores another key with the same hash, and is
+  // dropped to make room for `key`.
+  std::string name;
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    auto it = index_.find(hash);
+    if (it == index_.end() || it->second->size_ != header_size + nbytes) {
+      if (it != index_.end())
+        remove(it->second);
+      STATS_ADD_COUNTER(stats::Stats::CounterType::VFS_DISK_CACHE_MISS_NUM, 1);
+      return Status::Ok();
+    }
+    name = it->second->name_;
+    entries_.splice(entries_.end(), entries_, it->second);
+  }
+
+  // Check the key stored in the entry, which differs from `key` on hash
+  // collisions, and read the cached bytes. The entries whose files cannot
+  // be read, e.g. because another process evicted them, are dropped, and
+  // so are colliding entries, to make room for `key`.
+  const auto file_uri = entry_uri(name);
+  Buffer header;
+  RETURN_NOT_OK(header.realloc(header_size));
+  if (!vfs_->read(file_uri, 0, header.data(), header_size).ok()) {
+    remove(hash, name);
+    STATS_ADD_COUNTER(stats::Stats::CounterType::VFS_DISK_CACHE_MISS_NUM, 1);
+    return Status::Ok();
+  }
+  uint64_t key_size = 0;
+  std::memcpy(&key_size, header.data(), sizeof(uint64_t));
+  if (key_size != key.size() ||
+      std::memcmp(header.data(sizeof(uint64_t)), key.data(), key_size) != 0) {
+    remove(hash, name);
+    STATS_ADD_COUNTER(stats::Stats::CounterType::VFS_DISK_CACHE_MISS_NUM, 1);
+    return Status::Ok();
+  }
+  if (!vfs_->read(file_uri, header_size, buffer, nbytes).ok()) {
+    remove(hash, name);
+    STATS_ADD_COUNTER(stats::Stats::CounterType::VFS_DISK_CACHE_MISS_NUM, 1);
+    return Status::Ok();
+  }
+
+  STATS_ADD_COUNTER(stats::Stats::CounterType::VFS_DISK_CACHE_HIT_NUM, 1);
+  *success = true;
+  return Status::Ok();
+}
+
+Status DiskCache::insert(
+    const URI& uri,
+    const uint64_t offset,
+    const void* const buffer,
+    const uint64_t nbytes) {
+  const auto key = this->key(uri, offset, nbytes);
+  const uint64_t hash = fnv1a(key);
+  const uint64_t key_size = key.size();
+  const uint64_t size = sizeof(uint64_t) + key_size + nbytes;
+  if (size > max_size_)
+    return Status::Ok();
+
+  uint64_t seq = 0;
+  {
+    std::unique_lock<std::mutex> lck(mtx_);
+    if (index_.count(hash) != 0)
+      return Status::Ok();
+    seq = next_seq_++;
+  }
+
+  // Write the entry to a temporary file and move it in place, so that
+  // other processes never see partial entries
+  Buffer entry;
+  RETURN_NOT_OK(entry.realloc(size));
+  RETURN_NOT_OK(entry.write(&key_size, sizeof(uint64_t)));
+  RETURN_NOT_OK(entry.write(key.data(), key_size));
+  RETURN_NOT_OK(entry.write(buffer, nbytes));
+  const auto name = to_hex(hash) + "_" + to_hex(seq) + "_" + token_;
+  const auto tmp_uri = entry_uri(name + tmp_suffix);
+  Status st = vfs_->write(tmp_uri, entry.data(), size);
+  if (st.ok())
+    st = vfs_->move_file(tmp_uri, entry_uri(name));
+  if (!st.ok()) {
+    vfs_->remove_file(tmp_uri);
+    return st;
+  }
+
+  // Evict entries to make room for the new one, unless a concurrent
+  // insertion stored the same key
+  std::unique_lock<std::mutex> lck(mtx_);
+  if (index_.count(hash) != 0) {
+    vfs_->remove_file(entry_uri(name));
+    return Status::Ok();
+  }
+  while (size_ + size > max_size_)
+    remove(entries_.begin());
+  entries_.push_back(Entry{hash, uri.to_string(), name, size});
+  index_[hash] = std::prev(entries_.end());
+  size_ += size;
+
+  return Status::Ok();
+}
+
+void DiskCache::remove_prefix(const URI& uri) {
+  const auto prefix = uri.remove_trailing_slash().to_string();
+  std::unique_lock<std::mutex> lck(mtx_);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    auto entry = it++;
+    const auto& entry_uri = entry->uri_;
+    if (entry_uri.compare(0, prefix.size(), prefix) == 0 &&
+        (entry_uri.size() == prefix.size() ||
+         entry_uri[prefix.size()] == '/'))
+      remove(entry);
+  }
+}
+
+uint64_t DiskCache::size() const {
+  std::unique_lock<std::mutex> lck(mtx_);
+  return size_;
+}
+
+bool DiskCache::cacheable(const URI& uri) {
+  // The object is in a uniquely named TileDB object if one of its path
+  // parts has a unique name
+  std::stringstream ss(uri.to_string());
+  bool unique = false, versioned = false;
+  std::string part;
+  while (std::getline(ss, part, '/')) {
+    if (!unique)
+      unique = is_unique_name(part, &versioned);
+  }
+
+  // The fragment metadata of fragments without a format version in their
+  // names may be rewritten in place
+  return unique &&
+         (versioned || part != constants::fragment_metadata_filename);
+}
+
+/* ********************************* */
+/*          PRIVATE METHODS          */
+/* ********************************* */
+
+std::string DiskCache::key(
+    const URI& uri, const uint64_t offset, const uint64_t nbytes) {
+  std::stringstream ss;
+  ss << uri.to_string() << "\n" << offset << "\n" << nbytes;
+  return ss.str();
+}
+
+Status DiskCache::read_key(const std::string& name, std::string* key) const {
+  const auto file_uri = entry_uri(name);
+  uint64_t key_size = 0;
+  RETURN_NOT_OK(vfs_->read(file_uri, 0, &key_size, sizeof(uint64_t)));
+  uint64_t file_size = 0;
+  RETURN_NOT_OK(vfs_->file_size(file_uri, &file_size));
+  if (key_size > file_size - sizeof(uint64_t))
+    return Status::VFSError(
+        "Cannot read disk cache entry '" + name + "'; Invalid key size");
+  key->resize(key_size);
+  return vfs_->read(file_uri, sizeof(uint64_t), &(*key)[0], key_size);
+}
+
+void DiskCache::remove(const uint64_t hash, const std::string& name) {
+  std::unique_lock<std::mutex> lck(mtx_);
+  auto it = index_.find(hash);
+  if (it != index_.end() && it->second->name_ == name)
+    remove(it->second);
+}
+
+void DiskCache::remove(EntryIter entry) {
+  vfs_->remove_file(entry_uri(entry->name_));
+  size_ -= entry->size_;
+  index_.erase(entry->hash_);
+  entries_.erase(entry);
+}
+
+URI DiskCache::entry_uri(const std::string& name) const {
+  return dir_.join_path(name);
+}
+
+}  // namespace sm
+}  // namespace tiledb
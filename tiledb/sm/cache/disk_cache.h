@@ -0,0 +1,247 @@
+/**
+ * @file   disk_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class DiskCache.
+ */
+
+#ifndef TILEDB_DISK_CACHE_H
+#define TILEDB_DISK_CACHE_H
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/misc/macros.h"
+#include "tiledb/sm/misc/uri.h"
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class VFS;
+
+/**
+ * A least-recently used cache of byte ranges of remote objects, stored as
+ * files in a local directory so that it persists across processes. Each
+ * entry is keyed by the object URI and the byte range. The cache has no
+ * way to tell that an object changed, so it must only store objects that
+ * are never rewritten under the same URI (see `cacheable`). The maximum
+ * capacity of the cache is defined as a total byte size among all entry
+ * files.
+ *
+ * An entry file is named `<key hash>_<sequence number>_<cache token>`,
+ * where the sequence number orders the entries by insertion and the token
+ * is unique to the cache instance. The file stores the key length, the
+ * key and the cached bytes. The entries found in the directory on
+ * initialization are adopted in sequence order, so the least recently
+ * inserted ones are evicted first.
+ *
+ * Each cache instance enforces the capacity over the entries it knows of,
+ * i.e. the ones found on initialization and the ones it inserted.
+ *
+ * This class is thread-safe.
+ */
+class DiskCache {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param vfs The VFS used to access the cache directory.
+   * @param dir The local cache directory.
+   * @param max_size The maximum cache byte size.
+   */
+  DiskCache(VFS* vfs, const URI& dir, uint64_t max_size);
+
+  /** Destructor. */
+  ~DiskCache() = default;
+
+  DISABLE_COPY_AND_COPY_ASSIGN(DiskCache);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(DiskCache);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Initializes the cache, creating the cache directory if it does not
+   * exist and adopting the entries it stores.
+   *
+   * @return Status
+   */
+  Status init();
+
+  /**
+   * Reads the byte range `[offset, offset + nbytes)` of the object at `uri`
+   * from the cache.
+   *
+   * @param uri The object URI.
+   * @param offset The offset where the read will start.
+   * @param buffer The buffer that will store the data to be read.
+   * @param nbytes The number of bytes to be read.
+   * @param success `true` if the data were read from the cache and `false`
+   *     otherwise.
+   * @return Status
+   */
+  Status read(
+      const URI& uri,
+      uint64_t offset,
+      void* buffer,
+      uint64_t nbytes,
+      bool* success);
+
+  /**
+   * Stores the byte range `[offset, offset + nbytes)` of the object at `uri`
+   * in the cache, evicting the least recently used entries to make room for
+   * it. Ranges larger than the cache are not stored.
+   *
+   * @param uri The object URI.
+   * @param offset The offset of the range in the object.
+   * @param buffer The range bytes.
+   * @param nbytes The number of bytes in the range.
+   * @return Status
+   */
+  Status insert(
+      const URI& uri, uint64_t offset, const void* buffer, uint64_t nbytes);
+
+  /**
+   * Removes the entries of the object at `uri` and of the objects under
+   * it, after they were modified, moved or removed.
+   *
+   * @param uri The URI of an object or of a directory prefix.
+   */
+  void remove_prefix(const URI& uri);
+
+  /** Returns the total byte size of the entry files. */
+  uint64_t size() const;
+
+  /**
+   * Returns `true` if the object at `uri` can be cached, i.e. if it lies
+   * in a fragment, consolidated fragment metadata file or array metadata
+   * file whose name is unique, since it embeds a UUID. Objects with fixed
+   * names, such as array schemas, lock files and the fragment metadata of
+   * fragments written before format version 5, may be rewritten in place
+   * and are not cached.
+   */
+  static bool cacheable(const URI& uri);
+
+ private:
+  /* ********************************* */
+  /*      PRIVATE DATA STRUCTURES      */
+  /* ********************************* */
+
+  /** A cache entry. */
+  struct Entry {
+    /** The key hash. */
+    uint64_t hash_;
+
+    /** The URI of the cached object. */
+    std::string uri_;
+
+    /** The name of the entry file. */
+    std::string name_;
+
+    /** The byte size of the entry file. */
+    uint64_t size_;
+  };
+
+  /** An iterator to an entry. */
+  typedef std::list<Entry>::iterator EntryIter;
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The VFS used to access the cache directory. */
+  VFS* vfs_;
+
+  /** The cache directory. */
+  URI dir_;
+
+  /** The maximum cache byte size. */
+  const uint64_t max_size_;
+
+  /** The current cache byte size. */
+  uint64_t size_;
+
+  /** The sequence number of the next inserted entry. */
+  uint64_t next_seq_;
+
+  /** The token that makes the names of the entry files of this cache unique. */
+  std::string token_;
+
+  /**
+   * The entries, in least-recently used order. The head of the list is the
+   * next entry to be evicted.
+   */
+  std::list<Entry> entries_;
+
+  /** Maps a key hash to its entry. */
+  std::unordered_map<uint64_t, EntryIter> index_;
+
+  /** Protects the entries. */
+  mutable std::mutex mtx_;
+
+  /* ********************************* */
+  /*         PRIVATE METHODS           */
+  /* ********************************* */
+
+  /** Returns the key of a byte range of the object at `uri`. */
+  static std::string key(const URI& uri, uint64_t offset, uint64_t nbytes);
+
+  /**
+   * Reads the key stored at the start of the entry file with the input
+   * name.
+   */
+  Status read_key(const std::string& name, std::string* key) const;
+
+  /**
+   * Removes the input entry and its file, if it still is the entry of
+   * `hash` named `name`. Used to drop entries whose files cannot be read
+   * and entries whose keys collide with the key of a read.
+   */
+  void remove(uint64_t hash, const std::string& name);
+
+  /** Removes the input entry and its file. The mutex must be held. */
+  void remove(EntryIter entry);
+
+  /** Returns the URI of the entry file with the input name. */
+  URI entry_uri(const std::string& name) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_DISK_CACHE_H
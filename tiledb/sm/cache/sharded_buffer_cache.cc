@@ -0,0 +1,336 @@
+/**
+ * @file   sharded_buffer_cache.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class ShardedBufferCache.
+ */
+
+#include "tiledb/sm/cache/sharded_buffer_cache.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/stats/stats.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/* ********************************* */
+/*               SHARD               */
+/* ********************************* */
+
+/** A segmented LRU, guarded by its own mutex. */
+class ShardedBufferCache::Shard {
+ public:
+  /** Constructor. */
+  Shard(
+      uint64_t max_size,
+      uint64_t protected_max_size,
+      stats::Stats::CacheShardCounters* counters)
+      : max_size_(max_size)
+      , protected_max_size_(protected_max_size)
+      , size_(0)
+      , protected_size_(0)
+      , counters_(counters) {
+  }
+
+  DISABLE_COPY_AND_COPY_ASSIGN(Shard);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(Shard);
+
+  /** See `ShardedBufferCache::insert`. */
+  Status insert(const std::string& key, Buffer&& buffer, bool overwrite) {
+    const uint64_t size = buffer.alloced_size();
+    if (size > max_size_)
+      return Status::Ok();
+
+    std::lock_guard<std::mutex> lg(mtx_);
+    auto it = items_.find(key);
+    if (it != items_.end()) {
+      if (!overwrite)
+        return Status::Ok();
+      remove(it->second);
+    }
+
+    while (size_ + size > max_size_) {
+      remove(probation_.empty() ? protected_.begin() : probation_.begin());
+      STATS_ADD_CACHE_COUNTER(counters_->evictions_, 1);
+    }
+
+    probation_.emplace_back(key, std::move(buffer), size);
+    items_[key] = std::prev(probation_.end());
+    size_ += size;
+
+    return Status::Ok();
+  }
+
+  /**
+   * Copies `nbytes` bytes of the object labeled by `key`, starting at
+   * `offset`, into `buffer`. If `nbytes` is `UINT64_MAX` the object is
+   * copied whole.
+   */
+  Status read(
+      const std::string& key,
+      Buffer* buffer,
+      uint64_t offset,
+      uint64_t nbytes,
+      bool* success) {
+    assert(buffer);
+    assert(success);
+    *success = false;
+
+    std::lock_guard<std::mutex> lg(mtx_);
+    auto it = items_.find(key);
+    if (it == items_.end()) {
+      STATS_ADD_CACHE_COUNTER(counters_->misses_, 1);
+      return Status::Ok();
+    }
+
+    // Check the bounds of the read.
+    const Buffer& cached_buffer = it->second->buffer_;
+    if (nbytes == UINT64_MAX)
+      nbytes = cached_buffer.size() - offset;
+    if (cached_buffer.size() < offset + nbytes) {
+      return LOG_STATUS(Status::LRUCacheError(
+          "Failed to read item; Byte range out of bounds"));
+    }
+
+    RETURN_NOT_OK(buffer->write(cached_buffer.data(offset), nbytes));
+    STATS_ADD_CACHE_COUNTER(counters_->hits_, 1);
+    touch(it->second);
+
+    *success = true;
+    return Status::Ok();
+  }
+
+  /** See `ShardedBufferCache::clear`. */
+  void clear() {
+    std::lock_guard<std::mutex> lg(mtx_);
+    items_.clear();
+    probation_.clear();
+    protected_.clear();
+    size_ = 0;
+    protected_size_ = 0;
+  }
+
+  /** See `ShardedBufferCache::invalidate`. */
+  void invalidate(const std::string& key, bool* success) {
+    std::lock_guard<std::mutex> lg(mtx_);
+    auto it = items_.find(key);
+    *success = it != items_.end();
+    if (*success)
+      remove(it->second);
+  }
+
+  /** Returns the total byte size of the cached objects. */
+  uint64_t size() const {
+    std::lock_guard<std::mutex> lg(mtx_);
+    return size_;
+  }
+
+ private:
+  /** A cached object. */
+  struct Item {
+    /** Constructor. */
+    Item(const std::string& key, Buffer&& buffer, uint64_t size)
+        : key_(key)
+        , buffer_(std::move(buffer))
+        , size_(size)
+        , protected_(false) {
+    }
+
+    /** The key that maps to the object. */
+    std::string key_;
+
+    /** The object. */
+    Buffer buffer_;
+
+    /** The allocated object size. */
+    uint64_t size_;
+
+    /** `true` if the item is in the protected segment. */
+    bool protected_;
+  };
+
+  /** An iterator to an item of either segment. */
+  typedef std::list<Item>::iterator ItemIter;
+
+  /** The maximum byte size of the shard. */
+  const uint64_t max_size_;
+
+  /** The maximum byte size of the protected segment. */
+  const uint64_t protected_max_size_;
+
+  /** The current byte size of the shard. */
+  uint64_t size_;
+
+  /** The current byte size of the protected segment. */
+  uint64_t protected_size_;
+
+  /**
+   * The probationary segment. The head of the list is the next item to be
+   * evicted.
+   */
+  std::list<Item> probation_;
+
+  /**
+   * The protected segment. The head of the list is the next item to be
+   * demoted to the probationary segment.
+   */
+  std::list<Item> protected_;
+
+  /** Maps a key to its item in either segment. */
+  std::unordered_map<std::string, ItemIter> items_;
+
+  /** The stats counters of the shard. */
+  stats::Stats::CacheShardCounters* counters_;
+
+  /** Protects the shard. */
+  mutable std::mutex mtx_;
+
+  /** Removes the input item from the shard. */
+  void remove(ItemIter item) {
+    size_ -= item->size_;
+    items_.erase(item->key_);
+    if (item->protected_) {
+      protected_size_ -= item->size_;
+      protected_.erase(item);
+    } else {
+      probation_.erase(item);
+    }
+  }
+
+  /**
+   * Makes the input item the most recently used one of the protected
+   * segment, demoting the least recently used protected items if the
+   * segment overflows.
+   */
+  void touch(ItemIter item) {
+    if (item->protected_) {
+      protected_.splice(protected_.end(), protected_, item);
+    } else {
+      item->protected_ = true;
+      protected_size_ += item->size_;
+      protected_.splice(protected_.end(), probation_, item);
+    }
+
+    while (protected_size_ > protected_max_size_) {
+      auto demoted = protected_.begin();
+      demoted->protected_ = false;
+      protected_size_ -= demoted->size_;
+      probation_.splice(probation_.end(), protected_, demoted);
+    }
+  }
+};
+
+/* ********************************* */
+/*     CONSTRUCTORS & DESTRUCTORS    */
+/* ********************************* */
+
+ShardedBufferCache::ShardedBufferCache(
+    const std::string& name,
+    const uint64_t max_size,
+    const unsigned shard_num,
+    const double protected_ratio) {
+  const unsigned num = std::max(shard_num, 1u);
+  const uint64_t shard_max_size = max_size / num;
+  const auto protected_max_size =
+      static_cast<uint64_t>(shard_max_size * protected_ratio);
+  for (unsigned i = 0; i < num; ++i) {
+    shards_.emplace_back(new Shard(
+        shard_max_size,
+        protected_max_size,
+        stats::all_stats.cache_shard_counters(name, i)));
+  }
+}
+
+ShardedBufferCache::~ShardedBufferCache() = default;
+
+/* ********************************* */
+/*                API                */
+/* ********************************* */
+
+Status ShardedBufferCache::insert(
+    const std::string& key, Buffer&& buffer, const bool overwrite) {
+  return shard(key)->insert(key, std::move(buffer), overwrite);
+}
+
+Status ShardedBufferCache::read(
+    const std::string& key,
+    Buffer* const buffer,
+    const uint64_t offset,
+    const uint64_t nbytes,
+    bool* const success) {
+  return shard(key)->read(key, buffer, offset, nbytes, success);
+}
+
+Status ShardedBufferCache::read(
+    const std::string& key, Buffer* const buffer, bool* const success) {
+  return shard(key)->read(key, buffer, 0, UINT64_MAX, success);
+}
+
+void ShardedBufferCache::clear() {
+  for (auto& shard : shards_)
+    shard->clear();
+}
+
+Status ShardedBufferCache::invalidate(const std::string& key, bool* success) {
+  assert(success);
+  shard(key)->invalidate(key, success);
+  return Status::Ok();
+}
+
+unsigned ShardedBufferCache::shard_num() const {
+  return static_cast<unsigned>(shards_.size());
+}
+
+uint64_t ShardedBufferCache::size() const {
+  uint64_t size = 0;
+  for (const auto& shard : shards_)
+    size += shard->size();
+  return size;
+}
+
+/* ********************************* */
+/*          PRIVATE METHODS          */
+/* ********************************* */
+
+ShardedBufferCache::Shard* ShardedBufferCache::shard(
+    const std::string& key) const {
+  return shards_[std::hash<std::string>()(key) % shards_.size()].get();
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,190 @@
+/**
+ * @file   sharded_buffer_cache.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class ShardedBufferCache.
+ */
+
+#ifndef TILEDB_SHARDED_BUFFER_CACHE_H
+#define TILEDB_SHARDED_BUFFER_CACHE_H
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/misc/macros.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class Buffer;
+
+/**
+ * A cache for `Buffer` objects mapped by a `std::string` key, whose
+ * maximum capacity is a total allocated byte size among all `Buffer`
+ * objects.
+ *
+ * The cache is split into shards by key hash, each holding an equal part
+ * of the capacity behind its own lock, so that concurrent readers of
+ * different keys rarely contend.
+ *
+ * Each shard is a segmented LRU. New objects enter a probationary segment
+ * and are promoted to a protected segment, which holds up to
+ * `protected_ratio` of the shard capacity, when they are read again. The
+ * least recently used protected objects are demoted back to probation,
+ * and evictions take the least recently used probationary objects first.
+ * Hence a scan that reads many objects once only evicts other
+ * probationary objects, and not the objects that were read repeatedly.
+ *
+ * The hits, misses and evictions of each shard are reported in the stats
+ * under the cache name, when the stats are enabled.
+ *
+ * This class is thread-safe.
+ */
+class ShardedBufferCache {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param name The cache name in the stats.
+   * @param max_size The maximum cache byte size.
+   * @param shard_num The number of shards. It is at least 1.
+   * @param protected_ratio The fraction of the capacity of each shard
+   *     held by its protected segment.
+   */
+  ShardedBufferCache(
+      const std::string& name,
+      uint64_t max_size,
+      unsigned shard_num,
+      double protected_ratio = 0.8);
+
+  /** Destructor. */
+  ~ShardedBufferCache();
+
+  DISABLE_COPY_AND_COPY_ASSIGN(ShardedBufferCache);
+  DISABLE_MOVE_AND_MOVE_ASSIGN(ShardedBufferCache);
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Inserts an object with a given key into the cache. Note that the
+   * cache *owns* the object after insertion. Objects larger than a shard
+   * are not cached.
+   *
+   * @param key The key that describes the inserted object.
+   * @param buffer The buffer to store.
+   * @param overwrite If `true`, if the object exists in the cache it will be
+   *     overwritten. Otherwise, the new object will be deleted.
+   * @return Status
+   */
+  Status insert(const std::string& key, Buffer&& buffer, bool overwrite = true);
+
+  /**
+   * Reads a portion of the object labeled by `key`.
+   *
+   * @param key The label of the object to be read.
+   * @param buffer The buffer that will store the data to be read.
+   * @param offset The offset where the read will start.
+   * @param nbytes The number of bytes to be read.
+   * @param success `true` if the data were read from the cache and `false`
+   *     otherwise.
+   * @return Status.
+   */
+  Status read(
+      const std::string& key,
+      Buffer* buffer,
+      uint64_t offset,
+      uint64_t nbytes,
+      bool* success);
+
+  /**
+   * Reads the whole object labeled by `key`.
+   *
+   * @param key The label of the object to be read.
+   * @param buffer The buffer that will store the data to be read.
+   * @param success `true` if the data were read from the cache and `false`
+   *     otherwise.
+   * @return Status.
+   */
+  Status read(const std::string& key, Buffer* buffer, bool* success);
+
+  /** Clears the cache, deleting all cached items. */
+  void clear();
+
+  /**
+   * Invalidates and evicts the object in the cache with the given key.
+   *
+   * @param key The key that describes the object to be invalidated.
+   * @param success Set to `true` if the object was removed successfully; if
+   *    the object did not exist in the cache, set to `false`.
+   * @return Status
+   */
+  Status invalidate(const std::string& key, bool* success);
+
+  /** Returns the number of shards. */
+  unsigned shard_num() const;
+
+  /** Returns the total byte size of the cached objects. */
+  uint64_t size() const;
+
+ private:
+  /* ********************************* */
+  /*      PRIVATE DATA STRUCTURES      */
+  /* ********************************* */
+
+  /** A shard of the cache, defined in the source file. */
+  class Shard;
+
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The shards. */
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  /* ********************************* */
+  /*         PRIVATE METHODS           */
+  /* ********************************* */
+
+  /** Returns the shard storing the object with the input key. */
+  Shard* shard(const std::string& key) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_SHARDED_BUFFER_CACHE_H
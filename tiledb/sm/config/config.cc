@@ -59,9 +59,14 @@ const std::string Config::SM_CHECK_COORD_DUPS = "true";
 const std::string Config::SM_CHECK_COORD_OOB = "true";
 const std::string Config::SM_CHECK_GLOBAL_ORDER = "true";
 const std::string Config::SM_TILE_CACHE_SIZE = "10000000";
+const std::string Config::SM_TILE_CACHE_UNFILTERED_SIZE = "0";
+const std::string Config::SM_TILE_CACHE_POLICY = "both";
+const std::string Config::SM_TILE_CACHE_SHARDS = "8";
+const std::string Config::SM_FRAGMENT_METADATA_CACHE_SIZE = "10000000";
 const std::string Config::SM_MEMORY_BUDGET = "5368709120";       // 5GB
 const std::string Config::SM_MEMORY_BUDGET_VAR = "10737418240";  // 10GB;
 const std::string Config::SM_SUB_PARTITIONER_MEMORY_BUDGET = "0";
+const std::string Config::SM_SPARSE_UNORDERED_TILE_WINDOW = "256";
 const std::string Config::SM_ENABLE_SIGNAL_HANDLERS = "true";
 const std::string Config::SM_COMPUTE_CONCURRENCY_LEVEL =
     utils::parse::to_str(std::thread::hardware_concurrency());
@@ -92,6 +97,8 @@ const std::string Config::VFS_FILE_MAX_PARALLEL_OPS =
 const std::string Config::VFS_FILE_ENABLE_FILELOCKS = "true";
 const std::string Config::VFS_READ_AHEAD_SIZE = "102400";          // 100KiB
 const std::string Config::VFS_READ_AHEAD_CACHE_SIZE = "10485760";  // 10MiB;
+const std::string Config::VFS_DISK_CACHE_DIR = "";
+const std::string Config::VFS_DISK_CACHE_SIZE = "10737418240";  // 10GiB
 const std::string Config::VFS_AZURE_STORAGE_ACCOUNT_NAME = "";
 const std::string Config::VFS_AZURE_STORAGE_ACCOUNT_KEY = "";
 const std::string Config::VFS_AZURE_BLOB_ENDPOINT = "";
@@ -168,10 +175,18 @@ Config::Config() {
   param_values_["sm.check_coord_oob"] = SM_CHECK_COORD_OOB;
   param_values_["sm.check_global_order"] = SM_CHECK_GLOBAL_ORDER;
   param_values_["sm.tile_cache_size"] = SM_TILE_CACHE_SIZE;
+  param_values_["sm.tile_cache_unfiltered_size"] =
+      SM_TILE_CACHE_UNFILTERED_SIZE;
+  param_values_["sm.tile_cache_policy"] = SM_TILE_CACHE_POLICY;
+  param_values_["sm.tile_cache_shards"] = SM_TILE_CACHE_SHARDS;
+  param_values_["sm.fragment_metadata_cache_size"] =
+      SM_FRAGMENT_METADATA_CACHE_SIZE;
   param_values_["sm.memory_budget"] = SM_MEMORY_BUDGET;
   param_values_["sm.memory_budget_var"] = SM_MEMORY_BUDGET_VAR;
   param_values_["sm.sub_partitioner_memory_budget"] =
       SM_SUB_PARTITIONER_MEMORY_BUDGET;
+  param_values_["sm.sparse_unordered_tile_window"] =
+      SM_SPARSE_UNORDERED_TILE_WINDOW;
   param_values_["sm.enable_signal_handlers"] = SM_ENABLE_SIGNAL_HANDLERS;
   param_values_["sm.compute_concurrency_level"] = SM_COMPUTE_CONCURRENCY_LEVEL;
   param_values_["sm.io_concurrency_level"] = SM_IO_CONCURRENCY_LEVEL;
@@ -194,6 +209,8 @@ Config::Config() {
   param_values_["vfs.min_batch_size"] = VFS_MIN_BATCH_SIZE;
   param_values_["vfs.read_ahead_size"] = VFS_READ_AHEAD_SIZE;
   param_values_["vfs.read_ahead_cache_size"] = VFS_READ_AHEAD_CACHE_SIZE;
+  param_values_["vfs.disk_cache_dir"] = VFS_DISK_CACHE_DIR;
+  param_values_["vfs.disk_cache_size"] = VFS_DISK_CACHE_SIZE;
   param_values_["vfs.file.posix_file_permissions"] =
       VFS_FILE_POSIX_FILE_PERMISSIONS;
   param_values_["vfs.file.posix_directory_permissions"] =
@@ -385,6 +402,16 @@ Status Config::unset(const std::string& param) {
     param_values_["sm.check_global_order"] = SM_CHECK_GLOBAL_ORDER;
   } else if (param == "sm.tile_cache_size") {
     param_values_["sm.tile_cache_size"] = SM_TILE_CACHE_SIZE;
+  } else if (param == "sm.tile_cache_unfiltered_size") {
+    param_values_["sm.tile_cache_unfiltered_size"] =
+        SM_TILE_CACHE_UNFILTERED_SIZE;
+  } else if (param == "sm.tile_cache_policy") {
+    param_values_["sm.tile_cache_policy"] = SM_TILE_CACHE_POLICY;
+  } else if (param == "sm.tile_cache_shards") {
+    param_values_["sm.tile_cache_shards"] = SM_TILE_CACHE_SHARDS;
+  } else if (param == "sm.fragment_metadata_cache_size") {
+    param_values_["sm.fragment_metadata_cache_size"] =
+        SM_FRAGMENT_METADATA_CACHE_SIZE;
   } else if (param == "sm.memory_budget") {
     param_values_["sm.memory_budget"] = SM_MEMORY_BUDGET;
   } else if (param == "sm.memory_budget_var") {
@@ -392,6 +419,9 @@ Status Config::unset(const std::string& param) {
   } else if (param == "sm.memory_budget") {
     param_values_["sm.sub_partitioner_memory_budget"] =
         SM_SUB_PARTITIONER_MEMORY_BUDGET;
+  } else if (param == "sm.sparse_unordered_tile_window") {
+    param_values_["sm.sparse_unordered_tile_window"] =
+        SM_SPARSE_UNORDERED_TILE_WINDOW;
   } else if (param == "sm.enable_signal_handlers") {
     param_values_["sm.enable_signal_handlers"] = SM_ENABLE_SIGNAL_HANDLERS;
   } else if (param == "sm.compute_concurrency_level") {
@@ -432,6 +462,10 @@ Status Config::unset(const std::string& param) {
     param_values_["vfs.read_ahead_size"] = VFS_READ_AHEAD_SIZE;
   } else if (param == "vfs.read_ahead_cache_size") {
     param_values_["vfs.read_ahead_cache_size"] = VFS_READ_AHEAD_CACHE_SIZE;
+  } else if (param == "vfs.disk_cache_dir") {
+    param_values_["vfs.disk_cache_dir"] = VFS_DISK_CACHE_DIR;
+  } else if (param == "vfs.disk_cache_size") {
+    param_values_["vfs.disk_cache_size"] = VFS_DISK_CACHE_SIZE;
   } else if (param == "vfs.file.posix_file_permissions") {
     param_values_["vfs.file.posix_file_permissions"] =
         VFS_FILE_POSIX_FILE_PERMISSIONS;
@@ -568,12 +602,20 @@ Status Config::sanity_check(
     RETURN_NOT_OK(utils::parse::convert(value, &v));
   } else if (param == "sm.tile_cache_size") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.tile_cache_unfiltered_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.tile_cache_shards") {
+    RETURN_NOT_OK(utils::parse::convert(value, &v32));
+  } else if (param == "sm.fragment_metadata_cache_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "sm.memory_budget") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "sm.memory_budget_var") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "sm.sub_partitioner_memory_budget") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "sm.sparse_unordered_tile_window") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "sm.enable_signal_handlers") {
     RETURN_NOT_OK(utils::parse::convert(value, &v));
   } else if (param == "sm.compute_concurrency_level") {
@@ -604,6 +646,8 @@ Status Config::sanity_check(
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "vfs.read_ahead_cache_size") {
     RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
+  } else if (param == "vfs.disk_cache_size") {
+    RETURN_NOT_OK(utils::parse::convert(value, &vuint64));
   } else if (param == "vfs.file.posix_file_permissions") {
     RETURN_NOT_OK(utils::parse::convert(value, &v32));
   } else if (param == "vfs.file.posix_directory_permissions") {
@@ -95,6 +95,30 @@ class Config {
   /** The tile cache size. */
   static const std::string SM_TILE_CACHE_SIZE;
 
+  /** The size of the tile cache tier that stores unfiltered tiles. */
+  static const std::string SM_TILE_CACHE_UNFILTERED_SIZE;
+
+  /**
+   * The tile cache tiers that reads fill. It can be one of:
+   *     - "filtered": only the tier storing the tiles as read from disk
+   *     - "unfiltered": the unfiltered tier for the tiles that are unfiltered
+   *       whole, and the filtered tier for the rest
+   *     - "both": both tiers
+   */
+  static const std::string SM_TILE_CACHE_POLICY;
+
+  /**
+   * The number of shards of each tile cache tier. Each shard holds an equal
+   * part of the tier capacity behind its own lock.
+   */
+  static const std::string SM_TILE_CACHE_SHARDS;
+
+  /**
+   * The maximum memory (in bytes) taken by the array schemas and fragment
+   * metadata that are retained after arrays are closed for reads.
+   */
+  static const std::string SM_FRAGMENT_METADATA_CACHE_SIZE;
+
   /**
    * The maximum memory budget for producing the result (in bytes)
    * for a fixed-sized attribute or the offsets of a var-sized attribute.
@@ -117,6 +141,13 @@ class Config {
    */
   static const std::string SM_SUB_PARTITIONER_MEMORY_BUDGET;
 
+  /**
+   * The number of result tiles whose results are copied to the user buffers
+   * at a time by unordered sparse reads that need no deduplication. If `0`,
+   * the results of the whole partition are computed before being copied.
+   */
+  static const std::string SM_SPARSE_UNORDERED_TILE_WINDOW;
+
   /** Whether or not the signal handlers are installed. */
   static const std::string SM_ENABLE_SIGNAL_HANDLERS;
 
@@ -208,6 +239,15 @@ class Config {
   /** The maximum size (in bytes) of the VFS read-ahead cache . */
   static const std::string VFS_READ_AHEAD_CACHE_SIZE;
 
+  /**
+   * The local directory of the disk cache of remote reads. If empty, the
+   * disk cache is disabled.
+   */
+  static const std::string VFS_DISK_CACHE_DIR;
+
+  /** The maximum size (in bytes) of the disk cache of remote reads. */
+  static const std::string VFS_DISK_CACHE_SIZE;
+
   /** Azure storage account name. */
   static const std::string VFS_AZURE_STORAGE_ACCOUNT_NAME;
 
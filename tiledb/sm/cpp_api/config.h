@@ -240,14 +240,32 @@ class Config {
    * - `sm.tile_cache_size` <br>
    *    The tile cache size in bytes. Any `uint64_t` value is acceptable. <br>
    *    **Default**: 10,000,000
+   * - `sm.tile_cache_unfiltered_size` <br>
+   *    The size in bytes of the tile cache tier that stores tiles after
+   *    they have been unfiltered (e.g. decompressed), so that the reads
+   *    hitting it skip unfiltering. `0` disables the tier. <br>
+   *    **Default**: 0
+   * - `sm.tile_cache_policy` <br>
+   *    The tile cache tiers that reads fill. `filtered` stores the tiles
+   *    only as read from disk. `unfiltered` stores the tiles that are
+   *    unfiltered whole only in the unfiltered tier, and the rest in the
+   *    filtered tier. `both` stores the tiles in both tiers. <br>
+   *    **Default**: both
+   * - `sm.tile_cache_shards` <br>
+   *    The number of shards of each tile cache tier. Each shard holds an equal
+   *    part of the tier size behind its own lock, and tiles larger than a
+   *    shard are not cached. Must be at least `1`. <br>
+   *    **Default**: 8
+   * - `sm.fragment_metadata_cache_size` <br>
+   *    The maximum memory in bytes taken by the array schemas and fragment
+   *    metadata that are retained after arrays are closed for reads, so that
+   *    opening the arrays again does not reload them. `0` disables the
+   *    retention. <br>
+   *    **Default**: 10,000,000
    * - `sm.array_schema_cache_size` <br>
    *    Array schema cache size in bytes. Any `uint64_t` value is acceptable.
    * <br>
    *    **Default**: 10,000,000
-   * - `sm.fragment_metadata_cache_size` <br>
-   *    The fragment metadata cache size in bytes. Any `uint64_t` value is
-   *    acceptable. <br>
-   *    **Default**: 10,000,000
    * - `sm.enable_signal_handlers` <br>
    *    Whether or not TileDB will install signal handlers. <br>
    *    **Default**: true
@@ -304,6 +322,12 @@ class Config {
    *    The memory budget for tiles of var-sized attributes
    *    to be fetched during reads.<br>
    *    **Default**: 10GB
+   * - `sm.sparse_unordered_tile_window` <br>
+   *    The number of result tiles whose results are copied to the user
+   *    buffers at a time by unordered sparse reads that do not deduplicate
+   *    cells. If `0`, the results of the whole partition are computed
+   *    before being copied.<br>
+   *    **Default**: 256
    * - `vfs.num_threads` <br>
    *    The number of threads allocated for VFS operations (any backend), per
    *    VFS instance. <br>
@@ -319,6 +343,17 @@ class Config {
    * - `vfs.min_batch_gap` <br>
    *    The minimum number of bytes between two VFS read batches.<br>
    *    **Default**: 500KB
+   * - `vfs.disk_cache_dir` <br>
+   *    A local directory where the reads from S3, Azure, GCS and HDFS are
+   *    cached across processes, keyed by object URI and byte range. Only
+   *    the files of fragments, array metadata and consolidated fragment
+   *    metadata are cached, since their names are unique. If empty, the
+   *    disk cache is disabled. <br>
+   *    **Default**: ""
+   * - `vfs.disk_cache_size` <br>
+   *    The maximum size in bytes of the disk cache, beyond which the least
+   *    recently used reads are evicted. <br>
+   *    **Default**: 10GB
    * - `vfs.file.posix_file_permissions` <br>
    *    permissions to use for posix file system with file or dir creation.<br>
    *    **Default**: 644
@@ -78,6 +78,10 @@ class Deleter {
     tiledb_query_free(&p);
   }
 
+  void operator()(tiledb_query_condition_t* p) const {
+    tiledb_query_condition_free(&p);
+  }
+
   void operator()(tiledb_array_schema_t* p) const {
     tiledb_array_schema_free(&p);
   }
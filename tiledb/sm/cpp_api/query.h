@@ -41,6 +41,7 @@
 #include "core_interface.h"
 #include "deleter.h"
 #include "exception.h"
+#include "query_condition.h"
 #include "tiledb.h"
 #include "type.h"
 #include "utils.h"
@@ -224,6 +225,157 @@ class Query {
     return *this;
   }
 
+  /**
+   * Sets the query condition used to filter the read results. Only the
+   * cells whose attribute values satisfy the condition are returned.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::QueryCondition cond(ctx);
+   * int32_t value = 5;
+   * cond.init("a", &value, sizeof(int32_t), TILEDB_GT);
+   * query.set_condition(cond);
+   * @endcode
+   *
+   * @param condition The query condition object.
+   * @return Reference to this Query
+   */
+  Query& set_condition(const QueryCondition& condition) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_set_condition(
+        ctx.ptr().get(), query_.get(), condition.ptr().get()));
+    return *this;
+  }
+
+  /**
+   * Adds an aggregate to be computed over the cells of the query subarray.
+   * A query with aggregates does not return any cells, so it must not have
+   * any buffers set. The query completes in a single submission.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * query.add_aggregate("a", TILEDB_AGGREGATE_SUM);
+   * query.submit();
+   * int64_t sum = query.aggregate<int64_t>("a", TILEDB_AGGREGATE_SUM);
+   * @endcode
+   *
+   * @param name The attribute name.
+   * @param op The aggregate to compute.
+   * @return Reference to this Query
+   *
+   * @note Aggregates are applicable only to read queries on sparse arrays.
+   */
+  Query& add_aggregate(const std::string& name, tiledb_aggregate_t op) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_add_aggregate(
+        ctx.ptr().get(), query_.get(), name.c_str(), op));
+    return *this;
+  }
+
+  /**
+   * Retrieves the value of an aggregate of a completed query. See
+   * `tiledb_query_get_aggregate` for the value types.
+   *
+   * @tparam T The aggregate value type.
+   * @param name The attribute name.
+   * @param op The aggregate.
+   * @return The aggregate value.
+   */
+  template <typename T>
+  T aggregate(const std::string& name, tiledb_aggregate_t op) const {
+    uint64_t value_size = sizeof(uint64_t);
+    if (op == TILEDB_AGGREGATE_MIN || op == TILEDB_AGGREGATE_MAX)
+      value_size = tiledb_datatype_size(schema_.attribute(name).type());
+    if (sizeof(T) != value_size)
+      throw TileDBError(
+          "Cannot get aggregate; Value type does not match the aggregate");
+
+    auto& ctx = ctx_.get();
+    T value = T();
+    ctx.handle_error(tiledb_query_get_aggregate(
+        ctx.ptr().get(), query_.get(), name.c_str(), op, &value));
+    return value;
+  }
+
+  /**
+   * Turns a read query into a batch of point lookups. The values of the
+   * attributes with buffers set are returned for all the points, in the
+   * input order, and the points that have no cell get the fill values.
+   * See `tiledb_query_set_point_lookups`.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * std::vector<int32_t> rows = {1, 4, 2}, cols = {3, 1, 2};
+   * std::vector<uint8_t> found;
+   * std::vector<int32_t> a(3);
+   * query.set_point_lookups<int32_t>({rows, cols}, found)
+   *     .set_buffer("a", a);
+   * query.submit();
+   * @endcode
+   *
+   * @tparam T The dimension type. All the dimensions must have this type.
+   * @param coords The point coordinates, one vector per dimension in the
+   *     order of the array schema. All the vectors must have the same size.
+   * @param found Resized to the number of points, and set to `1` for every
+   *     point that has a cell, and to `0` otherwise.
+   * @return Reference to this Query
+   */
+  template <typename T>
+  Query& set_point_lookups(
+      const std::vector<std::vector<T>>& coords, std::vector<uint8_t>& found) {
+    auto domain = schema_.domain();
+    if (coords.size() != domain.ndim())
+      throw TileDBError(
+          "Cannot set point lookups; The number of coordinate vectors must "
+          "be equal to the number of dimensions");
+
+    std::vector<const void*> dim_coords;
+    for (unsigned d = 0; d < coords.size(); ++d) {
+      impl::type_check<T>(domain.dimension(d).type());
+      if (coords[d].size() != coords[0].size())
+        throw TileDBError(
+            "Cannot set point lookups; The coordinate vectors must have the "
+            "same size");
+      dim_coords.push_back(coords[d].data());
+    }
+
+    found.resize(coords.empty() ? 0 : coords[0].size());
+    return set_point_lookups(dim_coords, found.size(), found.data());
+  }
+
+  /**
+   * Turns a read query into a batch of point lookups. See
+   * `tiledb_query_set_point_lookups`.
+   *
+   * @param coords The point coordinates, one buffer per dimension in the
+   *     order of the array schema, each storing `point_num` coordinates.
+   * @param point_num The number of points.
+   * @param found Set to `1` for every point that has a cell, and to `0`
+   *     otherwise. It must be able to hold `point_num` values.
+   * @return Reference to this Query
+   */
+  Query& set_point_lookups(
+      const std::vector<const void*>& coords,
+      uint64_t point_num,
+      uint8_t* found) {
+    if (coords.size() != schema_.domain().ndim())
+      throw TileDBError(
+          "Cannot set point lookups; The number of coordinate buffers must "
+          "be equal to the number of dimensions");
+
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_set_point_lookups(
+        ctx.ptr().get(),
+        query_.get(),
+        const_cast<const void**>(coords.data()),
+        point_num,
+        found));
+    return *this;
+  }
+
   /** Returns the layout of the query. */
   tiledb_layout_t query_layout() const {
     auto& ctx = ctx_.get();
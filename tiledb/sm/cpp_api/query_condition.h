@@ -0,0 +1,212 @@
+/**
+ * @file   query_condition.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file declares the C++ API for the TileDB QueryCondition object.
+ */
+
+#ifndef TILEDB_CPP_API_QUERY_CONDITION_H
+#define TILEDB_CPP_API_QUERY_CONDITION_H
+
+#include "context.h"
+#include "deleter.h"
+#include "tiledb.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace tiledb {
+
+/**
+ * Represents a condition on attribute values that is evaluated by a read
+ * query. Only the cells that satisfy the condition are returned.
+ *
+ * **Example:**
+ *
+ * @code{.cpp}
+ * tiledb::Context ctx;
+ * tiledb::QueryCondition cond(ctx);
+ * int32_t value = 5;
+ * cond.init("a", &value, sizeof(int32_t), TILEDB_GT);
+ * query.set_condition(cond);
+ * @endcode
+ */
+class QueryCondition {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Creates an empty TileDB query condition object.
+   *
+   * @param ctx TileDB context.
+   */
+  explicit QueryCondition(const Context& ctx)
+      : ctx_(ctx) {
+    tiledb_query_condition_t* qc;
+    ctx.handle_error(tiledb_query_condition_alloc(ctx.ptr().get(), &qc));
+    query_condition_ = std::shared_ptr<tiledb_query_condition_t>(qc, deleter_);
+  }
+
+  /**
+   * Creates a TileDB query condition object from a C API object.
+   *
+   * @param ctx TileDB context.
+   * @param qc The C API query condition object.
+   */
+  QueryCondition(const Context& ctx, tiledb_query_condition_t* qc)
+      : ctx_(ctx) {
+    query_condition_ = std::shared_ptr<tiledb_query_condition_t>(qc, deleter_);
+  }
+
+  QueryCondition(const QueryCondition&) = default;
+  QueryCondition(QueryCondition&&) = default;
+  QueryCondition& operator=(const QueryCondition&) = default;
+  QueryCondition& operator=(QueryCondition&&) = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Initializes a TileDB query condition object.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::QueryCondition cond(ctx);
+   * int32_t value = 5;
+   * cond.init("a", &value, sizeof(int32_t), TILEDB_LT);
+   * @endcode
+   *
+   * @param attribute_name The name of the attribute to compare against.
+   * @param condition_value The value to compare against.
+   * @param condition_value_size The byte size of `condition_value`.
+   * @param op The comparison operator.
+   * @return Reference to this QueryCondition.
+   */
+  QueryCondition& init(
+      const std::string& attribute_name,
+      const void* condition_value,
+      uint64_t condition_value_size,
+      tiledb_query_condition_op_t op) {
+    auto& ctx = ctx_.get();
+    ctx.handle_error(tiledb_query_condition_init(
+        ctx.ptr().get(),
+        query_condition_.get(),
+        attribute_name.c_str(),
+        condition_value,
+        condition_value_size,
+        op));
+    return *this;
+  }
+
+  /**
+   * Initializes a TileDB query condition object on a var-sized string
+   * attribute.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::QueryCondition cond(ctx);
+   * cond.init("b", "foo", TILEDB_EQ);
+   * @endcode
+   *
+   * @param attribute_name The name of the attribute to compare against.
+   * @param condition_value The string to compare against.
+   * @param op The comparison operator.
+   * @return Reference to this QueryCondition.
+   */
+  QueryCondition& init(
+      const std::string& attribute_name,
+      const std::string& condition_value,
+      tiledb_query_condition_op_t op) {
+    return init(
+        attribute_name, condition_value.data(), condition_value.size(), op);
+  }
+
+  /** Returns a shared pointer to the C TileDB query condition object. */
+  std::shared_ptr<tiledb_query_condition_t> ptr() const {
+    return query_condition_;
+  }
+
+  /**
+   * Combines this instance with another instance to form a multi-clause
+   * condition object.
+   *
+   * **Example:**
+   *
+   * @code{.cpp}
+   * tiledb::QueryCondition cond1(ctx);
+   * int32_t value1 = 5;
+   * cond1.init("a", &value1, sizeof(int32_t), TILEDB_GT);
+   * tiledb::QueryCondition cond2(ctx);
+   * float value2 = 3.5f;
+   * cond2.init("b", &value2, sizeof(float), TILEDB_LE);
+   * tiledb::QueryCondition cond3 = cond1.combine(cond2, TILEDB_AND);
+   * @endcode
+   *
+   * @param rhs The right-hand side condition.
+   * @param combination_op The combination operator.
+   * @return The combined query condition object.
+   */
+  QueryCondition combine(
+      const QueryCondition& rhs,
+      tiledb_query_condition_combination_op_t combination_op) const {
+    auto& ctx = ctx_.get();
+    tiledb_query_condition_t* combined_qc;
+    ctx.handle_error(tiledb_query_condition_combine(
+        ctx.ptr().get(),
+        query_condition_.get(),
+        rhs.ptr().get(),
+        combination_op,
+        &combined_qc));
+    return QueryCondition(ctx, combined_qc);
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The TileDB context. */
+  std::reference_wrapper<const Context> ctx_;
+
+  /** Deleter wrapper. */
+  impl::Deleter deleter_;
+
+  /** Pointer to the TileDB C query condition object. */
+  std::shared_ptr<tiledb_query_condition_t> query_condition_;
+};
+
+}  // namespace tiledb
+
+#endif  // TILEDB_CPP_API_QUERY_CONDITION_H
@@ -0,0 +1,77 @@
+/**
+ * @file query_condition_combination_op.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This defines the tiledb QueryConditionCombinationOp enum that maps to the
+ * tiledb_query_condition_combination_op_t C-api enum.
+ */
+
+#ifndef TILEDB_QUERY_CONDITION_COMBINATION_OP_H
+#define TILEDB_QUERY_CONDITION_COMBINATION_OP_H
+
+#include "tiledb/common/status.h"
+#include "tiledb/sm/misc/constants.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/** A query condition combination operator. */
+enum class QueryConditionCombinationOp : uint8_t {
+#define TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM(id) id
+#include "tiledb/sm/c_api/tiledb_enum.h"
+#undef TILEDB_QUERY_CONDITION_COMBINATION_OP_ENUM
+};
+
+/** Returns the string representation of the input combination op. */
+inline const std::string& query_condition_combination_op_str(
+    QueryConditionCombinationOp op) {
+  switch (op) {
+    case QueryConditionCombinationOp::AND:
+      return constants::query_condition_combination_op_and_str;
+    default:
+      return constants::empty_str;
+  }
+}
+
+/** Returns the combination op given a string representation. */
+inline Status query_condition_combination_op_enum(
+    const std::string& op_str, QueryConditionCombinationOp* op) {
+  if (op_str == constants::query_condition_combination_op_and_str)
+    *op = QueryConditionCombinationOp::AND;
+  else
+    return Status::Error("Invalid QueryConditionCombinationOp " + op_str);
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_QUERY_CONDITION_COMBINATION_OP_H
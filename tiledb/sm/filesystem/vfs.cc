@@ -33,6 +33,7 @@
 #include "tiledb/sm/filesystem/vfs.h"
 #include "tiledb/common/logger.h"
 #include "tiledb/sm/buffer/buffer.h"
+#include "tiledb/sm/cache/disk_cache.h"
 #include "tiledb/sm/enums/filesystem.h"
 #include "tiledb/sm/enums/vfs_mode.h"
 #include "tiledb/sm/filesystem/hdfs_filesystem.h"
@@ -87,6 +88,8 @@ VFS::VFS()
 #endif
 }
 
+VFS::~VFS() = default;
+
 /* ********************************* */
 /*                API                */
 /* ********************************* */
@@ -414,6 +417,7 @@ Status VFS::remove_dir(const URI& uri) const {
     return LOG_STATUS(
         Status::VFSError("Cannot remove directory; VFS not "
                          "initialized"));
+  disk_cache_object_changed(uri);
 
   if (uri.is_file()) {
 #ifdef _WIN32
@@ -457,6 +461,7 @@ Status VFS::remove_file(const URI& uri) const {
   if (!init_)
     return LOG_STATUS(
         Status::VFSError("Cannot remove file; VFS not initialized"));
+  disk_cache_object_changed(uri);
 
   if (uri.is_file()) {
 #ifdef _WIN32
@@ -950,6 +955,19 @@ Status VFS::init(
 
   init_ = true;
 
+  // Construct the disk cache, which accesses its directory through this VFS
+  const char* disk_cache_dir = nullptr;
+  RETURN_NOT_OK(config_.get("vfs.disk_cache_dir", &disk_cache_dir));
+  if (disk_cache_dir != nullptr && std::string(disk_cache_dir) != "") {
+    uint64_t disk_cache_size = 0;
+    RETURN_NOT_OK(config_.get<uint64_t>(
+        "vfs.disk_cache_size", &disk_cache_size, &found));
+    assert(found);
+    disk_cache_ = std::unique_ptr<DiskCache>(
+        new DiskCache(this, URI(disk_cache_dir), disk_cache_size));
+    RETURN_NOT_OK(disk_cache_->init());
+  }
+
   return Status::Ok();
 }
 
@@ -1013,6 +1031,8 @@ Status VFS::move_file(const URI& old_uri, const URI& new_uri) {
   if (!init_)
     return LOG_STATUS(
         Status::VFSError("Cannot move file; VFS not initialized"));
+  disk_cache_object_changed(old_uri);
+  disk_cache_object_changed(new_uri);
 
   // If new_uri exists, delete it or raise an error based on `force`
   bool is_file;
@@ -1095,6 +1115,8 @@ Status VFS::move_dir(const URI& old_uri, const URI& new_uri) {
   if (!init_)
     return LOG_STATUS(
         Status::VFSError("Cannot move directory; VFS not initialized"));
+  disk_cache_object_changed(old_uri);
+  disk_cache_object_changed(new_uri);
 
   // File
   if (old_uri.is_file()) {
@@ -1344,6 +1366,28 @@ Status VFS::read(
   if (!init_)
     return LOG_STATUS(Status::VFSError("Cannot read; VFS not initialized"));
 
+  // Serve remote reads of immutable objects from the disk cache, and store
+  // the ones it misses. A failure to store a read only loses its cached
+  // copy.
+  if (disk_cache_ != nullptr && !uri.is_file() && DiskCache::cacheable(uri)) {
+    bool success = false;
+    RETURN_NOT_OK(disk_cache_->read(uri, offset, buffer, nbytes, &success));
+    if (success)
+      return Status::Ok();
+    RETURN_NOT_OK(read_parallel(uri, offset, buffer, nbytes, use_read_ahead));
+    disk_cache_->insert(uri, offset, buffer, nbytes);
+    return Status::Ok();
+  }
+
+  return read_parallel(uri, offset, buffer, nbytes, use_read_ahead);
+}
+
+Status VFS::read_parallel(
+    const URI& uri,
+    const uint64_t offset,
+    void* const buffer,
+    const uint64_t nbytes,
+    const bool use_read_ahead) {
   // Get config params
   bool found;
   uint64_t min_parallel_size = 0;
@@ -1399,6 +1443,11 @@ Status VFS::read(
   }
 }
 
+void VFS::disk_cache_object_changed(const URI& uri) const {
+  if (disk_cache_ != nullptr && !uri.is_file())
+    disk_cache_->remove_prefix(uri);
+}
+
 Status VFS::read_impl(
     const URI& uri,
     const uint64_t offset,
@@ -1774,6 +1823,7 @@ Status VFS::close_file(const URI& uri) {
   if (!init_)
     return LOG_STATUS(
         Status::VFSError("Cannot close file; VFS not initialized"));
+  disk_cache_object_changed(uri);
 
   if (uri.is_file()) {
 #ifdef _WIN32
@@ -76,6 +76,7 @@ using namespace tiledb::common;
 namespace tiledb {
 namespace sm {
 
+class DiskCache;
 enum class Filesystem : uint8_t;
 enum class VFSMode : uint8_t;
 
@@ -93,7 +94,7 @@ class VFS {
   VFS();
 
   /** Destructor. */
-  ~VFS() = default;
+  ~VFS();
 
   /* ********************************* */
   /*               API                 */
@@ -647,6 +648,12 @@ class VFS {
   /** The read-ahead cache. */
   std::unique_ptr<ReadAheadCache> read_ahead_cache_;
 
+  /**
+   * The local disk cache of remote reads. It is null if
+   * "vfs.disk_cache_dir" is empty.
+   */
+  std::unique_ptr<DiskCache> disk_cache_;
+
   /* ********************************* */
   /*          PRIVATE METHODS          */
   /* ********************************* */
@@ -664,6 +671,30 @@ class VFS {
       const std::vector<std::tuple<uint64_t, void*, uint64_t>>& regions,
       std::vector<BatchedRead>* batches) const;
 
+  /**
+   * Reads from a file, splitting reads larger than "vfs.min_parallel_size"
+   * into parallel reads on the io thread pool.
+   *
+   * @param uri The URI of the file.
+   * @param offset The offset where the read begins.
+   * @param buffer The buffer to read into.
+   * @param nbytes Number of bytes to read.
+   * @param use_read_ahead Whether to use the read-ahead cache.
+   * @return Status
+   */
+  Status read_parallel(
+      const URI& uri,
+      uint64_t offset,
+      void* buffer,
+      uint64_t nbytes,
+      bool use_read_ahead);
+
+  /**
+   * Drops the disk cache entries of the remote object at `uri` and of the
+   * objects under it, after they were modified, moved or removed.
+   */
+  void disk_cache_object_changed(const URI& uri) const;
+
   /**
    * Reads from a file by calling the specific backend read function.
    *
@@ -45,8 +45,10 @@
 #include "tiledb/sm/storage_manager/storage_manager.h"
 #include "tiledb/sm/tile/generic_tile_io.h"
 #include "tiledb/sm/tile/tile.h"
+#include "tiledb/sm/tile/tile_metadata_generator.h"
 
 #include <cassert>
+#include <cstring>
 #include <iostream>
 
 using namespace tiledb::common;
@@ -54,6 +56,37 @@ using namespace tiledb::common;
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/**
+ * Retrieves the tile minimum/maximum value at position `tile_idx` out of
+ * `tile_num` from the input buffers (see `tile_min_buffer_`).
+ */
+inline void get_tile_min_max_value(
+    const std::vector<uint8_t>& values,
+    const std::vector<uint8_t>& var_values,
+    bool var_size,
+    uint64_t cell_size,
+    uint64_t tile_idx,
+    uint64_t tile_num,
+    const void** value,
+    uint64_t* size) {
+  if (!var_size) {
+    *value = &values[tile_idx * cell_size];
+    *size = cell_size;
+    return;
+  }
+
+  auto offsets = reinterpret_cast<const uint64_t*>(values.data());
+  auto start = offsets[tile_idx];
+  auto end =
+      (tile_idx == tile_num - 1) ? var_values.size() : offsets[tile_idx + 1];
+  *value = var_values.data() + start;
+  *size = end - start;
+}
+
+}  // namespace
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
@@ -139,6 +172,67 @@ void FragmentMetadata::set_tile_var_size(
   tile_var_sizes_[idx][tid] = size;
 }
 
+void FragmentMetadata::set_tile_min(
+    const std::string& name, uint64_t tid, const std::vector<uint8_t>& min) {
+  auto it = idx_map_.find(name);
+  assert(it != idx_map_.end());
+  auto idx = it->second;
+  tid += tile_index_base_;
+
+  if (!array_schema_->var_size(name)) {
+    auto cell_size = array_schema_->cell_size(name);
+    assert(min.size() == cell_size);
+    assert((tid + 1) * cell_size <= tile_min_buffer_[idx].size());
+    std::memcpy(&tile_min_buffer_[idx][tid * cell_size], min.data(), cell_size);
+    return;
+  }
+
+  uint64_t offset = tile_min_var_buffer_[idx].size();
+  assert((tid + 1) * sizeof(uint64_t) <= tile_min_buffer_[idx].size());
+  std::memcpy(
+      &tile_min_buffer_[idx][tid * sizeof(uint64_t)],
+      &offset,
+      sizeof(uint64_t));
+  tile_min_var_buffer_[idx].insert(
+      tile_min_var_buffer_[idx].end(), min.begin(), min.end());
+}
+
+void FragmentMetadata::set_tile_max(
+    const std::string& name, uint64_t tid, const std::vector<uint8_t>& max) {
+  auto it = idx_map_.find(name);
+  assert(it != idx_map_.end());
+  auto idx = it->second;
+  tid += tile_index_base_;
+
+  if (!array_schema_->var_size(name)) {
+    auto cell_size = array_schema_->cell_size(name);
+    assert(max.size() == cell_size);
+    assert((tid + 1) * cell_size <= tile_max_buffer_[idx].size());
+    std::memcpy(&tile_max_buffer_[idx][tid * cell_size], max.data(), cell_size);
+    return;
+  }
+
+  uint64_t offset = tile_max_var_buffer_[idx].size();
+  assert((tid + 1) * sizeof(uint64_t) <= tile_max_buffer_[idx].size());
+  std::memcpy(
+      &tile_max_buffer_[idx][tid * sizeof(uint64_t)],
+      &offset,
+      sizeof(uint64_t));
+  tile_max_var_buffer_[idx].insert(
+      tile_max_var_buffer_[idx].end(), max.begin(), max.end());
+}
+
+void FragmentMetadata::set_tile_sum(
+    const std::string& name, uint64_t tid, const std::vector<uint8_t>& sum) {
+  auto it = idx_map_.find(name);
+  assert(it != idx_map_.end());
+  auto idx = it->second;
+  tid += tile_index_base_;
+  assert(sum.size() == sizeof(uint64_t));
+  assert((tid + 1) * sizeof(uint64_t) <= tile_sums_[idx].size());
+  std::memcpy(&tile_sums_[idx][tid * sizeof(uint64_t)], sum.data(), sum.size());
+}
+
 uint64_t FragmentMetadata::cell_num(uint64_t tile_pos) const {
   if (dense_)
     return array_schema_->domain()->cell_num_per_tile();
@@ -351,6 +445,23 @@ Status FragmentMetadata::get_tile_overlap(
   return Status::Ok();
 }
 
+Status FragmentMetadata::get_tile_overlap(
+    const std::vector<NDRange>& ranges,
+    std::vector<TileOverlap>* tile_overlaps) {
+  assert(version_ <= 2 || loaded_metadata_.rtree_);
+  *tile_overlaps = rtree_.get_tile_overlap(ranges);
+  return Status::Ok();
+}
+
+Status FragmentMetadata::get_point_tiles(
+    const std::vector<const void*>& coords,
+    const std::vector<uint64_t>& points,
+    std::vector<uint64_t>* tiles) const {
+  assert(version_ <= 2 || loaded_metadata_.rtree_);
+  *tiles = rtree_.get_point_tiles(coords, points);
+  return Status::Ok();
+}
+
 Status FragmentMetadata::init(const NDRange& non_empty_domain) {
   // For easy reference
   auto dim_num = array_schema_->dim_num();
@@ -396,6 +507,13 @@ Status FragmentMetadata::init(const NDRange& non_empty_domain) {
   // Initialize variable tile sizes
   tile_var_sizes_.resize(num);
 
+  // Initialize tile minimum/maximum values and sums
+  tile_min_buffer_.resize(num);
+  tile_min_var_buffer_.resize(num);
+  tile_max_buffer_.resize(num);
+  tile_max_var_buffer_.resize(num);
+  tile_sums_.resize(num);
+
   return Status::Ok();
 }
 
@@ -478,6 +596,15 @@ Status FragmentMetadata::store(const EncryptionKey& encryption_key) {
     offset += nbytes;
   }
 
+  // Store tile statistics
+  auto attribute_num = array_schema_->attribute_num();
+  gt_offsets_.tile_stats_.resize(attribute_num);
+  for (unsigned int i = 0; i < attribute_num; ++i) {
+    gt_offsets_.tile_stats_[i] = offset;
+    RETURN_NOT_OK_ELSE(store_tile_stats(i, encryption_key, &nbytes), clean_up());
+    offset += nbytes;
+  }
+
   // Store footer
   RETURN_NOT_OK_ELSE(store_footer(encryption_key), clean_up());
 
@@ -487,6 +614,29 @@ Status FragmentMetadata::store(const EncryptionKey& encryption_key) {
   STATS_END_TIMER(stats::Stats::TimerType::WRITE_STORE_FRAG_META)
 }
 
+uint64_t FragmentMetadata::memory_size() {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  auto size = (uint64_t)sizeof(FragmentMetadata) + rtree_.memory_size();
+  size += (file_sizes_.size() + file_var_sizes_.size()) * sizeof(uint64_t);
+  for (const auto& b : bounding_coords_)
+    size += b.size();
+  for (const auto& v : {&tile_offsets_, &tile_var_offsets_, &tile_var_sizes_}) {
+    for (const auto& t : *v)
+      size += t.size() * sizeof(uint64_t);
+  }
+  for (const auto& v : {&tile_min_buffer_,
+                        &tile_min_var_buffer_,
+                        &tile_max_buffer_,
+                        &tile_max_var_buffer_,
+                        &tile_sums_}) {
+    for (const auto& t : *v)
+      size += t.size();
+  }
+
+  return size;
+}
+
 const NDRange& FragmentMetadata::non_empty_domain() {
   return non_empty_domain_;
 }
@@ -501,6 +651,22 @@ Status FragmentMetadata::set_num_tiles(uint64_t num_tiles) {
     tile_var_sizes_[i].resize(num_tiles, 0);
   }
 
+  // Tile minimum/maximum values and sums are stored only for attributes
+  for (unsigned i = 0; i < array_schema_->attribute_num(); i++) {
+    auto attr = array_schema_->attribute(i);
+    auto type = attr->type();
+    auto var_size = attr->var_size();
+    auto cell_val_num = attr->cell_val_num();
+    if (TileMetadataGenerator::has_min_max_metadata(
+            type, var_size, cell_val_num)) {
+      auto size = var_size ? sizeof(uint64_t) : attr->cell_size();
+      tile_min_buffer_[i].resize(num_tiles * size, 0);
+      tile_max_buffer_[i].resize(num_tiles * size, 0);
+    }
+    if (TileMetadataGenerator::has_sum_metadata(type, var_size, cell_val_num))
+      tile_sums_[i].resize(num_tiles * sizeof(uint64_t), 0);
+  }
+
   if (!dense_) {
     rtree_.set_leaf_num(num_tiles);
     sparse_tile_num_ = num_tiles;
@@ -562,6 +728,27 @@ Status FragmentMetadata::load_tile_offsets(
   return Status::Ok();
 }
 
+Status FragmentMetadata::load_tile_stats(
+    const EncryptionKey& encryption_key, std::vector<std::string>&& names) {
+  // Sort 'names' in ascending order of their index, so that the
+  // statistics are loaded in order of their layout in the file.
+  std::sort(
+      names.begin(),
+      names.end(),
+      [&](const std::string& lhs, const std::string& rhs) {
+        assert(idx_map_.count(lhs) > 0);
+        assert(idx_map_.count(rhs) > 0);
+        return idx_map_[lhs] < idx_map_[rhs];
+      });
+
+  for (const auto& name : names) {
+    if (has_tile_min_max(name) || has_tile_sum(name))
+      RETURN_NOT_OK(load_tile_stats(encryption_key, idx_map_[name]));
+  }
+
+  return Status::Ok();
+}
+
 Status FragmentMetadata::file_offset(
     const EncryptionKey& encryption_key,
     const std::string& name,
@@ -588,12 +775,109 @@ Status FragmentMetadata::file_var_offset(
   return Status::Ok();
 }
 
-const NDRange& FragmentMetadata::mbr(uint64_t tile_idx) const {
-  return rtree_.leaf(tile_idx);
+bool FragmentMetadata::has_tile_min_max(const std::string& name) const {
+  if (version_ < 7)
+    return false;
+
+  auto attr = array_schema_->attribute(name);
+  if (attr == nullptr)
+    return false;
+
+  return TileMetadataGenerator::has_min_max_metadata(
+      attr->type(), attr->var_size(), attr->cell_val_num());
 }
 
-const std::vector<NDRange>& FragmentMetadata::mbrs() const {
-  return rtree_.leaves();
+bool FragmentMetadata::has_tile_sum(const std::string& name) const {
+  if (version_ < 7)
+    return false;
+
+  auto attr = array_schema_->attribute(name);
+  if (attr == nullptr)
+    return false;
+
+  return TileMetadataGenerator::has_sum_metadata(
+      attr->type(), attr->var_size(), attr->cell_val_num());
+}
+
+Status FragmentMetadata::get_tile_min(
+    const std::string& name,
+    uint64_t tile_idx,
+    const void** value,
+    uint64_t* size) const {
+  auto it = idx_map_.find(name);
+  assert(it != idx_map_.end());
+  auto idx = it->second;
+  auto tile_num = this->tile_num();
+  if (!has_tile_min_max(name) || tile_min_buffer_[idx].empty())
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot get tile minimum value; Values are not loaded for '" + name +
+        "'"));
+  if (tile_idx >= tile_num)
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot get tile minimum value; Invalid tile index"));
+
+  get_tile_min_max_value(
+      tile_min_buffer_[idx],
+      tile_min_var_buffer_[idx],
+      array_schema_->var_size(name),
+      array_schema_->cell_size(name),
+      tile_idx,
+      tile_num,
+      value,
+      size);
+
+  return Status::Ok();
+}
+
+Status FragmentMetadata::get_tile_max(
+    const std::string& name,
+    uint64_t tile_idx,
+    const void** value,
+    uint64_t* size) const {
+  auto it = idx_map_.find(name);
+  assert(it != idx_map_.end());
+  auto idx = it->second;
+  auto tile_num = this->tile_num();
+  if (!has_tile_min_max(name) || tile_max_buffer_[idx].empty())
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot get tile maximum value; Values are not loaded for '" + name +
+        "'"));
+  if (tile_idx >= tile_num)
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot get tile maximum value; Invalid tile index"));
+
+  get_tile_min_max_value(
+      tile_max_buffer_[idx],
+      tile_max_var_buffer_[idx],
+      array_schema_->var_size(name),
+      array_schema_->cell_size(name),
+      tile_idx,
+      tile_num,
+      value,
+      size);
+
+  return Status::Ok();
+}
+
+Status FragmentMetadata::get_tile_sum(
+    const std::string& name, uint64_t tile_idx, const void** sum) const {
+  auto it = idx_map_.find(name);
+  assert(it != idx_map_.end());
+  auto idx = it->second;
+  if (!has_tile_sum(name) || tile_sums_[idx].empty())
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot get tile sum; Sums are not loaded for '" + name + "'"));
+  if (tile_idx >= tile_num())
+    return LOG_STATUS(Status::FragmentMetadataError(
+        "Cannot get tile sum; Invalid tile index"));
+
+  *sum = &tile_sums_[idx][tile_idx * sizeof(uint64_t)];
+
+  return Status::Ok();
+}
+
+NDRange FragmentMetadata::mbr(uint64_t tile_idx) const {
+  return rtree_.leaf(tile_idx);
 }
 
 Status FragmentMetadata::persisted_tile_size(
@@ -724,7 +1008,8 @@ Status FragmentMetadata::load_tile_var_sizes(
 
 Status FragmentMetadata::get_footer_size(
     uint32_t version, uint64_t* size) const {
-  *size = (version < 3) ? footer_size_v3_v4() : footer_size_v5_or_higher();
+  *size = (version < 3) ? footer_size_v3_v4() :
+                          footer_size_v5_or_higher(version_);
 
   return Status::Ok();
 }
@@ -735,7 +1020,15 @@ Status FragmentMetadata::get_footer_offset_and_size(
     uint32_t f_version;
     auto name = fragment_uri_.remove_trailing_slash().last_path_part();
     RETURN_NOT_OK(utils::parse::get_fragment_name_version(name, &f_version));
-    RETURN_NOT_OK(get_footer_size(f_version, size));
+    if (f_version < 3) {
+      *size = footer_size_v3_v4();
+    } else {
+      // The footer layout depends on the format version, which is
+      // encoded in the fragment name
+      uint32_t version;
+      RETURN_NOT_OK(utils::parse::get_fragment_version(name, &version));
+      *size = footer_size_v5_or_higher(version);
+    }
     *offset = meta_file_size_ - *size;
   } else {
     URI fragment_metadata_uri = fragment_uri_.join_path(
@@ -778,7 +1071,7 @@ uint64_t FragmentMetadata::footer_size_v3_v4() const {
   return size;
 }
 
-uint64_t FragmentMetadata::footer_size_v5_or_higher() const {
+uint64_t FragmentMetadata::footer_size_v5_or_higher(uint32_t version) const {
   auto dim_num = array_schema_->dim_num();
   auto num = array_schema_->attribute_num() + dim_num + 1;
   uint64_t domain_size = 0;
@@ -814,6 +1107,8 @@ uint64_t FragmentMetadata::footer_size_v5_or_higher() const {
   size += num * sizeof(uint64_t);  // tile offsets
   size += num * sizeof(uint64_t);  // tile var offsets
   size += num * sizeof(uint64_t);  // tile var sizes
+  if (version >= 7)
+    size += array_schema_->attribute_num() * sizeof(uint64_t);  // tile stats
 
   return size;
 }
@@ -1035,6 +1330,28 @@ Status FragmentMetadata::load_tile_var_sizes(
   return Status::Ok();
 }
 
+Status FragmentMetadata::load_tile_stats(
+    const EncryptionKey& encryption_key, unsigned idx) {
+  if (version_ < 7)
+    return Status::Ok();
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  if (loaded_metadata_.tile_stats_[idx])
+    return Status::Ok();
+
+  Buffer buff;
+  RETURN_NOT_OK(read_generic_tile_from_file(
+      encryption_key, gt_offsets_.tile_stats_[idx], &buff));
+
+  ConstBuffer cbuff(&buff);
+  RETURN_NOT_OK(load_tile_stats(idx, &cbuff));
+
+  loaded_metadata_.tile_stats_[idx] = true;
+
+  return Status::Ok();
+}
+
 // ===== FORMAT =====
 //  bounding_coords_num (uint64_t)
 //  bounding_coords_#1 (void*) bounding_coords_#2 (void*) ...
@@ -1510,6 +1827,48 @@ Status FragmentMetadata::load_tile_var_sizes(unsigned idx, ConstBuffer* buff) {
   return Status::Ok();
 }
 
+// ===== FORMAT =====
+// tile_min_size (uint64_t)
+// tile_min_var_size (uint64_t)
+// tile_max_size (uint64_t)
+// tile_max_var_size (uint64_t)
+// tile_sums_size (uint64_t)
+// tile_min (uint8_t[])
+// tile_min_var (uint8_t[])
+// tile_max (uint8_t[])
+// tile_max_var (uint8_t[])
+// tile_sums (uint8_t[])
+Status FragmentMetadata::load_tile_stats(unsigned idx, ConstBuffer* buff) {
+  std::vector<uint8_t>* stats[] = {&tile_min_buffer_[idx],
+                                   &tile_min_var_buffer_[idx],
+                                   &tile_max_buffer_[idx],
+                                   &tile_max_var_buffer_[idx],
+                                   &tile_sums_[idx]};
+
+  for (auto stat : stats) {
+    uint64_t size = 0;
+    Status st = buff->read(&size, sizeof(uint64_t));
+    if (!st.ok()) {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot load fragment metadata; Reading size of tile statistics "
+          "failed"));
+    }
+    stat->resize(size);
+  }
+
+  for (auto stat : stats) {
+    if (stat->empty())
+      continue;
+    Status st = buff->read(stat->data(), stat->size());
+    if (!st.ok()) {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot load fragment metadata; Reading tile statistics failed"));
+    }
+  }
+
+  return Status::Ok();
+}
+
 Status FragmentMetadata::load_version(ConstBuffer* buff) {
   RETURN_NOT_OK(buff->read(&version_, sizeof(uint32_t)));
   return Status::Ok();
@@ -1590,6 +1949,16 @@ Status FragmentMetadata::load_generic_tile_offsets_v5_or_higher(
         buff->read(&gt_offsets_.tile_var_sizes_[i], sizeof(uint64_t)));
   }
 
+  // Tile minimum/maximum values and sums exist from format version 7
+  if (version_ < 7)
+    return Status::Ok();
+
+  // Load offsets for tile statistics
+  auto attribute_num = array_schema_->attribute_num();
+  gt_offsets_.tile_stats_.resize(attribute_num);
+  for (unsigned i = 0; i < attribute_num; ++i)
+    RETURN_NOT_OK(buff->read(&gt_offsets_.tile_stats_[i], sizeof(uint64_t)));
+
   return Status::Ok();
 }
 
@@ -1675,10 +2044,16 @@ Status FragmentMetadata::load_footer(
   tile_offsets_.resize(num);
   tile_var_offsets_.resize(num);
   tile_var_sizes_.resize(num);
+  tile_min_buffer_.resize(num);
+  tile_min_var_buffer_.resize(num);
+  tile_max_buffer_.resize(num);
+  tile_max_var_buffer_.resize(num);
+  tile_sums_.resize(num);
 
   loaded_metadata_.tile_offsets_.resize(num, false);
   loaded_metadata_.tile_var_offsets_.resize(num, false);
   loaded_metadata_.tile_var_sizes_.resize(num, false);
+  loaded_metadata_.tile_stats_.resize(array_schema_->attribute_num(), false);
 
   RETURN_NOT_OK(load_generic_tile_offsets(cbuff.get(), version));
 
@@ -1728,6 +2103,9 @@ Status FragmentMetadata::write_file_var_sizes(Buffer* buff) const {
 // tile_var_sizes_0(uint64_t)
 // ...
 // tile_var_sizes_{attr_num+dim_num}(uint64_t)
+// tile_stats_0(uint64_t)
+// ...
+// tile_stats_{attr_num-1}(uint64_t)
 Status FragmentMetadata::write_generic_tile_offsets(Buffer* buff) const {
   auto num = array_schema_->attribute_num() + array_schema_->dim_num() + 1;
 
@@ -1766,6 +2144,20 @@ Status FragmentMetadata::write_generic_tile_offsets(Buffer* buff) const {
     }
   }
 
+  // Tile minimum/maximum values and sums exist from format version 7
+  if (version_ < 7)
+    return Status::Ok();
+
+  // Write tile statistics
+  for (auto offset : gt_offsets_.tile_stats_) {
+    st = buff->write(&offset, sizeof(uint64_t));
+    if (!st.ok()) {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot serialize fragment metadata; Writing tile statistics "
+          "failed"));
+    }
+  }
+
   return Status::Ok();
 }
 
@@ -2044,6 +2436,49 @@ Status FragmentMetadata::write_tile_var_sizes(unsigned idx, Buffer* buff) {
   return Status::Ok();
 }
 
+Status FragmentMetadata::store_tile_stats(
+    unsigned idx, const EncryptionKey& encryption_key, uint64_t* nbytes) {
+  Buffer buff;
+  RETURN_NOT_OK(write_tile_stats(idx, &buff));
+  RETURN_NOT_OK(
+      write_generic_tile_to_file(encryption_key, std::move(buff), nbytes));
+
+  return Status::Ok();
+}
+
+Status FragmentMetadata::write_tile_stats(unsigned idx, Buffer* buff) const {
+  const std::vector<uint8_t>* stats[] = {&tile_min_buffer_[idx],
+                                         &tile_min_var_buffer_[idx],
+                                         &tile_max_buffer_[idx],
+                                         &tile_max_var_buffer_[idx],
+                                         &tile_sums_[idx]};
+
+  // Write sizes
+  for (auto stat : stats) {
+    uint64_t size = stat->size();
+    Status st = buff->write(&size, sizeof(uint64_t));
+    if (!st.ok()) {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot serialize fragment metadata; Writing size of tile "
+          "statistics failed"));
+    }
+  }
+
+  // Write statistics
+  for (auto stat : stats) {
+    if (stat->empty())
+      continue;
+    Status st = buff->write(stat->data(), stat->size());
+    if (!st.ok()) {
+      return LOG_STATUS(Status::FragmentMetadataError(
+          "Cannot serialize fragment metadata; Writing tile statistics "
+          "failed"));
+    }
+  }
+
+  return Status::Ok();
+}
+
 Status FragmentMetadata::write_version(Buffer* buff) const {
   RETURN_NOT_OK(buff->write(&version_, sizeof(uint32_t)));
   return Status::Ok();
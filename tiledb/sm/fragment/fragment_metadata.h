@@ -210,6 +210,24 @@ class FragmentMetadata {
    */
   Status get_tile_overlap(const NDRange& range, TileOverlap* tile_overlap);
 
+  /**
+   * Retrieves the overlap of all MBRs with each of the input ND ranges, in
+   * a single traversal of the R-tree. See `RTree::get_tile_overlap`.
+   */
+  Status get_tile_overlap(
+      const std::vector<NDRange>& ranges,
+      std::vector<TileOverlap>* tile_overlaps);
+
+  /**
+   * Retrieves the sorted indices of the tiles whose MBRs contain at least
+   * one of the input points, in a single traversal of the R-tree. See
+   * `RTree::get_point_tiles`. The R-tree must have been loaded.
+   */
+  Status get_point_tiles(
+      const std::vector<const void*>& coords,
+      const std::vector<uint64_t>& points,
+      std::vector<uint64_t>* tiles) const;
+
   /**
    * Initializes the fragment metadata structures.
    *
@@ -233,6 +251,13 @@ class FragmentMetadata {
       uint64_t offset,
       uint32_t meta_version);
 
+  /**
+   * Returns an estimate of the number of bytes the loaded metadata
+   * occupy in memory, i.e., the R-tree, tile offsets, sizes and
+   * statistics loaded so far.
+   */
+  uint64_t memory_size();
+
   /** Stores all the metadata to storage. */
   Status store(const EncryptionKey& encryption_key);
 
@@ -311,6 +336,41 @@ class FragmentMetadata {
    */
   void set_tile_var_size(const std::string& name, uint64_t tid, uint64_t size);
 
+  /**
+   * Sets the minimum value of a tile for the input attribute. For var-sized
+   * attributes, the values of the tiles must be set in ascending tile order.
+   *
+   * @param name The attribute for which the minimum is set.
+   * @param tid The index of the tile for which the minimum is set.
+   * @param min The minimum value (raw bytes).
+   * @return void
+   */
+  void set_tile_min(
+      const std::string& name, uint64_t tid, const std::vector<uint8_t>& min);
+
+  /**
+   * Sets the maximum value of a tile for the input attribute. For var-sized
+   * attributes, the values of the tiles must be set in ascending tile order.
+   *
+   * @param name The attribute for which the maximum is set.
+   * @param tid The index of the tile for which the maximum is set.
+   * @param max The maximum value (raw bytes).
+   * @return void
+   */
+  void set_tile_max(
+      const std::string& name, uint64_t tid, const std::vector<uint8_t>& max);
+
+  /**
+   * Sets the sum of the values of a tile for the input attribute.
+   *
+   * @param name The attribute for which the sum is set.
+   * @param tid The index of the tile for which the sum is set.
+   * @param sum The sum (8 raw bytes).
+   * @return void
+   */
+  void set_tile_sum(
+      const std::string& name, uint64_t tid, const std::vector<uint8_t>& sum);
+
   /** Returns the tile index base value. */
   uint64_t tile_index_base() const;
 
@@ -362,11 +422,73 @@ class FragmentMetadata {
    */
   Status get_footer_size(uint32_t version, uint64_t* size) const;
 
-  /** Returns the MBR of the input tile. */
-  const NDRange& mbr(uint64_t tile_idx) const;
+  /**
+   * Returns `true` if the fragment stores the minimum/maximum value of each
+   * tile of the input attribute.
+   */
+  bool has_tile_min_max(const std::string& name) const;
+
+  /**
+   * Returns `true` if the fragment stores the sum of the values of each
+   * tile of the input attribute.
+   */
+  bool has_tile_sum(const std::string& name) const;
+
+  /**
+   * Retrieves the minimum value of the input tile of the input attribute.
+   * The values must have been loaded with `load_tile_stats`.
+   *
+   * @param name The input attribute.
+   * @param tile_idx The index of the tile in the metadata.
+   * @param value Set to point to the minimum value, which is owned by the
+   *     fragment metadata.
+   * @param size Set to the size of the minimum value.
+   * @return Status
+   */
+  Status get_tile_min(
+      const std::string& name,
+      uint64_t tile_idx,
+      const void** value,
+      uint64_t* size) const;
+
+  /**
+   * Retrieves the maximum value of the input tile of the input attribute.
+   * The values must have been loaded with `load_tile_stats`.
+   *
+   * @param name The input attribute.
+   * @param tile_idx The index of the tile in the metadata.
+   * @param value Set to point to the maximum value, which is owned by the
+   *     fragment metadata.
+   * @param size Set to the size of the maximum value.
+   * @return Status
+   */
+  Status get_tile_max(
+      const std::string& name,
+      uint64_t tile_idx,
+      const void** value,
+      uint64_t* size) const;
+
+  /**
+   * Retrieves the sum of the values of the input tile of the input
+   * attribute. The sum is an `int64_t` for signed integer (and datetime)
+   * attributes, a `uint64_t` for unsigned integer attributes and a `double`
+   * for real attributes. The sums must have been loaded with
+   * `load_tile_stats`.
+   *
+   * @param name The input attribute.
+   * @param tile_idx The index of the tile in the metadata.
+   * @param sum Set to point to the sum, which is owned by the fragment
+   *     metadata.
+   * @return Status
+   */
+  Status get_tile_sum(
+      const std::string& name, uint64_t tile_idx, const void** sum) const;
 
-  /** Returns all the MBRs of all tiles in the fragment. */
-  const std::vector<NDRange>& mbrs() const;
+  /**
+   * Returns the MBR of the input tile. The MBR is built from the R-tree,
+   * which does not store `NDRange` objects.
+   */
+  NDRange mbr(uint64_t tile_idx) const;
 
   /**
    * Retrieves the size of the tile when it is persisted (e.g. the size of the
@@ -465,6 +587,18 @@ class FragmentMetadata {
   Status load_tile_offsets(
       const EncryptionKey& encryption_key, std::vector<std::string>&& names);
 
+  /**
+   * Loads the tile statistics (minimum/maximum values and sums) for the
+   * attribute names. It is a noop for dimensions and for fragments that
+   * do not store tile statistics.
+   *
+   * @param encryption_key The key the array got opened with.
+   * @param names The attribute/dimension names.
+   * @return Status
+   */
+  Status load_tile_stats(
+      const EncryptionKey& encryption_key, std::vector<std::string>&& names);
+
  private:
   /* ********************************* */
   /*          TYPE DEFINITIONS         */
@@ -480,6 +614,7 @@ class FragmentMetadata {
     std::vector<uint64_t> tile_offsets_;
     std::vector<uint64_t> tile_var_offsets_;
     std::vector<uint64_t> tile_var_sizes_;
+    std::vector<uint64_t> tile_stats_;
   };
 
   /** Keeps track of which metadata is loaded. */
@@ -489,6 +624,7 @@ class FragmentMetadata {
     std::vector<bool> tile_offsets_;
     std::vector<bool> tile_var_offsets_;
     std::vector<bool> tile_var_sizes_;
+    std::vector<bool> tile_stats_;
   };
 
   /* ********************************* */
@@ -576,6 +712,30 @@ class FragmentMetadata {
    */
   std::vector<std::vector<uint64_t>> tile_var_sizes_;
 
+  /**
+   * The minimum value of each tile, per attribute. For fixed-sized
+   * attributes, the values are stored contiguously (one cell per tile). For
+   * var-sized attributes, this stores the `uint64_t` starting offset of the
+   * value of each tile in `tile_min_var_buffer_`. Empty for attributes and
+   * dimensions without tile minimum/maximum values.
+   */
+  std::vector<std::vector<uint8_t>> tile_min_buffer_;
+
+  /** The var-sized minimum values of each tile, per attribute. */
+  std::vector<std::vector<uint8_t>> tile_min_var_buffer_;
+
+  /** The maximum value of each tile, per attribute (see `tile_min_buffer_`). */
+  std::vector<std::vector<uint8_t>> tile_max_buffer_;
+
+  /** The var-sized maximum values of each tile, per attribute. */
+  std::vector<std::vector<uint8_t>> tile_max_var_buffer_;
+
+  /**
+   * The sum of the values of each tile (8 bytes per tile), per attribute.
+   * Empty for attributes and dimensions without tile sums.
+   */
+  std::vector<std::vector<uint8_t>> tile_sums_;
+
   /** The format version of this metadata. */
   uint32_t version_;
 
@@ -608,8 +768,10 @@ class FragmentMetadata {
    * (which contains the generic tile offsets) along with its size.
    *
    * Applicable to format version 5 or higher.
+   *
+   * @param version The format version of the fragment.
    */
-  uint64_t footer_size_v5_or_higher() const;
+  uint64_t footer_size_v5_or_higher(uint32_t version) const;
 
   /**
    * Returns the ids (positions) of the tiles overlapping `subarray`.
@@ -654,6 +816,9 @@ class FragmentMetadata {
    * */
   Status load_tile_var_sizes(const EncryptionKey& encryption_key, unsigned idx);
 
+  /** Loads the tile statistics for the input attribute idx from storage. */
+  Status load_tile_stats(const EncryptionKey& encryption_key, unsigned idx);
+
   /** Loads the generic tile offsets from the buffer. */
   Status load_generic_tile_offsets(ConstBuffer* buff, uint32_t version);
 
@@ -780,6 +945,12 @@ class FragmentMetadata {
    */
   Status load_tile_var_sizes(unsigned idx, ConstBuffer* buff);
 
+  /**
+   * Loads the tile statistics for the input attribute from the input
+   * buffer.
+   */
+  Status load_tile_stats(unsigned idx, ConstBuffer* buff);
+
   /** Loads the format version from the buffer. */
   Status load_version(ConstBuffer* buff);
 
@@ -899,6 +1070,20 @@ class FragmentMetadata {
    */
   Status write_tile_var_sizes(unsigned idx, Buffer* buff);
 
+  /**
+   * Writes the tile statistics for the input attribute to storage.
+   *
+   * @param idx The index of the attribute.
+   * @param encryption_key The encryption key.
+   * @param nbytes The total number of bytes written for the tile statistics.
+   * @return Status
+   */
+  Status store_tile_stats(
+      unsigned idx, const EncryptionKey& encryption_key, uint64_t* nbytes);
+
+  /** Writes the tile statistics for the input attribute to the buffer. */
+  Status write_tile_stats(unsigned idx, Buffer* buff) const;
+
   /** Writes the format version to the buffer. */
   Status write_version(Buffer* buff) const;
 
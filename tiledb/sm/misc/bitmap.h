@@ -0,0 +1,253 @@
+/**
+ * @file   bitmap.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class Bitmap.
+ */
+
+#ifndef TILEDB_BITMAP_H
+#define TILEDB_BITMAP_H
+
+#include <algorithm>
+#include <cassert>
+#include <cinttypes>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace tiledb {
+namespace sm {
+
+/**
+ * A fixed-size bitmap packed into 64-bit words, with one bit per cell of a
+ * result tile. Bit `i` is stored in bit `i % 64` of word `i / 64`. The bits
+ * of the last word past `size()` are always zero, so that the word-wise
+ * operations need no masking.
+ */
+class Bitmap {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Default constructor. */
+  Bitmap() = default;
+
+  /** Constructor. Sets all `size` bits to `value`. */
+  Bitmap(uint64_t size, bool value)
+      : size_(size)
+      , words_((size + 63) / 64, value ? ~(uint64_t)0 : 0) {
+    if (value && size % 64 != 0)
+      words_.back() = ((uint64_t)1 << (size % 64)) - 1;
+  }
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns the number of bits. */
+  uint64_t size() const {
+    return size_;
+  }
+
+  /** Returns the number of words. */
+  uint64_t word_num() const {
+    return words_.size();
+  }
+
+  /** Returns the words, e.g., for kernels that compute a word at a time. */
+  uint64_t* words() {
+    return words_.data();
+  }
+
+  /** Returns the words. */
+  const uint64_t* words() const {
+    return words_.data();
+  }
+
+  /** Returns the bit at position `pos`. */
+  bool get(uint64_t pos) const {
+    assert(pos < size_);
+    return (words_[pos / 64] >> (pos % 64)) & 1;
+  }
+
+  /** Sets the bit at position `pos`. */
+  void set(uint64_t pos) {
+    assert(pos < size_);
+    words_[pos / 64] |= (uint64_t)1 << (pos % 64);
+  }
+
+  /** Clears the bit at position `pos`. */
+  void clear(uint64_t pos) {
+    assert(pos < size_);
+    words_[pos / 64] &= ~((uint64_t)1 << (pos % 64));
+  }
+
+  /** Clears the bit at position `pos` if `value` is `false`. */
+  void and_bit(uint64_t pos, bool value) {
+    assert(pos < size_);
+    words_[pos / 64] &= ~((uint64_t)!value << (pos % 64));
+  }
+
+  /** Sets the bits in `[start, end)`. */
+  void set_range(uint64_t start, uint64_t end) {
+    assert(start <= end && end <= size_);
+    for (uint64_t pos = start; pos < end;) {
+      auto bit = pos % 64;
+      auto n = std::min<uint64_t>(64 - bit, end - pos);
+      words_[pos / 64] |= mask(n) << bit;
+      pos += n;
+    }
+  }
+
+  /** Clears the bits that are not set in `bitmap`. */
+  Bitmap& operator&=(const Bitmap& bitmap) {
+    assert(bitmap.size_ == size_);
+    for (uint64_t w = 0; w < words_.size(); ++w)
+      words_[w] &= bitmap.words_[w];
+    return *this;
+  }
+
+  /** Clears the bits that are set in `bitmap`. */
+  void and_not(const Bitmap& bitmap) {
+    assert(bitmap.size_ == size_);
+    for (uint64_t w = 0; w < words_.size(); ++w)
+      words_[w] &= ~bitmap.words_[w];
+  }
+
+  /** Returns the number of set bits. */
+  uint64_t count() const {
+    uint64_t count = 0;
+    for (auto word : words_)
+      count += popcount(word);
+    return count;
+  }
+
+  /** Returns true if no bit is set. */
+  bool none() const {
+    for (auto word : words_) {
+      if (word != 0)
+        return false;
+    }
+    return true;
+  }
+
+  /**
+   * Returns the position of the first set bit at or after `pos`, or
+   * `size()` if there is none.
+   */
+  uint64_t next(uint64_t pos) const {
+    if (pos >= size_)
+      return size_;
+    auto w = pos / 64;
+    auto word = words_[w] & (~(uint64_t)0 << (pos % 64));
+    while (word == 0) {
+      if (++w == words_.size())
+        return size_;
+      word = words_[w];
+    }
+    return w * 64 + ctz(word);
+  }
+
+  /**
+   * Invokes `f(pos)` for the position of every set bit in `[start, end)`,
+   * in increasing order. Zero words are skipped as a whole.
+   */
+  template <class F>
+  void for_each(uint64_t start, uint64_t end, F f) const {
+    assert(start <= end && end <= size_);
+    if (start == end)
+      return;
+    auto last = (end - 1) / 64;
+    for (auto w = start / 64; w <= last; ++w) {
+      auto word = words_[w];
+      if (w == start / 64)
+        word &= ~(uint64_t)0 << (start % 64);
+      if (w == last && end % 64 != 0)
+        word &= mask(end % 64);
+      while (word != 0) {
+        f(w * 64 + ctz(word));
+        word &= word - 1;
+      }
+    }
+  }
+
+  /** Invokes `f(pos)` for the position of every set bit. */
+  template <class F>
+  void for_each(F f) const {
+    for_each(0, size_, f);
+  }
+
+  /** Returns a word with the `n` low bits set, for `n <= 64`. */
+  static uint64_t mask(uint64_t n) {
+    return (n == 64) ? ~(uint64_t)0 : ((uint64_t)1 << n) - 1;
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The number of bits. */
+  uint64_t size_ = 0;
+
+  /** The bits, packed into words. */
+  std::vector<uint64_t> words_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Returns the number of set bits of `word`. */
+  static uint64_t popcount(uint64_t word) {
+#ifdef _MSC_VER
+    return (uint64_t)__popcnt64(word);
+#else
+    return (uint64_t)__builtin_popcountll(word);
+#endif
+  }
+
+  /** Returns the position of the lowest set bit of the non-zero `word`. */
+  static uint64_t ctz(uint64_t word) {
+    assert(word != 0);
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanForward64(&idx, word);
+    return (uint64_t)idx;
+#else
+    return (uint64_t)__builtin_ctzll(word);
+#endif
+  }
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_BITMAP_H
@@ -35,11 +35,16 @@
 #ifndef TILEDB_COMPARATORS_H
 #define TILEDB_COMPARATORS_H
 
+#include <algorithm>
 #include <cinttypes>
+#include <cstring>
 #include <vector>
 
+#include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/array_schema/domain.h"
+#include "tiledb/sm/enums/datatype.h"
 #include "tiledb/sm/enums/layout.h"
+#include "tiledb/sm/misc/utils.h"
 #include "tiledb/sm/query/result_coords.h"
 
 using namespace tiledb::common;
@@ -164,6 +169,16 @@ class GlobalCmp {
    * @return `true` if `a` precedes `b` and `false` otherwise.
    */
   bool operator()(const ResultCoords& a, const ResultCoords& b) const {
+    // The Hilbert order ignores the space tiles, and breaks ties between
+    // equal Hilbert values in row-major order
+    if (cell_order_ == Layout::HILBERT) {
+      auto ha = domain_->hilbert_value(a);
+      auto hb = domain_->hilbert_value(b);
+      if (ha != hb)
+        return ha < hb;
+      return RowCmp(domain_)(a, b);
+    }
+
     if (tile_order_ == Layout::ROW_MAJOR) {
       for (unsigned d = 0; d < dim_num_; ++d) {
         // Not applicable to var-sized dimensions
@@ -267,6 +282,436 @@ class GlobalCmp {
   const std::vector<const QueryBuffer*>* buffs_;
 };
 
+/**
+ * Compares the coordinates of a single dimension of type `T`. The typed
+ * comparators below are built from instances of this class, so that the
+ * coordinate access and comparison are inlined instead of dispatched
+ * through the `Domain` per dimension.
+ */
+template <class T>
+class TypedDimCmp {
+ public:
+  /** Default constructor. */
+  TypedDimCmp()
+      : has_tile_extent_(false)
+      , domain_low_(0)
+      , tile_extent_(0) {
+  }
+
+  /** Constructor. */
+  explicit TypedDimCmp(const Dimension* dim)
+      : TypedDimCmp() {
+    if (!dim->tile_extent().empty()) {
+      has_tile_extent_ = true;
+      domain_low_ = *(const T*)dim->domain().data();
+      tile_extent_ = *(const T*)dim->tile_extent().data();
+    }
+  }
+
+  /** Compares the cell order of coordinates `a` and `b`. */
+  inline int cell_cmp(T a, T b) const {
+    if (a < b)
+      return -1;
+    if (a > b)
+      return 1;
+    return 0;
+  }
+
+  /** Compares the tile order of coordinates `a` and `b`. */
+  inline int tile_cmp(T a, T b) const {
+    if (!has_tile_extent_)
+      return 0;
+
+    auto ta = (uint64_t)((a - domain_low_) / tile_extent_);
+    auto tb = (uint64_t)((b - domain_low_) / tile_extent_);
+    if (ta < tb)
+      return -1;
+    if (ta > tb)
+      return 1;
+    return 0;
+  }
+
+  /** Compares the cell order of `a` and `b` on dimension `d`. */
+  inline int cell_cmp(
+      const ResultCoords& a, const ResultCoords& b, unsigned d) const {
+    return cell_cmp(
+        a.tile_->coord_value<T>(a.pos_, d), b.tile_->coord_value<T>(b.pos_, d));
+  }
+
+  /** Compares the tile order of `a` and `b` on dimension `d`. */
+  inline int tile_cmp(
+      const ResultCoords& a, const ResultCoords& b, unsigned d) const {
+    return tile_cmp(
+        a.tile_->coord_value<T>(a.pos_, d), b.tile_->coord_value<T>(b.pos_, d));
+  }
+
+ private:
+  /** `false` if the dimension has a null tile extent. */
+  bool has_tile_extent_;
+  /** The lower bound of the dimension domain. */
+  T domain_low_;
+  /** The tile extent of the dimension. */
+  T tile_extent_;
+};
+
+/**
+ * Specialization for string dimensions, which are compared lexicographically
+ * without copying the coordinates and do not participate in the tile order.
+ */
+template <>
+class TypedDimCmp<char> {
+ public:
+  /** Default constructor. */
+  TypedDimCmp() = default;
+
+  /** Constructor. */
+  explicit TypedDimCmp(const Dimension* dim) {
+    (void)dim;
+  }
+
+  /** Compares the cell order of `a` and `b` on dimension `d`. */
+  inline int cell_cmp(
+      const ResultCoords& a, const ResultCoords& b, unsigned d) const {
+    const char* ca = nullptr;
+    const char* cb = nullptr;
+    uint64_t size_a = 0, size_b = 0;
+    a.tile_->coord_string(a.pos_, d, &ca, &size_a);
+    b.tile_->coord_string(b.pos_, d, &cb, &size_b);
+    return utils::parse::compare(ca, size_a, cb, size_b);
+  }
+
+  /** Strings do not participate in the tile order. */
+  inline int tile_cmp(
+      const ResultCoords& a, const ResultCoords& b, unsigned d) const {
+    (void)a;
+    (void)b;
+    (void)d;
+    return 0;
+  }
+};
+
+/**
+ * Row-major comparator specialized for `N` dimensions, where the first
+ * dimension has type `T0` and the rest have type `T`. `T0` is `char` for
+ * a string first dimension.
+ */
+template <class T0, class T, unsigned N>
+class RowCmpTyped {
+ public:
+  /** Constructor. */
+  RowCmpTyped(const Domain* domain)
+      : dim_cmp_0_(domain->dimension(0)) {
+  }
+
+  /**
+   * Comparison operator.
+   *
+   * @param a The first coordinate.
+   * @param b The second coordinate.
+   * @return `true` if `a` precedes `b` and `false` otherwise.
+   */
+  bool operator()(const ResultCoords& a, const ResultCoords& b) const {
+    auto res = dim_cmp_0_.cell_cmp(a, b, 0);
+    if (res != 0)
+      return res == -1;
+
+    for (unsigned d = 1; d < N; ++d) {
+      res = dim_cmp_.cell_cmp(a, b, d);
+      if (res != 0)
+        return res == -1;
+    }
+
+    return false;
+  }
+
+ private:
+  /** Compares the first dimension. */
+  TypedDimCmp<T0> dim_cmp_0_;
+  /** Compares the rest of the dimensions. */
+  TypedDimCmp<T> dim_cmp_;
+};
+
+/**
+ * Col-major comparator specialized for `N` dimensions, where the first
+ * dimension has type `T0` and the rest have type `T`. `T0` is `char` for
+ * a string first dimension.
+ */
+template <class T0, class T, unsigned N>
+class ColCmpTyped {
+ public:
+  /** Constructor. */
+  ColCmpTyped(const Domain* domain)
+      : dim_cmp_0_(domain->dimension(0)) {
+  }
+
+  /**
+   * Comparison operator.
+   *
+   * @param a The first coordinate.
+   * @param b The second coordinate.
+   * @return `true` if `a` precedes `b` and `false` otherwise.
+   */
+  bool operator()(const ResultCoords& a, const ResultCoords& b) const {
+    for (unsigned d = N - 1; d > 0; --d) {
+      auto res = dim_cmp_.cell_cmp(a, b, d);
+      if (res != 0)
+        return res == -1;
+    }
+
+    return dim_cmp_0_.cell_cmp(a, b, 0) == -1;
+  }
+
+ private:
+  /** Compares the first dimension. */
+  TypedDimCmp<T0> dim_cmp_0_;
+  /** Compares the rest of the dimensions. */
+  TypedDimCmp<T> dim_cmp_;
+};
+
+/**
+ * Global order comparator specialized for `N` dimensions, where the first
+ * dimension has type `T0` and the rest have type `T`. `T0` is `char` for
+ * a string first dimension.
+ */
+template <class T0, class T, unsigned N>
+class GlobalCmpTyped {
+ public:
+  /** Constructor. */
+  GlobalCmpTyped(const Domain* domain)
+      : tile_order_(domain->tile_order())
+      , cell_order_(domain->cell_order())
+      , dim_cmp_0_(domain->dimension(0))
+      , buffs_(nullptr) {
+    for (unsigned d = 1; d < N; ++d)
+      dim_cmp_[d] = TypedDimCmp<T>(domain->dimension(d));
+  }
+
+  /**
+   * Constructor. Only applicable when `T0` is the same as `T`.
+   *
+   * @param domain The array domain.
+   * @param buffs The coordinate query buffers, one per dimension.
+   */
+  GlobalCmpTyped(
+      const Domain* domain, const std::vector<const QueryBuffer*>* buffs)
+      : GlobalCmpTyped(domain) {
+    buffs_ = buffs;
+  }
+
+  /**
+   * Comparison operator for a vector of `ResultCoords`.
+   *
+   * @param a The first coordinate.
+   * @param b The second coordinate.
+   * @return `true` if `a` precedes `b` and `false` otherwise.
+   */
+  bool operator()(const ResultCoords& a, const ResultCoords& b) const {
+    auto res = tile_order_cmp(a, b);
+    if (res != 0)
+      return res == -1;
+
+    return cell_order_cmp(a, b) == -1;
+  }
+
+  /**
+   * Positional comparison operator.
+   *
+   * @param a The first cell position.
+   * @param b The second cell position.
+   * @return `true` if cell at `a` across all coordinate buffers precedes
+   *     cell at `b`, and `false` otherwise.
+   */
+  bool operator()(uint64_t a, uint64_t b) const {
+    assert(buffs_ != nullptr);
+    auto res = 0;
+
+    // Compare tile order
+    if (tile_order_ == Layout::ROW_MAJOR) {
+      for (unsigned d = 0; d < N && res == 0; ++d)
+        res = dim_cmp(d).tile_cmp(coord(d, a), coord(d, b));
+    } else {
+      for (unsigned d = N; d > 0 && res == 0; --d)
+        res = dim_cmp(d - 1).tile_cmp(coord(d - 1, a), coord(d - 1, b));
+    }
+    if (res != 0)
+      return res == -1;
+
+    // Compare cell order
+    if (cell_order_ == Layout::ROW_MAJOR) {
+      for (unsigned d = 0; d < N && res == 0; ++d)
+        res = dim_cmp(d).cell_cmp(coord(d, a), coord(d, b));
+    } else {
+      for (unsigned d = N; d > 0 && res == 0; --d)
+        res = dim_cmp(d - 1).cell_cmp(coord(d - 1, a), coord(d - 1, b));
+    }
+
+    return res == -1;
+  }
+
+ private:
+  /** The tile order. */
+  Layout tile_order_;
+  /** The cell order. */
+  Layout cell_order_;
+  /** Compares the first dimension. */
+  TypedDimCmp<T0> dim_cmp_0_;
+  /** Compares the rest of the dimensions (the first element is unused). */
+  TypedDimCmp<T> dim_cmp_[N];
+  /** The coordinate buffers, one per dimension. */
+  const std::vector<const QueryBuffer*>* buffs_;
+
+  /** Compares the tile order of `a` and `b`. */
+  inline int tile_order_cmp(
+      const ResultCoords& a, const ResultCoords& b) const {
+    if (tile_order_ == Layout::ROW_MAJOR) {
+      auto res = dim_cmp_0_.tile_cmp(a, b, 0);
+      for (unsigned d = 1; d < N && res == 0; ++d)
+        res = dim_cmp_[d].tile_cmp(a, b, d);
+      return res;
+    }
+
+    auto res = 0;
+    for (unsigned d = N - 1; d > 0 && res == 0; --d)
+      res = dim_cmp_[d].tile_cmp(a, b, d);
+    return (res != 0) ? res : dim_cmp_0_.tile_cmp(a, b, 0);
+  }
+
+  /** Compares the cell order of `a` and `b`. */
+  inline int cell_order_cmp(
+      const ResultCoords& a, const ResultCoords& b) const {
+    if (cell_order_ == Layout::ROW_MAJOR) {
+      auto res = dim_cmp_0_.cell_cmp(a, b, 0);
+      for (unsigned d = 1; d < N && res == 0; ++d)
+        res = dim_cmp_[d].cell_cmp(a, b, d);
+      return res;
+    }
+
+    auto res = 0;
+    for (unsigned d = N - 1; d > 0 && res == 0; --d)
+      res = dim_cmp_[d].cell_cmp(a, b, d);
+    return (res != 0) ? res : dim_cmp_0_.cell_cmp(a, b, 0);
+  }
+
+  /** Returns the comparator of dimension `d`, assuming `T0` is `T`. */
+  inline const TypedDimCmp<T>& dim_cmp(unsigned d) const {
+    return (d == 0) ? dim_cmp_0_ : dim_cmp_[d];
+  }
+
+  /** Returns the coordinate at position `pos` of dimension `d`. */
+  inline T coord(unsigned d, uint64_t pos) const {
+    return static_cast<const T*>((*buffs_)[d]->buffer_)[pos];
+  }
+};
+
+/**
+ * Returns the type the typed comparators use for a dimension of type
+ * `type`, or `Datatype::ANY` if there is no specialization for it.
+ */
+inline Datatype typed_cmp_type(Datatype type) {
+  switch (type) {
+    case Datatype::INT32:
+    case Datatype::INT64:
+    case Datatype::UINT64:
+    case Datatype::FLOAT64:
+      return type;
+    default:
+      return datatype_is_datetime(type) ? Datatype::INT64 : Datatype::ANY;
+  }
+}
+
+/**
+ * Invokes `f->template run<T0, T, N>()` for `dim_num` (`N`) dimensions,
+ * where the first has type `T0` and the rest have type `T`.
+ *
+ * @return `false` if there is no specialization for `dim_num`.
+ */
+template <class T0, class T, class F>
+bool dispatch_typed_cmp(unsigned dim_num, F* f) {
+  switch (dim_num) {
+    case 1:
+      f->template run<T0, T, 1>();
+      return true;
+    case 2:
+      f->template run<T0, T, 2>();
+      return true;
+    case 3:
+      f->template run<T0, T, 3>();
+      return true;
+    case 4:
+      f->template run<T0, T, 4>();
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Picks the typed comparator parameters that match a domain of 1-4
+ * dimensions that all have one of the types int32, int64 (or datetime),
+ * uint64 or float64, and invokes `f->template run<T, T, N>()` with them,
+ * where `N` is the number of dimensions and `T` their type.
+ *
+ * @return `false` without invoking `f` if `domain` is not one of the
+ *     specialized cases, in which case the generic comparators must be used.
+ */
+template <class F>
+bool dispatch_typed_cmp(const Domain* domain, F* f) {
+  auto dim_num = domain->dim_num();
+  auto type = typed_cmp_type(domain->dimension(0)->type());
+  for (unsigned d = 1; d < dim_num; ++d) {
+    if (typed_cmp_type(domain->dimension(d)->type()) != type)
+      return false;
+  }
+
+  switch (type) {
+    case Datatype::INT32:
+      return dispatch_typed_cmp<int32_t, int32_t>(dim_num, f);
+    case Datatype::INT64:
+      return dispatch_typed_cmp<int64_t, int64_t>(dim_num, f);
+    case Datatype::UINT64:
+      return dispatch_typed_cmp<uint64_t, uint64_t>(dim_num, f);
+    case Datatype::FLOAT64:
+      return dispatch_typed_cmp<double, double>(dim_num, f);
+    default:
+      return false;
+  }
+}
+
+/**
+ * Same as `dispatch_typed_cmp()`, but for string-first domains, i.e.,
+ * a string dimension optionally followed by a dimension of type int32,
+ * int64 (or datetime), uint64 or float64. `T0` is `char` in the invocation
+ * of `f->template run<T0, T, N>()`.
+ */
+template <class F>
+bool dispatch_typed_cmp_string_first(const Domain* domain, F* f) {
+  auto dim_num = domain->dim_num();
+  if (domain->dimension(0)->type() != Datatype::STRING_ASCII || dim_num > 2)
+    return false;
+
+  if (dim_num == 1) {
+    f->template run<char, char, 1>();
+    return true;
+  }
+
+  switch (typed_cmp_type(domain->dimension(1)->type())) {
+    case Datatype::INT32:
+      f->template run<char, int32_t, 2>();
+      return true;
+    case Datatype::INT64:
+      f->template run<char, int64_t, 2>();
+      return true;
+    case Datatype::UINT64:
+      f->template run<char, uint64_t, 2>();
+      return true;
+    case Datatype::FLOAT64:
+      f->template run<char, double, 2>();
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace sm
 }  // namespace tiledb
 
@@ -405,6 +405,9 @@ const std::string global_order_str = "global-order";
 /** The string representation for the unordered layout. */
 const std::string unordered_str = "unordered";
 
+/** The string representation for the Hilbert layout. */
+const std::string hilbert_str = "hilbert";
+
 /** The string representation of null. */
 const std::string null_str = "null";
 
@@ -435,6 +438,42 @@ const std::string walkorder_preorder_str = "PREORDER";
 /** The string representation for WalkOrder postorder. */
 const std::string walkorder_postorder_str = "POSTORDER";
 
+/** The string representation for QueryConditionOp less-than. */
+const std::string query_condition_op_lt_str = "LT";
+
+/** The string representation for QueryConditionOp less-than-or-equal. */
+const std::string query_condition_op_le_str = "LE";
+
+/** The string representation for QueryConditionOp greater-than. */
+const std::string query_condition_op_gt_str = "GT";
+
+/** The string representation for QueryConditionOp greater-than-or-equal. */
+const std::string query_condition_op_ge_str = "GE";
+
+/** The string representation for QueryConditionOp equal. */
+const std::string query_condition_op_eq_str = "EQ";
+
+/** The string representation for QueryConditionOp not-equal. */
+const std::string query_condition_op_ne_str = "NE";
+
+/** The string representation for QueryConditionCombinationOp and. */
+const std::string query_condition_combination_op_and_str = "AND";
+
+/** The string representation for AggregateOp count. */
+const std::string aggregate_count_str = "AGGREGATE_COUNT";
+
+/** The string representation for AggregateOp sum. */
+const std::string aggregate_sum_str = "AGGREGATE_SUM";
+
+/** The string representation for AggregateOp min. */
+const std::string aggregate_min_str = "AGGREGATE_MIN";
+
+/** The string representation for AggregateOp max. */
+const std::string aggregate_max_str = "AGGREGATE_MAX";
+
+/** The string representation for AggregateOp mean. */
+const std::string aggregate_mean_str = "AGGREGATE_MEAN";
+
 /** The string representation for VFSMode read. */
 const std::string vfsmode_read_str = "VFS_READ";
 
@@ -449,7 +488,7 @@ const int32_t library_version[3] = {
     TILEDB_VERSION_MAJOR, TILEDB_VERSION_MINOR, TILEDB_VERSION_PATCH};
 
 /** The TileDB serialization format version number. */
-const uint32_t format_version = 6;
+const uint32_t format_version = 7;
 
 /** The maximum size of a tile chunk (unit of compression) in bytes. */
 const uint64_t max_tile_chunk_size = 64 * 1024;
@@ -393,6 +393,9 @@ extern const std::string global_order_str;
 /** The string representation for the unordered layout. */
 extern const std::string unordered_str;
 
+/** The string representation for the Hilbert layout. */
+extern const std::string hilbert_str;
+
 /** The string representation of null. */
 extern const std::string null_str;
 
@@ -423,6 +426,42 @@ extern const std::string walkorder_preorder_str;
 /** The string representation for WalkOrder postorder. */
 extern const std::string walkorder_postorder_str;
 
+/** The string representation for QueryConditionOp less-than. */
+extern const std::string query_condition_op_lt_str;
+
+/** The string representation for QueryConditionOp less-than-or-equal. */
+extern const std::string query_condition_op_le_str;
+
+/** The string representation for QueryConditionOp greater-than. */
+extern const std::string query_condition_op_gt_str;
+
+/** The string representation for QueryConditionOp greater-than-or-equal. */
+extern const std::string query_condition_op_ge_str;
+
+/** The string representation for QueryConditionOp equal. */
+extern const std::string query_condition_op_eq_str;
+
+/** The string representation for QueryConditionOp not-equal. */
+extern const std::string query_condition_op_ne_str;
+
+/** The string representation for QueryConditionCombinationOp and. */
+extern const std::string query_condition_combination_op_and_str;
+
+/** The string representation for AggregateOp count. */
+extern const std::string aggregate_count_str;
+
+/** The string representation for AggregateOp sum. */
+extern const std::string aggregate_sum_str;
+
+/** The string representation for AggregateOp min. */
+extern const std::string aggregate_min_str;
+
+/** The string representation for AggregateOp max. */
+extern const std::string aggregate_max_str;
+
+/** The string representation for AggregateOp mean. */
+extern const std::string aggregate_mean_str;
+
 /** The string representation for VFSMode read. */
 extern const std::string vfsmode_read_str;
 
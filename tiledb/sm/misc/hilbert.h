@@ -0,0 +1,209 @@
+/**
+ * @file   hilbert.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class Hilbert, which maps points of a `dim_num`-dimensional
+ * grid with `2^bits` cells per side to their position (Hilbert value) on the
+ * Hilbert curve that traverses the grid. The mapping follows J. Skilling,
+ * "Programming the Hilbert curve", AIP Conf. Proc. 707, 381 (2004).
+ */
+
+#ifndef TILEDB_HILBERT_H
+#define TILEDB_HILBERT_H
+
+#include <cassert>
+#include <cinttypes>
+
+namespace tiledb {
+namespace sm {
+
+/** Computes Hilbert values of points in a multi-dimensional grid. */
+class Hilbert {
+ public:
+  /* ********************************* */
+  /*         PUBLIC ATTRIBUTES         */
+  /* ********************************* */
+
+  /** The maximum number of dimensions, with one bit per dimension. */
+  static const unsigned max_dim_num = 63;
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor. The number of bits per dimension is the largest for which
+   * the Hilbert value of a point fits in 63 bits.
+   *
+   * @param dim_num The number of dimensions, in `[1, max_dim_num]`.
+   */
+  explicit Hilbert(unsigned dim_num)
+      : dim_num_(dim_num)
+      , bits_(63 / dim_num) {
+    assert(dim_num > 0 && dim_num <= max_dim_num);
+  }
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Returns the number of bits per dimension. */
+  unsigned bits() const {
+    return bits_;
+  }
+
+  /** Returns the largest coordinate value on every dimension of the grid. */
+  uint64_t max_bucket_val() const {
+    return ((uint64_t)1 << bits_) - 1;
+  }
+
+  /**
+   * Returns the Hilbert value of the input point.
+   *
+   * @param coords The `dim_num` coordinates of the point, each in
+   *     `[0, max_bucket_val()]`. They are overwritten.
+   * @return The Hilbert value, in `[0, 2^(bits * dim_num))`.
+   */
+  uint64_t coords_to_hilbert(uint64_t* coords) const {
+    axes_to_transpose(coords);
+
+    // Interleave the bits of the transposed coordinates, most significant
+    // bit first
+    uint64_t h = 0;
+    for (unsigned b = bits_; b > 0; --b) {
+      for (unsigned d = 0; d < dim_num_; ++d)
+        h = (h << 1) | ((coords[d] >> (b - 1)) & 1);
+    }
+
+    return h;
+  }
+
+  /**
+   * Returns the point whose Hilbert value is `h`, i.e. inverts
+   * `coords_to_hilbert`.
+   *
+   * @param h The Hilbert value, in `[0, 2^(bits * dim_num))`.
+   * @param coords The `dim_num` coordinates of the point.
+   */
+  void hilbert_to_coords(uint64_t h, uint64_t* coords) const {
+    // De-interleave the bits of the Hilbert value into the transposed
+    // coordinates
+    for (unsigned d = 0; d < dim_num_; ++d)
+      coords[d] = 0;
+    for (unsigned b = bits_; b > 0; --b) {
+      for (unsigned d = 0; d < dim_num_; ++d) {
+        auto shift = (b - 1) * dim_num_ + (dim_num_ - 1 - d);
+        coords[d] |= ((h >> shift) & 1) << (b - 1);
+      }
+    }
+
+    transpose_to_axes(coords);
+  }
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The number of dimensions. */
+  unsigned dim_num_;
+
+  /** The number of bits per dimension. */
+  unsigned bits_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Converts the input coordinates in place to the "transposed" form of
+   * their Hilbert value, whose bits interleaved across the dimensions
+   * form the Hilbert value.
+   */
+  void axes_to_transpose(uint64_t* x) const {
+    const uint64_t m = (uint64_t)1 << (bits_ - 1);
+
+    // Inverse undo
+    for (uint64_t q = m; q > 1; q >>= 1) {
+      const uint64_t p = q - 1;
+      for (unsigned d = 0; d < dim_num_; ++d) {
+        if (x[d] & q) {
+          x[0] ^= p;  // Invert
+        } else {
+          auto t = (x[0] ^ x[d]) & p;  // Exchange
+          x[0] ^= t;
+          x[d] ^= t;
+        }
+      }
+    }
+
+    // Gray encode
+    for (unsigned d = 1; d < dim_num_; ++d)
+      x[d] ^= x[d - 1];
+    uint64_t t = 0;
+    for (uint64_t q = m; q > 1; q >>= 1) {
+      if (x[dim_num_ - 1] & q)
+        t ^= q - 1;
+    }
+    for (unsigned d = 0; d < dim_num_; ++d)
+      x[d] ^= t;
+  }
+
+  /**
+   * Converts the "transposed" form of a Hilbert value in place to the
+   * coordinates of its point, inverting `axes_to_transpose`.
+   */
+  void transpose_to_axes(uint64_t* x) const {
+    const uint64_t n = (uint64_t)1 << bits_;
+
+    // Gray decode
+    uint64_t t = x[dim_num_ - 1] >> 1;
+    for (unsigned d = dim_num_ - 1; d > 0; --d)
+      x[d] ^= x[d - 1];
+    x[0] ^= t;
+
+    // Undo excess work
+    for (uint64_t q = 2; q != n; q <<= 1) {
+      const uint64_t p = q - 1;
+      for (unsigned d = dim_num_; d > 0; --d) {
+        if (x[d - 1] & q) {
+          x[0] ^= p;  // Invert
+        } else {
+          t = (x[0] ^ x[d - 1]) & p;  // Exchange
+          x[0] ^= t;
+          x[d - 1] ^= t;
+        }
+      }
+    }
+  }
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_HILBERT_H
@@ -0,0 +1,310 @@
+/**
+ * @file   range_filter.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines kernels that test a contiguous array of numeric
+ * coordinates against a closed range `[lo, hi]`, AND-ing the outcome into
+ * a result `Bitmap` a 64-bit word at a time. When the library is built with
+ * AVX2 (see `CheckAVX2Support.cmake`) the kernels compare a full 256-bit
+ * register of coordinates per instruction; otherwise they fall back to a
+ * scalar loop.
+ */
+
+#ifndef TILEDB_RANGE_FILTER_H
+#define TILEDB_RANGE_FILTER_H
+
+#include <algorithm>
+#include <cinttypes>
+#include <type_traits>
+
+#include "tiledb/sm/misc/bitmap.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace tiledb {
+namespace sm {
+namespace range_filter {
+
+/**
+ * Returns a mask with bit `i` set iff `coords[i]` lies in `[lo, hi]`, for
+ * every `i` in `[0, num)`, with `num <= 64`.
+ */
+template <class T>
+inline uint64_t in_range_bits(const T* coords, uint64_t num, T lo, T hi) {
+  uint64_t m = 0;
+  for (uint64_t i = 0; i < num; ++i)
+    m |= (uint64_t)(coords[i] >= lo && coords[i] <= hi) << i;
+  return m;
+}
+
+/**
+ * Word-at-a-time driver. For every `i` in `[start, end)`, clears bit `i` of
+ * `bitmap` if `coords[i]` lies outside `[lo, hi]`. The full words are
+ * computed by `word(coords)`, which returns the in-range mask of the 64
+ * coordinates at `coords`; the partial words at the ends are computed
+ * scalarly.
+ */
+template <class T, class WordFunc>
+inline void in_range_words(
+    const T* coords,
+    uint64_t start,
+    uint64_t end,
+    T lo,
+    T hi,
+    Bitmap* bitmap,
+    WordFunc word) {
+  auto words = bitmap->words();
+  for (uint64_t pos = start; pos < end;) {
+    auto bit = pos % 64;
+    auto n = std::min<uint64_t>(64 - bit, end - pos);
+    if (n == 64) {
+      words[pos / 64] &= word(coords + pos);
+    } else {
+      // Leave the bits outside `[pos, pos + n)` untouched
+      auto m = in_range_bits(coords + pos, n, lo, hi);
+      words[pos / 64] &= (m << bit) | ~(Bitmap::mask(n) << bit);
+    }
+    pos += n;
+  }
+}
+
+/** Scalar kernel. */
+template <class T>
+inline void in_range_scalar(
+    const T* coords, uint64_t start, uint64_t end, T lo, T hi, Bitmap* bitmap) {
+  in_range_words(
+      coords, start, end, lo, hi, bitmap, [&](const T* c) -> uint64_t {
+        return in_range_bits(c, 64, lo, hi);
+      });
+}
+
+#ifdef __AVX2__
+
+/**
+ * AVX2 register traits. `in_range` returns a mask with bit `i` set iff
+ * lane `i` of `c` lies in `[lo, hi]`. Unsigned types are flipped into the
+ * signed domain since AVX2 only provides signed integer comparisons.
+ */
+template <class T, class Enable = void>
+struct AVX2Traits {
+  static const bool supported = false;
+};
+
+/** Integer traits, parameterized on the lane width. */
+template <class T>
+struct AVX2Traits<
+    T,
+    typename std::enable_if<std::is_integral<T>::value>::type> {
+  static const bool supported = true;
+  static const unsigned lanes = 32 / sizeof(T);
+
+  static __m256i set1(T v) {
+    switch (sizeof(T)) {
+      case 1:
+        return _mm256_set1_epi8((char)flip(v));
+      case 2:
+        return _mm256_set1_epi16((short)flip(v));
+      case 4:
+        return _mm256_set1_epi32((int)flip(v));
+      default:
+        return _mm256_set1_epi64x((long long)flip(v));
+    }
+  }
+
+  static uint32_t in_range(const T* c, __m256i lo, __m256i hi) {
+    __m256i v = _mm256_loadu_si256((const __m256i*)c);
+    if (std::is_unsigned<T>::value)
+      v = _mm256_xor_si256(v, sign_bits());
+    __m256i out = _mm256_or_si256(cmpgt(lo, v), cmpgt(v, hi));
+    return ~movemask(out) & (uint32_t)((1ull << lanes) - 1);
+  }
+
+ private:
+  /** Maps `v` so that signed comparison preserves its order. */
+  static T flip(T v) {
+    return std::is_unsigned<T>::value ?
+               (T)(v ^ ((T)1 << (8 * sizeof(T) - 1))) :
+               v;
+  }
+
+  static __m256i sign_bits() {
+    switch (sizeof(T)) {
+      case 1:
+        return _mm256_set1_epi8((char)0x80);
+      case 2:
+        return _mm256_set1_epi16((short)0x8000);
+      case 4:
+        return _mm256_set1_epi32((int)0x80000000);
+      default:
+        return _mm256_set1_epi64x((long long)0x8000000000000000ull);
+    }
+  }
+
+  static __m256i cmpgt(__m256i a, __m256i b) {
+    switch (sizeof(T)) {
+      case 1:
+        return _mm256_cmpgt_epi8(a, b);
+      case 2:
+        return _mm256_cmpgt_epi16(a, b);
+      case 4:
+        return _mm256_cmpgt_epi32(a, b);
+      default:
+        return _mm256_cmpgt_epi64(a, b);
+    }
+  }
+
+  /** Returns one bit per lane of the all-ones/all-zeros lanes of `m`. */
+  static uint32_t movemask(__m256i m) {
+    switch (sizeof(T)) {
+      case 1:
+        return (uint32_t)_mm256_movemask_epi8(m);
+      case 2: {
+        // Narrow the 16-bit lanes to bytes, then gather the two
+        // 128-bit halves holding them into the low half
+        __m256i packed = _mm256_packs_epi16(m, m);
+        packed = _mm256_permute4x64_epi64(packed, 0x08);
+        return (uint32_t)_mm_movemask_epi8(_mm256_castsi256_si128(packed));
+      }
+      case 4:
+        return (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(m));
+      default:
+        return (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(m));
+    }
+  }
+};
+
+/** Single-precision floating point traits. */
+template <>
+struct AVX2Traits<float> {
+  static const bool supported = true;
+  static const unsigned lanes = 8;
+
+  static __m256 set1(float v) {
+    return _mm256_set1_ps(v);
+  }
+
+  static uint32_t in_range(const float* c, __m256 lo, __m256 hi) {
+    __m256 v = _mm256_loadu_ps(c);
+    __m256 in = _mm256_and_ps(
+        _mm256_cmp_ps(v, lo, _CMP_GE_OQ), _mm256_cmp_ps(v, hi, _CMP_LE_OQ));
+    return (uint32_t)_mm256_movemask_ps(in);
+  }
+};
+
+/** Double-precision floating point traits. */
+template <>
+struct AVX2Traits<double> {
+  static const bool supported = true;
+  static const unsigned lanes = 4;
+
+  static __m256d set1(double v) {
+    return _mm256_set1_pd(v);
+  }
+
+  static uint32_t in_range(const double* c, __m256d lo, __m256d hi) {
+    __m256d v = _mm256_loadu_pd(c);
+    __m256d in = _mm256_and_pd(
+        _mm256_cmp_pd(v, lo, _CMP_GE_OQ), _mm256_cmp_pd(v, hi, _CMP_LE_OQ));
+    return (uint32_t)_mm256_movemask_pd(in);
+  }
+};
+
+/** AVX2 kernel, computing a word from `64 / lanes` registers. */
+template <class T>
+inline void in_range_avx2(
+    const T* coords, uint64_t start, uint64_t end, T lo, T hi, Bitmap* bitmap) {
+  typedef AVX2Traits<T> Traits;
+  const auto lanes = Traits::lanes;
+  const auto vlo = Traits::set1(lo);
+  const auto vhi = Traits::set1(hi);
+  in_range_words(
+      coords, start, end, lo, hi, bitmap, [&](const T* c) -> uint64_t {
+        uint64_t m = 0;
+        for (unsigned l = 0; l < 64; l += lanes)
+          m |= (uint64_t)Traits::in_range(c + l, vlo, vhi) << l;
+        return m;
+      });
+}
+
+/** Selects the AVX2 kernel for the types it supports. */
+template <class T>
+inline void in_range_dispatch(
+    const T* coords,
+    uint64_t start,
+    uint64_t end,
+    T lo,
+    T hi,
+    Bitmap* bitmap,
+    std::true_type) {
+  in_range_avx2(coords, start, end, lo, hi, bitmap);
+}
+
+/** Falls back to the scalar kernel for the remaining types. */
+template <class T>
+inline void in_range_dispatch(
+    const T* coords,
+    uint64_t start,
+    uint64_t end,
+    T lo,
+    T hi,
+    Bitmap* bitmap,
+    std::false_type) {
+  in_range_scalar(coords, start, end, lo, hi, bitmap);
+}
+
+#endif
+
+/**
+ * For every `i` in `[start, end)`, clears bit `i` of `bitmap` if
+ * `coords[i]` lies outside `[lo, hi]` and leaves it unchanged otherwise.
+ * Uses the widest vector kernel the library was compiled for.
+ */
+template <class T>
+inline void in_range(
+    const T* coords, uint64_t start, uint64_t end, T lo, T hi, Bitmap* bitmap) {
+#ifdef __AVX2__
+  in_range_dispatch(
+      coords,
+      start,
+      end,
+      lo,
+      hi,
+      bitmap,
+      std::integral_constant<bool, AVX2Traits<T>::supported>());
+#else
+  in_range_scalar(coords, start, end, lo, hi, bitmap);
+#endif
+}
+
+}  // namespace range_filter
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_RANGE_FILTER_H
@@ -432,8 +432,13 @@ std::string to_str(const void* value, Datatype type) {
 }
 
 uint64_t common_prefix_size(const std::string& a, const std::string& b) {
-  auto size = std::min(a.size(), b.size());
-  for (size_t i = 0; i < size; ++i) {
+  return common_prefix_size(a.data(), a.size(), b.data(), b.size());
+}
+
+uint64_t common_prefix_size(
+    const char* a, uint64_t a_size, const char* b, uint64_t b_size) {
+  auto size = std::min(a_size, b_size);
+  for (uint64_t i = 0; i < size; ++i) {
     if (a[i] != b[i])
       return i;
   }
@@ -675,6 +680,24 @@ T safe_mul(T a, T b) {
   return prod;
 }
 
+int64_t safe_add(int64_t a, int64_t b) {
+  if (b > 0 && a > std::numeric_limits<int64_t>::max() - b)
+    return std::numeric_limits<int64_t>::max();
+  if (b < 0 && a < std::numeric_limits<int64_t>::min() - b)
+    return std::numeric_limits<int64_t>::min();
+  return a + b;
+}
+
+uint64_t safe_add(uint64_t a, uint64_t b) {
+  if (a > std::numeric_limits<uint64_t>::max() - b)
+    return std::numeric_limits<uint64_t>::max();
+  return a + b;
+}
+
+double safe_add(double a, double b) {
+  return a + b;
+}
+
 }  // namespace math
 
 // Explicit template instantiations
@@ -34,7 +34,9 @@
 #ifndef TILEDB_UTILS_H
 #define TILEDB_UTILS_H
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -156,6 +158,34 @@ std::string to_str(const void* value, Datatype type);
 /** Returns the size of the common prefix between `a` and `b`. */
 uint64_t common_prefix_size(const std::string& a, const std::string& b);
 
+/**
+ * Returns the size of the common prefix between the `a_size` bytes of `a`
+ * and the `b_size` bytes of `b`.
+ */
+uint64_t common_prefix_size(
+    const char* a, uint64_t a_size, const char* b, uint64_t b_size);
+
+/**
+ * Compares the `a_size` bytes of `a` with the `b_size` bytes of `b`
+ * in place, with the same ordering as `std::string::compare`.
+ *
+ * @return -1, 0 or 1 if `a` precedes, equals or follows `b`, respectively.
+ */
+inline int compare(
+    const char* a, uint64_t a_size, const char* b, uint64_t b_size) {
+  auto size = std::min(a_size, b_size);
+  auto res = (size == 0) ? 0 : std::memcmp(a, b, size);
+  if (res < 0)
+    return -1;
+  if (res > 0)
+    return 1;
+  if (a_size < b_size)
+    return -1;
+  if (a_size > b_size)
+    return 1;
+  return 0;
+}
+
 }  // namespace parse
 
 /* ********************************* */
@@ -263,6 +293,22 @@ void overlap(const T* a, const T* b, unsigned dim_num, T* o, bool* overlap);
 template <class T>
 double coverage(const T* a, const T* b, unsigned dim_num);
 
+/**
+ * Computes the minimum and maximum of the first `num` values of `data`,
+ * with `num > 0`. The loop carries no dependencies other than the two
+ * reductions, so that the compiler can vectorize it.
+ */
+template <class T>
+inline void min_max(const T* data, uint64_t num, T* min, T* max) {
+  T lo = data[0], hi = data[0];
+  for (uint64_t i = 1; i < num; ++i) {
+    lo = (data[i] < lo) ? data[i] : lo;
+    hi = (data[i] > hi) ? data[i] : hi;
+  }
+  *min = lo;
+  *max = hi;
+}
+
 }  // namespace geometry
 
 /* ********************************* */
@@ -315,6 +361,22 @@ double log(double b, double x);
 template <class T>
 T safe_mul(T a, T b);
 
+/**
+ * Computes a + b, but it checks for overflow. In case the sum overflows,
+ * it returns std::numeric_limits<int64_t>::max() (or ::min() if it
+ * overflows negatively).
+ */
+int64_t safe_add(int64_t a, int64_t b);
+
+/**
+ * Computes a + b, but it checks for overflow. In case the sum overflows,
+ * it returns std::numeric_limits<uint64_t>::max().
+ */
+uint64_t safe_add(uint64_t a, uint64_t b);
+
+/** Computes a + b. Real numbers overflow to infinity. */
+double safe_add(double a, double b);
+
 }  // namespace math
 
 /* ********************************* */
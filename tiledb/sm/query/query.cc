@@ -87,6 +87,27 @@ Query::~Query() = default;
 /*               API              */
 /* ****************************** */
 
+Status Query::add_aggregate(const std::string& name, AggregateOp op) {
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot add aggregate; Only applicable to read queries"));
+
+  return reader_.add_aggregate(name, op);
+}
+
+Status Query::get_aggregate(
+    const std::string& name, AggregateOp op, void* value) const {
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot get aggregate; Only applicable to read queries"));
+
+  if (status_ != QueryStatus::COMPLETED)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot get aggregate; The query has not completed"));
+
+  return reader_.get_aggregate(name, op, value);
+}
+
 Status Query::add_range(
     unsigned dim_idx, const void* start, const void* end, const void* stride) {
   if (dim_idx >= array_->array_schema()->dim_num())
@@ -619,10 +640,33 @@ Status Query::set_est_result_size(
 }
 
 Status Query::set_layout(Layout layout) {
+  if (layout == Layout::HILBERT)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set layout; Hilbert order is not applicable to queries"));
+
   layout_ = layout;
   return Status::Ok();
 }
 
+Status Query::set_condition(const QueryCondition& condition) {
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set query condition; Only applicable to read queries"));
+
+  return reader_.set_condition(condition);
+}
+
+Status Query::set_point_lookups(
+    const void** coords, uint64_t point_num, uint8_t* found) {
+  if (type_ != QueryType::READ)
+    return LOG_STATUS(Status::QueryError(
+        "Cannot set point lookups; Only applicable to read queries"));
+
+  auto dim_num = array_->array_schema()->dim_num();
+  std::vector<const void*> dim_coords(coords, coords + dim_num);
+  return reader_.set_point_lookups(dim_coords, point_num, found);
+}
+
 Status Query::set_sparse_mode(bool sparse_mode) {
   if (type_ != QueryType::READ)
     return LOG_STATUS(Status::QueryError(
@@ -56,6 +56,7 @@ class Array;
 class Subarray;
 class StorageManager;
 
+enum class AggregateOp : uint8_t;
 enum class QueryStatus : uint8_t;
 enum class QueryType : uint8_t;
 
@@ -115,6 +116,28 @@ class Query {
   /*                 API               */
   /* ********************************* */
 
+  /**
+   * Adds an aggregate to be computed over the cells of the subarray of a
+   * read query. A query with aggregates does not return any cells, so it
+   * must not have any buffers set.
+   *
+   * @param name The attribute name.
+   * @param op The aggregate operation.
+   * @return Status
+   */
+  Status add_aggregate(const std::string& name, AggregateOp op);
+
+  /**
+   * Retrieves the value of an aggregate of a completed read query.
+   *
+   * @param name The attribute name.
+   * @param op The aggregate operation.
+   * @param value The aggregate value to be retrieved.
+   * @return Status
+   */
+  Status get_aggregate(
+      const std::string& name, AggregateOp op, void* value) const;
+
   /**
    * Adds a range to the (read/write) query on the input dimension,
    * in the form of (start, end, stride).
@@ -410,6 +433,30 @@ class Query {
    */
   Status set_layout(Layout layout);
 
+  /**
+   * Sets the condition for filtering results in a read query. Only the cells
+   * whose attribute values satisfy the condition are returned.
+   *
+   * @param condition The condition object.
+   * @return Status
+   */
+  Status set_condition(const QueryCondition& condition);
+
+  /**
+   * Turns a read query into a batch of point lookups, whose results are
+   * returned in the input order of the points. See
+   * `Reader::set_point_lookups`.
+   *
+   * @param coords The point coordinates, one buffer per dimension in the
+   *     order of the array schema, each storing `point_num` coordinates.
+   * @param point_num The number of points.
+   * @param found Set to `1` for every point that has a cell, and to `0`
+   *     otherwise.
+   * @return Status
+   */
+  Status set_point_lookups(
+      const void** coords, uint64_t point_num, uint8_t* found);
+
   /**
    * This is applicable only to dense arrays (errors out for sparse arrays),
    * and only in the case where the array is opened in a way that all its
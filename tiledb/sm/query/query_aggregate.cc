@@ -0,0 +1,495 @@
+/**
+ * @file   query_aggregate.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class QueryAggregate.
+ */
+
+#include "tiledb/sm/query/query_aggregate.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/array_schema/attribute.h"
+#include "tiledb/sm/enums/aggregate_op.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/query/result_cell_slab.h"
+#include "tiledb/sm/query/result_tile.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*        HELPER FUNCTIONS        */
+/* ****************************** */
+
+namespace {
+
+/** Returns `true` if `v` is NaN; always `false` for non-real types. */
+template <class T>
+inline typename std::enable_if<std::is_floating_point<T>::value, bool>::type
+is_nan(T v) {
+  return std::isnan(v);
+}
+
+template <class T>
+inline typename std::enable_if<!std::is_floating_point<T>::value, bool>::type
+is_nan(T) {
+  return false;
+}
+
+/**
+ * Adds `b` to `*a`. Returns `false` and leaves `*a` unchanged if the
+ * integer sum overflows. Real sums overflow to infinity.
+ */
+inline bool add_sum(int64_t* a, int64_t b) {
+  if ((b > 0 && *a > std::numeric_limits<int64_t>::max() - b) ||
+      (b < 0 && *a < std::numeric_limits<int64_t>::min() - b))
+    return false;
+  *a += b;
+  return true;
+}
+
+inline bool add_sum(uint64_t* a, uint64_t b) {
+  if (*a > std::numeric_limits<uint64_t>::max() - b)
+    return false;
+  *a += b;
+  return true;
+}
+
+inline bool add_sum(double* a, double b) {
+  *a += b;
+  return true;
+}
+
+}  // namespace
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+QueryAggregate::QueryAggregate(const std::string& field_name, AggregateOp op)
+    : field_name_(field_name)
+    , op_(op)
+    , type_(Datatype::ANY)
+    , count_(0)
+    , sum_(sizeof(uint64_t), 0)
+    , sum_overflow_(false) {
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status QueryAggregate::check(const ArraySchema* array_schema) const {
+  const auto attr = array_schema->attribute(field_name_);
+  if (attr == nullptr)
+    return LOG_STATUS(Status::QueryError(
+        "Invalid aggregate; Unknown attribute '" + field_name_ + "'"));
+
+  if (op_ == AggregateOp::AGGREGATE_COUNT)
+    return Status::Ok();
+
+  const auto type = attr->type();
+  if (attr->var_size() || attr->cell_val_num() != 1)
+    return LOG_STATUS(Status::QueryError(
+        "Invalid aggregate; Attribute '" + field_name_ +
+        "' must store a single fixed-sized value per cell"));
+
+  if (!datatype_is_integer(type) && !datatype_is_real(type) &&
+      !datatype_is_datetime(type))
+    return LOG_STATUS(Status::QueryError(
+        "Invalid aggregate; Unsupported type '" + datatype_str(type) +
+        "' for attribute '" + field_name_ + "'"));
+
+  return Status::Ok();
+}
+
+void QueryAggregate::reset(const ArraySchema* array_schema) {
+  const auto attr = array_schema->attribute(field_name_);
+  assert(attr != nullptr);
+  type_ = attr->type();
+  count_ = 0;
+  sum_.assign(sizeof(uint64_t), 0);
+  sum_overflow_ = false;
+  min_.clear();
+  max_.clear();
+}
+
+const std::string& QueryAggregate::field_name() const {
+  return field_name_;
+}
+
+AggregateOp QueryAggregate::op() const {
+  return op_;
+}
+
+bool QueryAggregate::needs_values() const {
+  return op_ != AggregateOp::AGGREGATE_COUNT;
+}
+
+bool QueryAggregate::has_tile_stats(const FragmentMetadata& meta) const {
+  switch (op_) {
+    case AggregateOp::AGGREGATE_COUNT:
+      return true;
+    case AggregateOp::AGGREGATE_SUM:
+    case AggregateOp::AGGREGATE_MEAN:
+      return meta.has_tile_sum(field_name_);
+    case AggregateOp::AGGREGATE_MIN:
+    case AggregateOp::AGGREGATE_MAX:
+      return meta.has_tile_min_max(field_name_);
+    default:
+      return false;
+  }
+}
+
+Status QueryAggregate::tile_stats_exact(
+    const FragmentMetadata& meta, uint64_t tile_idx, bool* exact) const {
+  *exact = true;
+  if ((op_ != AggregateOp::AGGREGATE_SUM &&
+       op_ != AggregateOp::AGGREGATE_MEAN) ||
+      datatype_is_real(type_))
+    return Status::Ok();
+
+  const void* sum = nullptr;
+  RETURN_NOT_OK(meta.get_tile_sum(field_name_, tile_idx, &sum));
+  if (type_ == Datatype::UINT8 || type_ == Datatype::UINT16 ||
+      type_ == Datatype::UINT32 || type_ == Datatype::UINT64) {
+    uint64_t s;
+    std::memcpy(&s, sum, sizeof(uint64_t));
+    *exact = s != std::numeric_limits<uint64_t>::max();
+  } else {
+    int64_t s;
+    std::memcpy(&s, sum, sizeof(int64_t));
+    *exact = s != std::numeric_limits<int64_t>::max() &&
+             s != std::numeric_limits<int64_t>::min();
+  }
+
+  return Status::Ok();
+}
+
+Status QueryAggregate::aggregate_tile_stats(
+    const FragmentMetadata& meta, uint64_t tile_idx) {
+  const void *sum = nullptr, *min = nullptr, *max = nullptr;
+  uint64_t min_size = 0, max_size = 0;
+  switch (op_) {
+    case AggregateOp::AGGREGATE_COUNT:
+      break;
+    case AggregateOp::AGGREGATE_SUM:
+    case AggregateOp::AGGREGATE_MEAN:
+      RETURN_NOT_OK(meta.get_tile_sum(field_name_, tile_idx, &sum));
+      break;
+    case AggregateOp::AGGREGATE_MIN:
+    case AggregateOp::AGGREGATE_MAX:
+      RETURN_NOT_OK(meta.get_tile_min(field_name_, tile_idx, &min, &min_size));
+      RETURN_NOT_OK(meta.get_tile_max(field_name_, tile_idx, &max, &max_size));
+      assert(min_size == datatype_size(type_));
+      assert(max_size == datatype_size(type_));
+      break;
+    default:
+      return LOG_STATUS(
+          Status::QueryError("Cannot aggregate tile; Unknown aggregate"));
+  }
+
+  merge(meta.cell_num(tile_idx), sum, false, min, max);
+
+  return Status::Ok();
+}
+
+Status QueryAggregate::aggregate_cells(
+    const std::vector<ResultCellSlab>& result_cell_slabs) {
+  if (op_ == AggregateOp::AGGREGATE_COUNT) {
+    for (const auto& slab : result_cell_slabs)
+      count_ += slab.length_;
+    return Status::Ok();
+  }
+
+  switch (type_) {
+    case Datatype::INT8:
+      return aggregate_cells<int8_t, int64_t>(result_cell_slabs);
+    case Datatype::UINT8:
+      return aggregate_cells<uint8_t, uint64_t>(result_cell_slabs);
+    case Datatype::INT16:
+      return aggregate_cells<int16_t, int64_t>(result_cell_slabs);
+    case Datatype::UINT16:
+      return aggregate_cells<uint16_t, uint64_t>(result_cell_slabs);
+    case Datatype::INT32:
+      return aggregate_cells<int32_t, int64_t>(result_cell_slabs);
+    case Datatype::UINT32:
+      return aggregate_cells<uint32_t, uint64_t>(result_cell_slabs);
+    case Datatype::INT64:
+      return aggregate_cells<int64_t, int64_t>(result_cell_slabs);
+    case Datatype::UINT64:
+      return aggregate_cells<uint64_t, uint64_t>(result_cell_slabs);
+    case Datatype::FLOAT32:
+      return aggregate_cells<float, double>(result_cell_slabs);
+    case Datatype::FLOAT64:
+      return aggregate_cells<double, double>(result_cell_slabs);
+    case Datatype::DATETIME_YEAR:
+    case Datatype::DATETIME_MONTH:
+    case Datatype::DATETIME_WEEK:
+    case Datatype::DATETIME_DAY:
+    case Datatype::DATETIME_HR:
+    case Datatype::DATETIME_MIN:
+    case Datatype::DATETIME_SEC:
+    case Datatype::DATETIME_MS:
+    case Datatype::DATETIME_US:
+    case Datatype::DATETIME_NS:
+    case Datatype::DATETIME_PS:
+    case Datatype::DATETIME_FS:
+    case Datatype::DATETIME_AS:
+      return aggregate_cells<int64_t, int64_t>(result_cell_slabs);
+    default:
+      return LOG_STATUS(Status::QueryError(
+          "Cannot aggregate cells; Unsupported datatype " +
+          datatype_str(type_)));
+  }
+}
+
+void QueryAggregate::merge(const QueryAggregate& rhs) {
+  assert(rhs.field_name_ == field_name_ && rhs.op_ == op_);
+  merge(
+      rhs.count_,
+      rhs.sum_.data(),
+      rhs.sum_overflow_,
+      rhs.min_.empty() ? nullptr : rhs.min_.data(),
+      rhs.max_.empty() ? nullptr : rhs.max_.data());
+}
+
+Status QueryAggregate::get_value(void* value) const {
+  switch (op_) {
+    case AggregateOp::AGGREGATE_COUNT:
+      std::memcpy(value, &count_, sizeof(uint64_t));
+      break;
+    case AggregateOp::AGGREGATE_SUM:
+      if (sum_overflow_)
+        return LOG_STATUS(Status::QueryError(
+            "Cannot get aggregate value; The sum of attribute '" +
+            field_name_ + "' overflows"));
+      std::memcpy(value, sum_.data(), sum_.size());
+      break;
+    case AggregateOp::AGGREGATE_MIN:
+      if (!min_.empty())
+        std::memcpy(value, min_.data(), min_.size());
+      break;
+    case AggregateOp::AGGREGATE_MAX:
+      if (!max_.empty())
+        std::memcpy(value, max_.data(), max_.size());
+      break;
+    case AggregateOp::AGGREGATE_MEAN: {
+      if (sum_overflow_)
+        return LOG_STATUS(Status::QueryError(
+            "Cannot get aggregate value; The sum of attribute '" +
+            field_name_ + "' overflows"));
+      double sum = 0;
+      if (datatype_is_real(type_)) {
+        std::memcpy(&sum, sum_.data(), sizeof(double));
+      } else if (
+          type_ == Datatype::UINT8 || type_ == Datatype::UINT16 ||
+          type_ == Datatype::UINT32 || type_ == Datatype::UINT64) {
+        uint64_t s;
+        std::memcpy(&s, sum_.data(), sizeof(uint64_t));
+        sum = (double)s;
+      } else {
+        int64_t s;
+        std::memcpy(&s, sum_.data(), sizeof(int64_t));
+        sum = (double)s;
+      }
+      const double mean = (count_ == 0) ?
+                              std::numeric_limits<double>::quiet_NaN() :
+                              sum / count_;
+      std::memcpy(value, &mean, sizeof(double));
+      break;
+    }
+    default:
+      return LOG_STATUS(Status::QueryError(
+          "Cannot get aggregate value; Unknown aggregate"));
+  }
+
+  return Status::Ok();
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+void QueryAggregate::merge(
+    uint64_t count,
+    const void* sum,
+    bool sum_overflow,
+    const void* min,
+    const void* max) {
+  if (op_ == AggregateOp::AGGREGATE_COUNT) {
+    count_ += count;
+    return;
+  }
+
+  switch (type_) {
+    case Datatype::INT8:
+      return merge<int8_t, int64_t>(count, sum, sum_overflow, min, max);
+    case Datatype::UINT8:
+      return merge<uint8_t, uint64_t>(count, sum, sum_overflow, min, max);
+    case Datatype::INT16:
+      return merge<int16_t, int64_t>(count, sum, sum_overflow, min, max);
+    case Datatype::UINT16:
+      return merge<uint16_t, uint64_t>(count, sum, sum_overflow, min, max);
+    case Datatype::INT32:
+      return merge<int32_t, int64_t>(count, sum, sum_overflow, min, max);
+    case Datatype::UINT32:
+      return merge<uint32_t, uint64_t>(count, sum, sum_overflow, min, max);
+    case Datatype::INT64:
+      return merge<int64_t, int64_t>(count, sum, sum_overflow, min, max);
+    case Datatype::UINT64:
+      return merge<uint64_t, uint64_t>(count, sum, sum_overflow, min, max);
+    case Datatype::FLOAT32:
+      return merge<float, double>(count, sum, sum_overflow, min, max);
+    case Datatype::FLOAT64:
+      return merge<double, double>(count, sum, sum_overflow, min, max);
+    case Datatype::DATETIME_YEAR:
+    case Datatype::DATETIME_MONTH:
+    case Datatype::DATETIME_WEEK:
+    case Datatype::DATETIME_DAY:
+    case Datatype::DATETIME_HR:
+    case Datatype::DATETIME_MIN:
+    case Datatype::DATETIME_SEC:
+    case Datatype::DATETIME_MS:
+    case Datatype::DATETIME_US:
+    case Datatype::DATETIME_NS:
+    case Datatype::DATETIME_PS:
+    case Datatype::DATETIME_FS:
+    case Datatype::DATETIME_AS:
+      return merge<int64_t, int64_t>(count, sum, sum_overflow, min, max);
+    default:
+      assert(false);
+  }
+}
+
+template <class T, class SumT>
+void QueryAggregate::merge(
+    uint64_t count,
+    const void* sum,
+    bool sum_overflow,
+    const void* min,
+    const void* max) {
+  count_ += count;
+
+  // An overflowed sum stays overflowed
+  if (sum != nullptr && !sum_overflow_) {
+    SumT lhs = 0, rhs = 0;
+    std::memcpy(&lhs, sum_.data(), sizeof(SumT));
+    std::memcpy(&rhs, sum, sizeof(SumT));
+    sum_overflow_ = sum_overflow || !add_sum(&lhs, rhs);
+    std::memcpy(sum_.data(), &lhs, sizeof(SumT));
+  }
+
+  // NaN values are replaced by any other value
+  if (min != nullptr) {
+    T lhs = 0, rhs = 0;
+    std::memcpy(&rhs, min, sizeof(T));
+    if (!min_.empty())
+      std::memcpy(&lhs, min_.data(), sizeof(T));
+    if (min_.empty() || rhs < lhs || is_nan(lhs)) {
+      min_.resize(sizeof(T));
+      std::memcpy(min_.data(), &rhs, sizeof(T));
+    }
+  }
+
+  if (max != nullptr) {
+    T lhs = 0, rhs = 0;
+    std::memcpy(&rhs, max, sizeof(T));
+    if (!max_.empty())
+      std::memcpy(&lhs, max_.data(), sizeof(T));
+    if (max_.empty() || rhs > lhs || is_nan(lhs)) {
+      max_.resize(sizeof(T));
+      std::memcpy(max_.data(), &rhs, sizeof(T));
+    }
+  }
+}
+
+template <class T, class SumT>
+Status QueryAggregate::aggregate_cells(
+    const std::vector<ResultCellSlab>& result_cell_slabs) {
+  const bool compute_sum = op_ == AggregateOp::AGGREGATE_SUM ||
+                           op_ == AggregateOp::AGGREGATE_MEAN;
+  uint64_t count = 0;
+  SumT sum = 0;
+  bool sum_overflow = false;
+  T min = 0, max = 0;
+  bool has_min_max = false;
+  for (const auto& slab : result_cell_slabs) {
+    const auto tile_pair = slab.tile_->tile_pair(field_name_);
+    if (tile_pair == nullptr)
+      return LOG_STATUS(Status::QueryError(
+          "Cannot aggregate cells; Tile for attribute '" + field_name_ +
+          "' is not loaded"));
+
+    void* buffer = nullptr;
+    RETURN_NOT_OK(tile_pair->first.chunked_buffer()->get_contiguous(&buffer));
+    const auto values = static_cast<const T*>(buffer) + slab.start_;
+
+    count += slab.length_;
+    if (compute_sum) {
+      for (uint64_t c = 0; c < slab.length_ && !sum_overflow; ++c)
+        sum_overflow = !add_sum(&sum, (SumT)values[c]);
+      continue;
+    }
+
+    // NaN values do not participate in the minimum/maximum computation,
+    // unless all values are NaN
+    for (uint64_t c = 0; c < slab.length_; ++c) {
+      const T v = values[c];
+      if (!has_min_max || is_nan(min)) {
+        min = max = v;
+        has_min_max = true;
+      } else if (v < min) {
+        min = v;
+      } else if (v > max) {
+        max = v;
+      }
+    }
+  }
+
+  merge<T, SumT>(
+      count,
+      compute_sum ? &sum : nullptr,
+      sum_overflow,
+      has_min_max ? &min : nullptr,
+      has_min_max ? &max : nullptr);
+
+  return Status::Ok();
+}
+
+}  // namespace sm
+}  // namespace tiledb
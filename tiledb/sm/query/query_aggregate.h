@@ -0,0 +1,236 @@
+/**
+ * @file   query_aggregate.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class QueryAggregate.
+ */
+
+#ifndef TILEDB_QUERY_AGGREGATE_H
+#define TILEDB_QUERY_AGGREGATE_H
+
+#include <string>
+#include <vector>
+
+#include "tiledb/common/status.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class ArraySchema;
+class FragmentMetadata;
+struct ResultCellSlab;
+
+enum class AggregateOp : uint8_t;
+enum class Datatype : uint8_t;
+
+/**
+ * An aggregate over the values of an attribute, computed by the reader
+ * directly on the result tiles (or on the tile statistics stored in the
+ * fragment metadata) instead of materializing the results in user
+ * buffers. Partial aggregates computed independently, e.g., one per
+ * result tile, are combined with `merge`.
+ *
+ * The aggregate values have the following types:
+ *   - COUNT: `uint64_t`
+ *   - SUM: `int64_t` for signed integer and datetime attributes,
+ *     `uint64_t` for unsigned integer attributes and `double` for real
+ *     attributes. Retrieving an integer sum that overflows is an error.
+ *   - MIN/MAX: the attribute type. NaN values are ignored.
+ *   - MEAN: `double`. Like SUM, it is an error if the integer sum of the
+ *     values overflows.
+ */
+class QueryAggregate {
+ public:
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param field_name The attribute name.
+   * @param op The aggregate operation.
+   */
+  QueryAggregate(const std::string& field_name, AggregateOp op);
+
+  /** Default copy constructor. */
+  QueryAggregate(const QueryAggregate& rhs) = default;
+
+  /** Default move constructor. */
+  QueryAggregate(QueryAggregate&& rhs) = default;
+
+  /** Default destructor. */
+  ~QueryAggregate() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Default copy-assign operator. */
+  QueryAggregate& operator=(const QueryAggregate& rhs) = default;
+
+  /** Default move-assign operator. */
+  QueryAggregate& operator=(QueryAggregate&& rhs) = default;
+
+  /**
+   * Checks that the aggregate is applicable to the input array schema.
+   * COUNT applies to any attribute. The other aggregates apply only to
+   * numeric and datetime attributes storing a single value per cell.
+   */
+  Status check(const ArraySchema* array_schema) const;
+
+  /**
+   * Resets the aggregate to the state of an empty set of cells. The
+   * aggregate must have been checked against `array_schema`.
+   */
+  void reset(const ArraySchema* array_schema);
+
+  /** Returns the attribute name. */
+  const std::string& field_name() const;
+
+  /** Returns the aggregate operation. */
+  AggregateOp op() const;
+
+  /** Returns `true` if the aggregate needs the attribute values. */
+  bool needs_values() const;
+
+  /**
+   * Returns `true` if the input fragment stores the tile statistics this
+   * aggregate can be computed from.
+   */
+  bool has_tile_stats(const FragmentMetadata& meta) const;
+
+  /**
+   * Checks whether the statistics of the input tile are exact for this
+   * aggregate. The integer tile sums saturate on overflow, so a tile whose
+   * sum is at the limit of its type must be aggregated from its cells.
+   *
+   * @param meta The metadata of the fragment the tile belongs to.
+   * @param tile_idx The index of the tile in the fragment.
+   * @param exact Set to `true` if the tile statistics are exact.
+   * @return Status
+   */
+  Status tile_stats_exact(
+      const FragmentMetadata& meta, uint64_t tile_idx, bool* exact) const;
+
+  /**
+   * Aggregates all the cells of the input tile from the tile statistics
+   * of the fragment, which must have been loaded.
+   *
+   * @param meta The metadata of the fragment the tile belongs to.
+   * @param tile_idx The index of the tile in the fragment.
+   * @return Status
+   */
+  Status aggregate_tile_stats(const FragmentMetadata& meta, uint64_t tile_idx);
+
+  /**
+   * Aggregates the cells of the input result cell slabs. The attribute
+   * tiles of the slabs must be loaded and unfiltered.
+   *
+   * @param result_cell_slabs The result cell slabs.
+   * @return Status
+   */
+  Status aggregate_cells(const std::vector<ResultCellSlab>& result_cell_slabs);
+
+  /** Merges the partial aggregate `rhs` into this aggregate. */
+  void merge(const QueryAggregate& rhs);
+
+  /**
+   * Retrieves the aggregate value (see the class description for the
+   * value types). MIN and MAX leave `value` unchanged if no cells were
+   * aggregated, whereas MEAN returns NaN. Returns an error for SUM and
+   * MEAN if the integer sum overflowed.
+   */
+  Status get_value(void* value) const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The attribute name. */
+  std::string field_name_;
+
+  /** The aggregate operation. */
+  AggregateOp op_;
+
+  /** The attribute type. */
+  Datatype type_;
+
+  /** The number of aggregated cells. */
+  uint64_t count_;
+
+  /** The sum of the aggregated values (8 bytes, see the class description). */
+  std::vector<uint8_t> sum_;
+
+  /** Whether the integer sum of the aggregated values overflowed. */
+  bool sum_overflow_;
+
+  /** The minimum aggregated value. Empty if no value was aggregated. */
+  std::vector<uint8_t> min_;
+
+  /** The maximum aggregated value. Empty if no value was aggregated. */
+  std::vector<uint8_t> max_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Merges a partial aggregate given by its cell count, sum, minimum and
+   * maximum value into this aggregate. `sum`, `min` and `max` may be
+   * `nullptr` if not needed by the operation. `sum_overflow` is `true` if
+   * the partial sum overflowed.
+   */
+  void merge(
+      uint64_t count,
+      const void* sum,
+      bool sum_overflow,
+      const void* min,
+      const void* max);
+
+  /** Merges a partial aggregate on an attribute of type `T`. */
+  template <class T, class SumT>
+  void merge(
+      uint64_t count,
+      const void* sum,
+      bool sum_overflow,
+      const void* min,
+      const void* max);
+
+  /** Aggregates the values of the result cell slabs of type `T`. */
+  template <class T, class SumT>
+  Status aggregate_cells(const std::vector<ResultCellSlab>& result_cell_slabs);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_QUERY_AGGREGATE_H
@@ -0,0 +1,518 @@
+/**
+ * @file   query_condition.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class QueryCondition.
+ */
+
+#include "tiledb/sm/query/query_condition.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/array_schema/attribute.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/enums/query_condition_combination_op.h"
+#include "tiledb/sm/enums/query_condition_op.h"
+#include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/bitmap.h"
+#include "tiledb/sm/query/result_tile.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+/* ****************************** */
+/*        HELPER FUNCTIONS        */
+/* ****************************** */
+
+namespace {
+
+/** Returns the result of `lhs <op> rhs`. */
+template <class T>
+inline bool cmp(const T& lhs, const T& rhs, QueryConditionOp op) {
+  switch (op) {
+    case QueryConditionOp::LT:
+      return lhs < rhs;
+    case QueryConditionOp::LE:
+      return lhs <= rhs;
+    case QueryConditionOp::GT:
+      return lhs > rhs;
+    case QueryConditionOp::GE:
+      return lhs >= rhs;
+    case QueryConditionOp::EQ:
+      return lhs == rhs;
+    case QueryConditionOp::NE:
+      return lhs != rhs;
+    default:
+      assert(false);
+      return false;
+  }
+}
+
+/**
+ * Clears the bits of `result_bitmap` for the cells whose value does not
+ * satisfy `<value> <op> rhs`. The comparison operator is resolved once,
+ * outside the loop over the cells, which are compared a word of the
+ * bitmap at a time. The words without any result are skipped.
+ */
+template <class T, class Cmp>
+inline void filter_cells(
+    const T* values, const T& rhs, Cmp cmp_func, Bitmap* result_bitmap) {
+  const uint64_t cell_num = result_bitmap->size();
+  auto words = result_bitmap->words();
+  for (uint64_t w = 0; w < result_bitmap->word_num(); ++w) {
+    if (words[w] == 0)
+      continue;
+
+    auto word_values = values + w * 64;
+    auto n = std::min<uint64_t>(64, cell_num - w * 64);
+    uint64_t m = 0;
+    for (uint64_t i = 0; i < n; ++i)
+      m |= (uint64_t)cmp_func(word_values[i], rhs) << i;
+    words[w] &= m;
+  }
+}
+
+/**
+ * Lexicographically compares `lhs` (of size `lhs_size`) with `rhs` (of
+ * size `rhs_size`), returning a negative number, zero or a positive number,
+ * as in `std::string::compare`.
+ */
+inline int str_cmp(
+    const char* lhs, uint64_t lhs_size, const char* rhs, uint64_t rhs_size) {
+  const uint64_t min_size = std::min(lhs_size, rhs_size);
+  const int r = (min_size == 0) ? 0 : std::memcmp(lhs, rhs, min_size);
+  if (r != 0)
+    return r;
+  return (lhs_size < rhs_size) ? -1 : ((lhs_size > rhs_size) ? 1 : 0);
+}
+
+/**
+ * Returns `false` if no value in `[min, max]` can satisfy `<value> <op> rhs`.
+ * NaN bounds never rule out a tile, except for the operators that NaN
+ * values do not satisfy either.
+ */
+template <class T>
+inline bool range_may_satisfy(
+    const T& min, const T& max, const T& rhs, QueryConditionOp op) {
+  switch (op) {
+    case QueryConditionOp::LT:
+      return !(min >= rhs);
+    case QueryConditionOp::LE:
+      return !(min > rhs);
+    case QueryConditionOp::GT:
+      return !(max <= rhs);
+    case QueryConditionOp::GE:
+      return !(max < rhs);
+    case QueryConditionOp::EQ:
+      return !(rhs < min || rhs > max);
+    case QueryConditionOp::NE:
+      // NaN values are not reflected in the bounds, but satisfy `!=`
+      return std::is_floating_point<T>::value || !(min == rhs && max == rhs);
+    default:
+      return true;
+  }
+}
+
+/** Returns `false` if no value in `[min, max]` can satisfy the clause. */
+template <class T>
+inline bool range_may_satisfy(
+    const void* min, const void* max, const void* rhs, QueryConditionOp op) {
+  T min_v, max_v, rhs_v;
+  std::memcpy(&min_v, min, sizeof(T));
+  std::memcpy(&max_v, max, sizeof(T));
+  std::memcpy(&rhs_v, rhs, sizeof(T));
+  return range_may_satisfy(min_v, max_v, rhs_v, op);
+}
+
+}  // namespace
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+QueryCondition::Clause::Clause(
+    const std::string& field_name,
+    const void* condition_value,
+    uint64_t condition_value_size,
+    QueryConditionOp op)
+    : field_name_(field_name)
+    , condition_value_(
+          static_cast<const uint8_t*>(condition_value),
+          static_cast<const uint8_t*>(condition_value) + condition_value_size)
+    , op_(op) {
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status QueryCondition::init(
+    const std::string& field_name,
+    const void* condition_value,
+    uint64_t condition_value_size,
+    QueryConditionOp op) {
+  if (!clauses_.empty())
+    return LOG_STATUS(Status::QueryConditionError(
+        "Cannot initialize query condition; Condition is already initialized"));
+
+  if (field_name.empty())
+    return LOG_STATUS(Status::QueryConditionError(
+        "Cannot initialize query condition; Field name cannot be empty"));
+
+  if (condition_value == nullptr && condition_value_size != 0)
+    return LOG_STATUS(Status::QueryConditionError(
+        "Cannot initialize query condition; Value cannot be null"));
+
+  clauses_.emplace_back(field_name, condition_value, condition_value_size, op);
+  field_names_.insert(field_name);
+
+  return Status::Ok();
+}
+
+Status QueryCondition::check(const ArraySchema* array_schema) const {
+  for (const auto& clause : clauses_) {
+    const auto attr = array_schema->attribute(clause.field_name_);
+    if (attr == nullptr)
+      return LOG_STATUS(Status::QueryConditionError(
+          "Invalid query condition; Unknown attribute '" + clause.field_name_ +
+          "'"));
+
+    const auto type = attr->type();
+    if (attr->var_size()) {
+      if (!datatype_is_string(type) && type != Datatype::CHAR)
+        return LOG_STATUS(Status::QueryConditionError(
+            "Invalid query condition; Var-sized attribute '" +
+            clause.field_name_ + "' is not a string attribute"));
+      continue;
+    }
+
+    if (attr->cell_val_num() != 1)
+      return LOG_STATUS(Status::QueryConditionError(
+          "Invalid query condition; Attribute '" + clause.field_name_ +
+          "' must store a single value per cell"));
+
+    if (type == Datatype::ANY || datatype_is_string(type))
+      return LOG_STATUS(Status::QueryConditionError(
+          "Invalid query condition; Unsupported type '" + datatype_str(type) +
+          "' for attribute '" + clause.field_name_ + "'"));
+
+    if (clause.condition_value_.size() != attr->cell_size())
+      return LOG_STATUS(Status::QueryConditionError(
+          "Invalid query condition; Value size does not match the cell size "
+          "of attribute '" +
+          clause.field_name_ + "'"));
+  }
+
+  return Status::Ok();
+}
+
+Status QueryCondition::combine(
+    const QueryCondition& rhs,
+    QueryConditionCombinationOp combination_op,
+    QueryCondition* combined_cond) const {
+  if (combination_op != QueryConditionCombinationOp::AND)
+    return LOG_STATUS(Status::QueryConditionError(
+        "Cannot combine query conditions; Only the AND operator is supported"));
+
+  if (combined_cond == nullptr)
+    return LOG_STATUS(Status::QueryConditionError(
+        "Cannot combine query conditions; Output condition cannot be null"));
+
+  std::vector<Clause> clauses = clauses_;
+  clauses.insert(clauses.end(), rhs.clauses_.begin(), rhs.clauses_.end());
+  std::unordered_set<std::string> field_names = field_names_;
+  field_names.insert(rhs.field_names_.begin(), rhs.field_names_.end());
+
+  combined_cond->clauses_ = std::move(clauses);
+  combined_cond->field_names_ = std::move(field_names);
+
+  return Status::Ok();
+}
+
+bool QueryCondition::empty() const {
+  return clauses_.empty();
+}
+
+const std::unordered_set<std::string>& QueryCondition::field_names() const {
+  return field_names_;
+}
+
+Status QueryCondition::apply(
+    const ArraySchema* array_schema,
+    ResultTile* result_tile,
+    Bitmap* result_bitmap) const {
+  assert(result_bitmap->size() == result_tile->cell_num());
+  for (const auto& clause : clauses_)
+    RETURN_NOT_OK(
+        apply_clause(array_schema, clause, result_tile, result_bitmap));
+
+  return Status::Ok();
+}
+
+bool QueryCondition::tile_may_satisfy(
+    const ArraySchema* array_schema,
+    const FragmentMetadata& meta,
+    uint64_t tile_idx) const {
+  for (const auto& clause : clauses_) {
+    const auto& name = clause.field_name_;
+    if (!meta.has_tile_min_max(name))
+      continue;
+
+    const void *min, *max;
+    uint64_t min_size, max_size;
+    if (!meta.get_tile_min(name, tile_idx, &min, &min_size).ok() ||
+        !meta.get_tile_max(name, tile_idx, &max, &max_size).ok())
+      continue;
+
+    const auto attr = array_schema->attribute(name);
+    assert(attr != nullptr);
+    const auto rhs = clause.condition_value_.data();
+    bool may_satisfy = true;
+    if (attr->var_size()) {
+      // Compare the string bounds once and reason on the comparison results
+      const auto rhs_str = reinterpret_cast<const char*>(rhs);
+      const auto rhs_size = clause.condition_value_.size();
+      const int min_cmp =
+          str_cmp((const char*)min, min_size, rhs_str, rhs_size);
+      const int max_cmp =
+          str_cmp((const char*)max, max_size, rhs_str, rhs_size);
+      may_satisfy = range_may_satisfy(min_cmp, max_cmp, 0, clause.op_);
+    } else {
+      switch (attr->type()) {
+        case Datatype::INT8:
+          may_satisfy = range_may_satisfy<int8_t>(min, max, rhs, clause.op_);
+          break;
+        case Datatype::UINT8:
+          may_satisfy = range_may_satisfy<uint8_t>(min, max, rhs, clause.op_);
+          break;
+        case Datatype::INT16:
+          may_satisfy = range_may_satisfy<int16_t>(min, max, rhs, clause.op_);
+          break;
+        case Datatype::UINT16:
+          may_satisfy =
+              range_may_satisfy<uint16_t>(min, max, rhs, clause.op_);
+          break;
+        case Datatype::INT32:
+          may_satisfy = range_may_satisfy<int32_t>(min, max, rhs, clause.op_);
+          break;
+        case Datatype::UINT32:
+          may_satisfy =
+              range_may_satisfy<uint32_t>(min, max, rhs, clause.op_);
+          break;
+        case Datatype::INT64:
+          may_satisfy = range_may_satisfy<int64_t>(min, max, rhs, clause.op_);
+          break;
+        case Datatype::UINT64:
+          may_satisfy =
+              range_may_satisfy<uint64_t>(min, max, rhs, clause.op_);
+          break;
+        case Datatype::FLOAT32:
+          may_satisfy = range_may_satisfy<float>(min, max, rhs, clause.op_);
+          break;
+        case Datatype::FLOAT64:
+          may_satisfy = range_may_satisfy<double>(min, max, rhs, clause.op_);
+          break;
+        case Datatype::CHAR:
+          may_satisfy = range_may_satisfy<char>(min, max, rhs, clause.op_);
+          break;
+        case Datatype::DATETIME_YEAR:
+        case Datatype::DATETIME_MONTH:
+        case Datatype::DATETIME_WEEK:
+        case Datatype::DATETIME_DAY:
+        case Datatype::DATETIME_HR:
+        case Datatype::DATETIME_MIN:
+        case Datatype::DATETIME_SEC:
+        case Datatype::DATETIME_MS:
+        case Datatype::DATETIME_US:
+        case Datatype::DATETIME_NS:
+        case Datatype::DATETIME_PS:
+        case Datatype::DATETIME_FS:
+        case Datatype::DATETIME_AS:
+          may_satisfy = range_may_satisfy<int64_t>(min, max, rhs, clause.op_);
+          break;
+        default:
+          break;
+      }
+    }
+
+    if (!may_satisfy)
+      return false;
+  }
+
+  return true;
+}
+
+/* ****************************** */
+/*          PRIVATE METHODS       */
+/* ****************************** */
+
+template <class T>
+Status QueryCondition::apply_clause(
+    const Clause& clause,
+    ResultTile* result_tile,
+    Bitmap* result_bitmap) const {
+  const auto tile_pair = result_tile->tile_pair(clause.field_name_);
+  if (tile_pair == nullptr)
+    return LOG_STATUS(Status::QueryConditionError(
+        "Cannot apply query condition; Tile for attribute '" +
+        clause.field_name_ + "' is not loaded"));
+
+  void* buffer = nullptr;
+  RETURN_NOT_OK(tile_pair->first.chunked_buffer()->get_contiguous(&buffer));
+  const auto values = static_cast<const T*>(buffer);
+
+  T rhs;
+  std::memcpy(&rhs, clause.condition_value_.data(), sizeof(T));
+
+  switch (clause.op_) {
+    case QueryConditionOp::LT:
+      filter_cells(values, rhs, std::less<T>(), result_bitmap);
+      break;
+    case QueryConditionOp::LE:
+      filter_cells(values, rhs, std::less_equal<T>(), result_bitmap);
+      break;
+    case QueryConditionOp::GT:
+      filter_cells(values, rhs, std::greater<T>(), result_bitmap);
+      break;
+    case QueryConditionOp::GE:
+      filter_cells(values, rhs, std::greater_equal<T>(), result_bitmap);
+      break;
+    case QueryConditionOp::EQ:
+      filter_cells(values, rhs, std::equal_to<T>(), result_bitmap);
+      break;
+    case QueryConditionOp::NE:
+      filter_cells(values, rhs, std::not_equal_to<T>(), result_bitmap);
+      break;
+    default:
+      return LOG_STATUS(Status::QueryConditionError(
+          "Cannot apply query condition; Unknown operator"));
+  }
+
+  return Status::Ok();
+}
+
+Status QueryCondition::apply_clause_str(
+    const Clause& clause,
+    ResultTile* result_tile,
+    Bitmap* result_bitmap) const {
+  const auto tile_pair = result_tile->tile_pair(clause.field_name_);
+  if (tile_pair == nullptr)
+    return LOG_STATUS(Status::QueryConditionError(
+        "Cannot apply query condition; Tile for attribute '" +
+        clause.field_name_ + "' is not loaded"));
+
+  const auto& tile_off = tile_pair->first;
+  const auto& tile_val = tile_pair->second;
+  void* buffer_off = nullptr;
+  void* buffer_val = nullptr;
+  RETURN_NOT_OK(tile_off.chunked_buffer()->get_contiguous(&buffer_off));
+  if (tile_val.size() > 0)
+    RETURN_NOT_OK(tile_val.chunked_buffer()->get_contiguous(&buffer_val));
+  const auto offsets = static_cast<const uint64_t*>(buffer_off);
+  const auto values = static_cast<const char*>(buffer_val);
+  const uint64_t val_size = tile_val.size();
+
+  const auto rhs =
+      reinterpret_cast<const char*>(clause.condition_value_.data());
+  const uint64_t rhs_size = clause.condition_value_.size();
+
+  const uint64_t cell_num = result_bitmap->size();
+  result_bitmap->for_each([&](uint64_t c) {
+    const uint64_t start = offsets[c];
+    const uint64_t end = (c == cell_num - 1) ? val_size : offsets[c + 1];
+    const int r = str_cmp(values + start, end - start, rhs, rhs_size);
+    result_bitmap->and_bit(c, cmp(r, 0, clause.op_));
+  });
+
+  return Status::Ok();
+}
+
+Status QueryCondition::apply_clause(
+    const ArraySchema* array_schema,
+    const Clause& clause,
+    ResultTile* result_tile,
+    Bitmap* result_bitmap) const {
+  const auto attr = array_schema->attribute(clause.field_name_);
+  assert(attr != nullptr);
+
+  if (attr->var_size())
+    return apply_clause_str(clause, result_tile, result_bitmap);
+
+  switch (attr->type()) {
+    case Datatype::INT8:
+      return apply_clause<int8_t>(clause, result_tile, result_bitmap);
+    case Datatype::UINT8:
+      return apply_clause<uint8_t>(clause, result_tile, result_bitmap);
+    case Datatype::INT16:
+      return apply_clause<int16_t>(clause, result_tile, result_bitmap);
+    case Datatype::UINT16:
+      return apply_clause<uint16_t>(clause, result_tile, result_bitmap);
+    case Datatype::INT32:
+      return apply_clause<int32_t>(clause, result_tile, result_bitmap);
+    case Datatype::UINT32:
+      return apply_clause<uint32_t>(clause, result_tile, result_bitmap);
+    case Datatype::INT64:
+      return apply_clause<int64_t>(clause, result_tile, result_bitmap);
+    case Datatype::UINT64:
+      return apply_clause<uint64_t>(clause, result_tile, result_bitmap);
+    case Datatype::FLOAT32:
+      return apply_clause<float>(clause, result_tile, result_bitmap);
+    case Datatype::FLOAT64:
+      return apply_clause<double>(clause, result_tile, result_bitmap);
+    case Datatype::CHAR:
+      return apply_clause<char>(clause, result_tile, result_bitmap);
+    case Datatype::DATETIME_YEAR:
+    case Datatype::DATETIME_MONTH:
+    case Datatype::DATETIME_WEEK:
+    case Datatype::DATETIME_DAY:
+    case Datatype::DATETIME_HR:
+    case Datatype::DATETIME_MIN:
+    case Datatype::DATETIME_SEC:
+    case Datatype::DATETIME_MS:
+    case Datatype::DATETIME_US:
+    case Datatype::DATETIME_NS:
+    case Datatype::DATETIME_PS:
+    case Datatype::DATETIME_FS:
+    case Datatype::DATETIME_AS:
+      return apply_clause<int64_t>(clause, result_tile, result_bitmap);
+    default:
+      return LOG_STATUS(Status::QueryConditionError(
+          "Cannot apply query condition; Unsupported attribute type " +
+          datatype_str(attr->type())));
+  }
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,225 @@
+/**
+ * @file   query_condition.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class QueryCondition.
+ */
+
+#ifndef TILEDB_QUERY_CONDITION_H
+#define TILEDB_QUERY_CONDITION_H
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "tiledb/common/status.h"
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class ArraySchema;
+class Bitmap;
+class FragmentMetadata;
+class ResultTile;
+
+enum class QueryConditionCombinationOp : uint8_t;
+enum class QueryConditionOp : uint8_t;
+
+/**
+ * A predicate on attribute values, evaluated by the reader on unfiltered
+ * result tiles. It is a conjunction of clauses, each comparing the values
+ * of a single attribute against a constant.
+ */
+class QueryCondition {
+ public:
+  /* ********************************* */
+  /*          TYPE DEFINITIONS         */
+  /* ********************************* */
+
+  /** A single `<field> <op> <value>` clause. */
+  struct Clause {
+    /** Value constructor. */
+    Clause(
+        const std::string& field_name,
+        const void* condition_value,
+        uint64_t condition_value_size,
+        QueryConditionOp op);
+
+    /** The attribute name. */
+    std::string field_name_;
+
+    /** The value to compare against, stored as raw bytes. */
+    std::vector<uint8_t> condition_value_;
+
+    /** The comparison operator. */
+    QueryConditionOp op_;
+  };
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /** Default constructor. */
+  QueryCondition() = default;
+
+  /** Default copy constructor. */
+  QueryCondition(const QueryCondition& rhs) = default;
+
+  /** Default move constructor. */
+  QueryCondition(QueryCondition&& rhs) = default;
+
+  /** Default destructor. */
+  ~QueryCondition() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /** Default copy-assign operator. */
+  QueryCondition& operator=(const QueryCondition& rhs) = default;
+
+  /** Default move-assign operator. */
+  QueryCondition& operator=(QueryCondition&& rhs) = default;
+
+  /**
+   * Initializes the condition with a single clause. The condition must
+   * be empty.
+   *
+   * @param field_name The attribute name.
+   * @param condition_value The value to compare against.
+   * @param condition_value_size The size of `condition_value` in bytes.
+   * @param op The comparison operator.
+   * @return Status
+   */
+  Status init(
+      const std::string& field_name,
+      const void* condition_value,
+      uint64_t condition_value_size,
+      QueryConditionOp op);
+
+  /**
+   * Checks that the condition is compatible with the input array schema,
+   * i.e., every clause refers to an existing attribute, and the condition
+   * values match the attribute cell sizes. Only single-valued fixed-sized
+   * attributes and var-sized string attributes are supported.
+   */
+  Status check(const ArraySchema* array_schema) const;
+
+  /**
+   * Combines this condition with `rhs` into `combined_cond`.
+   *
+   * @param rhs The right-hand operand.
+   * @param combination_op The combination operator.
+   * @param combined_cond The resulting condition.
+   * @return Status
+   */
+  Status combine(
+      const QueryCondition& rhs,
+      QueryConditionCombinationOp combination_op,
+      QueryCondition* combined_cond) const;
+
+  /** Returns `true` if the condition has no clauses. */
+  bool empty() const;
+
+  /** Returns the names of the attributes the condition refers to. */
+  const std::unordered_set<std::string>& field_names() const;
+
+  /**
+   * Evaluates the condition on the cells of the input result tile and
+   * clears the bits of `result_bitmap` for the cells that do not satisfy it.
+   * Cells whose bit is already cleared are not evaluated. The tiles of all
+   * attributes in `field_names()` must be loaded and unfiltered.
+   *
+   * @param array_schema The array schema.
+   * @param result_tile The result tile to evaluate the condition on.
+   * @param result_bitmap One bit per cell of `result_tile`.
+   * @return Status
+   */
+  Status apply(
+      const ArraySchema* array_schema,
+      ResultTile* result_tile,
+      Bitmap* result_bitmap) const;
+
+  /**
+   * Returns `false` if the tile minimum/maximum values stored in the
+   * fragment metadata prove that no cell of the input tile satisfies the
+   * condition, and `true` otherwise. Clauses on attributes without (loaded)
+   * tile minimum/maximum values are ignored.
+   *
+   * @param array_schema The array schema.
+   * @param meta The metadata of the fragment the tile belongs to.
+   * @param tile_idx The index of the tile in the fragment.
+   * @return See above.
+   */
+  bool tile_may_satisfy(
+      const ArraySchema* array_schema,
+      const FragmentMetadata& meta,
+      uint64_t tile_idx) const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The clauses, all combined with AND. */
+  std::vector<Clause> clauses_;
+
+  /** The attribute names referenced by `clauses_`. */
+  std::unordered_set<std::string> field_names_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /** Applies a clause on a fixed-sized attribute of type `T`. */
+  template <class T>
+  Status apply_clause(
+      const Clause& clause,
+      ResultTile* result_tile,
+      Bitmap* result_bitmap) const;
+
+  /** Applies a clause on a var-sized string attribute. */
+  Status apply_clause_str(
+      const Clause& clause,
+      ResultTile* result_tile,
+      Bitmap* result_bitmap) const;
+
+  /** Applies a clause, dispatching on the attribute type. */
+  Status apply_clause(
+      const ArraySchema* array_schema,
+      const Clause& clause,
+      ResultTile* result_tile,
+      Bitmap* result_bitmap) const;
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_QUERY_CONDITION_H
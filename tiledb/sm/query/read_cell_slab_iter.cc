@@ -229,7 +229,7 @@ void ReadCellSlabIter<T>::compute_result_cell_slabs(
     i = result_coords_pos_;
 
     // Ignore if the result coordinates are invalid
-    if (!(*result_coords_)[i].valid_)
+    if (!(*result_coords_)[i].valid())
       continue;
 
     // Check overlap
@@ -35,9 +35,11 @@
 #include "tiledb/sm/array/array.h"
 #include "tiledb/sm/array_schema/array_schema.h"
 #include "tiledb/sm/array_schema/dimension.h"
+#include "tiledb/sm/enums/aggregate_op.h"
 #include "tiledb/sm/filesystem/vfs.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
 #include "tiledb/sm/global_state/global_state.h"
+#include "tiledb/sm/misc/bitmap.h"
 #include "tiledb/sm/misc/comparators.h"
 #include "tiledb/sm/misc/parallel_functions.h"
 #include "tiledb/sm/misc/utils.h"
@@ -49,7 +51,9 @@
 #include "tiledb/sm/subarray/cell_slab.h"
 #include "tiledb/sm/tile/generic_tile_io.h"
 
+#include <algorithm>
 #include <iostream>
+#include <numeric>
 #include <unordered_set>
 
 using namespace tiledb::common;
@@ -88,6 +92,209 @@ inline IterT skip_invalid_elements(IterT it, const IterT& end) {
   }
   return it;
 }
+
+/**
+ * Invokes `f->apply(cmp)` with the typed comparator `cmp` for `layout`, as
+ * selected by `dispatch_typed_cmp()`.
+ */
+template <class F>
+class TypedResultCoordsCmp {
+ public:
+  /** Constructor. */
+  TypedResultCoordsCmp(const Domain* domain, Layout layout, F* f)
+      : domain_(domain)
+      , layout_(layout)
+      , f_(f) {
+  }
+
+  /** Invokes `f_` with the comparator for `N` dimensions of `T0`, `T`. */
+  template <class T0, class T, unsigned N>
+  void run() {
+    if (layout_ == Layout::ROW_MAJOR) {
+      f_->apply(RowCmpTyped<T0, T, N>(domain_));
+    } else if (layout_ == Layout::COL_MAJOR) {
+      f_->apply(ColCmpTyped<T0, T, N>(domain_));
+    } else {
+      assert(layout_ == Layout::GLOBAL_ORDER);
+      f_->apply(GlobalCmpTyped<T0, T, N>(domain_));
+    }
+  }
+
+ private:
+  /** The array domain. */
+  const Domain* domain_;
+  /** The layout to compare in. */
+  Layout layout_;
+  /** The function object to invoke. */
+  F* f_;
+};
+
+/**
+ * Invokes `f->apply(cmp)` with the comparator `cmp` that orders result
+ * coordinates in `layout`. The comparator is specialized for the domain if
+ * possible, otherwise it is one of the generic `RowCmp`, `ColCmp` and
+ * `GlobalCmp`. Only `GlobalCmp` supports the Hilbert cell order.
+ */
+template <class F>
+void dispatch_result_coords_cmp(const Domain* domain, Layout layout, F* f) {
+  const bool hilbert = layout == Layout::GLOBAL_ORDER &&
+                       domain->cell_order() == Layout::HILBERT;
+  TypedResultCoordsCmp<F> typed_cmp(domain, layout, f);
+  if (!hilbert && (dispatch_typed_cmp(domain, &typed_cmp) ||
+                   dispatch_typed_cmp_string_first(domain, &typed_cmp)))
+    return;
+
+  if (layout == Layout::ROW_MAJOR) {
+    f->apply(RowCmp(domain));
+  } else if (layout == Layout::COL_MAJOR) {
+    f->apply(ColCmp(domain));
+  } else {
+    assert(layout == Layout::GLOBAL_ORDER);
+    f->apply(GlobalCmp(domain));
+  }
+}
+
+/**
+ * Merges runs of result coordinates with the comparator it is given, using
+ * a heap over the heads of the runs. Invalid coordinates are skipped.
+ */
+class ResultCoordsMerge {
+ public:
+  /** Constructor. */
+  ResultCoordsMerge(
+      const std::vector<std::vector<ResultCoords>>& runs,
+      bool dedup,
+      std::vector<ResultCoords>* result_coords)
+      : runs_(runs)
+      , dedup_(dedup)
+      , result_coords_(result_coords) {
+  }
+
+  /** Merges with `cmp`, which each run is sorted with. */
+  template <class CmpT>
+  void apply(const CmpT& cmp) {
+    typedef std::vector<ResultCoords>::const_iterator Iter;
+    typedef std::pair<Iter, Iter> Cursor;
+
+    // The heap has the cursor on the smallest coordinates on top
+    std::vector<Cursor> heap;
+    heap.reserve(runs_.size());
+    uint64_t coords_num = 0;
+    for (const auto& run : runs_) {
+      auto it = skip_invalid_elements(run.begin(), run.end());
+      if (it != run.end())
+        heap.emplace_back(it, run.end());
+      coords_num += run.size();
+    }
+    auto heap_cmp = [&cmp](const Cursor& a, const Cursor& b) {
+      return cmp(*b.first, *a.first);
+    };
+    std::make_heap(heap.begin(), heap.end(), heap_cmp);
+    result_coords_->reserve(result_coords_->size() + coords_num);
+
+    const auto start = result_coords_->size();
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), heap_cmp);
+      auto& cursor = heap.back();
+      const auto& c = *cursor.first;
+
+      // Identical coordinates are adjacent in the merged order. Keep the
+      // ones of the most recent fragment.
+      if (dedup_ && result_coords_->size() > start &&
+          result_coords_->back().same_coords(c)) {
+        if (result_coords_->back().tile_->frag_idx() < c.tile_->frag_idx())
+          result_coords_->back() = c;
+      } else {
+        result_coords_->emplace_back(c.tile_, c.pos_);
+      }
+
+      cursor.first = skip_invalid_elements(++cursor.first, cursor.second);
+      if (cursor.first == cursor.second)
+        heap.pop_back();
+      else
+        std::push_heap(heap.begin(), heap.end(), heap_cmp);
+    }
+  }
+
+ private:
+  /** The sorted runs of coordinates to merge. */
+  const std::vector<std::vector<ResultCoords>>& runs_;
+  /** Whether to deduplicate identical coordinates. */
+  bool dedup_;
+  /** The merged coordinates are appended here. */
+  std::vector<ResultCoords>* result_coords_;
+};
+
+/** Sorts a range of result coordinates with the comparator it is given. */
+class ResultCoordsSort {
+ public:
+  /** Constructor. */
+  ResultCoordsSort(
+      ThreadPool* tp,
+      std::vector<ResultCoords>::iterator iter_begin,
+      std::vector<ResultCoords>::iterator iter_end)
+      : tp_(tp)
+      , iter_begin_(iter_begin)
+      , iter_end_(iter_end) {
+  }
+
+  /** Sorts with `cmp`. */
+  template <class CmpT>
+  void apply(const CmpT& cmp) {
+    parallel_sort(tp_, iter_begin_, iter_end_, cmp);
+  }
+
+ private:
+  /** The thread pool to sort on. */
+  ThreadPool* tp_;
+  /** The start position of the coordinates to sort. */
+  std::vector<ResultCoords>::iterator iter_begin_;
+  /** The end position of the coordinates to sort. */
+  std::vector<ResultCoords>::iterator iter_end_;
+};
+
+/**
+ * Appends the `size` bytes of coordinate `coord` of type `type` to `key`.
+ * The negative zero of real coordinates is appended as zero, which it
+ * equals.
+ */
+inline void append_coord_key(
+    std::string* key, const void* coord, uint64_t size, Datatype type) {
+  if (type == Datatype::FLOAT32 && *(const float*)coord == 0) {
+    const float zero = 0;
+    key->append((const char*)&zero, sizeof(float));
+  } else if (type == Datatype::FLOAT64 && *(const double*)coord == 0) {
+    const double zero = 0;
+    key->append((const char*)&zero, sizeof(double));
+  } else {
+    key->append((const char*)coord, size);
+  }
+}
+
+/**
+ * Returns the result cell slabs of the `num` cells of `result_cell_slabs`
+ * that follow the first `skip` cells.
+ */
+std::vector<ResultCellSlab> slice_result_cell_slabs(
+    const std::vector<ResultCellSlab>& result_cell_slabs,
+    uint64_t skip,
+    uint64_t num) {
+  std::vector<ResultCellSlab> slice;
+  for (const auto& slab : result_cell_slabs) {
+    if (num == 0)
+      break;
+    if (skip >= slab.length_) {
+      skip -= slab.length_;
+      continue;
+    }
+    const uint64_t length = std::min(slab.length_ - skip, num);
+    slice.emplace_back(slab.tile_, slab.start_ + skip, length);
+    num -= length;
+    skip = 0;
+  }
+
+  return slice;
+}
 }  // namespace
 
 /* ****************************** */
@@ -100,6 +307,8 @@ Reader::Reader() {
   storage_manager_ = nullptr;
   layout_ = Layout::ROW_MAJOR;
   sparse_mode_ = false;
+  point_num_ = 0;
+  point_found_ = nullptr;
   read_state_.initialized_ = false;
 }
 
@@ -113,10 +322,38 @@ const Array* Reader::array() const {
   return array_;
 }
 
+Status Reader::add_aggregate(const std::string& name, AggregateOp op) {
+  QueryAggregate aggregate(name, op);
+  if (array_schema_ != nullptr)
+    RETURN_NOT_OK(aggregate.check(array_schema_));
+
+  // Ignore duplicate aggregates
+  for (const auto& a : aggregates_) {
+    if (a.field_name() == name && a.op() == op)
+      return Status::Ok();
+  }
+
+  aggregates_.emplace_back(std::move(aggregate));
+
+  return Status::Ok();
+}
+
 Status Reader::add_range(unsigned dim_idx, const Range& range) {
   return subarray_.add_range(dim_idx, range);
 }
 
+Status Reader::get_aggregate(
+    const std::string& name, AggregateOp op, void* value) const {
+  for (const auto& aggregate : aggregates_) {
+    if (aggregate.field_name() == name && aggregate.op() == op)
+      return aggregate.get_value(value);
+  }
+
+  return LOG_STATUS(Status::ReaderError(
+      "Cannot get aggregate; Aggregate " + aggregate_op_str(op) +
+      " on attribute '" + name + "' was not added to the query"));
+}
+
 Status Reader::get_range_num(unsigned dim_idx, uint64_t* range_num) const {
   return subarray_.get_range_num(dim_idx, range_num);
 }
@@ -171,6 +408,10 @@ QueryBuffer Reader::buffer(const std::string& name) const {
 }
 
 bool Reader::incomplete() const {
+  // Point lookups are not partitioned
+  if (!point_coords_.empty())
+    return read_state_.overflowed_;
+
   return read_state_.overflowed_ || !read_state_.done();
 }
 
@@ -217,12 +458,42 @@ Status Reader::init(const Layout& layout) {
   if (array_schema_ == nullptr)
     return LOG_STATUS(Status::ReaderError(
         "Cannot initialize reader; Array metadata not set"));
-  if (buffers_.empty())
+  if (buffers_.empty() && aggregates_.empty() && point_coords_.empty())
     return LOG_STATUS(
         Status::ReaderError("Cannot initialize reader; Buffers not set"));
+  if (!buffers_.empty() && !aggregates_.empty())
+    return LOG_STATUS(Status::ReaderError(
+        "Cannot initialize reader; Aggregates cannot be combined with "
+        "buffers"));
+  if (array_schema_->dense() && !aggregates_.empty())
+    return LOG_STATUS(Status::ReaderError(
+        "Cannot initialize reader; Aggregates are only supported for sparse "
+        "arrays"));
   if (array_schema_->dense() && !sparse_mode_ && !subarray_.is_set())
     return LOG_STATUS(Status::ReaderError(
         "Cannot initialize reader; Dense reads must have a subarray set"));
+  if (array_schema_->dense() && !sparse_mode_ && !condition_.empty())
+    return LOG_STATUS(Status::ReaderError(
+        "Cannot initialize reader; Query conditions are only supported "
+        "for sparse reads"));
+  if (!point_coords_.empty() && (!condition_.empty() || !aggregates_.empty()))
+    return LOG_STATUS(Status::ReaderError(
+        "Cannot initialize reader; Point lookups cannot be combined with "
+        "query conditions or aggregates"));
+  if (!point_coords_.empty() && has_coords())
+    return LOG_STATUS(Status::ReaderError(
+        "Cannot initialize reader; Point lookups cannot be combined with "
+        "coordinate buffers"));
+  if (!point_coords_.empty() && subarray_.is_set())
+    return LOG_STATUS(Status::ReaderError(
+        "Cannot initialize reader; Point lookups cannot be combined with "
+        "a subarray"));
+  if (!condition_.empty())
+    RETURN_NOT_OK(condition_.check(array_schema_));
+  for (auto& aggregate : aggregates_) {
+    RETURN_NOT_OK(aggregate.check(array_schema_));
+    aggregate.reset(array_schema_);
+  }
 
   // Set layout
   RETURN_NOT_OK(set_layout(layout));
@@ -282,8 +553,13 @@ Status Reader::read() {
 
   auto dense_mode = array_schema_->dense() && !sparse_mode_;
 
-  // Get next partition
-  if (!read_state_.unsplittable_)
+  // Point lookups read all the points at once, without partitioning the
+  // subarray
+  if (!point_coords_.empty())
+    return point_lookup_read();
+
+  // Get next partition, unless the current one was returned partially
+  if (!read_state_.unsplittable_ && !read_state_.resumes_partition())
     RETURN_NOT_OK(read_state_.next());
 
   // Handle empty array or empty/finished subarray
@@ -292,6 +568,11 @@ Status Reader::read() {
     return Status::Ok();
   }
 
+  // Reads with aggregates do not return results in the user buffers, so
+  // they process all partitions at once
+  if (!aggregates_.empty())
+    return aggregate_read();
+
   // Loop until you find results, or unsplittable, or done
   do {
     STATS_ADD_COUNTER(stats::Stats::CounterType::READ_LOOP_NUM, 1)
@@ -307,9 +588,13 @@ Status Reader::read() {
     }
 
     // In the case of overflow, we need to split the current partition
-    // without advancing to the next partition
+    // without advancing to the next partition. A partition that was
+    // returned partially cannot be split, since its results would be
+    // returned again, so the read is left incomplete without results.
     if (read_state_.overflowed_) {
       zero_out_buffer_sizes();
+      if (read_state_.resumes_partition())
+        return Status::Ok();
       RETURN_NOT_OK(read_state_.split_current());
 
       if (read_state_.unsplittable_)
@@ -443,6 +728,15 @@ Status Reader::set_buffer(
   return Status::Ok();
 }
 
+Status Reader::set_condition(const QueryCondition& condition) {
+  if (array_schema_ != nullptr)
+    RETURN_NOT_OK(condition.check(array_schema_));
+
+  condition_ = condition;
+
+  return Status::Ok();
+}
+
 void Reader::set_fragment_metadata(
     const std::vector<FragmentMetadata*>& fragment_metadata) {
   fragment_metadata_ = fragment_metadata;
@@ -455,6 +749,44 @@ Status Reader::set_layout(Layout layout) {
   return Status::Ok();
 }
 
+Status Reader::set_point_lookups(
+    const std::vector<const void*>& coords,
+    uint64_t point_num,
+    uint8_t* found) {
+  if (array_schema_ == nullptr || array_schema_->dense())
+    return LOG_STATUS(Status::ReaderError(
+        "Cannot set point lookups; Only applicable to sparse arrays"));
+
+  auto dim_num = array_schema_->dim_num();
+  if (coords.size() != dim_num)
+    return LOG_STATUS(Status::ReaderError(
+        "Cannot set point lookups; The number of coordinate buffers must be "
+        "equal to the number of dimensions"));
+  for (unsigned d = 0; d < dim_num; ++d) {
+    if (array_schema_->dimension(d)->var_size())
+      return LOG_STATUS(Status::ReaderError(
+          "Cannot set point lookups; Not applicable to var-sized dimensions"));
+    if (coords[d] == nullptr && point_num != 0)
+      return LOG_STATUS(Status::ReaderError(
+          "Cannot set point lookups; Coordinate buffers cannot be null"));
+  }
+  if (found == nullptr && point_num != 0)
+    return LOG_STATUS(Status::ReaderError(
+        "Cannot set point lookups; Found buffer cannot be null"));
+
+  // Copy the coordinates, which are read only when the query is submitted
+  point_coords_.resize(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto size = point_num * array_schema_->dimension(d)->coord_size();
+    auto data = (const uint8_t*)coords[d];
+    point_coords_[d].assign(data, data + size);
+  }
+  point_num_ = point_num;
+  point_found_ = found;
+
+  return Status::Ok();
+}
+
 Status Reader::set_sparse_mode(bool sparse_mode) {
   if (!array_schema_->dense())
     return LOG_STATUS(Status::ReaderError(
@@ -554,6 +886,240 @@ void Reader::compute_result_space_tiles(
 /*          PRIVATE METHODS       */
 /* ****************************** */
 
+Status Reader::aggregate_read() {
+  for (auto& aggregate : aggregates_)
+    aggregate.reset(array_schema_);
+
+  do {
+    STATS_ADD_COUNTER(stats::Stats::CounterType::READ_LOOP_NUM, 1)
+
+    RETURN_NOT_OK(sparse_aggregate());
+    read_state_.unsplittable_ = false;
+
+    if (read_state_.done())
+      return Status::Ok();
+
+    RETURN_NOT_OK(read_state_.next());
+  } while (true);
+
+  return Status::Ok();
+}
+
+Status Reader::point_lookup_read() {
+  read_state_.overflowed_ = false;
+  reset_buffer_sizes();
+
+  // Sort the points on the global order, so that the points of a tile are
+  // contiguous, and group the identical points. `point_idx` maps every
+  // input point to its distinct point in `points`.
+  const auto dim_num = array_schema_->dim_num();
+  auto domain = array_schema_->domain();
+  std::vector<QueryBuffer> point_buffs(dim_num);
+  std::vector<const QueryBuffer*> buffs(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d) {
+    point_buffs[d].buffer_ = point_coords_[d].data();
+    buffs[d] = &point_buffs[d];
+  }
+  std::vector<uint64_t> sorted(point_num_);
+  std::iota(sorted.begin(), sorted.end(), 0);
+  parallel_sort(
+      storage_manager_->compute_tp(),
+      sorted.begin(),
+      sorted.end(),
+      GlobalCmp(domain, &buffs));
+  std::vector<uint64_t> points, point_idx(point_num_);
+  for (auto p : sorted) {
+    if (points.empty() || domain->cell_order_cmp(buffs, points.back(), p) != 0)
+      points.push_back(p);
+    point_idx[p] = points.size() - 1;
+  }
+  sorted.clear();
+
+  // Find the cell of every distinct point
+  std::vector<ResultTile> point_tiles;
+  RETURN_CANCEL_OR_ERROR(compute_point_tiles(points, &point_tiles));
+  std::vector<ResultTile*> result_tiles;
+  for (auto& tile : point_tiles)
+    result_tiles.push_back(&tile);
+  std::vector<ResultCoords> point_cells;
+  RETURN_CANCEL_OR_ERROR(
+      compute_point_cells(points, result_tiles, &point_cells));
+
+  // Compute the result cell slabs in the input order. The points without
+  // a cell get empty slabs, which are filled with the fill values.
+  std::vector<ResultCellSlab> result_cell_slabs;
+  std::unordered_set<const ResultTile*> found_tiles;
+  for (uint64_t i = 0; i < point_num_; ++i) {
+    const auto& cell = point_cells[point_idx[i]];
+    point_found_[i] = cell.valid() ? 1 : 0;
+    if (cell.valid())
+      found_tiles.insert(cell.tile_);
+
+    // Extend the last slab with consecutive cells of the same tile
+    auto pos = cell.valid() ? cell.pos_ : 0;
+    if (!result_cell_slabs.empty()) {
+      auto& last = result_cell_slabs.back();
+      if (last.tile_ == cell.tile_ &&
+          (!cell.valid() || last.start_ + last.length_ == pos)) {
+        ++last.length_;
+        continue;
+      }
+    }
+    result_cell_slabs.emplace_back(cell.tile_, pos, 1);
+  }
+  point_cells.clear();
+
+  // Copy the attribute values of the tiles with results
+  auto it = std::remove_if(
+      result_tiles.begin(), result_tiles.end(), [&](const ResultTile* tile) {
+        return found_tiles.count(tile) == 0;
+      });
+  result_tiles.erase(it, result_tiles.end());
+
+  get_result_tile_stats(result_tiles);
+  get_result_cell_stats(result_cell_slabs);
+
+  RETURN_NOT_OK(
+      copy_attribute_values(UINT64_MAX, result_tiles, result_cell_slabs));
+
+  // The buffers must fit all the points
+  if (read_state_.overflowed_)
+    zero_out_buffer_sizes();
+
+  return Status::Ok();
+}
+
+Status Reader::compute_point_tiles(
+    const std::vector<uint64_t>& points,
+    std::vector<ResultTile>* result_tiles) const {
+  const auto dim_num = array_schema_->dim_num();
+  auto domain = array_schema_->domain();
+  std::vector<const void*> coords(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d)
+    coords[d] = point_coords_[d].data();
+
+  // Find the fragments whose non-empty domain contains some point
+  auto relevant_fragments =
+      array_->fragment_index().get_point_tiles(coords, points);
+
+  // Load the R-trees of the relevant fragments
+  auto encryption_key = array_->encryption_key();
+  auto statuses = parallel_for(
+      storage_manager_->compute_tp(),
+      0,
+      relevant_fragments.size(),
+      [&](uint64_t i) {
+        return fragment_metadata_[relevant_fragments[i]]->load_rtree(
+            *encryption_key);
+      });
+  for (const auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  // Probe each R-tree with all the points at once
+  std::vector<std::vector<uint64_t>> tiles(relevant_fragments.size());
+  statuses = parallel_for(
+      storage_manager_->compute_tp(),
+      0,
+      relevant_fragments.size(),
+      [&](uint64_t i) {
+        return fragment_metadata_[relevant_fragments[i]]->get_point_tiles(
+            coords, points, &tiles[i]);
+      });
+  for (const auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  result_tiles->clear();
+  for (size_t i = 0; i < relevant_fragments.size(); ++i) {
+    for (auto t : tiles[i])
+      result_tiles->emplace_back((unsigned)relevant_fragments[i], t, domain);
+  }
+
+  return Status::Ok();
+}
+
+Status Reader::compute_point_cells(
+    const std::vector<uint64_t>& points,
+    const std::vector<ResultTile*>& result_tiles,
+    std::vector<ResultCoords>* point_cells) {
+  point_cells->assign(points.size(), ResultCoords(nullptr, 0));
+  if (result_tiles.empty())
+    return Status::Ok();
+
+  // Read and unfilter the coordinate tiles. Note that the zipped
+  // coordinates apply only to fragments with a version < 5, and the
+  // separate dimension tiles only to fragments with a version >= 5.
+  const auto dim_num = array_schema_->dim_num();
+  std::vector<std::string> dim_names;
+  std::vector<uint64_t> coord_sizes;
+  std::vector<Datatype> coord_types;
+  for (unsigned d = 0; d < dim_num; ++d) {
+    dim_names.emplace_back(array_schema_->dimension(d)->name());
+    coord_sizes.push_back(array_schema_->dimension(d)->coord_size());
+    coord_types.push_back(array_schema_->dimension(d)->type());
+  }
+  RETURN_CANCEL_OR_ERROR(load_tile_offsets({constants::coords}));
+  RETURN_CANCEL_OR_ERROR(load_tile_offsets(dim_names));
+  RETURN_CANCEL_OR_ERROR(
+      read_coordinate_tiles({constants::coords}, result_tiles));
+  RETURN_CANCEL_OR_ERROR(unfilter_tiles(constants::coords, result_tiles));
+  RETURN_CANCEL_OR_ERROR(read_coordinate_tiles(dim_names, result_tiles));
+  for (const auto& dim_name : dim_names)
+    RETURN_CANCEL_OR_ERROR(unfilter_tiles(dim_name, result_tiles));
+
+  // Index the points on their coordinate bytes, which are equal for equal
+  // coordinates once the negative zeros are normalized
+  std::unordered_map<std::string, uint64_t> point_map;
+  point_map.reserve(points.size());
+  std::string key;
+  for (uint64_t i = 0; i < points.size(); ++i) {
+    key.clear();
+    for (unsigned d = 0; d < dim_num; ++d)
+      append_coord_key(
+          &key,
+          point_coords_[d].data() + points[i] * coord_sizes[d],
+          coord_sizes[d],
+          coord_types[d]);
+    point_map.emplace(key, i);
+  }
+
+  // Match the cells of every tile against the points in parallel
+  std::vector<std::vector<std::pair<uint64_t, uint64_t>>> matches(
+      result_tiles.size());
+  auto statuses = parallel_for(
+      storage_manager_->compute_tp(), 0, result_tiles.size(), [&](uint64_t t) {
+        const auto tile = result_tiles[t];
+        auto cell_num =
+            fragment_metadata_[tile->frag_idx()]->cell_num(tile->tile_idx());
+        std::string cell_key;
+        for (uint64_t pos = 0; pos < cell_num; ++pos) {
+          cell_key.clear();
+          for (unsigned d = 0; d < dim_num; ++d)
+            append_coord_key(
+                &cell_key, tile->coord(pos, d), coord_sizes[d], coord_types[d]);
+          auto it = point_map.find(cell_key);
+          if (it != point_map.end())
+            matches[t].emplace_back(it->second, pos);
+        }
+        return Status::Ok();
+      });
+  for (const auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  // The result tiles are sorted on the fragment index, so the cells of
+  // the more recent fragments overwrite those of the earlier ones
+  for (size_t t = 0; t < result_tiles.size(); ++t) {
+    for (const auto& match : matches[t])
+      (*point_cells)[match.first] = ResultCoords(result_tiles[t], match.second);
+  }
+
+  // The coordinate tiles are no longer needed
+  clear_tiles(constants::coords, result_tiles);
+  for (const auto& dim_name : dim_names)
+    clear_tiles(dim_name, result_tiles);
+
+  return Status::Ok();
+}
+
 Status Reader::check_subarray() const {
   if (subarray_.layout() == Layout::GLOBAL_ORDER && subarray_.range_num() != 1)
     return LOG_STATUS(Status::ReaderError(
@@ -621,47 +1187,61 @@ Status Reader::compute_range_result_coords(
     unsigned frag_idx,
     ResultTile* tile,
     uint64_t range_idx,
+    bool apply_condition,
     std::vector<ResultCoords>* result_coords) {
   auto coords_num = tile->cell_num();
   auto dim_num = array_schema_->dim_num();
   auto range_coords = subarray->get_range_coords(range_idx);
 
   if (array_schema_->dense()) {
-    std::vector<uint8_t> result_bitmap(coords_num, 1);
-    std::vector<uint8_t> overwritten_bitmap(coords_num, 0);
+    Bitmap result_bitmap(coords_num, true);
+    Bitmap overwritten_bitmap(coords_num, false);
 
     // Compute result and overwritten bitmap per dimension
     for (unsigned d = 0; d < dim_num; ++d) {
       const auto& ranges = subarray->ranges_for_dim(d);
       RETURN_NOT_OK(tile->compute_results_dense(
-          d,
-          ranges[range_coords[d]],
-          fragment_metadata_,
-          frag_idx,
-          &result_bitmap,
-          &overwritten_bitmap));
+          d, ranges[range_coords[d]], &result_bitmap, &overwritten_bitmap));
     }
 
     // Gather results
-    for (uint64_t pos = 0; pos < coords_num; ++pos) {
-      if (result_bitmap[pos] && !overwritten_bitmap[pos])
-        result_coords->emplace_back(tile, pos);
-    }
+    result_bitmap.and_not(overwritten_bitmap);
+    result_bitmap.for_each(
+        [&](uint64_t pos) { result_coords->emplace_back(tile, pos); });
   } else {  // Sparse
-    std::vector<uint8_t> result_bitmap(coords_num, 1);
+    // If the cells are sorted on the leading dimension, only the window
+    // of cells that fall in the range on that dimension is checked
+    uint64_t min_cell = 0, max_cell = coords_num;
+    unsigned leading_dim = dim_num;
+    if (sparse_tile_sorted(frag_idx, tile->tile_idx(), &leading_dim)) {
+      const auto& ranges = subarray->ranges_for_dim(leading_dim);
+      const auto& range = ranges[range_coords[leading_dim]];
+      RETURN_NOT_OK(tile->compute_results_window(
+          leading_dim, range, &min_cell, &max_cell));
+      if (min_cell == max_cell)
+        return Status::Ok();
+    }
 
-    // Compute result and overwritten bitmap per dimension
+    Bitmap result_bitmap(coords_num, false);
+    result_bitmap.set_range(min_cell, max_cell);
+
+    // Compute result bitmap per dimension
     for (unsigned d = 0; d < dim_num; ++d) {
+      if (d == leading_dim)
+        continue;
       const auto& ranges = subarray->ranges_for_dim(d);
       RETURN_NOT_OK(tile->compute_results_sparse(
-          d, ranges[range_coords[d]], &result_bitmap));
+          d, ranges[range_coords[d]], min_cell, max_cell, &result_bitmap));
     }
 
+    // Fold the query condition into the result bitmap
+    if (apply_condition && !condition_.empty())
+      RETURN_NOT_OK(condition_.apply(array_schema_, tile, &result_bitmap));
+
     // Gather results
-    for (uint64_t pos = 0; pos < coords_num; ++pos) {
-      if (result_bitmap[pos])
-        result_coords->emplace_back(tile, pos);
-    }
+    result_bitmap.for_each(min_cell, max_cell, [&](uint64_t pos) {
+      result_coords->emplace_back(tile, pos);
+    });
   }
 
   return Status::Ok();
@@ -677,33 +1257,36 @@ Status Reader::compute_range_result_coords(
 
   auto range_num = subarray->range_num();
   range_result_coords->resize(range_num);
-  auto cell_order = array_schema_->cell_order();
-  Layout layout =
-      (layout_ == Layout::GLOBAL_ORDER || layout_ == Layout::UNORDERED) ?
-          cell_order :
-          layout_;
   auto allows_dups = array_schema_->allows_dups();
 
   auto statuses = parallel_for(
       storage_manager_->compute_tp(), 0, range_num, [&](uint64_t r) {
-        // Compute overlapping coordinates per range
+        // Dedup unless there is a single fragment or array schema allows
+        // duplicates. The query condition can be folded into the result
+        // bitmaps of the tiles only when no dedup takes place, otherwise it
+        // must be applied on the most recent version of each cell.
+        const bool dedup = !single_fragment[r] && !allows_dups;
+        auto& coords = (*range_result_coords)[r];
+
+        // Compute overlapping coordinates per range, deduplicated and in
+        // global order if needed
         RETURN_NOT_OK(compute_range_result_coords(
             subarray,
             r,
             result_tile_map,
             result_tiles,
-            &((*range_result_coords)[r])));
+            dedup,
+            nullptr,
+            &coords));
 
-        // Dedup unless there is a single fragment or array schema allows
-        // duplicates
-        if (!single_fragment[r] && !allows_dups) {
-          RETURN_CANCEL_OR_ERROR(sort_result_coords(
-              ((*range_result_coords)[r]).begin(),
-              ((*range_result_coords)[r]).end(),
-              layout));
+        if (dedup && !condition_.empty())
+          RETURN_CANCEL_OR_ERROR(apply_query_condition(&coords));
+
+        // Sort each range separately in row- or col-major order, the
+        // ranges are merged in `compute_subarray_coords`
+        if (layout_ == Layout::ROW_MAJOR || layout_ == Layout::COL_MAJOR)
           RETURN_CANCEL_OR_ERROR(
-              dedup_result_coords(&((*range_result_coords)[r])));
-        }
+              sort_result_coords(coords.begin(), coords.end(), layout_));
 
         return Status::Ok();
       });
@@ -722,6 +1305,8 @@ Status Reader::compute_range_result_coords(
     uint32_t fragment_idx,
     const std::map<std::pair<unsigned, uint64_t>, size_t>& result_tile_map,
     std::vector<ResultTile>* result_tiles,
+    bool apply_condition,
+    std::vector<ResultCellSlab>* full_tile_slabs,
     std::vector<ResultCoords>* range_result_coords) {
   const auto& overlap = subarray->tile_overlap();
 
@@ -740,31 +1325,66 @@ Status Reader::compute_range_result_coords(
       for (uint64_t i = tr->first; i <= tr->second; ++i) {
         auto pair = std::pair<unsigned, uint64_t>(fragment_idx, i);
         auto tile_it = result_tile_map.find(pair);
-        assert(tile_it != result_tile_map.end());
+        // Pruned by the query condition, or outside the streamed window
+        if (tile_it == result_tile_map.end())
+          continue;
         auto tile_idx = tile_it->second;
         auto& tile = (*result_tiles)[tile_idx];
 
         // Add results only if the sparse tile MBR is not fully
-        // covered by a more recent fragment's non-empty domain
-        if (!sparse_tile_overwritten(fragment_idx, i))
-          RETURN_NOT_OK(get_all_result_coords(&tile, range_result_coords));
+        // covered by a more recent fragment's non-empty domain. The
+        // cells of a tile partially covered by some are checked one by one.
+        if (!tile.overwrite_domains().empty()) {
+          if (!sparse_tile_overwritten(fragment_idx, i))
+            RETURN_NOT_OK(compute_range_result_coords(
+                subarray,
+                fragment_idx,
+                &tile,
+                range_idx,
+                apply_condition,
+                range_result_coords));
+        } else if (!sparse_tile_overwritten(fragment_idx, i)) {
+          RETURN_NOT_OK(get_all_result_coords(
+              &tile, apply_condition, full_tile_slabs, range_result_coords));
+        }
       }
       ++tr;
     } else {
       // Handle single tile
       auto pair = std::pair<unsigned, uint64_t>(fragment_idx, t->first);
       auto tile_it = result_tile_map.find(pair);
-      assert(tile_it != result_tile_map.end());
+      // Pruned by the query condition, or outside the streamed window
+      if (tile_it == result_tile_map.end()) {
+        ++t;
+        continue;
+      }
       auto tile_idx = tile_it->second;
       auto& tile = (*result_tiles)[tile_idx];
       if (t->second == 1.0) {  // Full overlap
         // Add results only if the sparse tile MBR is not fully
-        // covered by a more recent fragment's non-empty domain
-        if (!sparse_tile_overwritten(fragment_idx, t->first))
-          RETURN_NOT_OK(get_all_result_coords(&tile, range_result_coords));
+        // covered by a more recent fragment's non-empty domain. The
+        // cells of a tile partially covered by some are checked one by one.
+        if (!tile.overwrite_domains().empty()) {
+          if (!sparse_tile_overwritten(fragment_idx, t->first))
+            RETURN_NOT_OK(compute_range_result_coords(
+                subarray,
+                fragment_idx,
+                &tile,
+                range_idx,
+                apply_condition,
+                range_result_coords));
+        } else if (!sparse_tile_overwritten(fragment_idx, t->first)) {
+          RETURN_NOT_OK(get_all_result_coords(
+              &tile, apply_condition, full_tile_slabs, range_result_coords));
+        }
       } else {  // Partial overlap
         RETURN_NOT_OK(compute_range_result_coords(
-            subarray, fragment_idx, &tile, range_idx, range_result_coords));
+            subarray,
+            fragment_idx,
+            &tile,
+            range_idx,
+            apply_condition,
+            range_result_coords));
       }
       ++t;
     }
@@ -778,10 +1398,15 @@ Status Reader::compute_range_result_coords(
     uint64_t range_idx,
     const std::map<std::pair<unsigned, uint64_t>, size_t>& result_tile_map,
     std::vector<ResultTile>* result_tiles,
+    bool dedup,
+    std::vector<ResultCellSlab>* full_tile_slabs,
     std::vector<ResultCoords>* range_result_coords) {
+  assert(full_tile_slabs == nullptr || !dedup);
+
   // Gather result range coordinates per fragment
   auto fragment_num = fragment_metadata_.size();
   std::vector<std::vector<ResultCoords>> range_result_coords_vec(fragment_num);
+  std::vector<std::vector<ResultCellSlab>> full_tile_slabs_vec(fragment_num);
   auto statuses = parallel_for(
       storage_manager_->compute_tp(), 0, fragment_num, [&](uint32_t f) {
         return compute_range_result_coords(
@@ -790,12 +1415,28 @@ Status Reader::compute_range_result_coords(
             f,
             result_tile_map,
             result_tiles,
+            !dedup,
+            (full_tile_slabs == nullptr) ? nullptr : &full_tile_slabs_vec[f],
             &range_result_coords_vec[f]);
       });
   for (const auto& st : statuses)
     RETURN_NOT_OK(st);
 
-  // Consolidate the result coordinates in the single result vector
+  if (full_tile_slabs != nullptr) {
+    for (const auto& vec : full_tile_slabs_vec)
+      full_tile_slabs->insert(full_tile_slabs->end(), vec.begin(), vec.end());
+  }
+
+  // The coordinates of each fragment are in the global order. Merge them
+  // if they need dedup or the global order is requested, otherwise
+  // consolidate them in the single result vector
+  if (dedup || layout_ == Layout::GLOBAL_ORDER)
+    return merge_result_coords(
+        range_result_coords_vec,
+        Layout::GLOBAL_ORDER,
+        dedup,
+        range_result_coords);
+
   for (const auto& vec : range_result_coords_vec) {
     for (const auto& r : vec)
       range_result_coords->emplace_back(r);
@@ -807,32 +1448,22 @@ Status Reader::compute_range_result_coords(
 Status Reader::compute_subarray_coords(
     std::vector<std::vector<ResultCoords>>* range_result_coords,
     std::vector<ResultCoords>* result_coords) {
-  // The input 'result_coords' is already sorted. Save the current size
-  // before inserting new elements.
-  const size_t result_coords_size = result_coords->size();
-
-  // Add all valid ``range_result_coords`` to ``result_coords``
-  for (const auto& rv : *range_result_coords) {
-    for (const auto& c : rv) {
-      if (c.valid())
-        result_coords->emplace_back(c.tile_, c.pos_);
+  // No need to sort in UNORDERED layout. Add all valid
+  // ``range_result_coords`` to ``result_coords``
+  if (layout_ == Layout::UNORDERED) {
+    for (const auto& rv : *range_result_coords) {
+      for (const auto& c : rv) {
+        if (c.valid())
+          result_coords->emplace_back(c.tile_, c.pos_);
+      }
     }
-  }
-
-  // No need to sort in UNORDERED layout
-  if (layout_ == Layout::UNORDERED)
     return Status::Ok();
+  }
 
-  // Sort
-  auto cell_order = array_schema_->cell_order();
-  Layout layout = (layout_ == Layout ::UNORDERED) ? cell_order : layout_;
-
-  RETURN_NOT_OK(sort_result_coords(
-      result_coords->begin() + result_coords_size,
-      result_coords->end(),
-      layout));
-
-  return Status::Ok();
+  // The coordinates of each range are already sorted in the query layout.
+  // Merge them after the coordinates already in ``result_coords``.
+  return merge_result_coords(
+      *range_result_coords, layout_, false, result_coords);
 }
 
 Status Reader::compute_sparse_result_tiles(
@@ -856,17 +1487,67 @@ Status Reader::compute_sparse_result_tiles(
   for (uint64_t i = 0; i < range_num; ++i)
     (*single_fragment)[i] = true;
 
+  // Tiles whose minimum/maximum values prove that none of their cells
+  // satisfies the query condition are skipped. This is safe only if no
+  // deduplication across fragments takes place, as the latter may need
+  // the cells of a skipped tile to discard older cells.
+  const bool prune_tiles =
+      !condition_.empty() &&
+      (array_schema_->allows_dups() || fragment_num == 1);
+  if (prune_tiles) {
+    std::vector<std::string> names(
+        condition_.field_names().begin(), condition_.field_names().end());
+    RETURN_NOT_OK(load_tile_stats(names));
+  }
+
+  // For reads with aggregates, the tiles whose cells are all results, i.e.,
+  // the tiles fully covered by a single-range subarray when no query
+  // condition or deduplication applies, are aggregated directly from the
+  // tile statistics, without being read, unless their sums saturated
+  const bool aggregate_tile_stats =
+      !aggregates_.empty() && condition_.empty() && range_num == 1 &&
+      (array_schema_->allows_dups() || fragment_num == 1);
+  if (aggregate_tile_stats) {
+    std::vector<std::string> names;
+    for (const auto& aggregate : aggregates_) {
+      if (aggregate.needs_values())
+        names.emplace_back(aggregate.field_name());
+    }
+    RETURN_NOT_OK(load_tile_stats(names));
+  }
+
   result_tiles->clear();
   for (unsigned f = 0; f < fragment_num; ++f) {
     // Skip dense fragments
     if (fragment_metadata_[f]->dense())
       continue;
 
+    bool use_tile_stats = aggregate_tile_stats;
+    for (const auto& aggregate : aggregates_)
+      use_tile_stats =
+          use_tile_stats && aggregate.has_tile_stats(*fragment_metadata_[f]);
+
     for (uint64_t r = 0; r < range_num; ++r) {
       // Handle range of tiles (full overlap)
       const auto& tile_ranges = overlap[f][r].tile_ranges_;
       for (const auto& tr : tile_ranges) {
         for (uint64_t t = tr.first; t <= tr.second; ++t) {
+          if (prune_tiles && !condition_.tile_may_satisfy(
+                                 array_schema_, *fragment_metadata_[f], t))
+            continue;
+          bool tile_stats_exact = use_tile_stats;
+          for (const auto& aggregate : aggregates_) {
+            if (!tile_stats_exact)
+              break;
+            RETURN_NOT_OK(aggregate.tile_stats_exact(
+                *fragment_metadata_[f], t, &tile_stats_exact));
+          }
+          if (tile_stats_exact) {
+            for (auto& aggregate : aggregates_)
+              RETURN_NOT_OK(aggregate.aggregate_tile_stats(
+                  *fragment_metadata_[f], t));
+            continue;
+          }
           auto pair = std::pair<unsigned, uint64_t>(f, t);
           // Add tile only if it does not already exist
           if (result_tile_map->find(pair) == result_tile_map->end()) {
@@ -885,6 +1566,9 @@ Status Reader::compute_sparse_result_tiles(
       const auto& o_tiles = overlap[f][r].tiles_;
       for (const auto& o_tile : o_tiles) {
         auto t = o_tile.first;
+        if (prune_tiles && !condition_.tile_may_satisfy(
+                               array_schema_, *fragment_metadata_[f], t))
+          continue;
         auto pair = std::pair<unsigned, uint64_t>(f, t);
         // Add tile only if it does not already exist
         if (result_tile_map->find(pair) == result_tile_map->end()) {
@@ -900,31 +1584,136 @@ Status Reader::compute_sparse_result_tiles(
     }
   }
 
+  // The cells of the sparse fragments of dense arrays are checked for
+  // overwrites by the future dense fragments
+  if (array_schema_->dense())
+    compute_overwrite_domains(result_tiles);
+
   return Status::Ok();
 
   STATS_END_TIMER(stats::Stats::TimerType::READ_COMPUTE_SPARSE_RESULT_TILES)
 }
 
-Status Reader::copy_fixed_cells(
-    const std::string& name,
-    uint64_t stride,
-    const std::vector<ResultCellSlab>& result_cell_slabs,
-    CopyFixedCellsContextCache* const ctx_cache) {
-  assert(ctx_cache);
+void Reader::compute_overwrite_domains(
+    std::vector<ResultTile>* result_tiles) const {
+  auto domain = array_schema_->domain();
+  auto fragment_num = (unsigned)fragment_metadata_.size();
 
-  auto stat_type = (array_schema_->is_attr(name)) ?
-                       stats::Stats::TimerType::READ_COPY_FIXED_ATTR_VALUES :
-                       stats::Stats::TimerType::READ_COPY_FIXED_COORDS;
-  STATS_START_TIMER(stat_type)
+  // A dense fragment whose non-empty domain is covered by that of a more
+  // recent dense fragment overwrites no cell that the latter does not
+  // overwrite too, so it is ignored. Computed once per read, so that each
+  // tile is checked only against the fragments that may affect it.
+  std::vector<unsigned> dense_fragments;
+  for (unsigned f = 0; f < fragment_num; ++f) {
+    if (!fragment_metadata_[f]->dense())
+      continue;
+    const auto& non_empty_domain = fragment_metadata_[f]->non_empty_domain();
+    bool redundant = false;
+    for (unsigned g = f + 1; g < fragment_num && !redundant; ++g) {
+      const auto& meta = fragment_metadata_[g];
+      redundant = meta->dense() &&
+                  domain->covered(non_empty_domain, meta->non_empty_domain());
+    }
+    if (!redundant)
+      dense_fragments.push_back(f);
+  }
 
-  if (result_cell_slabs.empty()) {
-    zero_out_buffer_sizes();
-    return Status::Ok();
+  for (auto& tile : *result_tiles) {
+    std::vector<NDRange> overwrite_domains;
+    auto mbr = fragment_metadata_[tile.frag_idx()]->mbr(tile.tile_idx());
+    auto it = std::upper_bound(
+        dense_fragments.begin(), dense_fragments.end(), tile.frag_idx());
+    for (; it != dense_fragments.end(); ++it) {
+      const auto& meta = fragment_metadata_[*it];
+      if (domain->overlap(mbr, meta->non_empty_domain()))
+        overwrite_domains.push_back(meta->non_empty_domain());
+    }
+    tile.set_overwrite_domains(std::move(overwrite_domains));
   }
+}
 
-  // Perform a lazy initialization of the context cache for copying
-  // fixed cells.
-  populate_cfc_ctx_cache(result_cell_slabs, ctx_cache);
+Status Reader::compute_tile_batches(
+    const std::vector<std::string>& names,
+    const std::vector<ResultTile*>& result_tiles,
+    uint64_t max_tiles,
+    std::vector<std::vector<ResultTile*>>* batches) const {
+  const auto encryption_key = array_->encryption_key();
+
+  // A batch is closed when adding the next tile would exceed the budget of
+  // the fixed-sized tiles (including the offsets of the var-sized tiles) or
+  // of the var-sized tiles. A single tile exceeding the budget forms a
+  // batch by itself.
+  batches->clear();
+  batches->emplace_back();
+  uint64_t batch_size = 0, batch_size_var = 0;
+  for (const auto& tile : result_tiles) {
+    auto fragment = fragment_metadata_[tile->frag_idx()];
+    const auto format_version = fragment->format_version();
+    const auto tile_idx = tile->tile_idx();
+
+    // Count the unfiltered and filtered size of each tile
+    uint64_t tile_size = 0, tile_size_var = 0;
+    for (const auto& name : names) {
+      // Applicable for zipped coordinates only to versions < 5
+      if (name == constants::coords && format_version >= 5)
+        continue;
+
+      // Applicable to separate coordinates only to versions >= 5
+      if (array_schema_->is_dim(name) && format_version < 5)
+        continue;
+
+      uint64_t persisted_size;
+      RETURN_NOT_OK(fragment->persisted_tile_size(
+          *encryption_key, name, tile_idx, &persisted_size));
+      tile_size += fragment->tile_size(name, tile_idx) + persisted_size;
+      if (array_schema_->var_size(name)) {
+        uint64_t size_var, persisted_size_var;
+        RETURN_NOT_OK(fragment->tile_var_size(
+            *encryption_key, name, tile_idx, &size_var));
+        RETURN_NOT_OK(fragment->persisted_tile_var_size(
+            *encryption_key, name, tile_idx, &persisted_size_var));
+        tile_size_var += size_var + persisted_size_var;
+      }
+    }
+
+    auto& batch = batches->back();
+    if (!batch.empty() &&
+        (batch.size() == max_tiles ||
+         batch_size + tile_size > memory_budget_ ||
+         batch_size_var + tile_size_var > memory_budget_var_)) {
+      batches->emplace_back();
+      batch_size = 0;
+      batch_size_var = 0;
+    }
+    batches->back().push_back(tile);
+    batch_size += tile_size;
+    batch_size_var += tile_size_var;
+  }
+
+  return Status::Ok();
+}
+
+Status Reader::copy_fixed_cells(
+    const std::string& name,
+    uint64_t stride,
+    const std::vector<ResultCellSlab>& result_cell_slabs,
+    const std::unordered_set<const ResultTile*>* const batch_tiles,
+    CopyFixedCellsContextCache* const ctx_cache) {
+  assert(ctx_cache);
+
+  auto stat_type = (array_schema_->is_attr(name)) ?
+                       stats::Stats::TimerType::READ_COPY_FIXED_ATTR_VALUES :
+                       stats::Stats::TimerType::READ_COPY_FIXED_COORDS;
+  STATS_START_TIMER(stat_type)
+
+  if (result_cell_slabs.empty()) {
+    zero_out_buffer_sizes();
+    return Status::Ok();
+  }
+
+  // Perform a lazy initialization of the context cache for copying
+  // fixed cells.
+  populate_cfc_ctx_cache(result_cell_slabs, ctx_cache);
 
   auto it = buffers_.find(name);
   auto buffer_size = it->second.buffer_size_;
@@ -955,6 +1744,7 @@ Status Reader::copy_fixed_cells(
       &name,
       stride,
       &result_cell_slabs,
+      batch_tiles,
       *cs_offsets,
       *ctx_cache->cs_partitions());
   auto statuses = parallel_for(
@@ -994,6 +1784,7 @@ Status Reader::copy_partitioned_fixed_cells(
     const std::string* const name,
     const uint64_t stride,
     const std::vector<ResultCellSlab>* const result_cell_slabs,
+    const std::unordered_set<const ResultTile*>* const batch_tiles,
     const std::vector<uint64_t>& cs_offsets,
     const std::vector<size_t>& cs_partitions) {
   assert(name);
@@ -1018,6 +1809,10 @@ Status Reader::copy_partitioned_fixed_cells(
     const auto& cs = (*result_cell_slabs)[cs_idx];
     uint64_t offset = cs_offsets[cs_idx];
 
+    // Skip the cell slabs of the tiles outside the batch
+    if (batch_tiles != nullptr && batch_tiles->count(cs.tile_) == 0)
+      continue;
+
     // Copy
     if (cs.tile_ == nullptr) {  // Empty range
       auto bytes_to_copy = cs.length_ * cell_size;
@@ -1049,6 +1844,8 @@ Status Reader::copy_var_cells(
     const std::string& name,
     const uint64_t stride,
     const std::vector<ResultCellSlab>& result_cell_slabs,
+    const std::unordered_set<const ResultTile*>* const batch_tiles,
+    const std::vector<uint64_t>* const cell_var_sizes,
     CopyVarCellsContextCache* const ctx_cache) {
   assert(ctx_cache);
 
@@ -1076,6 +1873,7 @@ Status Reader::copy_var_cells(
       name,
       stride,
       result_cell_slabs,
+      cell_var_sizes,
       offset_offsets_per_cs.get(),
       var_offsets_per_cs.get(),
       &total_offset_size,
@@ -1099,6 +1897,7 @@ Status Reader::copy_var_cells(
       &name,
       stride,
       &result_cell_slabs,
+      batch_tiles,
       offset_offsets_per_cs.get(),
       var_offsets_per_cs.get(),
       ctx_cache->cs_partitions());
@@ -1136,30 +1935,37 @@ void Reader::populate_cvc_ctx_cache(
   ctx_cache->initialize(result_cell_slabs, num_copy_threads);
 }
 
-Status Reader::compute_var_cell_destinations(
+Status Reader::compute_cell_var_sizes(
     const std::string& name,
     uint64_t stride,
     const std::vector<ResultCellSlab>& result_cell_slabs,
-    std::vector<uint64_t>* offset_offsets_per_cs,
-    std::vector<uint64_t>* var_offsets_per_cs,
-    uint64_t* total_offset_size,
-    uint64_t* total_var_size) const {
+    const std::unordered_set<const ResultTile*>* const batch_tiles,
+    std::vector<uint64_t>* cell_var_sizes) const {
   // For easy reference
   auto num_cs = result_cell_slabs.size();
-  auto offset_size = constants::cell_var_offset_size;
   ByteVecValue fill_value;
   if (array_schema_->is_attr(name))
     fill_value = array_schema_->attribute(name)->fill_value();
   auto fill_value_size = (uint64_t)fill_value.size();
 
-  // Compute the destinations for all result cell slabs
-  *total_offset_size = 0;
-  *total_var_size = 0;
+  if (cell_var_sizes->empty()) {
+    uint64_t total_cs_length = 0;
+    for (const auto& cs : result_cell_slabs)
+      total_cs_length += cs.length_;
+    cell_var_sizes->resize(total_cs_length);
+  }
+
+  // Compute the sizes for the result cell slabs of the batch
   size_t total_cs_length = 0;
   for (uint64_t cs_idx = 0; cs_idx < num_cs; cs_idx++) {
     const auto& cs = result_cell_slabs[cs_idx];
+    if (batch_tiles != nullptr && batch_tiles->count(cs.tile_) == 0) {
+      total_cs_length += cs.length_;
+      continue;
+    }
 
-    // Get tile information, if the range is nonempty.
+    // Get tile information, if the range is nonempty. The size of a var
+    // tile that was not read is taken from the fragment metadata.
     uint64_t* tile_offsets = nullptr;
     uint64_t tile_cell_num = 0;
     uint64_t tile_var_size = 0;
@@ -1179,14 +1985,19 @@ Status Reader::compute_var_cell_destinations(
       tile_offsets = (uint64_t*)chunked_buffer->get_contiguous_unsafe();
       tile_cell_num = tile.cell_num();
       tile_var_size = tile_var.size();
+      if (tile_var_size == 0)
+        RETURN_NOT_OK(fragment_metadata_[cs.tile_->frag_idx()]->tile_var_size(
+            *array_->encryption_key(),
+            name,
+            cs.tile_->tile_idx(),
+            &tile_var_size));
     }
 
-    // Compute the destinations for each cell in the range.
+    // Compute the size of each cell in the range.
     uint64_t dest_vec_idx = 0;
     stride = (stride == UINT64_MAX) ? 1 : stride;
     for (auto cell_idx = cs.start_; dest_vec_idx < cs.length_;
          cell_idx += stride, dest_vec_idx++) {
-      // Get size of variable-sized cell
       uint64_t cell_var_size = 0;
       if (cs.tile_ == nullptr) {
         cell_var_size = fill_value_size;
@@ -1196,13 +2007,7 @@ Status Reader::compute_var_cell_destinations(
                 tile_offsets[cell_idx + 1] - tile_offsets[cell_idx] :
                 tile_var_size - (tile_offsets[cell_idx] - tile_offsets[0]);
       }
-
-      // Record destination offsets.
-      (*offset_offsets_per_cs)[total_cs_length + dest_vec_idx] =
-          *total_offset_size;
-      (*var_offsets_per_cs)[total_cs_length + dest_vec_idx] = *total_var_size;
-      *total_offset_size += offset_size;
-      *total_var_size += cell_var_size;
+      (*cell_var_sizes)[total_cs_length + dest_vec_idx] = cell_var_size;
     }
 
     total_cs_length += cs.length_;
@@ -1211,11 +2016,43 @@ Status Reader::compute_var_cell_destinations(
   return Status::Ok();
 }
 
+Status Reader::compute_var_cell_destinations(
+    const std::string& name,
+    uint64_t stride,
+    const std::vector<ResultCellSlab>& result_cell_slabs,
+    const std::vector<uint64_t>* cell_var_sizes,
+    std::vector<uint64_t>* offset_offsets_per_cs,
+    std::vector<uint64_t>* var_offsets_per_cs,
+    uint64_t* total_offset_size,
+    uint64_t* total_var_size) const {
+  // Compute the sizes of the cells from the tiles, unless given
+  std::vector<uint64_t> tile_cell_var_sizes;
+  if (cell_var_sizes == nullptr) {
+    RETURN_NOT_OK(compute_cell_var_sizes(
+        name, stride, result_cell_slabs, nullptr, &tile_cell_var_sizes));
+    cell_var_sizes = &tile_cell_var_sizes;
+  }
+
+  // Compute the destinations for all result cells
+  auto offset_size = constants::cell_var_offset_size;
+  *total_offset_size = 0;
+  *total_var_size = 0;
+  for (size_t i = 0; i < cell_var_sizes->size(); ++i) {
+    (*offset_offsets_per_cs)[i] = *total_offset_size;
+    (*var_offsets_per_cs)[i] = *total_var_size;
+    *total_offset_size += offset_size;
+    *total_var_size += (*cell_var_sizes)[i];
+  }
+
+  return Status::Ok();
+}
+
 Status Reader::copy_partitioned_var_cells(
     const size_t partition_idx,
     const std::string* const name,
     uint64_t stride,
     const std::vector<ResultCellSlab>* const result_cell_slabs,
+    const std::unordered_set<const ResultTile*>* const batch_tiles,
     const std::vector<uint64_t>* const offset_offsets_per_cs,
     const std::vector<uint64_t>* const var_offsets_per_cs,
     const std::vector<std::pair<size_t, size_t>>* const cs_partitions) {
@@ -1246,6 +2083,12 @@ Status Reader::copy_partitioned_var_cells(
   for (uint64_t cs_idx = start_cs_idx; cs_idx < end_cs_idx; ++cs_idx) {
     const auto& cs = (*result_cell_slabs)[cs_idx];
 
+    // Skip the cell slabs of the tiles outside the batch
+    if (batch_tiles != nullptr && batch_tiles->count(cs.tile_) == 0) {
+      arr_offset += cs.length_;
+      continue;
+    }
+
     // Get tile information, if the range is nonempty.
     uint64_t* tile_offsets = nullptr;
     Tile* tile_var = nullptr;
@@ -1473,31 +2316,12 @@ Status Reader::compute_result_coords(
   for (auto& result_tile : *result_tiles)
     tmp_result_tiles.push_back(&result_tile);
 
-  // Preload zipped coordinate tile offsets. Note that this will
-  // ignore fragments with a version >= 5.
-  RETURN_CANCEL_OR_ERROR(load_tile_offsets({constants::coords}));
-
-  // Preload unzipped coordinate tile offsets. Note that this will
-  // ignore fragments with a version < 5.
-  const auto dim_num = array_schema_->dim_num();
-  std::vector<std::string> dim_names;
-  dim_names.reserve(dim_num);
-  for (unsigned d = 0; d < dim_num; ++d)
-    dim_names.emplace_back(array_schema_->dimension(d)->name());
-  RETURN_CANCEL_OR_ERROR(load_tile_offsets(dim_names));
-
-  // Read and unfilter zipped coordinate tiles. Note that
-  // this will ignore fragments with a version >= 5.
-  RETURN_CANCEL_OR_ERROR(
-      read_coordinate_tiles({constants::coords}, tmp_result_tiles));
-  RETURN_CANCEL_OR_ERROR(unfilter_tiles(constants::coords, tmp_result_tiles));
-
-  // Read and unfilter unzipped coordinate tiles. Note that
-  // this will ignore fragments with a version < 5.
-  RETURN_CANCEL_OR_ERROR(read_coordinate_tiles(dim_names, tmp_result_tiles));
-  for (const auto& dim_name : dim_names) {
-    RETURN_CANCEL_OR_ERROR(unfilter_tiles(dim_name, tmp_result_tiles));
-  }
+  // Read and unfilter the coordinate tiles, and the tiles of the
+  // attributes in the query condition. The latter are cleared once the
+  // result coordinates are computed.
+  RETURN_CANCEL_OR_ERROR(read_and_unfilter_coords(tmp_result_tiles, true));
+  const std::vector<std::string> condition_names(
+      condition_.field_names().begin(), condition_.field_names().end());
 
   // Fetch the sub partitioner's memory budget.
   bool found = false;
@@ -1606,28 +2430,48 @@ Status Reader::compute_result_coords(
     }
   }
 
+  for (const auto& name : condition_names)
+    clear_tiles(name, tmp_result_tiles);
+
   return Status::Ok();
 
   STATS_END_TIMER(stats::Stats::TimerType::READ_COMPUTE_RESULT_COORDS)
 }
 
-Status Reader::dedup_result_coords(
+Status Reader::merge_result_coords(
+    const std::vector<std::vector<ResultCoords>>& runs,
+    Layout layout,
+    bool dedup,
     std::vector<ResultCoords>* result_coords) const {
-  auto coords_end = result_coords->end();
-  auto it = skip_invalid_elements(result_coords->begin(), coords_end);
-  while (it != coords_end) {
-    auto next_it = skip_invalid_elements(std::next(it), coords_end);
-    if (next_it != coords_end && it->same_coords(*next_it)) {
-      if (it->tile_->frag_idx() < next_it->tile_->frag_idx()) {
-        it->invalidate();
-        it = skip_invalid_elements(++it, coords_end);
-      } else {
-        next_it->invalidate();
-      }
-    } else {
-      it = skip_invalid_elements(++it, coords_end);
+  // Use the comparator specialized for the domain if there is one
+  ResultCoordsMerge merge(runs, dedup, result_coords);
+  dispatch_result_coords_cmp(array_schema_->domain(), layout, &merge);
+
+  return Status::Ok();
+}
+
+Status Reader::apply_query_condition(
+    std::vector<ResultCoords>* result_coords) const {
+  // Evaluate the condition once per result tile, on demand, compacting
+  // the coordinates that satisfy it to the front, in their original order
+  std::unordered_map<ResultTile*, Bitmap> result_bitmaps;
+  auto out = result_coords->begin();
+  for (auto& c : *result_coords) {
+    if (!c.valid())
+      continue;
+
+    auto it = result_bitmaps.find(c.tile_);
+    if (it == result_bitmaps.end()) {
+      Bitmap result_bitmap(c.tile_->cell_num(), true);
+      RETURN_NOT_OK(condition_.apply(array_schema_, c.tile_, &result_bitmap));
+      it = result_bitmaps.emplace(c.tile_, std::move(result_bitmap)).first;
     }
+
+    if (it->second.get(c.pos_))
+      *out++ = c;
   }
+  result_coords->erase(out, result_coords->end());
+
   return Status::Ok();
 }
 
@@ -1981,20 +2825,30 @@ Status Reader::unfilter_tiles(
                     &empty_ranges;
           }
 
+          // The tiles are unfiltered whole unless selectively unfiltered,
+          // and may then be cached only in the unfiltered tier
+          const bool unfiltered_whole = result_cell_slab_ranges == nullptr ||
+                                        name == constants::coords ||
+                                        t.stores_coords();
+          const bool cache_filtered =
+              storage_manager_->cache_filtered_tile(unfiltered_whole);
+          URI tile_attr_var_uri;
+          uint64_t tile_attr_var_offset = 0;
+          if (var_size) {
+            tile_attr_var_uri = fragment->var_uri(name);
+            RETURN_NOT_OK(fragment->file_var_offset(
+                *encryption_key, name, tile_idx, &tile_attr_var_offset));
+          }
+
           // Cache 't'.
-          if (t.filtered()) {
+          if (cache_filtered && t.filtered()) {
             // Store the filtered buffer in the tile cache.
             RETURN_NOT_OK(storage_manager_->write_to_cache(
                 tile_attr_uri, tile_attr_offset, t.filtered_buffer()));
           }
 
           // Cache 't_var'.
-          if (var_size && t_var.filtered()) {
-            auto tile_attr_var_uri = fragment->var_uri(name);
-            uint64_t tile_attr_var_offset;
-            RETURN_NOT_OK(fragment->file_var_offset(
-                *encryption_key, name, tile_idx, &tile_attr_var_offset));
-
+          if (cache_filtered && var_size && t_var.filtered()) {
             // Store the filtered buffer in the tile cache.
             RETURN_NOT_OK(storage_manager_->write_to_cache(
                 tile_attr_var_uri,
@@ -2010,6 +2864,20 @@ Status Reader::unfilter_tiles(
             RETURN_NOT_OK(
                 unfilter_tile(name, &t, &t_var, result_cell_slab_ranges));
           }
+
+          // Store the unfiltered tiles in the unfiltered tier of the tile
+          // cache, which skips the tiles that were unfiltered partially
+          if (!var_size) {
+            RETURN_NOT_OK(storage_manager_->write_to_unfiltered_cache(
+                tile_attr_uri, tile_attr_offset, t));
+          } else if (
+              t_var.chunked_buffer()->buffer_addressing() ==
+              ChunkedBuffer::BufferAddressing::CONTIGUOUS) {
+            RETURN_NOT_OK(storage_manager_->write_to_unfiltered_cache(
+                tile_attr_uri, tile_attr_offset, t));
+            RETURN_NOT_OK(storage_manager_->write_to_unfiltered_cache(
+                tile_attr_var_uri, tile_attr_var_offset, t_var));
+          }
         }
 
         return Status::Ok();
@@ -2023,6 +2891,58 @@ Status Reader::unfilter_tiles(
   STATS_END_TIMER(stat_type);
 }
 
+Status Reader::unfilter_offset_tiles(
+    const std::string& name,
+    const std::vector<ResultTile*>& result_tiles) const {
+  STATS_START_TIMER(stats::Stats::TimerType::READ_UNFILTER_ATTR_TILES);
+
+  FilterPipeline offset_filters = array_schema_->cell_var_offsets_filters();
+  RETURN_NOT_OK(FilterPipeline::append_encryption_filter(
+      &offset_filters, array_->get_encryption_key()));
+
+  auto encryption_key = array_->encryption_key();
+  const bool cache_filtered = storage_manager_->cache_filtered_tile(true);
+
+  auto statuses = parallel_for(
+      storage_manager_->compute_tp(),
+      0,
+      result_tiles.size(),
+      [&, this](uint64_t i) {
+        // Skip the tiles found in the unfiltered tier of the cache
+        auto tile_pair = result_tiles[i]->tile_pair(name);
+        if (tile_pair == nullptr ||
+            tile_pair->first.filtered_buffer()->size() == 0)
+          return Status::Ok();
+
+        // Cache the filtered tile for the read that copies the cells
+        auto& t = tile_pair->first;
+        if (cache_filtered && t.filtered()) {
+          auto& fragment = fragment_metadata_[result_tiles[i]->frag_idx()];
+          uint64_t tile_attr_offset;
+          RETURN_NOT_OK(fragment->file_offset(
+              *encryption_key,
+              name,
+              result_tiles[i]->tile_idx(),
+              &tile_attr_offset));
+          RETURN_NOT_OK(storage_manager_->write_to_cache(
+              fragment->uri(name), tile_attr_offset, t.filtered_buffer()));
+        }
+
+        return offset_filters.run_reverse(
+            &t,
+            storage_manager_->compute_tp(),
+            storage_manager_->config(),
+            nullptr);
+      });
+
+  for (const auto& st : statuses)
+    RETURN_CANCEL_OR_ERROR(st);
+
+  return Status::Ok();
+
+  STATS_END_TIMER(stats::Stats::TimerType::READ_UNFILTER_ATTR_TILES);
+}
+
 Status Reader::unfilter_tile(
     const std::string& name,
     Tile* tile,
@@ -2087,8 +3007,25 @@ Status Reader::unfilter_tile(
 }
 
 Status Reader::get_all_result_coords(
-    ResultTile* tile, std::vector<ResultCoords>* result_coords) const {
-  auto coords_num = tile->cell_num();
+    ResultTile* tile,
+    bool apply_condition,
+    std::vector<ResultCellSlab>* result_cell_slabs,
+    std::vector<ResultCoords>* result_coords) const {
+  auto coords_num =
+      fragment_metadata_[tile->frag_idx()]->cell_num(tile->tile_idx());
+  if (apply_condition && !condition_.empty()) {
+    Bitmap result_bitmap(coords_num, true);
+    RETURN_NOT_OK(condition_.apply(array_schema_, tile, &result_bitmap));
+    result_bitmap.for_each(
+        [&](uint64_t pos) { result_coords->emplace_back(tile, pos); });
+    return Status::Ok();
+  }
+
+  if (result_cell_slabs != nullptr) {
+    result_cell_slabs->emplace_back(tile, 0, coords_num);
+    return Status::Ok();
+  }
+
   for (uint64_t i = 0; i < coords_num; ++i)
     result_coords->emplace_back(tile, i);
 
@@ -2143,6 +3080,19 @@ Status Reader::init_read_state() {
   read_state_.overflowed_ = false;
   read_state_.unsplittable_ = false;
 
+  // Reads with aggregates do not return any results, so their partitions
+  // are bounded only by the memory budget
+  for (const auto& aggregate : aggregates_) {
+    const auto& name = aggregate.field_name();
+    if (!array_schema_->var_size(name)) {
+      RETURN_NOT_OK(
+          read_state_.partitioner_.set_result_budget(name.c_str(), UINT64_MAX));
+    } else {
+      RETURN_NOT_OK(read_state_.partitioner_.set_result_budget(
+          name.c_str(), UINT64_MAX, UINT64_MAX));
+    }
+  }
+
   // Set result size budget
   for (const auto& a : buffers_) {
     auto attr_name = a.first;
@@ -2159,6 +3109,8 @@ Status Reader::init_read_state() {
 
   read_state_.unsplittable_ = false;
   read_state_.overflowed_ = false;
+  read_state_.unordered_window_ = 0;
+  read_state_.unordered_window_cell_ = 0;
   read_state_.initialized_ = true;
 
   return Status::Ok();
@@ -2236,6 +3188,224 @@ Status Reader::load_tile_offsets(const std::vector<std::string>& names) {
   return Status::Ok();
 }
 
+Status Reader::load_tile_stats(
+    const std::vector<std::string>& names) {
+  const auto encryption_key = array_->encryption_key();
+
+  const auto statuses = parallel_for(
+      storage_manager_->compute_tp(),
+      0,
+      fragment_metadata_.size(),
+      [&](const uint64_t i) {
+        auto& fragment = fragment_metadata_[i];
+        std::vector<std::string> fragment_names(names);
+        return fragment->load_tile_stats(
+            *encryption_key, std::move(fragment_names));
+      });
+
+  for (const auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  return Status::Ok();
+}
+
+Status Reader::read_and_unfilter_coords(
+    const std::vector<ResultTile*>& result_tiles, bool full_tile_coords) {
+  // Preload zipped coordinate tile offsets. Note that this will
+  // ignore fragments with a version >= 5.
+  RETURN_CANCEL_OR_ERROR(load_tile_offsets({constants::coords}));
+
+  // Preload unzipped coordinate tile offsets. Note that this will
+  // ignore fragments with a version < 5.
+  const auto dim_num = array_schema_->dim_num();
+  std::vector<std::string> dim_names;
+  dim_names.reserve(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d)
+    dim_names.emplace_back(array_schema_->dimension(d)->name());
+  RETURN_CANCEL_OR_ERROR(load_tile_offsets(dim_names));
+
+  // Read and unfilter zipped coordinate tiles. Note that
+  // this will ignore fragments with a version >= 5.
+  RETURN_CANCEL_OR_ERROR(
+      read_coordinate_tiles({constants::coords}, result_tiles));
+  RETURN_CANCEL_OR_ERROR(unfilter_tiles(constants::coords, result_tiles));
+
+  // Find the tiles that need their unzipped coordinate tiles, and the
+  // tiles to search on the leading dimension of the cell order first
+  std::vector<ResultTile*> searched_tiles, coords_tiles;
+  RETURN_NOT_OK(compute_coords_tiles(
+      result_tiles, full_tile_coords, &searched_tiles, &coords_tiles));
+
+  // Read and unfilter the leading dimension tiles of the searched tiles,
+  // then read the rest of their coordinate tiles only for the tiles with
+  // cells in some range on that dimension. Note that this will ignore
+  // fragments with a version < 5.
+  std::unordered_set<const ResultTile*> skipped_tiles;
+  if (!searched_tiles.empty()) {
+    const unsigned leading_dim =
+        (array_schema_->cell_order() == Layout::ROW_MAJOR) ? 0 : dim_num - 1;
+    const std::vector<std::string> leading_dim_name = {
+        dim_names[leading_dim]};
+    std::vector<ResultTile*> leading_dim_tiles(coords_tiles);
+    leading_dim_tiles.insert(
+        leading_dim_tiles.end(), searched_tiles.begin(), searched_tiles.end());
+    RETURN_CANCEL_OR_ERROR(
+        read_coordinate_tiles(leading_dim_name, leading_dim_tiles));
+    RETURN_CANCEL_OR_ERROR(
+        unfilter_tiles(leading_dim_name[0], leading_dim_tiles));
+    leading_dim_tiles.clear();
+
+    std::vector<ResultTile*> tiles_in_ranges;
+    RETURN_NOT_OK(
+        compute_tiles_in_ranges(leading_dim, searched_tiles, &tiles_in_ranges));
+    skipped_tiles.insert(searched_tiles.begin(), searched_tiles.end());
+    for (const auto& tile : tiles_in_ranges)
+      skipped_tiles.erase(tile);
+    coords_tiles.insert(
+        coords_tiles.end(), tiles_in_ranges.begin(), tiles_in_ranges.end());
+    dim_names.erase(dim_names.begin() + leading_dim);
+  }
+
+  // Read and unfilter unzipped coordinate tiles. Note that
+  // this will ignore fragments with a version < 5.
+  RETURN_CANCEL_OR_ERROR(read_coordinate_tiles(dim_names, coords_tiles));
+  for (const auto& dim_name : dim_names) {
+    RETURN_CANCEL_OR_ERROR(unfilter_tiles(dim_name, coords_tiles));
+  }
+
+  // Read and unfilter the tiles of the attributes in the query condition,
+  // for all the tiles that may have results
+  const std::vector<std::string> condition_names(
+      condition_.field_names().begin(), condition_.field_names().end());
+  if (!condition_names.empty()) {
+    std::vector<ResultTile*> condition_tiles;
+    for (const auto& tile : result_tiles) {
+      if (skipped_tiles.count(tile) == 0)
+        condition_tiles.push_back(tile);
+    }
+    RETURN_CANCEL_OR_ERROR(load_tile_offsets(condition_names));
+    RETURN_CANCEL_OR_ERROR(
+        read_attribute_tiles(condition_names, condition_tiles));
+    for (const auto& name : condition_names)
+      RETURN_CANCEL_OR_ERROR(unfilter_tiles(name, condition_tiles));
+  }
+
+  return Status::Ok();
+}
+
+Status Reader::compute_coords_tiles(
+    const std::vector<ResultTile*>& result_tiles,
+    bool full_tile_coords,
+    std::vector<ResultTile*>* searched_tiles,
+    std::vector<ResultTile*>* coords_tiles) {
+  typedef std::pair<unsigned, uint64_t> FragTilePair;
+  std::map<FragTilePair, ResultTile*> tile_map;
+  for (const auto& tile : result_tiles)
+    tile_map[FragTilePair(tile->frag_idx(), tile->tile_idx())] = tile;
+
+  // Find the tiles fully covered by, and partially overlapping, some range
+  std::unordered_set<const ResultTile*> full_tiles, partial_tiles;
+  auto& subarray = read_state_.partitioner_.current();
+  const auto& overlap = subarray.tile_overlap();
+  auto range_num = subarray.range_num();
+  auto fragment_num = (unsigned)fragment_metadata_.size();
+  for (unsigned f = 0; f < fragment_num; ++f) {
+    for (uint64_t r = 0; r < range_num; ++r) {
+      const auto& tile_overlap = overlap[f][r];
+      for (const auto& tr : tile_overlap.tile_ranges_) {
+        auto it = tile_map.lower_bound(FragTilePair(f, tr.first));
+        auto it_end = tile_map.upper_bound(FragTilePair(f, tr.second));
+        for (; it != it_end; ++it)
+          full_tiles.insert(it->second);
+      }
+      for (const auto& t : tile_overlap.tiles_) {
+        auto it = tile_map.find(FragTilePair(f, t.first));
+        if (it == tile_map.end())
+          continue;
+        if (t.second == 1.0)
+          full_tiles.insert(it->second);
+        else
+          partial_tiles.insert(it->second);
+      }
+    }
+  }
+
+  // The cells of the fully covered tiles are all results, so their
+  // coordinates are needed only if requested. The partially overlapping
+  // tiles sorted on the leading dimension are searched on it first.
+  unsigned leading_dim = 0;
+  for (const auto& tile : result_tiles) {
+    bool full = full_tiles.count(tile) != 0;
+    bool partial = partial_tiles.count(tile) != 0;
+    if (full && !partial && !full_tile_coords)
+      continue;
+
+    if (partial && !(full && full_tile_coords) &&
+        !tile->stores_zipped_coords() &&
+        sparse_tile_sorted(tile->frag_idx(), tile->tile_idx(), &leading_dim))
+      searched_tiles->push_back(tile);
+    else
+      coords_tiles->push_back(tile);
+  }
+
+  return Status::Ok();
+}
+
+Status Reader::compute_tiles_in_ranges(
+    unsigned leading_dim,
+    const std::vector<ResultTile*>& searched_tiles,
+    std::vector<ResultTile*>* tiles_in_ranges) {
+  typedef std::pair<unsigned, uint64_t> FragTilePair;
+  std::map<FragTilePair, ResultTile*> tile_map;
+  for (const auto& tile : searched_tiles)
+    tile_map[FragTilePair(tile->frag_idx(), tile->tile_idx())] = tile;
+
+  // A tile has cells in some range if it is fully covered by a range, or
+  // its window of cells in a partially overlapping range on the leading
+  // dimension is non-empty
+  std::unordered_set<const ResultTile*> found;
+  auto& subarray = read_state_.partitioner_.current();
+  const auto& overlap = subarray.tile_overlap();
+  const auto& ranges = subarray.ranges_for_dim(leading_dim);
+  auto range_num = subarray.range_num();
+  auto fragment_num = (unsigned)fragment_metadata_.size();
+  for (unsigned f = 0; f < fragment_num; ++f) {
+    for (uint64_t r = 0; r < range_num; ++r) {
+      const auto& tile_overlap = overlap[f][r];
+      for (const auto& tr : tile_overlap.tile_ranges_) {
+        auto it = tile_map.lower_bound(FragTilePair(f, tr.first));
+        auto it_end = tile_map.upper_bound(FragTilePair(f, tr.second));
+        for (; it != it_end; ++it)
+          found.insert(it->second);
+      }
+
+      if (tile_overlap.tiles_.empty())
+        continue;
+      auto range_coords = subarray.get_range_coords(r);
+      const auto& range = ranges[range_coords[leading_dim]];
+      for (const auto& t : tile_overlap.tiles_) {
+        auto it = tile_map.find(FragTilePair(f, t.first));
+        if (it == tile_map.end() || found.count(it->second) != 0)
+          continue;
+        uint64_t start = 0, end = 0;
+        if (t.second != 1.0)
+          RETURN_NOT_OK(it->second->compute_results_window(
+              leading_dim, range, &start, &end));
+        if (t.second == 1.0 || start < end)
+          found.insert(it->second);
+      }
+    }
+  }
+
+  tiles_in_ranges->clear();
+  for (const auto& tile : searched_tiles) {
+    if (found.count(tile) != 0)
+      tiles_in_ranges->push_back(tile);
+  }
+
+  return Status::Ok();
+}
+
 Status Reader::read_attribute_tiles(
     const std::vector<std::string>& names,
     const std::vector<ResultTile*>& result_tiles) const {
@@ -2244,6 +3414,14 @@ Status Reader::read_attribute_tiles(
   STATS_END_TIMER(stats::Stats::TimerType::READ_ATTR_TILES);
 }
 
+Status Reader::read_attribute_offset_tiles(
+    const std::vector<std::string>& names,
+    const std::vector<ResultTile*>& result_tiles) const {
+  STATS_START_TIMER(stats::Stats::TimerType::READ_ATTR_TILES);
+  return read_tiles(names, result_tiles, true);
+  STATS_END_TIMER(stats::Stats::TimerType::READ_ATTR_TILES);
+}
+
 Status Reader::read_coordinate_tiles(
     const std::vector<std::string>& names,
     const std::vector<ResultTile*>& result_tiles) const {
@@ -2254,15 +3432,16 @@ Status Reader::read_coordinate_tiles(
 
 Status Reader::read_tiles(
     const std::vector<std::string>& names,
-    const std::vector<ResultTile*>& result_tiles) const {
+    const std::vector<ResultTile*>& result_tiles,
+    const bool offsets_only) const {
   // Reading tiles are thread safe. However, we will perform
   // them on this thread if there is only one read to perform.
   if (names.size() == 1) {
-    RETURN_NOT_OK(read_tiles(names[0], result_tiles));
+    RETURN_NOT_OK(read_tiles(names[0], result_tiles, offsets_only));
   } else {
     const auto statuses = parallel_for(
         storage_manager_->compute_tp(), 0, names.size(), [&](const uint64_t i) {
-          RETURN_NOT_OK(read_tiles(names[i], result_tiles));
+          RETURN_NOT_OK(read_tiles(names[i], result_tiles, offsets_only));
           return Status::Ok();
         });
 
@@ -2275,14 +3454,16 @@ Status Reader::read_tiles(
 
 Status Reader::read_tiles(
     const std::string& name,
-    const std::vector<ResultTile*>& result_tiles) const {
+    const std::vector<ResultTile*>& result_tiles,
+    const bool offsets_only) const {
   // Shortcut for empty tile vec
   if (result_tiles.empty())
     return Status::Ok();
 
   // Read the tiles asynchronously
   std::vector<ThreadPool::Task> tasks;
-  RETURN_CANCEL_OR_ERROR(read_tiles(name, result_tiles, &tasks));
+  RETURN_CANCEL_OR_ERROR(
+      read_tiles(name, result_tiles, &tasks, offsets_only));
 
   // Wait for the reads to finish and check statuses.
   auto statuses = storage_manager_->io_tp()->wait_all_status(tasks);
@@ -2295,13 +3476,15 @@ Status Reader::read_tiles(
 Status Reader::read_tiles(
     const std::string& name,
     const std::vector<ResultTile*>& result_tiles,
-    std::vector<ThreadPool::Task>* const tasks) const {
+    std::vector<ThreadPool::Task>* const tasks,
+    const bool offsets_only) const {
   // Shortcut for empty tile vec
   if (result_tiles.empty())
     return Status::Ok();
 
   // For each tile, read from its fragment.
   const bool var_size = array_schema_->var_size(name);
+  const bool read_var = var_size && !offsets_only;
   const auto encryption_key = array_->encryption_key();
 
   // Gather the unique fragments indexes for which there are tiles
@@ -2362,12 +3545,33 @@ Status Reader::read_tiles(
     uint64_t tile_attr_offset;
     RETURN_NOT_OK(fragment->file_offset(
         *encryption_key, name, tile_idx, &tile_attr_offset));
+
+    // Try the unfiltered tier of the cache first, which also saves
+    // unfiltering the tile. The tiles of a var-sized attribute are
+    // unfiltered together, so both of them must be hits.
+    bool cache_hit;
+    RETURN_NOT_OK(storage_manager_->read_from_unfiltered_cache(
+        tile_attr_uri, tile_attr_offset, t, &cache_hit));
+    if (cache_hit && read_var) {
+      uint64_t tile_attr_var_offset;
+      RETURN_NOT_OK(fragment->file_var_offset(
+          *encryption_key, name, tile_idx, &tile_attr_var_offset));
+      RETURN_NOT_OK(storage_manager_->read_from_unfiltered_cache(
+          fragment->var_uri(name), tile_attr_var_offset, t_var, &cache_hit));
+      if (!cache_hit)
+        t->chunked_buffer()->free();
+    }
+    if (cache_hit) {
+      STATS_ADD_COUNTER(
+          stats::Stats::CounterType::READ_UNFILTERED_CACHE_HIT_NUM, 1);
+      continue;
+    }
+
     uint64_t tile_persisted_size;
     RETURN_NOT_OK(fragment->persisted_tile_size(
         *encryption_key, name, tile_idx, &tile_persisted_size));
 
-    // Try the cache first.
-    bool cache_hit;
+    // Try the cache.
     RETURN_NOT_OK(storage_manager_->read_from_cache(
         tile_attr_uri,
         tile_attr_offset,
@@ -2383,7 +3587,7 @@ Status Reader::read_tiles(
           tile_attr_offset, t->filtered_buffer()->data(), tile_persisted_size);
     }
 
-    if (var_size) {
+    if (read_var) {
       auto tile_attr_var_uri = fragment->var_uri(name);
       uint64_t tile_attr_var_offset;
       RETURN_NOT_OK(fragment->file_var_offset(
@@ -2449,28 +3653,23 @@ Status Reader::sort_result_coords(
   // TODO: do not sort if it is single fragment and
   // (i) it is single dimension, or (ii) it is global order
 
-  auto domain = array_schema_->domain();
-
-  if (layout == Layout::ROW_MAJOR) {
-    parallel_sort(
-        storage_manager_->compute_tp(), iter_begin, iter_end, RowCmp(domain));
-  } else if (layout == Layout::COL_MAJOR) {
-    parallel_sort(
-        storage_manager_->compute_tp(), iter_begin, iter_end, ColCmp(domain));
-  } else if (layout == Layout::GLOBAL_ORDER) {
-    parallel_sort(
-        storage_manager_->compute_tp(),
-        iter_begin,
-        iter_end,
-        GlobalCmp(domain));
-  } else {
-    assert(false);
-  }
+  // Use the comparator specialized for the domain if there is one
+  ResultCoordsSort sort(storage_manager_->compute_tp(), iter_begin, iter_end);
+  dispatch_result_coords_cmp(array_schema_->domain(), layout, &sort);
 
   return Status::Ok();
 }
 
 Status Reader::sparse_read() {
+  // Unordered results that need no deduplication are streamed to the
+  // user buffers one window of tiles at a time
+  if (layout_ == Layout::UNORDERED) {
+    bool streamed = false;
+    RETURN_NOT_OK(sparse_read_unordered(&streamed));
+    if (streamed)
+      return Status::Ok();
+  }
+
   // Compute result coordinates from the sparse fragments
   // `sparse_result_tiles` will hold all the relevant result tiles of
   // sparse fragments
@@ -2497,6 +3696,305 @@ Status Reader::sparse_read() {
   return Status::Ok();
 }
 
+Status Reader::sparse_read_unordered(bool* streamed) {
+  *streamed = false;
+
+  // A zero window disables streaming
+  bool found = false;
+  uint64_t tile_window = 0;
+  RETURN_NOT_OK(storage_manager_->config().get<uint64_t>(
+      "sm.sparse_unordered_tile_window", &tile_window, &found));
+  assert(found);
+  if (tile_window == 0)
+    return Status::Ok();
+
+  // Compute the result tiles. Deduplication needs the cells of all the
+  // fragments of a range at once, so the results cannot be streamed if
+  // a range overlaps multiple fragments and duplicates are not allowed.
+  typedef std::pair<unsigned, uint64_t> FragTilePair;
+  std::vector<ResultTile> result_tiles;
+  std::map<FragTilePair, size_t> result_tile_map;
+  std::vector<bool> single_fragment;
+  RETURN_CANCEL_OR_ERROR(compute_sparse_result_tiles(
+      &result_tiles, &result_tile_map, &single_fragment));
+  if (!array_schema_->allows_dups() &&
+      std::find(single_fragment.begin(), single_fragment.end(), false) !=
+          single_fragment.end())
+    return Status::Ok();
+  *streamed = true;
+  result_tile_map.clear();
+
+  // The results of each window are copied after those of the previous
+  // windows, by offsetting the user buffers by the bytes written so far
+  const auto buffers = buffers_;
+  std::unordered_map<std::string, std::pair<uint64_t, uint64_t>> written;
+  for (const auto& it : buffers_)
+    written[it.first] = std::make_pair(0, 0);
+
+  // Split the result tiles into windows of at most `tile_window` tiles,
+  // whose coordinate and query condition tiles fit the memory budget
+  const auto dim_num = array_schema_->dim_num();
+  const std::vector<std::string> condition_names(
+      condition_.field_names().begin(), condition_.field_names().end());
+  std::vector<std::string> names = {constants::coords};
+  for (unsigned d = 0; d < dim_num; ++d)
+    names.emplace_back(array_schema_->dimension(d)->name());
+  names.insert(names.end(), condition_names.begin(), condition_names.end());
+  RETURN_CANCEL_OR_ERROR(load_tile_offsets(names));
+  std::vector<ResultTile*> tmp_result_tiles;
+  for (auto& result_tile : result_tiles)
+    tmp_result_tiles.push_back(&result_tile);
+  std::vector<std::vector<ResultTile*>> windows;
+  RETURN_NOT_OK(
+      compute_tile_batches(names, tmp_result_tiles, tile_window, &windows));
+
+  // A partially returned partition resumes from the first window whose
+  // results did not fit, skipping the cells of that window already
+  // returned
+  const uint64_t first_window = read_state_.unordered_window_;
+  const uint64_t first_window_cell = read_state_.unordered_window_cell_;
+  const bool resumed = read_state_.resumes_partition();
+  read_state_.unordered_window_ = 0;
+  read_state_.unordered_window_cell_ = 0;
+  bool copied = false;
+
+  auto subarray = &read_state_.partitioner_.current();
+  auto range_num = subarray->range_num();
+  for (uint64_t w = first_window; w < windows.size(); ++w) {
+    const auto& window_tiles = windows[w];
+
+    // Restrict the result tiles to the window
+    std::map<FragTilePair, size_t> window_tile_map;
+    for (const auto& tile : window_tiles)
+      window_tile_map[FragTilePair(tile->frag_idx(), tile->tile_idx())] =
+          tile - &result_tiles[0];
+
+    // Compute the result coordinates of the window per range, and the
+    // result cell slabs in the order the cells appear in the tiles. The
+    // tiles fully covered by a range yield a single result cell slab each,
+    // so their coordinates are read only if the user asked for them
+    RETURN_CANCEL_OR_ERROR(
+        read_and_unfilter_coords(window_tiles, has_coords()));
+    std::vector<std::vector<ResultCoords>> range_result_coords(range_num);
+    std::vector<std::vector<ResultCellSlab>> full_tile_slabs(range_num);
+    auto statuses = parallel_for(
+        storage_manager_->compute_tp(), 0, range_num, [&](uint64_t r) {
+          return compute_range_result_coords(
+              subarray,
+              r,
+              window_tile_map,
+              &result_tiles,
+              false,
+              &full_tile_slabs[r],
+              &range_result_coords[r]);
+        });
+    for (const auto& st : statuses)
+      RETURN_CANCEL_OR_ERROR(st);
+    std::vector<ResultCellSlab> result_cell_slabs;
+    for (uint64_t r = 0; r < range_num; ++r) {
+      RETURN_CANCEL_OR_ERROR(compute_result_cell_slabs(
+          range_result_coords[r], &result_cell_slabs));
+      result_cell_slabs.insert(
+          result_cell_slabs.end(),
+          full_tile_slabs[r].begin(),
+          full_tile_slabs[r].end());
+    }
+    range_result_coords.clear();
+    full_tile_slabs.clear();
+    const uint64_t skip_cell_num = (w == first_window) ? first_window_cell : 0;
+    if (skip_cell_num > 0)
+      result_cell_slabs = slice_result_cell_slabs(
+          result_cell_slabs, skip_cell_num, UINT64_MAX);
+
+    get_result_tile_stats(window_tiles);
+    get_result_cell_stats(result_cell_slabs);
+
+    if (!result_cell_slabs.empty()) {
+      uint64_t cell_num = 0;
+      for (const auto& slab : result_cell_slabs)
+        cell_num += slab.length_;
+
+      // Copy the window. If nothing was returned yet from a resumed
+      // partition, whose remaining results are copied after those already
+      // returned and cannot be split anymore, the window is copied
+      // partially, halving the copied cells until they fit.
+      uint64_t copy_cell_num = cell_num;
+      while (true) {
+        read_state_.overflowed_ = false;
+        for (auto& it : buffers_) {
+          const auto& buffer = buffers.at(it.first);
+          const auto& bytes = written[it.first];
+          it.second.buffer_ = (unsigned char*)buffer.buffer_ + bytes.first;
+          *it.second.buffer_size_ = buffer.original_buffer_size_ - bytes.first;
+          if (buffer.buffer_var_ != nullptr) {
+            it.second.buffer_var_ =
+                (unsigned char*)buffer.buffer_var_ + bytes.second;
+            *it.second.buffer_var_size_ =
+                buffer.original_buffer_var_size_ - bytes.second;
+          }
+        }
+
+        // The coordinate tiles copied by a failed attempt were released
+        std::vector<ResultCellSlab> partial_cell_slabs;
+        if (copy_cell_num < cell_num) {
+          RETURN_CANCEL_OR_ERROR(
+              read_and_unfilter_coords(window_tiles, has_coords()));
+          partial_cell_slabs =
+              slice_result_cell_slabs(result_cell_slabs, 0, copy_cell_num);
+        }
+        const auto& copy_cell_slabs = (copy_cell_num < cell_num) ?
+                                          partial_cell_slabs :
+                                          result_cell_slabs;
+        RETURN_NOT_OK(copy_coordinates(window_tiles, copy_cell_slabs));
+        RETURN_NOT_OK(copy_attribute_values(
+            UINT64_MAX, window_tiles, copy_cell_slabs));
+        if (!read_state_.overflowed_ || !resumed || copied ||
+            copy_cell_num == 1)
+          break;
+        copy_cell_num /= 2;
+      }
+
+      // Return the results copied so far and resume from this window in
+      // the next read. The partition is split only if none of its results
+      // were returned.
+      if (read_state_.overflowed_) {
+        if (copied || resumed) {
+          read_state_.unordered_window_ = w;
+          read_state_.unordered_window_cell_ = skip_cell_num;
+        }
+        if (copied)
+          read_state_.overflowed_ = false;
+        break;
+      }
+
+      // The offsets of the var-sized cells of the window are relative to
+      // the start of the window's var-sized data
+      for (auto& it : buffers_) {
+        auto& bytes = written[it.first];
+        if (it.second.buffer_var_ != nullptr) {
+          auto offsets = (uint64_t*)it.second.buffer_;
+          auto offset_num =
+              *it.second.buffer_size_ / constants::cell_var_offset_size;
+          for (uint64_t i = 0; i < offset_num; ++i)
+            offsets[i] += bytes.second;
+          bytes.second += *it.second.buffer_var_size_;
+        }
+        bytes.first += *it.second.buffer_size_;
+      }
+      copied = true;
+
+      // A partially copied window resumes after its copied cells
+      if (copy_cell_num < cell_num) {
+        read_state_.unordered_window_ = w;
+        read_state_.unordered_window_cell_ = skip_cell_num + copy_cell_num;
+        break;
+      }
+    }
+
+    // Release the tiles of the window
+    clear_tiles(constants::coords, window_tiles);
+    for (unsigned d = 0; d < dim_num; ++d)
+      clear_tiles(array_schema_->dimension(d)->name(), window_tiles);
+    for (const auto& name : condition_names)
+      clear_tiles(name, window_tiles);
+  }
+
+  // Restore the user buffers and set the sizes of the results
+  for (auto& it : buffers_) {
+    const auto& buffer = buffers.at(it.first);
+    const auto& bytes = written[it.first];
+    it.second.buffer_ = buffer.buffer_;
+    it.second.buffer_var_ = buffer.buffer_var_;
+    *it.second.buffer_size_ = bytes.first;
+    if (it.second.buffer_var_size_ != nullptr)
+      *it.second.buffer_var_size_ = bytes.second;
+  }
+
+  return Status::Ok();
+}
+
+Status Reader::sparse_aggregate() {
+  // Compute the result coordinates of the tiles that were not aggregated
+  // from the tile statistics
+  std::vector<ResultCoords> result_coords;
+  std::vector<ResultTile> sparse_result_tiles;
+  RETURN_NOT_OK(compute_result_coords(&sparse_result_tiles, &result_coords));
+  std::vector<ResultTile*> result_tiles;
+  for (auto& srt : sparse_result_tiles)
+    result_tiles.push_back(&srt);
+
+  // Compute result cell slabs
+  std::vector<ResultCellSlab> result_cell_slabs;
+  RETURN_CANCEL_OR_ERROR(
+      compute_result_cell_slabs(result_coords, &result_cell_slabs));
+  result_coords.clear();
+
+  get_result_tile_stats(result_tiles);
+  get_result_cell_stats(result_cell_slabs);
+
+  return compute_aggregates(result_tiles, result_cell_slabs);
+}
+
+Status Reader::compute_aggregates(
+    const std::vector<ResultTile*>& result_tiles,
+    const std::vector<ResultCellSlab>& result_cell_slabs) {
+  if (result_cell_slabs.empty())
+    return Status::Ok();
+
+  // Read and unfilter the tiles of the aggregated attributes
+  std::vector<std::string> names;
+  for (const auto& aggregate : aggregates_) {
+    const auto& name = aggregate.field_name();
+    if (aggregate.needs_values() &&
+        std::find(names.begin(), names.end(), name) == names.end())
+      names.emplace_back(name);
+  }
+  if (!names.empty()) {
+    RETURN_CANCEL_OR_ERROR(load_tile_offsets(names));
+    RETURN_CANCEL_OR_ERROR(read_attribute_tiles(names, result_tiles));
+    for (const auto& name : names)
+      RETURN_CANCEL_OR_ERROR(unfilter_tiles(name, result_tiles));
+  }
+
+  // Group the result cell slabs by result tile
+  std::unordered_map<const ResultTile*, size_t> tile_slabs_idx;
+  std::vector<std::vector<ResultCellSlab>> tile_slabs;
+  for (const auto& slab : result_cell_slabs) {
+    auto it = tile_slabs_idx.find(slab.tile_);
+    if (it == tile_slabs_idx.end()) {
+      it = tile_slabs_idx.emplace(slab.tile_, tile_slabs.size()).first;
+      tile_slabs.emplace_back();
+    }
+    tile_slabs[it->second].emplace_back(slab);
+  }
+
+  // Compute partial aggregates per result tile in parallel
+  std::vector<QueryAggregate> empty_aggregates(aggregates_);
+  for (auto& aggregate : empty_aggregates)
+    aggregate.reset(array_schema_);
+  std::vector<std::vector<QueryAggregate>> partial_aggregates(
+      tile_slabs.size(), empty_aggregates);
+  auto statuses = parallel_for(
+      storage_manager_->compute_tp(), 0, tile_slabs.size(), [&](uint64_t i) {
+        for (auto& aggregate : partial_aggregates[i])
+          RETURN_NOT_OK(aggregate.aggregate_cells(tile_slabs[i]));
+        return Status::Ok();
+      });
+  for (const auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  // Merge the partial aggregates
+  for (const auto& partial : partial_aggregates) {
+    for (size_t a = 0; a < aggregates_.size(); ++a)
+      aggregates_[a].merge(partial[a]);
+  }
+
+  for (const auto& name : names)
+    clear_tiles(name, result_tiles);
+
+  return Status::Ok();
+}
+
 Status Reader::copy_coordinates(
     const std::vector<ResultTile*>& result_tiles,
     const std::vector<ResultCellSlab>& result_cell_slabs) {
@@ -2530,7 +4028,8 @@ Status Reader::copy_coordinates(
     CopyFixedCellsContextCache ctx_cache;
     for (const auto& name : fixed_names) {
       RETURN_CANCEL_OR_ERROR(
-          copy_fixed_cells(name, stride, result_cell_slabs, &ctx_cache));
+          copy_fixed_cells(
+              name, stride, result_cell_slabs, nullptr, &ctx_cache));
       clear_tiles(name, result_tiles);
     }
   }
@@ -2540,7 +4039,8 @@ Status Reader::copy_coordinates(
     CopyVarCellsContextCache ctx_cache;
     for (const auto& name : var_names) {
       RETURN_CANCEL_OR_ERROR(
-          copy_var_cells(name, stride, result_cell_slabs, &ctx_cache));
+          copy_var_cells(
+              name, stride, result_cell_slabs, nullptr, nullptr, &ctx_cache));
       clear_tiles(name, result_tiles);
     }
   }
@@ -2638,24 +4138,84 @@ Status Reader::copy_attribute_values(
     std::vector<std::string> inner_names(
         names.begin() + names_idx, names.begin() + names_idx + num_reads);
 
-    // Read the tiles for the names in `inner_names`. Each attribute
-    // name will be read concurrently.
-    RETURN_CANCEL_OR_ERROR(read_attribute_tiles(inner_names, result_tiles));
+    // Split the result tiles into batches whose tiles for `inner_names`
+    // fit the memory budget. The tiles of a batch are released before the
+    // tiles of the next batch are read.
+    std::vector<std::vector<ResultTile*>> batches;
+    RETURN_NOT_OK(
+        compute_tile_batches(inner_names, result_tiles, UINT64_MAX, &batches));
+
+    // With multiple batches, each batch copies the cells of the result cell
+    // slabs of its tiles. The empty ranges are copied with the first batch.
+    // The destinations of the var-sized cells depend on the sizes of all
+    // the preceding cells, which are computed in a first pass over the
+    // batches. That pass needs only the offset tiles, since the sizes of
+    // the var tiles are stored in the fragment metadata.
+    std::vector<std::unordered_set<const ResultTile*>> batch_tiles;
+    std::unordered_map<std::string, std::vector<uint64_t>> cell_var_sizes;
+    if (batches.size() > 1) {
+      for (const auto& batch : batches)
+        batch_tiles.emplace_back(batch.begin(), batch.end());
+      batch_tiles[0].insert(nullptr);
+
+      std::vector<std::string> var_names;
+      for (const auto& inner_name : inner_names) {
+        if (array_schema_->var_size(inner_name))
+          var_names.emplace_back(inner_name);
+      }
+      for (size_t b = 0; !var_names.empty() && b < batches.size(); ++b) {
+        RETURN_CANCEL_OR_ERROR(
+            read_attribute_offset_tiles(var_names, batches[b]));
+        for (const auto& var_name : var_names) {
+          RETURN_CANCEL_OR_ERROR(unfilter_offset_tiles(var_name, batches[b]));
+          RETURN_CANCEL_OR_ERROR(compute_cell_var_sizes(
+              var_name,
+              stride,
+              result_cell_slabs,
+              &batch_tiles[b],
+              &cell_var_sizes[var_name]));
+          clear_tiles(var_name, batches[b]);
+        }
+      }
+    }
 
-    // Copy the cells into the associated `buffers_`, and then clear the cells
-    // from the tiles. The cell copies are not thread safe. Clearing tiles are
-    // thread safe, but quick enough that they do not justify scheduling on
-    // separate threads.
-    for (const auto& inner_name : inner_names) {
-      RETURN_CANCEL_OR_ERROR(
-          unfilter_tiles(inner_name, result_tiles, &cs_ranges));
-      if (!array_schema_->var_size(inner_name))
-        RETURN_CANCEL_OR_ERROR(copy_fixed_cells(
-            inner_name, stride, result_cell_slabs, &fixed_ctx_cache));
-      else
-        RETURN_CANCEL_OR_ERROR(copy_var_cells(
-            inner_name, stride, result_cell_slabs, &var_ctx_cache));
-      clear_tiles(inner_name, result_tiles);
+    for (size_t b = 0; b < batches.size(); ++b) {
+      const auto& batch = batches[b];
+      const auto copy_tiles = batch_tiles.empty() ? nullptr : &batch_tiles[b];
+
+      // Read the tiles for the names in `inner_names`. Each attribute
+      // name will be read concurrently.
+      RETURN_CANCEL_OR_ERROR(read_attribute_tiles(inner_names, batch));
+
+      // Copy the cells into the associated `buffers_`, and then clear the
+      // cells from the tiles. The cell copies are not thread safe. Clearing
+      // tiles are thread safe, but quick enough that they do not justify
+      // scheduling on separate threads.
+      for (const auto& inner_name : inner_names) {
+        RETURN_CANCEL_OR_ERROR(unfilter_tiles(inner_name, batch, &cs_ranges));
+        if (!array_schema_->var_size(inner_name)) {
+          RETURN_CANCEL_OR_ERROR(copy_fixed_cells(
+              inner_name,
+              stride,
+              result_cell_slabs,
+              copy_tiles,
+              &fixed_ctx_cache));
+        } else {
+          auto var_sizes =
+              copy_tiles == nullptr ? nullptr : &cell_var_sizes[inner_name];
+          RETURN_CANCEL_OR_ERROR(copy_var_cells(
+              inner_name,
+              stride,
+              result_cell_slabs,
+              copy_tiles,
+              var_sizes,
+              &var_ctx_cache));
+        }
+        clear_tiles(inner_name, batch);
+      }
+
+      if (read_state_.overflowed_)
+        return Status::Ok();
     }
 
     names_idx += inner_names.size();
@@ -2676,7 +4236,7 @@ void Reader::zero_out_buffer_sizes() {
 
 bool Reader::sparse_tile_overwritten(
     unsigned frag_idx, uint64_t tile_idx) const {
-  const auto& mbr = fragment_metadata_[frag_idx]->mbr(tile_idx);
+  auto mbr = fragment_metadata_[frag_idx]->mbr(tile_idx);
   assert(!mbr.empty());
   auto fragment_num = (unsigned)fragment_metadata_.size();
   auto domain = array_schema_->domain();
@@ -2690,6 +4250,31 @@ bool Reader::sparse_tile_overwritten(
   return false;
 }
 
+bool Reader::sparse_tile_sorted(
+    unsigned frag_idx, uint64_t tile_idx, unsigned* dim_idx) const {
+  // Applicable only to the sparse tiles of sparse arrays, in row- or
+  // col-major cell order
+  auto cell_order = array_schema_->cell_order();
+  if (array_schema_->dense() ||
+      (cell_order != Layout::ROW_MAJOR && cell_order != Layout::COL_MAJOR))
+    return false;
+
+  // The cells are sorted in the global order, i.e., on the space tiles
+  // first and the cell order within each space tile. The coordinates of
+  // the leading dimension of the cell order are therefore non-decreasing
+  // if the tile MBR lies in a single space tile on every other dimension.
+  auto dim_num = array_schema_->dim_num();
+  auto leading_dim = (cell_order == Layout::ROW_MAJOR) ? 0 : dim_num - 1;
+  auto mbr = fragment_metadata_[frag_idx]->mbr(tile_idx);
+  for (unsigned d = 0; d < dim_num; ++d) {
+    if (d != leading_dim && array_schema_->dimension(d)->tile_num(mbr[d]) != 1)
+      return false;
+  }
+
+  *dim_idx = leading_dim;
+  return true;
+}
+
 void Reader::erase_coord_tiles(std::vector<ResultTile>* result_tiles) const {
   for (auto& tile : *result_tiles) {
     auto dim_num = array_schema_->dim_num();
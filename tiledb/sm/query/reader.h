@@ -38,12 +38,15 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <unordered_set>
 #include <vector>
 
 #include "tiledb/common/status.h"
 #include "tiledb/sm/array_schema/tile_domain.h"
 #include "tiledb/sm/misc/types.h"
 #include "tiledb/sm/misc/uri.h"
+#include "tiledb/sm/query/query_aggregate.h"
+#include "tiledb/sm/query/query_condition.h"
 #include "tiledb/sm/query/result_cell_slab.h"
 #include "tiledb/sm/query/result_coords.h"
 #include "tiledb/sm/query/result_space_tile.h"
@@ -84,14 +87,29 @@ class Reader {
     bool unsplittable_ = false;
     /** True if the reader has been initialized. */
     bool initialized_ = false;
+    /**
+     * The window of result tiles a streamed unordered read of the current
+     * partition resumes from, after the results of the preceding windows
+     * were returned (see `Reader::sparse_read_unordered`).
+     */
+    uint64_t unordered_window_ = 0;
+    /** The number of result cells of that window already returned. */
+    uint64_t unordered_window_cell_ = 0;
+
+    /** ``true`` if the current partition was returned only partially. */
+    bool resumes_partition() const {
+      return unordered_window_ != 0 || unordered_window_cell_ != 0;
+    }
 
     /** ``true`` if there are no more partitions. */
     bool done() const {
-      return partitioner_.done();
+      return partitioner_.done() && !resumes_partition();
     }
 
     /** Retrieves the next partition from the partitioner. */
     Status next() {
+      unordered_window_ = 0;
+      unordered_window_cell_ = 0;
       return partitioner_.next(&unsplittable_);
     }
 
@@ -102,6 +120,8 @@ class Reader {
      * the results, but that was not eventually true.
      */
     Status split_current() {
+      unordered_window_ = 0;
+      unordered_window_cell_ = 0;
       return partitioner_.split_current(&unsplittable_);
     }
   };
@@ -128,9 +148,33 @@ class Reader {
   /** Returns the array. */
   const Array* array() const;
 
+  /**
+   * Adds an aggregate to be computed over the cells of the subarray. A read
+   * with aggregates reduces the cells inside the read path and does not
+   * return any cells, so it must not have any buffers set. Applicable only
+   * to sparse arrays.
+   *
+   * @param name The attribute name.
+   * @param op The aggregate operation.
+   * @return Status
+   */
+  Status add_aggregate(const std::string& name, AggregateOp op);
+
   /** Adds a range to the subarray on the input dimension. */
   Status add_range(unsigned dim_idx, const Range& range);
 
+  /**
+   * Retrieves the value of an aggregate added with `add_aggregate`, after
+   * the read has completed. See `QueryAggregate` for the value types.
+   *
+   * @param name The attribute name.
+   * @param op The aggregate operation.
+   * @param value The aggregate value to be retrieved.
+   * @return Status
+   */
+  Status get_aggregate(
+      const std::string& name, AggregateOp op, void* value) const;
+
   /** Retrieves the number of ranges of the subarray for the given dimension. */
   Status get_range_num(unsigned dim_idx, uint64_t* range_num) const;
 
@@ -330,6 +374,12 @@ class Reader {
       uint64_t* buffer_val_size,
       bool check_null_buffers = true);
 
+  /**
+   * Sets the query condition. Only the cells whose attribute values satisfy
+   * the condition will be returned. Applicable only to sparse reads.
+   */
+  Status set_condition(const QueryCondition& condition);
+
   /** Sets the fragment metadata. */
   void set_fragment_metadata(
       const std::vector<FragmentMetadata*>& fragment_metadata);
@@ -341,6 +391,29 @@ class Reader {
    */
   Status set_layout(Layout layout);
 
+  /**
+   * Turns the read into a batch of point lookups. Each point selects the
+   * cell with its coordinates, and the attribute values of the selected
+   * cells are returned in the input order of the points. The points that
+   * have no cell get the fill values of the attributes. A point-lookup read
+   * does not take a subarray, query condition, aggregates or coordinate
+   * buffers, and completes in a single submission unless the buffers are
+   * too small for all the points, in which case the read is incomplete and
+   * returns no results. Applicable only to sparse arrays with fixed-sized
+   * dimensions.
+   *
+   * @param coords The point coordinates, one buffer per dimension in the
+   *     order of the array schema, each storing `point_num` coordinates.
+   * @param point_num The number of points.
+   * @param found Set to `1` for every point that has a cell, and to `0`
+   *     otherwise. It must be able to hold `point_num` values.
+   * @return Status
+   */
+  Status set_point_lookups(
+      const std::vector<const void*>& coords,
+      uint64_t point_num,
+      uint8_t* found);
+
   /**
    * This is applicable only to dense arrays (errors out for sparse arrays),
    * and only in the case where the array is opened in a way that all its
@@ -808,6 +881,24 @@ class Reader {
   /** The layout of the cells in the result of the subarray. */
   Layout layout_;
 
+  /** The query condition on the attribute values. */
+  QueryCondition condition_;
+
+  /** The aggregates computed over the cells of the subarray. */
+  std::vector<QueryAggregate> aggregates_;
+
+  /**
+   * The point coordinates of a point-lookup read, one buffer per dimension.
+   * It is empty if the read is not a point lookup.
+   */
+  std::vector<ByteVec> point_coords_;
+
+  /** The number of points of a point-lookup read. */
+  uint64_t point_num_;
+
+  /** The output flags of a point-lookup read, one per point. */
+  uint8_t* point_found_;
+
   /** Read state. */
   ReadState read_state_;
 
@@ -840,6 +931,48 @@ class Reader {
   /*           PRIVATE METHODS         */
   /* ********************************* */
 
+  /**
+   * Computes the aggregates over all the partitions of the subarray in a
+   * single submission.
+   */
+  Status aggregate_read();
+
+  /**
+   * Performs a batch of point lookups. The points are sorted once on the
+   * global order and deduplicated, the R-tree of each relevant fragment is
+   * probed for all of them in a single traversal, and every tile that may
+   * contain some point is read once.
+   */
+  Status point_lookup_read();
+
+  /**
+   * Computes the result tiles that may contain some of the input points,
+   * sorted on the fragment and tile index.
+   *
+   * @param points The positions of the distinct points in `point_coords_`.
+   * @param result_tiles The result tiles to be computed.
+   * @return Status
+   */
+  Status compute_point_tiles(
+      const std::vector<uint64_t>& points,
+      std::vector<ResultTile>* result_tiles) const;
+
+  /**
+   * Reads the coordinate tiles of the input result tiles and finds the cell
+   * of each input point. When several fragments have a cell for a point,
+   * the cell of the most recent fragment is kept.
+   *
+   * @param points The positions of the distinct points in `point_coords_`.
+   * @param result_tiles The result tiles computed by `compute_point_tiles`.
+   * @param point_cells The cell of each point in `points`, or an invalid
+   *     instance if the point has no cell.
+   * @return Status
+   */
+  Status compute_point_cells(
+      const std::vector<uint64_t>& points,
+      const std::vector<ResultTile*>& result_tiles,
+      std::vector<ResultCoords>* point_cells);
+
   /** Correctness checks for `subarray_`. */
   Status check_subarray() const;
 
@@ -873,6 +1006,8 @@ class Reader {
    * @param frag_idx The id of the fragment that the result tile belongs to.
    * @param tile The result tile.
    * @param range_idx The range id.
+   * @param apply_condition If `true`, the query condition is folded into
+   *     the result bitmap of the tile.
    * @param result_coords The overlapping coordinates to retrieve.
    * @return Status
    */
@@ -881,6 +1016,7 @@ class Reader {
       unsigned frag_idx,
       ResultTile* tile,
       uint64_t range_idx,
+      bool apply_condition,
       std::vector<ResultCoords>* result_coords);
 
   /**
@@ -906,15 +1042,23 @@ class Reader {
 
   /**
    * Computes the result coordinates of a given range of the query
-   * subarray.
+   * subarray. The coordinates of the fragments are merged in the global
+   * order if they must be deduplicated or the query layout is the global
+   * order, otherwise they are concatenated.
    *
    * @param subarray The subarray to operate on.
    * @param range_idx The range to focus on.
    * @param result_tile_map This is an auxialiary map that helps finding the
    *     result_tiles overlapping with each range.
    * @param result_tiles The result tiles to read the coordinates from.
+   * @param dedup If `true`, the coordinates are deduplicated across the
+   *     fragments. Otherwise, the query condition is folded into the result
+   *     bitmaps of the tiles.
+   * @param full_tile_slabs If not `nullptr`, the tiles fully covered by
+   *     the range are added here as whole-tile result cell slabs instead of
+   *     to `range_result_coords` when no query condition applies (see
+   *     `get_all_result_coords`). Applicable only without `dedup`.
    * @param range_result_coords The result coordinates to be retrieved.
-   *     It contains a vector for each range of the subarray.
    * @return Status
    */
   Status compute_range_result_coords(
@@ -922,6 +1066,8 @@ class Reader {
       uint64_t range_idx,
       const std::map<std::pair<unsigned, uint64_t>, size_t>& result_tile_map,
       std::vector<ResultTile>* result_tiles,
+      bool dedup,
+      std::vector<ResultCellSlab>* full_tile_slabs,
       std::vector<ResultCoords>* range_result_coords);
 
   /**
@@ -934,6 +1080,11 @@ class Reader {
    * @param result_tile_map This is an auxialiary map that helps finding the
    *     result_tiles overlapping with each range.
    * @param result_tiles The result tiles to read the coordinates from.
+   * @param apply_condition If `true`, the query condition is folded into
+   *     the result bitmaps of the tiles.
+   * @param full_tile_slabs If not `nullptr`, the tiles fully covered by
+   *     the range are added here as whole-tile result cell slabs when no
+   *     query condition applies (see `get_all_result_coords`).
    * @param range_result_coords The result coordinates to be retrieved.
    *     It contains a vector for each range of the subarray.
    * @return Status
@@ -944,31 +1095,45 @@ class Reader {
       uint32_t fragment_idx,
       const std::map<std::pair<unsigned, uint64_t>, size_t>& result_tile_map,
       std::vector<ResultTile>* result_tiles,
+      bool apply_condition,
+      std::vector<ResultCellSlab>* full_tile_slabs,
       std::vector<ResultCoords>* range_result_coords);
 
   /**
-   * Computes the final subarray result coordinates, which will be
-   * deduplicated and sorted on the specified subarray layout.
+   * Computes the final subarray result coordinates, sorted on the specified
+   * subarray layout, and appends them to `result_coords`. Unless the layout
+   * is unordered, the coordinates of each range must be sorted in the
+   * layout, and they are merged.
    *
    * @param range_result_coords The result coordinates for each subarray range.
    * @param result_coords The final (subarray) result coordinates to be
    *     retrieved.
    * @return Status
-   *
-   * @note the function will try to gradually clean up ``range_result_coords``
-   *     as it is done processing its elements to quickly reclaim memory.
    */
   Status compute_subarray_coords(
       std::vector<std::vector<ResultCoords>>* range_result_coords,
       std::vector<ResultCoords>* result_coords);
 
+  /**
+   * Applicable only to dense arrays. Sets the overwrite domains of the
+   * input result tiles (see `ResultTile::overwrite_domains`), i.e., the
+   * non-empty domains of the dense fragments more recent than the tile's
+   * fragment that intersect the tile MBR. The domains covered by that of
+   * a more recent dense fragment are omitted.
+   *
+   * @param result_tiles The result tiles of the sparse fragments.
+   */
+  void compute_overwrite_domains(std::vector<ResultTile>* result_tiles) const;
+
   /**
    * Computes info about the sparse result tiles, such as which fragment they
    * belong to, the tile index and the type of overlap. The tile vector
    * contains unique info about the tiles. The function also computes
    * a map from fragment index and tile id to a result tile to keep
    * track of the unique result  tile info for subarray ranges that overlap
-   * with common tiles.
+   * with common tiles. For reads with aggregates, the tiles whose cells are
+   * all results are aggregated from the tile statistics when possible, and
+   * are not included in the result tiles.
    *
    * @param result_tiles The result tiles to be computed.
    * @param result_tile_map The result tile map to be computed.
@@ -982,6 +1147,26 @@ class Reader {
       std::map<std::pair<unsigned, uint64_t>, size_t>* result_tile_map,
       std::vector<bool>* single_fragment);
 
+  /**
+   * Splits the input result tiles into batches, such that the tiles of
+   * each batch for the input attributes/dimensions fit `sm.memory_budget`
+   * and `sm.memory_budget_var`. The unfiltered and the filtered size of
+   * each tile are counted. A tile that exceeds the budget by itself forms
+   * a batch on its own. There is always at least one (possibly empty)
+   * batch. The tile offsets of `names` must be loaded.
+   *
+   * @param names The attribute/dimension names.
+   * @param result_tiles The result tiles to split.
+   * @param max_tiles The maximum number of tiles in a batch.
+   * @param batches The batches of result tiles, in the input order.
+   * @return Status
+   */
+  Status compute_tile_batches(
+      const std::vector<std::string>& names,
+      const std::vector<ResultTile*>& result_tiles,
+      uint64_t max_tiles,
+      std::vector<std::vector<ResultTile*>>* batches) const;
+
   /**
    * Copies the cells for the input **fixed-sized** attribute/dimension and
    * result cell slabs into the corresponding result buffers.
@@ -991,6 +1176,8 @@ class Reader {
    *     cell slabs are all contiguous. Otherwise, each cell in the
    *     result cell slabs are `stride` cells apart from each other.
    * @param result_cell_slabs The result cell slabs to copy cells for.
+   * @param batch_tiles If not `nullptr`, only the cell slabs of these
+   *     tiles are copied, at their final positions in the buffers.
    * @param ctx_cache An opaque context cache that may be shared between
    *     calls to improve performance.
    * @return Status
@@ -999,6 +1186,7 @@ class Reader {
       const std::string& name,
       uint64_t stride,
       const std::vector<ResultCellSlab>& result_cell_slabs,
+      const std::unordered_set<const ResultTile*>* batch_tiles,
       CopyFixedCellsContextCache* ctx_cache);
 
   /**
@@ -1022,6 +1210,8 @@ class Reader {
    *     cell slabs are all contiguous. Otherwise, each cell in the
    *     result cell slabs are `stride` cells apart from each other.
    * @param result_cell_slabs The result cell slabs to copy cells for.
+   * @param batch_tiles If not `nullptr`, only the cell slabs of these
+   *     tiles are copied.
    * @param cs_offsets The cell slab offsets.
    * @param cs_partitions The cell slab partitions to operate on.
    * @return Status
@@ -1031,6 +1221,7 @@ class Reader {
       const std::string* name,
       uint64_t stride,
       const std::vector<ResultCellSlab>* result_cell_slabs,
+      const std::unordered_set<const ResultTile*>* batch_tiles,
       const std::vector<uint64_t>& cs_offsets,
       const std::vector<size_t>& cs_partitions);
 
@@ -1043,6 +1234,12 @@ class Reader {
    *     cell slabs are all contiguous. Otherwise, each cell in the
    *     result cell slabs are `stride` cells apart from each other.
    * @param result_cell_slabs The result cell slabs to copy cells for.
+   * @param batch_tiles If not `nullptr`, only the cell slabs of these
+   *     tiles are copied, at their final positions in the buffers.
+   * @param cell_var_sizes If not `nullptr`, the sizes of all the result
+   *     cells, as computed by `compute_cell_var_sizes`. It must be given
+   *     with `batch_tiles`, as the destinations of the cells depend on
+   *     the cells outside the batch.
    * @param ctx_cache An opaque context cache that may be shared between
    *     calls to improve performance.
    * @return Status
@@ -1051,6 +1248,8 @@ class Reader {
       const std::string& name,
       uint64_t stride,
       const std::vector<ResultCellSlab>& result_cell_slabs,
+      const std::unordered_set<const ResultTile*>* batch_tiles,
+      const std::vector<uint64_t>* cell_var_sizes,
       CopyVarCellsContextCache* ctx_cache);
 
   /**
@@ -1063,6 +1262,29 @@ class Reader {
       const std::vector<ResultCellSlab>& result_cell_slabs,
       CopyVarCellsContextCache* ctx_cache);
 
+  /**
+   * Computes the sizes of the variable-length data of the given
+   * attribute/dimension, for the cells of the given list of result cell
+   * slabs.
+   *
+   * @param name The variable-length attribute/dimension.
+   * @param stride If it is `UINT64_MAX`, then the cells in the result
+   *     cell slabs are all contiguous. Otherwise, each cell in the
+   *     result cell slabs are `stride` cells apart from each other.
+   * @param result_cell_slabs The result cell slabs to compute sizes for.
+   * @param batch_tiles If not `nullptr`, only the sizes of the cells of
+   *     these tiles are computed, the others are left unchanged.
+   * @param cell_var_sizes One element per cell of the result cell slabs.
+   *     It is resized to the number of cells if empty.
+   * @return Status
+   */
+  Status compute_cell_var_sizes(
+      const std::string& name,
+      uint64_t stride,
+      const std::vector<ResultCellSlab>& result_cell_slabs,
+      const std::unordered_set<const ResultTile*>* batch_tiles,
+      std::vector<uint64_t>* cell_var_sizes) const;
+
   /**
    * Computes offsets into destination buffers for the given
    * attribute/dimensions's offset and variable-length data, for the given list
@@ -1073,6 +1295,8 @@ class Reader {
    *     cell slabs are all contiguous. Otherwise, each cell in the
    *     result cell slabs are `stride` cells apart from each other.
    * @param result_cell_slabs The result cell slabs to compute destinations for.
+   * @param cell_var_sizes The sizes of the cells. If `nullptr`, they are
+   *     computed from the tiles of the result cell slabs.
    * @param offset_offsets_per_cs Output to hold one vector per result cell
    *    slab, and one element per cell in the slab. The elements are the
    *    destination offsets for the attribute's offsets.
@@ -1089,6 +1313,7 @@ class Reader {
       const std::string& name,
       uint64_t stride,
       const std::vector<ResultCellSlab>& result_cell_slabs,
+      const std::vector<uint64_t>* cell_var_sizes,
       std::vector<uint64_t>* offset_offsets_per_cs,
       std::vector<uint64_t>* var_offsets_per_cs,
       uint64_t* total_offset_size,
@@ -1105,6 +1330,8 @@ class Reader {
    *     cell slabs are all contiguous. Otherwise, each cell in the
    *     result cell slabs are `stride` cells apart from each other.
    * @param result_cell_slabs The result cell slabs to copy cells for.
+   * @param batch_tiles If not `nullptr`, only the cell slabs of these
+   *     tiles are copied.
    * @param offset_offsets_per_cs Maps each cell slab to its offset
    *     for its attribute offsets.
    * @param var_offsets_per_cs Maps each cell slab to its offset
@@ -1117,6 +1344,7 @@ class Reader {
       const std::string* name,
       uint64_t stride,
       const std::vector<ResultCellSlab>* result_cell_slabs,
+      const std::unordered_set<const ResultTile*>* batch_tiles,
       const std::vector<uint64_t>* offset_offsets_per_cs,
       const std::vector<uint64_t>* var_offsets_per_cs,
       const std::vector<std::pair<size_t, size_t>>* cs_partitions);
@@ -1144,13 +1372,33 @@ class Reader {
       std::vector<ResultCoords>* result_coords);
 
   /**
-   * Deduplicates the input result coordinates, breaking ties giving preference
-   * to the largest fragment index (i.e., it prefers more recent fragments).
+   * Merges runs of result coordinates that are each sorted in `layout`
+   * and appends them to `result_coords`, in O(n log k) time for `n`
+   * coordinates in `k` runs. Invalid coordinates are skipped. Optionally,
+   * it deduplicates the coordinates, breaking ties giving preference to
+   * the largest fragment index (i.e., it prefers more recent fragments).
    *
-   * @param result_coords The result coordinates to dedup.
+   * @param runs The sorted runs of result coordinates.
+   * @param layout The layout the runs are sorted in.
+   * @param dedup Whether to deduplicate the coordinates.
+   * @param result_coords The merged result coordinates are appended here.
    * @return Status
    */
-  Status dedup_result_coords(std::vector<ResultCoords>* result_coords) const;
+  Status merge_result_coords(
+      const std::vector<std::vector<ResultCoords>>& runs,
+      Layout layout,
+      bool dedup,
+      std::vector<ResultCoords>* result_coords) const;
+
+  /**
+   * Removes the input result coordinates whose cells do not satisfy the
+   * query condition, as well as the invalid ones, preserving the order of
+   * the rest.
+   *
+   * @param result_coords The result coordinates to filter.
+   * @return Status
+   */
+  Status apply_query_condition(std::vector<ResultCoords>* result_coords) const;
 
   /** Performs a read on a dense array. */
   Status dense_read();
@@ -1301,6 +1549,19 @@ class Reader {
           std::vector<std::pair<uint64_t, uint64_t>>>* const cs_ranges =
           nullptr) const;
 
+  /**
+   * Unfilters the offset tiles of a var-sized attribute read with
+   * `read_attribute_offset_tiles`.
+   *
+   * @param name The var-sized attribute whose offset tiles will be
+   *     unfiltered.
+   * @param result_tiles Vector containing the tiles to be unfiltered.
+   * @return Status
+   */
+  Status unfilter_offset_tiles(
+      const std::string& name,
+      const std::vector<ResultTile*>& result_tiles) const;
+
   /**
    * Runs the input fixed-sized tile for the input attribute or dimension
    * through the filter pipeline. The tile buffer is modified to contain the
@@ -1339,13 +1600,23 @@ class Reader {
 
   /**
    * Gets all the result coordinates of the input tile into `result_coords`.
+   * The number of cells comes from the fragment metadata, so the tile does
+   * not need its coordinate tiles.
    *
    * @param result_tile The result tile to read the coordinates from.
+   * @param apply_condition If `true`, only the coordinates of the cells
+   *     that satisfy the query condition are retrieved.
+   * @param result_cell_slabs If not `nullptr` and no query condition
+   *     applies, the whole tile is added here as a single result cell slab
+   *     instead of adding its coordinates to `result_coords`.
    * @param result_coords The result coordinates to copy into.
    * @return Status
    */
   Status get_all_result_coords(
-      ResultTile* tile, std::vector<ResultCoords>* result_coords) const;
+      ResultTile* tile,
+      bool apply_condition,
+      std::vector<ResultCellSlab>* result_cell_slabs,
+      std::vector<ResultCoords>* result_coords) const;
 
   /** Returns `true` if the coordinates are included in the attributes. */
   bool has_coords() const;
@@ -1394,6 +1665,70 @@ class Reader {
    */
   Status load_tile_offsets(const std::vector<std::string>& names);
 
+  /**
+   * Concurrently loads the tile statistics (minimum/maximum values and sums)
+   * of the input attributes for all fragments. It is a noop for fragments that
+   * do not store them.
+   *
+   * @param names The attribute names.
+   * @return Status
+   */
+  Status load_tile_stats(const std::vector<std::string>& names);
+
+  /**
+   * Reads and unfilters the coordinate tiles of the input result tiles,
+   * along with the tiles of the attributes in the query condition. Only
+   * the tiles that may have cells in some range of the current partition
+   * are read (see `compute_coords_tiles` and `compute_tiles_in_ranges`).
+   *
+   * @param result_tiles The result tiles to read the tiles of.
+   * @param full_tile_coords If `false`, the coordinate tiles of the tiles
+   *     fully covered by the ranges are not read, as all their cells are
+   *     results.
+   * @return Status
+   */
+  Status read_and_unfilter_coords(
+      const std::vector<ResultTile*>& result_tiles, bool full_tile_coords);
+
+  /**
+   * Computes the input result tiles whose coordinate tiles must be read,
+   * based on their overlap with the ranges of the current partition. The
+   * tiles partially overlapping some range whose cells are sorted on the
+   * leading dimension of the cell order (see `sparse_tile_sorted`) are
+   * searched on that dimension first. The tiles only fully covered by the
+   * ranges need no coordinates, unless `full_tile_coords` is `true`.
+   *
+   * @param result_tiles The result tiles.
+   * @param full_tile_coords Whether the fully covered tiles need their
+   *     coordinates.
+   * @param searched_tiles The tiles to search on the leading dimension.
+   * @param coords_tiles The tiles that need all their coordinate tiles.
+   * @return Status
+   */
+  Status compute_coords_tiles(
+      const std::vector<ResultTile*>& result_tiles,
+      bool full_tile_coords,
+      std::vector<ResultTile*>* searched_tiles,
+      std::vector<ResultTile*>* coords_tiles);
+
+  /**
+   * Computes the input searched tiles that have cells in some range of
+   * the current partition, i.e., the tiles fully covered by a range, or
+   * whose binary search of a partially overlapping range on the leading
+   * dimension finds some cells. The coordinate tiles of the leading
+   * dimension must be unfiltered.
+   *
+   * @param leading_dim The leading dimension of the cell order.
+   * @param searched_tiles The tiles sorted on the leading dimension.
+   * @param tiles_in_ranges The tiles with cells in some range, in the
+   *     order of `searched_tiles`.
+   * @return Status
+   */
+  Status compute_tiles_in_ranges(
+      unsigned leading_dim,
+      const std::vector<ResultTile*>& searched_tiles,
+      std::vector<ResultTile*>* tiles_in_ranges);
+
   /**
    * Concurrently executes `read_tiles` for each name in `names`. This
    * must be the entry point for reading attribute tiles because it
@@ -1408,6 +1743,19 @@ class Reader {
       const std::vector<std::string>& names,
       const std::vector<ResultTile*>& result_tiles) const;
 
+  /**
+   * Same as `read_attribute_tiles`, but reads only the offset tiles of
+   * the input var-sized attributes.
+   *
+   * @param names The var-sized attribute names.
+   * @param result_tiles The retrieved tiles will be stored inside the
+   *     `ResultTile` instances in this vector.
+   * @return Status
+   */
+  Status read_attribute_offset_tiles(
+      const std::vector<std::string>& names,
+      const std::vector<ResultTile*>& result_tiles) const;
+
   /**
    * Concurrently executes `read_tiles` for each name in `names`. This
    * must be the entry point for reading coordinate tiles because it
@@ -1428,11 +1776,14 @@ class Reader {
    * @param names The attribute/dimension names.
    * @param result_tiles The retrieved tiles will be stored inside the
    *     `ResultTile` instances in this vector.
+   * @param offsets_only If `true`, only the offset tiles of var-sized
+   *     attributes/dimensions are read.
    * @return Status
    */
   Status read_tiles(
       const std::vector<std::string>& names,
-      const std::vector<ResultTile*>& result_tiles) const;
+      const std::vector<ResultTile*>& result_tiles,
+      bool offsets_only = false) const;
 
   /**
    * Retrieves the tiles on a particular attribute or dimension and stores it
@@ -1441,11 +1792,14 @@ class Reader {
    * @param name The attribute/dimension name.
    * @param result_tiles The retrieved tiles will be stored inside the
    *     `ResultTile` instances in this vector.
+   * @param offsets_only If `true`, only the offset tiles of var-sized
+   *     attributes/dimensions are read.
    * @return Status
    */
   Status read_tiles(
       const std::string& name,
-      const std::vector<ResultTile*>& result_tiles) const;
+      const std::vector<ResultTile*>& result_tiles,
+      bool offsets_only = false) const;
 
   /**
    * Retrieves the tiles on a particular attribute or dimension and stores it
@@ -1458,12 +1812,15 @@ class Reader {
    * @param result_tiles The retrieved tiles will be stored inside the
    *     `ResultTile` instances in this vector.
    * @param tasks Vector to hold futures for the read tasks.
+   * @param offsets_only If `true`, only the offset tiles of var-sized
+   *     attributes/dimensions are read.
    * @return Status
    */
   Status read_tiles(
       const std::string& name,
       const std::vector<ResultTile*>& result_tiles,
-      std::vector<ThreadPool::Task>* tasks) const;
+      std::vector<ThreadPool::Task>* tasks,
+      bool offsets_only = false) const;
 
   /**
    * Resets the buffer sizes to the original buffer sizes. This is because
@@ -1488,6 +1845,46 @@ class Reader {
   /** Performs a read on a sparse array. */
   Status sparse_read();
 
+  /**
+   * Performs a read on a sparse array in unordered layout without
+   * materializing the result coordinates of the whole partition. The
+   * result tiles are processed in windows of `sm.sparse_unordered_tile_window`
+   * tiles at most, whose coordinate tiles fit the memory budget. The results
+   * of a window are copied to the user buffers before its tiles are
+   * released. This is possible only if no deduplication takes place,
+   * i.e., the array allows duplicates or every range overlaps a single
+   * fragment.
+   *
+   * If the results of a window do not fit the user buffers, those of the
+   * preceding windows are returned and the next read resumes from that
+   * window. The partition is split only if none of its results fit.
+   *
+   * @param streamed Set to `true` if the read was performed, or `false` if
+   *     the results cannot be streamed.
+   * @return Status
+   */
+  Status sparse_read_unordered(bool* streamed);
+
+  /**
+   * Computes the aggregates over the current partition of a sparse array.
+   * The tiles that can be answered from the tile statistics of the fragment
+   * metadata are aggregated in `compute_sparse_result_tiles`, whereas the
+   * remaining result cells are aggregated in `compute_aggregates`.
+   */
+  Status sparse_aggregate();
+
+  /**
+   * Aggregates the input result cell slabs into `aggregates_`, in parallel
+   * over the result tiles.
+   *
+   * @param result_tiles The result tiles the slabs point to.
+   * @param result_cell_slabs The result cell slabs.
+   * @return Status
+   */
+  Status compute_aggregates(
+      const std::vector<ResultTile*>& result_tiles,
+      const std::vector<ResultCellSlab>& result_cell_slabs);
+
   /**
    * Copies the result coordinates to the user buffers.
    * It also appropriately cleans up the used result tiles.
@@ -1498,7 +1895,9 @@ class Reader {
 
   /**
    * Copies the result attribute values to the user buffers.
-   * It also appropriately cleans up the used result tiles.
+   * It also appropriately cleans up the used result tiles. The tiles are
+   * read in batches that fit the memory budget (see
+   * `compute_tile_batches`), each batch released before the next is read.
    */
   Status copy_attribute_values(
       uint64_t stride,
@@ -1514,6 +1913,15 @@ class Reader {
    */
   bool sparse_tile_overwritten(unsigned frag_idx, uint64_t tile_idx) const;
 
+  /**
+   * Returns true if the cells of the input sparse tile of the input
+   * fragment are sorted on the leading dimension of the cell order, i.e.,
+   * its MBR lies in a single space tile on every other dimension. The
+   * index of the leading dimension is then stored in `dim_idx`.
+   */
+  bool sparse_tile_sorted(
+      unsigned frag_idx, uint64_t tile_idx, unsigned* dim_idx) const;
+
   /**
    * Erases the coordinate tiles (zipped or separate) from the input result
    * tiles.
@@ -46,10 +46,16 @@ namespace sm {
 /**
  * Stores information about cell coordinates of a sparse fragment
  * that are in the result of a subarray query.
+ *
+ * Sparse reads may produce a very large number of instances, which are
+ * sorted and merged, so the struct is kept to two words: an invalid
+ * instance is marked by a null tile instead of a separate flag. Invalid
+ * instances must not be compared or dereferenced.
  */
 struct ResultCoords {
   /**
-   * The result tile the coords belong to.
+   * The result tile the coords belong to, or `nullptr` if this instance
+   * has been invalidated.
    *
    * Note that the tile this points to is allocated and freed in
    * sparse_read/dense_read, so the lifetime of this struct must not exceed
@@ -58,24 +64,21 @@ struct ResultCoords {
   ResultTile* tile_;
   /** The position of the coordinates in the tile. */
   uint64_t pos_;
-  /** Whether this instance is "valid". */
-  bool valid_;
 
   /** Constructor. */
   ResultCoords(ResultTile* tile, uint64_t pos)
       : tile_(tile)
-      , pos_(pos)
-      , valid_(true) {
+      , pos_(pos) {
   }
 
   /** Invalidate this instance. */
   void invalidate() {
-    valid_ = false;
+    tile_ = nullptr;
   }
 
   /** Return true if this instance is valid. */
   bool valid() const {
-    return valid_;
+    return tile_ != nullptr;
   }
 
   /**
@@ -107,6 +110,10 @@ struct ResultCoords {
   }
 };
 
+static_assert(
+    sizeof(ResultCoords) == sizeof(ResultTile*) + sizeof(uint64_t),
+    "ResultCoords must not carry padding");
+
 }  // namespace sm
 }  // namespace tiledb
 
@@ -35,6 +35,8 @@
 #include "tiledb/sm/array_schema/domain.h"
 #include "tiledb/sm/enums/datatype.h"
 #include "tiledb/sm/fragment/fragment_metadata.h"
+#include "tiledb/sm/misc/range_filter.h"
+#include "tiledb/sm/misc/utils.h"
 
 #include <cassert>
 #include <iostream>
@@ -72,8 +74,11 @@ bool ResultTile::operator==(const ResultTile& rt) const {
 }
 
 uint64_t ResultTile::cell_num() const {
-  if (!coord_tiles_[0].second.first.empty())
-    return coord_tiles_[0].second.first.cell_num();
+  // Only some of the coordinate tiles may have been read
+  for (const auto& ct : coord_tiles_) {
+    if (!ct.second.first.empty())
+      return ct.second.first.cell_num();
+  }
 
   if (!coords_tile_.first.empty())
     return coords_tile_.first.cell_num();
@@ -171,6 +176,17 @@ const void* ResultTile::zipped_coord(uint64_t pos, unsigned dim_idx) const {
 }
 
 std::string ResultTile::coord_string(uint64_t pos, unsigned dim_idx) const {
+  const char* coord = nullptr;
+  uint64_t coord_size = 0;
+  coord_string(pos, dim_idx, &coord, &coord_size);
+  return std::string(coord, coord_size);
+}
+
+void ResultTile::coord_string(
+    uint64_t pos,
+    unsigned dim_idx,
+    const char** coord,
+    uint64_t* coord_size) const {
   const auto& coord_tile_off = coord_tiles_[dim_idx].second.first;
   const auto& coord_tile_val = coord_tiles_[dim_idx].second.second;
   assert(!coord_tile_off.empty());
@@ -192,14 +208,18 @@ std::string ResultTile::coord_string(uint64_t pos, unsigned dim_idx) const {
     assert(st.ok());
   }
 
-  auto size = next_offset - offset;
+  *coord_size = next_offset - offset;
+  if (*coord_size == 0) {
+    *coord = nullptr;
+    return;
+  }
 
   void* buffer = nullptr;
   st = coord_tile_val.chunked_buffer()->internal_buffer_from_offset(
       offset, &buffer);
   assert(st.ok());
 
-  return std::string(static_cast<char*>(buffer), size);
+  *coord = static_cast<const char*>(buffer);
 }
 
 uint64_t ResultTile::coord_size(unsigned dim_idx) const {
@@ -220,7 +240,13 @@ bool ResultTile::same_coords(
       if (std::memcmp(coord(pos_a, d), rt.coord(pos_b, d), coord_size(d)) != 0)
         return false;
     } else {  // Var-sized
-      if (coord_string(pos_a, d) != rt.coord_string(pos_b, d))
+      const char* coord_a = nullptr;
+      const char* coord_b = nullptr;
+      uint64_t size_a = 0, size_b = 0;
+      coord_string(pos_a, d, &coord_a, &size_a);
+      rt.coord_string(pos_b, d, &coord_b, &size_b);
+      if (size_a != size_b ||
+          (size_a != 0 && std::memcmp(coord_a, coord_b, size_a) != 0))
         return false;
     }
   }
@@ -316,17 +342,74 @@ void ResultTile::compute_results_sparse<char>(
     const ResultTile* result_tile,
     unsigned dim_idx,
     const Range& range,
-    std::vector<uint8_t>* result_bitmap) {
+    uint64_t min_cell,
+    uint64_t max_cell,
+    Bitmap* result_bitmap) {
   auto coords_num = result_tile->cell_num();
-  auto range_start = range.start_str();
-  auto range_end = range.end_str();
-  std::string coord_str;
-  auto& r_bitmap = (*result_bitmap);
-
-  for (uint64_t pos = 0; pos < coords_num; ++pos) {
-    coord_str = result_tile->coord_string(pos, dim_idx);
-    r_bitmap[pos] &= (coord_str >= range_start && coord_str <= range_end);
+
+  // The range bounds are compared in place, without copying them
+  auto start_size = range.start_size();
+  auto end_size = range.end_size();
+  auto start = (start_size == 0) ? nullptr : (const char*)range.start();
+  auto end = (end_size == 0) ? nullptr : (const char*)range.end();
+
+  // Every string in `[start, end]` starts with the common prefix of the
+  // bounds, so a prefix mismatch rejects a cell without further comparisons
+  // and only the suffixes after the prefix need to be compared otherwise
+  auto prefix_size =
+      utils::parse::common_prefix_size(start, start_size, end, end_size);
+  auto start_suffix = start + prefix_size;
+  auto start_suffix_size = start_size - prefix_size;
+  auto end_suffix = end + prefix_size;
+  auto end_suffix_size = end_size - prefix_size;
+
+  // Access the offsets and values directly when they are contiguous
+  const auto& coord_tile_off = result_tile->coord_tile(dim_idx).first;
+  const auto& coord_tile_val = result_tile->coord_tile(dim_idx).second;
+  ChunkedBuffer* const chunked_buffer_off = coord_tile_off.chunked_buffer();
+  ChunkedBuffer* const chunked_buffer_val = coord_tile_val.chunked_buffer();
+  const bool contiguous =
+      chunked_buffer_off->buffer_addressing() ==
+          ChunkedBuffer::BufferAddressing::CONTIGUOUS &&
+      chunked_buffer_val->buffer_addressing() ==
+          ChunkedBuffer::BufferAddressing::CONTIGUOUS;
+  const uint64_t* offsets = nullptr;
+  const char* values = nullptr;
+  uint64_t values_size = coord_tile_val.size();
+  if (contiguous) {
+    offsets = static_cast<const uint64_t*>(
+        chunked_buffer_off->get_contiguous_unsafe());
+    values =
+        static_cast<const char*>(chunked_buffer_val->get_contiguous_unsafe());
   }
+
+  // Only the cells not already excluded by another dimension are checked
+  const char* coord = nullptr;
+  uint64_t coord_size = 0;
+  result_bitmap->for_each(min_cell, max_cell, [&](uint64_t pos) {
+    if (contiguous) {
+      auto next_offset =
+          (pos == coords_num - 1) ? values_size : offsets[pos + 1];
+      coord = values + offsets[pos];
+      coord_size = next_offset - offsets[pos];
+    } else {
+      result_tile->coord_string(pos, dim_idx, &coord, &coord_size);
+    }
+
+    if (coord_size < prefix_size ||
+        (prefix_size != 0 && std::memcmp(coord, start, prefix_size) != 0)) {
+      result_bitmap->clear(pos);
+      return;
+    }
+
+    auto suffix = coord + prefix_size;
+    auto suffix_size = coord_size - prefix_size;
+    if (utils::parse::compare(
+            suffix, suffix_size, start_suffix, start_suffix_size) < 0 ||
+        utils::parse::compare(
+            suffix, suffix_size, end_suffix, end_suffix_size) > 0)
+      result_bitmap->clear(pos);
+  });
 }
 
 template <class T>
@@ -334,115 +417,84 @@ void ResultTile::compute_results_dense(
     const ResultTile* result_tile,
     unsigned dim_idx,
     const Range& range,
-    const std::vector<FragmentMetadata*> fragment_metadata,
-    unsigned frag_idx,
-    std::vector<uint8_t>* result_bitmap,
-    std::vector<uint8_t>* overwritten_bitmap) {
+    Bitmap* result_bitmap,
+    Bitmap* overwritten_bitmap) {
   auto coords_num = result_tile->cell_num();
-  auto frag_num = fragment_metadata.size();
   auto r = (const T*)range.data();
   auto stores_zipped_coords = result_tile->stores_zipped_coords();
   auto dim_num = result_tile->domain()->dim_num();
-  auto& r_bitmap = (*result_bitmap);
-  auto& o_bitmap = (*overwritten_bitmap);
 
-  // Handle separate coordinate tiles
+  // Gather the coordinates of every dimension, as `dim_coords[d][pos *
+  // stride]` for dimension `d` and cell `pos`
+  std::vector<const T*> dim_coords(dim_num);
+  uint64_t stride = 1;
   if (!stores_zipped_coords) {
-    const auto& coord_tile = result_tile->coord_tile(dim_idx).first;
-
-    ChunkedBuffer* const chunked_buffer = coord_tile.chunked_buffer();
+    for (unsigned d = 0; d < dim_num; ++d) {
+      ChunkedBuffer* const chunked_buffer =
+          result_tile->coord_tile(d).first.chunked_buffer();
+      assert(
+          chunked_buffer->buffer_addressing() ==
+          ChunkedBuffer::BufferAddressing::CONTIGUOUS);
+      dim_coords[d] = (const T*)chunked_buffer->get_contiguous_unsafe();
+    }
+  } else {
+    ChunkedBuffer* const chunked_buffer =
+        result_tile->zipped_coords_tile().chunked_buffer();
     assert(
         chunked_buffer->buffer_addressing() ==
         ChunkedBuffer::BufferAddressing::CONTIGUOUS);
     auto coords = (const T*)chunked_buffer->get_contiguous_unsafe();
-    T c;
-
-    if (dim_idx == dim_num - 1) {
-      // Last dimension, need to check for overwrites
-      for (uint64_t pos = 0; pos < coords_num; ++pos) {
-        c = coords[pos];
-        r_bitmap[pos] &= (uint8_t)(c >= r[0] && c <= r[1]);
-
-        // Check if overwritten only if it is a result
-        if (r_bitmap[pos] == 1) {
-          auto overwritten = false;
-          for (auto f = frag_idx + 1; f < frag_num && !overwritten; ++f) {
-            auto meta = fragment_metadata[f];
-            if (meta->dense()) {
-              overwritten = true;
-              for (unsigned d = 0; d < dim_num; ++d) {
-                const auto& coord_tile = result_tile->coord_tile(dim_idx).first;
-                ChunkedBuffer* const chunked_buffer =
-                    coord_tile.chunked_buffer();
-                assert(
-                    chunked_buffer->buffer_addressing() ==
-                    ChunkedBuffer::BufferAddressing::CONTIGUOUS);
-                const T* const coords = static_cast<const T*>(
-                    chunked_buffer->get_contiguous_unsafe());
-                auto c_d = coords[pos];
-                auto dom = (const T*)meta->non_empty_domain()[d].data();
-                if (c_d < dom[0] || c_d > dom[1]) {
-                  overwritten = false;
-                  break;
-                }
-              }
-            }
-          }
-          o_bitmap[pos] = overwritten;
-        }
-      }
-    } else {
-      for (uint64_t pos = 0; pos < coords_num; ++pos) {
-        c = coords[pos];
-        r_bitmap[pos] &= (uint8_t)(c >= r[0] && c <= r[1]);
-      }
+    for (unsigned d = 0; d < dim_num; ++d)
+      dim_coords[d] = coords + d;
+    stride = dim_num;
+  }
+
+  // Check if result
+  auto coords = dim_coords[dim_idx];
+  if (!stores_zipped_coords) {
+    range_filter::in_range(coords, 0, coords_num, r[0], r[1], result_bitmap);
+  } else {
+    for (uint64_t pos = 0; pos < coords_num; ++pos) {
+      auto c = coords[pos * stride];
+      result_bitmap->and_bit(pos, c >= r[0] && c <= r[1]);
     }
+  }
 
+  // Check if overwritten, only for the last dimension and only for the
+  // cells that are results
+  const auto& overwrite_domains = result_tile->overwrite_domains();
+  auto overwrite_num = overwrite_domains.size();
+  if (dim_idx != dim_num - 1 || overwrite_num == 0)
     return;
-  }
 
-  // Handle zipped coordinates tile
-  assert(stores_zipped_coords);
-  const auto& coords_tile = result_tile->zipped_coords_tile();
-  ChunkedBuffer* const chunked_buffer = coords_tile.chunked_buffer();
-  assert(
-      chunked_buffer->buffer_addressing() ==
-      ChunkedBuffer::BufferAddressing::CONTIGUOUS);
-  auto coords = (const T*)chunked_buffer->get_contiguous_unsafe();
-  T c;
+  // Flatten the overwrite domains into `[lo, hi]` pairs per dimension, so
+  // that the cells are checked against a contiguous array
+  std::vector<T> doms;
+  doms.reserve(overwrite_num * dim_num * 2);
+  for (const auto& ndrange : overwrite_domains) {
+    for (unsigned d = 0; d < dim_num; ++d) {
+      auto dom = (const T*)ndrange[d].data();
+      doms.push_back(dom[0]);
+      doms.push_back(dom[1]);
+    }
+  }
 
-  if (dim_idx == dim_num - 1) {
-    for (uint64_t pos = 0; pos < coords_num; ++pos) {
-      // Check if result
-      c = coords[pos * dim_num + dim_idx];
-      r_bitmap[pos] &= (uint8_t)(c >= r[0] && c <= r[1]);
-
-      // Check if overwritten
-      if ((*result_bitmap)[pos] == 1) {
-        auto overwritten = false;
-        for (auto f = frag_idx + 1; f < frag_num && !overwritten; ++f) {
-          auto meta = fragment_metadata[f];
-          if (meta->dense()) {
-            overwritten = true;
-            for (unsigned d = 0; d < dim_num; ++d) {
-              auto c_d = coords[pos * dim_num + d];
-              auto dom = (const T*)meta->non_empty_domain()[d].data();
-              if (c_d < dom[0] || c_d > dom[1]) {
-                overwritten = false;
-                break;
-              }
-            }
-          }
+  result_bitmap->for_each([&](uint64_t pos) {
+    auto overwritten = false;
+    for (uint64_t i = 0; i < overwrite_num && !overwritten; ++i) {
+      auto dom = &doms[i * dim_num * 2];
+      overwritten = true;
+      for (unsigned d = 0; d < dim_num; ++d) {
+        auto c_d = dim_coords[d][pos * stride];
+        if (c_d < dom[2 * d] || c_d > dom[2 * d + 1]) {
+          overwritten = false;
+          break;
         }
-        o_bitmap[pos] = overwritten;
       }
     }
-  } else {
-    for (uint64_t pos = 0; pos < coords_num; ++pos) {
-      c = coords[pos * dim_num + dim_idx];
-      r_bitmap[pos] &= (uint8_t)(c >= r[0] && c <= r[1]);
-    }
-  }
+    if (overwritten)
+      overwritten_bitmap->set(pos);
+  });
 }
 
 template <class T>
@@ -450,12 +502,12 @@ void ResultTile::compute_results_sparse(
     const ResultTile* result_tile,
     unsigned dim_idx,
     const Range& range,
-    std::vector<uint8_t>* result_bitmap) {
-  auto coords_num = result_tile->cell_num();
+    uint64_t min_cell,
+    uint64_t max_cell,
+    Bitmap* result_bitmap) {
   auto r = (const T*)range.data();
   auto stores_zipped_coords = result_tile->stores_zipped_coords();
   auto dim_num = result_tile->domain()->dim_num();
-  auto& r_bitmap = (*result_bitmap);
   T c;
 
   // Handle separate coordinate tiles
@@ -467,10 +519,8 @@ void ResultTile::compute_results_sparse(
         ChunkedBuffer::BufferAddressing::CONTIGUOUS);
     const T* const coords =
         static_cast<const T*>(chunked_buffer->get_contiguous_unsafe());
-    for (uint64_t pos = 0; pos < coords_num; ++pos) {
-      c = coords[pos];
-      r_bitmap[pos] &= (uint8_t)(c >= r[0] && c <= r[1]);
-    }
+    range_filter::in_range(
+        coords, min_cell, max_cell, r[0], r[1], result_bitmap);
     return;
   }
 
@@ -483,37 +533,151 @@ void ResultTile::compute_results_sparse(
       ChunkedBuffer::BufferAddressing::CONTIGUOUS);
   const T* const coords =
       static_cast<const T*>(chunked_buffer->get_contiguous_unsafe());
-  for (uint64_t pos = 0; pos < coords_num; ++pos) {
+  for (uint64_t pos = min_cell; pos < max_cell; ++pos) {
     c = coords[pos * dim_num + dim_idx];
-    r_bitmap[pos] &= (uint8_t)(c >= r[0] && c <= r[1]);
+    result_bitmap->and_bit(pos, c >= r[0] && c <= r[1]);
+  }
+}
+
+template <>
+void ResultTile::compute_results_window<char>(
+    const ResultTile* result_tile,
+    unsigned dim_idx,
+    const Range& range,
+    uint64_t* start,
+    uint64_t* end) {
+  auto start_size = range.start_size();
+  auto end_size = range.end_size();
+  auto range_start = (start_size == 0) ? nullptr : (const char*)range.start();
+  auto range_end = (end_size == 0) ? nullptr : (const char*)range.end();
+  const char* coord = nullptr;
+  uint64_t coord_size = 0;
+
+  // First cell not preceding the range start
+  uint64_t lo = 0, hi = result_tile->cell_num();
+  while (lo < hi) {
+    auto mid = lo + (hi - lo) / 2;
+    result_tile->coord_string(mid, dim_idx, &coord, &coord_size);
+    if (utils::parse::compare(coord, coord_size, range_start, start_size) < 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  *start = lo;
+
+  // First cell following the range end
+  hi = result_tile->cell_num();
+  while (lo < hi) {
+    auto mid = lo + (hi - lo) / 2;
+    result_tile->coord_string(mid, dim_idx, &coord, &coord_size);
+    if (utils::parse::compare(coord, coord_size, range_end, end_size) <= 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  *end = lo;
+}
+
+template <class T>
+void ResultTile::compute_results_window(
+    const ResultTile* result_tile,
+    unsigned dim_idx,
+    const Range& range,
+    uint64_t* start,
+    uint64_t* end) {
+  auto r = (const T*)range.data();
+
+  // The coordinates of the dimension are `stride` values apart
+  const T* coords = nullptr;
+  uint64_t stride = 1;
+  if (!result_tile->stores_zipped_coords()) {
+    const auto& coord_tile = result_tile->coord_tile(dim_idx).first;
+    ChunkedBuffer* const chunked_buffer = coord_tile.chunked_buffer();
+    assert(
+        chunked_buffer->buffer_addressing() ==
+        ChunkedBuffer::BufferAddressing::CONTIGUOUS);
+    coords = static_cast<const T*>(chunked_buffer->get_contiguous_unsafe());
+  } else {
+    const auto& coords_tile = result_tile->zipped_coords_tile();
+    ChunkedBuffer* const chunked_buffer = coords_tile.chunked_buffer();
+    assert(
+        chunked_buffer->buffer_addressing() ==
+        ChunkedBuffer::BufferAddressing::CONTIGUOUS);
+    stride = result_tile->domain()->dim_num();
+    coords =
+        static_cast<const T*>(chunked_buffer->get_contiguous_unsafe()) +
+        dim_idx;
   }
+
+  // First cell not preceding the range start
+  uint64_t lo = 0, hi = result_tile->cell_num();
+  while (lo < hi) {
+    auto mid = lo + (hi - lo) / 2;
+    if (coords[mid * stride] < r[0])
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  *start = lo;
+
+  // First cell following the range end
+  hi = result_tile->cell_num();
+  while (lo < hi) {
+    auto mid = lo + (hi - lo) / 2;
+    if (coords[mid * stride] <= r[1])
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  *end = lo;
 }
 
 Status ResultTile::compute_results_dense(
     unsigned dim_idx,
     const Range& range,
-    const std::vector<FragmentMetadata*> fragment_metadata,
-    unsigned frag_idx,
-    std::vector<uint8_t>* result_bitmap,
-    std::vector<uint8_t>* overwritten_bitmap) const {
+    Bitmap* result_bitmap,
+    Bitmap* overwritten_bitmap) const {
   assert(compute_results_dense_func_[dim_idx] != nullptr);
   compute_results_dense_func_[dim_idx](
-      this,
-      dim_idx,
-      range,
-      fragment_metadata,
-      frag_idx,
-      result_bitmap,
-      overwritten_bitmap);
+      this, dim_idx, range, result_bitmap, overwritten_bitmap);
   return Status::Ok();
 }
 
+const std::vector<NDRange>& ResultTile::overwrite_domains() const {
+  return overwrite_domains_;
+}
+
+void ResultTile::set_overwrite_domains(std::vector<NDRange>&& domains) {
+  overwrite_domains_ = std::move(domains);
+}
+
+Status ResultTile::compute_results_sparse(
+    unsigned dim_idx,
+    const Range& range,
+    Bitmap* result_bitmap) const {
+  return compute_results_sparse(
+      dim_idx, range, 0, cell_num(), result_bitmap);
+}
+
 Status ResultTile::compute_results_sparse(
     unsigned dim_idx,
     const Range& range,
-    std::vector<uint8_t>* result_bitmap) const {
+    uint64_t min_cell,
+    uint64_t max_cell,
+    Bitmap* result_bitmap) const {
   assert(compute_results_sparse_func_[dim_idx] != nullptr);
-  compute_results_sparse_func_[dim_idx](this, dim_idx, range, result_bitmap);
+  compute_results_sparse_func_[dim_idx](
+      this, dim_idx, range, min_cell, max_cell, result_bitmap);
+  return Status::Ok();
+}
+
+Status ResultTile::compute_results_window(
+    unsigned dim_idx,
+    const Range& range,
+    uint64_t* start,
+    uint64_t* end) const {
+  assert(compute_results_window_func_[dim_idx] != nullptr);
+  compute_results_window_func_[dim_idx](this, dim_idx, range, start, end);
   return Status::Ok();
 }
 
@@ -525,48 +689,59 @@ void ResultTile::set_compute_results_func() {
   auto dim_num = domain_->dim_num();
   compute_results_dense_func_.resize(dim_num);
   compute_results_sparse_func_.resize(dim_num);
+  compute_results_window_func_.resize(dim_num);
   for (unsigned d = 0; d < dim_num; ++d) {
     auto dim = domain_->dimension(d);
     switch (dim->type()) {
       case Datatype::INT32:
         compute_results_dense_func_[d] = compute_results_dense<int32_t>;
         compute_results_sparse_func_[d] = compute_results_sparse<int32_t>;
+        compute_results_window_func_[d] = compute_results_window<int32_t>;
         break;
       case Datatype::INT64:
         compute_results_dense_func_[d] = compute_results_dense<int64_t>;
         compute_results_sparse_func_[d] = compute_results_sparse<int64_t>;
+        compute_results_window_func_[d] = compute_results_window<int64_t>;
         break;
       case Datatype::INT8:
         compute_results_dense_func_[d] = compute_results_dense<int8_t>;
         compute_results_sparse_func_[d] = compute_results_sparse<int8_t>;
+        compute_results_window_func_[d] = compute_results_window<int8_t>;
         break;
       case Datatype::UINT8:
         compute_results_dense_func_[d] = compute_results_dense<uint8_t>;
         compute_results_sparse_func_[d] = compute_results_sparse<uint8_t>;
+        compute_results_window_func_[d] = compute_results_window<uint8_t>;
         break;
       case Datatype::INT16:
         compute_results_dense_func_[d] = compute_results_dense<int16_t>;
         compute_results_sparse_func_[d] = compute_results_sparse<int16_t>;
+        compute_results_window_func_[d] = compute_results_window<int16_t>;
         break;
       case Datatype::UINT16:
         compute_results_dense_func_[d] = compute_results_dense<uint16_t>;
         compute_results_sparse_func_[d] = compute_results_sparse<uint16_t>;
+        compute_results_window_func_[d] = compute_results_window<uint16_t>;
         break;
       case Datatype::UINT32:
         compute_results_dense_func_[d] = compute_results_dense<uint32_t>;
         compute_results_sparse_func_[d] = compute_results_sparse<uint32_t>;
+        compute_results_window_func_[d] = compute_results_window<uint32_t>;
         break;
       case Datatype::UINT64:
         compute_results_dense_func_[d] = compute_results_dense<uint64_t>;
         compute_results_sparse_func_[d] = compute_results_sparse<uint64_t>;
+        compute_results_window_func_[d] = compute_results_window<uint64_t>;
         break;
       case Datatype::FLOAT32:
         compute_results_dense_func_[d] = compute_results_dense<float>;
         compute_results_sparse_func_[d] = compute_results_sparse<float>;
+        compute_results_window_func_[d] = compute_results_window<float>;
         break;
       case Datatype::FLOAT64:
         compute_results_dense_func_[d] = compute_results_dense<double>;
         compute_results_sparse_func_[d] = compute_results_sparse<double>;
+        compute_results_window_func_[d] = compute_results_window<double>;
         break;
       case Datatype::DATETIME_YEAR:
       case Datatype::DATETIME_MONTH:
@@ -583,14 +758,17 @@ void ResultTile::set_compute_results_func() {
       case Datatype::DATETIME_AS:
         compute_results_dense_func_[d] = compute_results_dense<int64_t>;
         compute_results_sparse_func_[d] = compute_results_sparse<int64_t>;
+        compute_results_window_func_[d] = compute_results_window<int64_t>;
         break;
       case Datatype::STRING_ASCII:
         compute_results_dense_func_[d] = nullptr;
         compute_results_sparse_func_[d] = compute_results_sparse<char>;
+        compute_results_window_func_[d] = compute_results_window<char>;
         break;
       default:
         compute_results_dense_func_[d] = nullptr;
         compute_results_sparse_func_[d] = nullptr;
+        compute_results_window_func_[d] = nullptr;
         break;
     }
   }
@@ -38,6 +38,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "tiledb/sm/misc/bitmap.h"
 #include "tiledb/sm/misc/constants.h"
 #include "tiledb/sm/misc/types.h"
 #include "tiledb/sm/tile/tile.h"
@@ -147,6 +148,33 @@ class ResultTile {
    */
   std::string coord_string(uint64_t pos, unsigned dim_idx) const;
 
+  /**
+   * Retrieves a pointer to the string coordinate at position `pos` for
+   * dimension `dim_idx` and its size, without copying it. Applicable only
+   * to string dimensions.
+   */
+  void coord_string(
+      uint64_t pos,
+      unsigned dim_idx,
+      const char** coord,
+      uint64_t* coord_size) const;
+
+  /**
+   * Returns the fixed-sized coordinate of type `T` at position `pos` for
+   * dimension `dim_idx`. This is equivalent to dereferencing `coord()`,
+   * but the common unzipped case is inlined instead of going through
+   * `coord_func_`, for use in the typed sort comparators.
+   */
+  template <class T>
+  inline T coord_value(uint64_t pos, unsigned dim_idx) const {
+    if (coord_func_ == &ResultTile::zipped_coord)
+      return *static_cast<const T*>(zipped_coord(pos, dim_idx));
+
+    const auto& coord_tile = coord_tiles_[dim_idx].second.first;
+    return static_cast<const T*>(
+        coord_tile.chunked_buffer()->get_contiguous_unsafe())[pos];
+  }
+
   /** Returns the coordinate size on the input dimension. */
   uint64_t coord_size(unsigned dim_idx) const;
 
@@ -175,33 +203,50 @@ class ResultTile {
    * Accummulates to a result bitmap for the coordinates that
    * fall in the input range, checking only dimensions `dim_idx`.
    * It also accummulates to an `overwritten_bitmap` that
-   * checks if the coordinate is overwritten on that dimension by a
-   * future fragment (one with index greater than `frag_idx`). That
-   * is computed only for `dim_idx == dim_num -1`, as it needs
-   * to know if the the coordinates to be checked are already results.
+   * checks if the coordinate is overwritten by a future dense
+   * fragment, i.e., if it falls in one of the `overwrite_domains()`
+   * of the tile. That is computed only for `dim_idx == dim_num -1`,
+   * as it needs to know if the the coordinates to be checked are
+   * already results.
    */
   template <class T>
   static void compute_results_dense(
       const ResultTile* result_tile,
       unsigned dim_idx,
       const Range& range,
-      const std::vector<FragmentMetadata*> fragment_metadata,
-      unsigned frag_idx,
-      std::vector<uint8_t>* result_bitmap,
-      std::vector<uint8_t>* overwritten_bitmap);
+      Bitmap* result_bitmap,
+      Bitmap* overwritten_bitmap);
 
   /**
    * Applicable only to sparse arrays.
    *
    * Computes a result bitmap for the input dimension for the coordinates that
-   * fall in the input range.
+   * fall in the input range, checking only the cells in
+   * `[min_cell, max_cell)`.
    */
   template <class T>
   static void compute_results_sparse(
       const ResultTile* result_tile,
       unsigned dim_idx,
       const Range& range,
-      std::vector<uint8_t>* result_bitmap);
+      uint64_t min_cell,
+      uint64_t max_cell,
+      Bitmap* result_bitmap);
+
+  /**
+   * Applicable only to tiles whose cells are sorted on dimension `dim_idx`.
+   *
+   * Binary-searches the coordinates of the dimension for the bounds of
+   * the input range, computing the window `[start, end)` of the cells
+   * that fall in it.
+   */
+  template <class T>
+  static void compute_results_window(
+      const ResultTile* result_tile,
+      unsigned dim_idx,
+      const Range& range,
+      uint64_t* start,
+      uint64_t* end);
 
   /**
    * Applicable only to sparse tiles of dense arrays.
@@ -209,18 +254,28 @@ class ResultTile {
    * Accummulates to a result bitmap for the coordinates that
    * fall in the input range, checking only dimensions `dim_idx`.
    * It also accummulates to an `overwritten_bitmap` that
-   * checks if the coordinate is overwritten on that dimension by a
-   * future fragment (one with index greater than `frag_idx`). That
-   * is computed only for `dim_idx == dim_num -1`, as it needs
-   * to know if the the coordinates to be checked are already results.
+   * checks if the coordinate is overwritten by a future dense
+   * fragment, i.e., if it falls in one of the `overwrite_domains()`
+   * of the tile. That is computed only for `dim_idx == dim_num -1`,
+   * as it needs to know if the the coordinates to be checked are
+   * already results.
    */
   Status compute_results_dense(
       unsigned dim_idx,
       const Range& range,
-      const std::vector<FragmentMetadata*> fragment_metadata,
-      unsigned frag_idx,
-      std::vector<uint8_t>* result_bitmap,
-      std::vector<uint8_t>* overwritten_bitmap) const;
+      Bitmap* result_bitmap,
+      Bitmap* overwritten_bitmap) const;
+
+  /**
+   * Applicable only to sparse tiles of dense arrays.
+   *
+   * Returns the non-empty domains of the future dense fragments that
+   * may overwrite some cells of the tile, i.e., that intersect its MBR.
+   */
+  const std::vector<NDRange>& overwrite_domains() const;
+
+  /** Sets the overwrite domains of the tile (see `overwrite_domains`). */
+  void set_overwrite_domains(std::vector<NDRange>&& domains);
 
   /**
    * Applicable only to sparse arrays.
@@ -231,7 +286,35 @@ class ResultTile {
   Status compute_results_sparse(
       unsigned dim_idx,
       const Range& range,
-      std::vector<uint8_t>* result_bitmap) const;
+      Bitmap* result_bitmap) const;
+
+  /**
+   * Applicable only to sparse arrays.
+   *
+   * Accummulates to a result bitmap for the coordinates in
+   * `[min_cell, max_cell)` that fall in the input range, checking only
+   * dimension `dim_idx`. The rest of the bitmap is left untouched.
+   */
+  Status compute_results_sparse(
+      unsigned dim_idx,
+      const Range& range,
+      uint64_t min_cell,
+      uint64_t max_cell,
+      Bitmap* result_bitmap) const;
+
+  /**
+   * Applicable only to sparse tiles whose cells are sorted on dimension
+   * `dim_idx`, i.e., on the leading dimension of the cell order when the
+   * tile lies in a single space tile along the other dimensions.
+   *
+   * Computes the window `[start, end)` of the cells whose coordinates on
+   * the dimension fall in the input range, in logarithmic time.
+   */
+  Status compute_results_window(
+      unsigned dim_idx,
+      const Range& range,
+      uint64_t* start,
+      uint64_t* end) const;
 
  private:
   /* ********************************* */
@@ -259,6 +342,12 @@ class ResultTile {
    */
   std::vector<std::pair<std::string, TilePair>> coord_tiles_;
 
+  /**
+   * The non-empty domains of the future dense fragments intersecting the
+   * tile MBR, against which the cells are checked for overwrites.
+   */
+  std::vector<NDRange> overwrite_domains_;
+
   /**
    * Stores the appropriate templated compute_results_dense() function based for
    * each dimension, based on the dimension datatype.
@@ -267,10 +356,8 @@ class ResultTile {
       const ResultTile*,
       unsigned,
       const Range&,
-      const std::vector<FragmentMetadata*>,
-      unsigned,
-      std::vector<uint8_t>*,
-      std::vector<uint8_t>*)>>
+      Bitmap*,
+      Bitmap*)>>
       compute_results_dense_func_;
 
   /**
@@ -285,9 +372,22 @@ class ResultTile {
    * for each dimension, based on the dimension datatype.
    */
   std::vector<std::function<void(
-      const ResultTile*, unsigned, const Range&, std::vector<uint8_t>*)>>
+      const ResultTile*,
+      unsigned,
+      const Range&,
+      uint64_t,
+      uint64_t,
+      Bitmap*)>>
       compute_results_sparse_func_;
 
+  /**
+   * Stores the appropriate templated compute_results_window() function
+   * for each dimension, based on the dimension datatype.
+   */
+  std::vector<std::function<void(
+      const ResultTile*, unsigned, const Range&, uint64_t*, uint64_t*)>>
+      compute_results_window_func_;
+
   /* ********************************* */
   /*          PRIVATE METHODS          */
   /* ********************************* */
@@ -45,6 +45,7 @@
 #include "tiledb/sm/stats/stats.h"
 #include "tiledb/sm/storage_manager/storage_manager.h"
 #include "tiledb/sm/tile/generic_tile_io.h"
+#include "tiledb/sm/tile/tile_metadata_generator.h"
 
 #include <iostream>
 #include <sstream>
@@ -54,6 +55,111 @@ using namespace tiledb::common;
 namespace tiledb {
 namespace sm {
 
+namespace {
+/**
+ * Sorts cell positions in the global order with the typed comparators that
+ * `dispatch_typed_cmp()` selects for the array domain.
+ */
+class TypedCellPosSort {
+ public:
+  /** Constructor. */
+  TypedCellPosSort(
+      ThreadPool* tp,
+      const Domain* domain,
+      const std::vector<const QueryBuffer*>* buffs,
+      std::vector<uint64_t>* cell_pos)
+      : tp_(tp)
+      , domain_(domain)
+      , buffs_(buffs)
+      , cell_pos_(cell_pos) {
+  }
+
+  /** Sorts with the comparator for `N` dimensions of type `T`. */
+  template <class T0, class T, unsigned N>
+  void run() {
+    parallel_sort(
+        tp_,
+        cell_pos_->begin(),
+        cell_pos_->end(),
+        GlobalCmpTyped<T0, T, N>(domain_, buffs_));
+  }
+
+ private:
+  /** The thread pool to sort on. */
+  ThreadPool* tp_;
+  /** The array domain. */
+  const Domain* domain_;
+  /** The coordinate buffers, one per dimension. */
+  const std::vector<const QueryBuffer*>* buffs_;
+  /** The cell positions to sort. */
+  std::vector<uint64_t>* cell_pos_;
+};
+
+/**
+ * Computes the MBRs of the tiles of a fixed-sized dimension with the
+ * bounds reduction for its coordinate type, which `Dimension::
+ * dispatch_fixed()` selects once for all the tiles.
+ */
+class TypedTileMBRs {
+ public:
+  /** Constructor. */
+  TypedTileMBRs(
+      ThreadPool* tp,
+      const std::vector<Tile>* tiles,
+      unsigned dim_idx,
+      std::vector<NDRange>* mbrs)
+      : tp_(tp)
+      , tiles_(tiles)
+      , dim_idx_(dim_idx)
+      , mbrs_(mbrs) {
+  }
+
+  /** Computes the MBRs for coordinates of type `T`. */
+  template <class T>
+  void run() {
+    auto statuses =
+        parallel_for(tp_, 0, tiles_->size(), [&](uint64_t t) -> Status {
+          const auto& tile = (*tiles_)[t];
+          assert(tile.cell_num() > 0);
+
+          // The chunked buffers in the write path are always contiguous.
+          void* buff = nullptr;
+          RETURN_NOT_OK(tile.chunked_buffer()->get_contiguous(&buff));
+
+          T res[2];
+          utils::geometry::min_max(
+              static_cast<const T*>(buff), tile.cell_num(), &res[0], &res[1]);
+          (*mbrs_)[t][dim_idx_].set_range(res, sizeof(res));
+          return Status::Ok();
+        });
+
+    for (auto& st : statuses) {
+      if (!st.ok()) {
+        st_ = st;
+        return;
+      }
+    }
+  }
+
+  /** Returns the status of the last `run()`. */
+  const Status& status() const {
+    return st_;
+  }
+
+ private:
+  /** The thread pool to compute on. */
+  ThreadPool* tp_;
+  /** The coordinate tiles of the dimension. */
+  const std::vector<Tile>* tiles_;
+  /** The index of the dimension in the MBRs. */
+  unsigned dim_idx_;
+  /** The MBRs to set, one per tile. */
+  std::vector<NDRange>* mbrs_;
+  /** The status of the last `run()`. */
+  Status st_;
+};
+}  // namespace
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
@@ -1091,30 +1197,32 @@ Status Writer::compute_coords_metadata(
                                                        it->second.size();
   auto dim_num = array_schema_->dim_num();
 
-  // Compute MBRs
-  auto statuses = parallel_for(
-      storage_manager_->compute_tp(), 0, tile_num, [&](uint64_t t) {
-        NDRange mbr(dim_num);
-        std::vector<const void*> data(dim_num);
-        for (unsigned d = 0; d < dim_num; ++d) {
-          auto dim = array_schema_->dimension(d);
-          const auto& dim_name = dim->name();
-          auto tiles_it = tiles.find(dim_name);
-          assert(tiles_it != tiles.end());
-          if (!dim->var_size())
-            dim->compute_mbr(tiles_it->second[t], &mbr[d]);
-          else
-            dim->compute_mbr_var(
-                tiles_it->second[2 * t], tiles_it->second[2 * t + 1], &mbr[d]);
-        }
-
-        meta->set_mbr(t, mbr);
-        return Status::Ok();
-      });
+  // Compute the MBRs one dimension at a time, so that the tiles of a
+  // fixed-sized dimension are reduced by a routine specialized on its type
+  std::vector<NDRange> mbrs(tile_num, NDRange(dim_num));
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto dim = array_schema_->dimension(d);
+    auto tiles_it = tiles.find(dim->name());
+    assert(tiles_it != tiles.end());
+    const auto& dim_tiles = tiles_it->second;
+    if (!dim->var_size()) {
+      TypedTileMBRs f(storage_manager_->compute_tp(), &dim_tiles, d, &mbrs);
+      dim->dispatch_fixed(&f);
+      RETURN_NOT_OK(f.status());
+    } else {
+      auto statuses = parallel_for(
+          storage_manager_->compute_tp(), 0, tile_num, [&](uint64_t t) {
+            return dim->compute_mbr_var(
+                dim_tiles[2 * t], dim_tiles[2 * t + 1], &mbrs[t][d]);
+          });
+      for (auto& st : statuses)
+        RETURN_NOT_OK(st);
+    }
+  }
 
-  // Check all statuses
-  for (auto& st : statuses)
-    RETURN_NOT_OK(st);
+  // Set the MBRs, expanding the non-empty domain without lock contention
+  for (uint64_t t = 0; t < tile_num; ++t)
+    RETURN_NOT_OK(meta->set_mbr(t, mbrs[t]));
 
   // Set last tile cell number
   auto dim_0 = array_schema_->dimension(0);
@@ -1128,6 +1236,66 @@ Status Writer::compute_coords_metadata(
   STATS_END_TIMER(stats::Stats::TimerType::WRITE_COMPUTE_COORD_META)
 }
 
+Status Writer::compute_tiles_metadata(
+    const std::unordered_map<std::string, std::vector<Tile>>& tiles,
+    FragmentMetadata* meta) const {
+  // Collect the attribute tiles
+  std::vector<const std::string*> names;
+  for (const auto& it : tiles) {
+    if (array_schema_->is_attr(it.first))
+      names.push_back(&it.first);
+  }
+
+  auto statuses = parallel_for(
+      storage_manager_->compute_tp(), 0, names.size(), [&](uint64_t i) {
+        const auto& name = *names[i];
+        RETURN_CANCEL_OR_ERROR(
+            compute_tiles_metadata(name, tiles.find(name)->second, meta));
+        return Status::Ok();
+      });
+
+  // Check all statuses
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  return Status::Ok();
+}
+
+Status Writer::compute_tiles_metadata(
+    const std::string& name,
+    const std::vector<Tile>& tiles,
+    FragmentMetadata* meta) const {
+  const auto attr = array_schema_->attribute(name);
+  assert(attr != nullptr);
+  const auto type = attr->type();
+  const auto var_size = attr->var_size();
+  const auto cell_val_num = attr->cell_val_num();
+  if (!TileMetadataGenerator::has_min_max_metadata(
+          type, var_size, cell_val_num))
+    return Status::Ok();
+  const bool has_sum =
+      TileMetadataGenerator::has_sum_metadata(type, var_size, cell_val_num);
+
+  // The tiles are processed in order, as required by the var-sized
+  // minimum/maximum values in the fragment metadata
+  TileMetadataGenerator md_generator(type, var_size, cell_val_num);
+  const uint64_t tile_num = var_size ? tiles.size() / 2 : tiles.size();
+  for (uint64_t t = 0; t < tile_num; ++t) {
+    if (var_size)
+      RETURN_NOT_OK(
+          md_generator.process_tile_var(tiles[2 * t], tiles[2 * t + 1]));
+    else
+      RETURN_NOT_OK(md_generator.process_tile(tiles[t]));
+
+    meta->set_tile_min(name, t, md_generator.min());
+    meta->set_tile_max(name, t, md_generator.max());
+    if (has_sum)
+      meta->set_tile_sum(name, t, md_generator.sum());
+  }
+
+  return Status::Ok();
+}
+
 template <class T>
 Status Writer::compute_write_cell_ranges(
     WriteCellSlabIter<T>* iter, WriteCellRangeVec* write_cell_ranges) const {
@@ -1388,6 +1556,10 @@ Status Writer::global_write() {
   RETURN_CANCEL_OR_ERROR_ELSE(
       compute_coords_metadata(tiles, frag_meta), clean_up(uri));
 
+  // Compute tile metadata
+  RETURN_CANCEL_OR_ERROR_ELSE(
+      compute_tiles_metadata(tiles, frag_meta), clean_up(uri));
+
   // Filter all tiles
   RETURN_CANCEL_OR_ERROR_ELSE(filter_tiles(&tiles), clean_up(uri));
 
@@ -1463,6 +1635,9 @@ Status Writer::filter_last_tiles(
   auto meta = global_write_state_->frag_meta_.get();
   RETURN_NOT_OK(compute_coords_metadata(*tiles, meta));
 
+  // Compute tile metadata
+  RETURN_NOT_OK(compute_tiles_metadata(*tiles, meta));
+
   // Gather stats
   STATS_ADD_COUNTER(
       stats::Stats::CounterType::WRITE_CELL_NUM,
@@ -1749,7 +1924,8 @@ Status Writer::ordered_write() {
   // Prepare tiles and filter attribute tiles
   std::unordered_map<std::string, std::vector<Tile>> attr_tiles;
   RETURN_NOT_OK_ELSE(
-      prepare_and_filter_attr_tiles(write_cell_ranges, &attr_tiles),
+      prepare_and_filter_attr_tiles(
+          write_cell_ranges, frag_meta.get(), &attr_tiles),
       clean_up(uri));
 
   // Write tiles for all attributes
@@ -1774,6 +1950,7 @@ Status Writer::ordered_write() {
 
 Status Writer::prepare_and_filter_attr_tiles(
     const std::vector<WriteCellRangeVec>& write_cell_ranges,
+    FragmentMetadata* meta,
     std::unordered_map<std::string, std::vector<Tile>>* attr_tiles) const {
   STATS_START_TIMER(stats::Stats::TimerType::WRITE_PREPARE_AND_FILTER_TILES)
 
@@ -1805,6 +1982,7 @@ Status Writer::prepare_and_filter_attr_tiles(
            tile_num);
             }
         */
+        RETURN_CANCEL_OR_ERROR(compute_tiles_metadata(attr, tiles, meta));
         RETURN_CANCEL_OR_ERROR(filter_tiles(attr, &tiles));
         return Status::Ok();
       });
@@ -2364,23 +2542,66 @@ Status Writer::sort_coords(std::vector<uint64_t>* cell_pos) const {
     buffs[d] = &(buffers_.find(dim_name)->second);
   }
 
+  // Sort on the precomputed Hilbert values, breaking ties in row-major order
+  if (domain->cell_order() == Layout::HILBERT)
+    return sort_coords_hilbert(buffs, cell_pos);
+
   // Populate cell_pos
   cell_pos->resize(coords_num_);
   for (uint64_t i = 0; i < coords_num_; ++i)
     (*cell_pos)[i] = i;
 
-  // Sort the coordinates in global order
-  parallel_sort(
-      storage_manager_->compute_tp(),
-      cell_pos->begin(),
-      cell_pos->end(),
-      GlobalCmp(domain, &buffs));
+  // Sort the coordinates in global order, with the comparator specialized
+  // for the domain if there is one
+  TypedCellPosSort typed_sort(
+      storage_manager_->compute_tp(), domain, &buffs, cell_pos);
+  if (!dispatch_typed_cmp(domain, &typed_sort)) {
+    parallel_sort(
+        storage_manager_->compute_tp(),
+        cell_pos->begin(),
+        cell_pos->end(),
+        GlobalCmp(domain, &buffs));
+  }
 
   return Status::Ok();
 
   STATS_END_TIMER(stats::Stats::TimerType::WRITE_SORT_COORDS)
 }
 
+Status Writer::sort_coords_hilbert(
+    const std::vector<const QueryBuffer*>& buffs,
+    std::vector<uint64_t>* cell_pos) const {
+  // Compute the Hilbert values in parallel
+  auto domain = array_schema_->domain();
+  std::vector<std::pair<uint64_t, uint64_t>> hilbert_values(coords_num_);
+  auto statuses = parallel_for(
+      storage_manager_->compute_tp(), 0, coords_num_, [&](uint64_t i) {
+        hilbert_values[i] =
+            std::make_pair(domain->hilbert_value(buffs, i), (uint64_t)i);
+        return Status::Ok();
+      });
+  for (auto& st : statuses)
+    RETURN_NOT_OK(st);
+
+  // Sort on the Hilbert values, comparing the coordinates only on ties
+  parallel_sort(
+      storage_manager_->compute_tp(),
+      hilbert_values.begin(),
+      hilbert_values.end(),
+      [&](const std::pair<uint64_t, uint64_t>& a,
+          const std::pair<uint64_t, uint64_t>& b) {
+        if (a.first != b.first)
+          return a.first < b.first;
+        return domain->cell_order_cmp(buffs, a.second, b.second) == -1;
+      });
+
+  cell_pos->resize(coords_num_);
+  for (uint64_t i = 0; i < coords_num_; ++i)
+    (*cell_pos)[i] = hilbert_values[i].second;
+
+  return Status::Ok();
+}
+
 Status Writer::split_coords_buffer() {
   STATS_START_TIMER(stats::Stats::TimerType::WRITE_SPLIT_COORDS_BUFF)
 
@@ -2476,6 +2697,10 @@ Status Writer::unordered_write() {
   RETURN_CANCEL_OR_ERROR_ELSE(
       compute_coords_metadata(tiles, frag_meta.get()), clean_up(uri));
 
+  // Compute tile metadata
+  RETURN_CANCEL_OR_ERROR_ELSE(
+      compute_tiles_metadata(tiles, frag_meta.get()), clean_up(uri));
+
   // Filter all tiles
   RETURN_CANCEL_OR_ERROR_ELSE(filter_tiles(&tiles), clean_up(uri));
 
@@ -492,6 +492,35 @@ class Writer {
       const std::unordered_map<std::string, std::vector<Tile>>& tiles,
       FragmentMetadata* meta) const;
 
+  /**
+   * Computes the tile metadata (minimum/maximum values and sums) of the
+   * attribute tiles and stores it in the fragment metadata. The tiles must
+   * not be filtered yet.
+   *
+   * @param tiles The tiles to calculate the metadata from, one vector of
+   *     tiles per attribute/dimension.
+   * @param meta The fragment metadata that will store the tile metadata.
+   * @return Status
+   */
+  Status compute_tiles_metadata(
+      const std::unordered_map<std::string, std::vector<Tile>>& tiles,
+      FragmentMetadata* meta) const;
+
+  /**
+   * Computes the tile metadata (minimum/maximum values and sums) of the
+   * input attribute tiles and stores it in the fragment metadata. The tiles
+   * must not be filtered yet.
+   *
+   * @param name The attribute name.
+   * @param tiles The tiles of the attribute.
+   * @param meta The fragment metadata that will store the tile metadata.
+   * @return Status
+   */
+  Status compute_tiles_metadata(
+      const std::string& name,
+      const std::vector<Tile>& tiles,
+      FragmentMetadata* meta) const;
+
   /**
    * Computes the cell ranges to be written, derived from a
    * dense cell range iterator for a specific tile.
@@ -743,11 +772,13 @@ class Writer {
    * buffers into the tiles the values based on the input write cell ranges.
    *
    * @param write_cell_ranges The write cell ranges.
+   * @param meta The fragment metadata that will store the tile metadata.
    * @param tiles The tiles to be created.
    * @return Status
    */
   Status prepare_and_filter_attr_tiles(
       const std::vector<WriteCellRangeVec>& write_cell_ranges,
+      FragmentMetadata* meta,
       std::unordered_map<std::string, std::vector<Tile>>* attr_tiles) const;
 
   /**
@@ -851,6 +882,18 @@ class Writer {
    */
   Status sort_coords(std::vector<uint64_t>* cell_pos) const;
 
+  /**
+   * Sorts the coordinates of the user buffers on the Hilbert order,
+   * computing the Hilbert value of every cell once.
+   *
+   * @param buffs The coordinate buffers, one per dimension.
+   * @param cell_pos The sorted cell positions to be created.
+   * @return Status
+   */
+  Status sort_coords_hilbert(
+      const std::vector<const QueryBuffer*>& buffs,
+      std::vector<uint64_t>* cell_pos) const;
+
   /**
    * Splits the coordinates buffer into separate coordinate
    * buffers, one per dimension. Note that this will require extra memory
@@ -36,17 +36,156 @@
 #include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/buffer/const_buffer.h"
 #include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/misc/bitmap.h"
+#include "tiledb/sm/misc/range_filter.h"
 #include "tiledb/sm/misc/utils.h"
 
 #include <cassert>
+#include <cstring>
 #include <iostream>
-#include <list>
+#include <limits>
+#include <numeric>
 
 using namespace tiledb::common;
 
 namespace tiledb {
 namespace sm {
 
+namespace {
+
+/** Returns a value not greater than any value of type `T`. */
+template <class T>
+T lowest() {
+  return std::numeric_limits<T>::has_infinity ?
+             -std::numeric_limits<T>::infinity() :
+             std::numeric_limits<T>::lowest();
+}
+
+/** Returns a value not smaller than any value of type `T`. */
+template <class T>
+T highest() {
+  return std::numeric_limits<T>::has_infinity ?
+             std::numeric_limits<T>::infinity() :
+             std::numeric_limits<T>::max();
+}
+
+/**
+ * Computes the bounds of the MBRs of a new level along a fixed-sized
+ * dimension, each being the union of `fanout` consecutive MBRs of the
+ * level below.
+ */
+struct BuildBounds {
+  const ByteVec* lo_;
+  const ByteVec* hi_;
+  uint64_t mbr_num_;
+  unsigned fanout_;
+  uint64_t start_;
+  ByteVec* new_lo_;
+  ByteVec* new_hi_;
+
+  template <class T>
+  void run() {
+    auto lo = (const T*)lo_->data();
+    auto hi = (const T*)hi_->data();
+    auto new_lo = (T*)new_lo_->data();
+    auto new_hi = (T*)new_hi_->data();
+    for (uint64_t i = start_, m = start_ * fanout_; m < mbr_num_; ++i) {
+      auto end = std::min(m + fanout_, mbr_num_);
+      new_lo[i] = lo[m];
+      new_hi[i] = hi[m];
+      for (++m; m < end; ++m) {
+        new_lo[i] = std::min(new_lo[i], lo[m]);
+        new_hi[i] = std::max(new_hi[i], hi[m]);
+      }
+    }
+  }
+};
+
+/**
+ * Clears the bits of `overlap_` of the `num_` MBRs starting at `start_`
+ * that do not overlap `range_` along a fixed-sized dimension, and the bits
+ * of `covered_` of those not covered by it.
+ */
+struct OverlapBits {
+  const ByteVec* lo_;
+  const ByteVec* hi_;
+  uint64_t start_;
+  uint64_t num_;
+  const Range* range_;
+  Bitmap* overlap_;
+  Bitmap* covered_;
+
+  template <class T>
+  void run() {
+    auto lo = (const T*)lo_->data() + start_;
+    auto hi = (const T*)hi_->data() + start_;
+    auto r = (const T*)range_->data();
+    range_filter::in_range(lo, 0, num_, lowest<T>(), r[1], overlap_);
+    range_filter::in_range(hi, 0, num_, r[0], highest<T>(), overlap_);
+    range_filter::in_range(lo, 0, num_, r[0], r[1], covered_);
+    range_filter::in_range(hi, 0, num_, r[0], r[1], covered_);
+  }
+};
+
+/**
+ * Clears the bits of `inside_` of the `num_` MBRs starting at `start_`
+ * that do not contain `coord_` along a fixed-sized dimension.
+ */
+struct PointBits {
+  const ByteVec* lo_;
+  const ByteVec* hi_;
+  uint64_t start_;
+  uint64_t num_;
+  const void* coord_;
+  Bitmap* inside_;
+
+  template <class T>
+  void run() {
+    auto lo = (const T*)lo_->data() + start_;
+    auto hi = (const T*)hi_->data() + start_;
+    auto c = *(const T*)coord_;
+    range_filter::in_range(lo, 0, num_, lowest<T>(), c, inside_);
+    range_filter::in_range(hi, 0, num_, c, highest<T>(), inside_);
+  }
+};
+
+/**
+ * Computes the overlap ratio of `range_` with the bounds of MBR `mbr_idx_`
+ * along a fixed-sized dimension. Same as `Dimension::overlap_ratio`.
+ */
+struct OverlapRatio {
+  const ByteVec* lo_;
+  const ByteVec* hi_;
+  uint64_t mbr_idx_;
+  const Range* range_;
+  double ratio_;
+
+  template <class T>
+  void run() {
+    auto lo = ((const T*)lo_->data())[mbr_idx_];
+    auto hi = ((const T*)hi_->data())[mbr_idx_];
+    auto r = (const T*)range_->data();
+    assert(!(r[0] > hi || r[1] < lo));
+
+    auto overlap_range = std::min(r[1], hi) - std::max(r[0], lo);
+    auto mbr_range = hi - lo;
+    auto max = std::numeric_limits<double>::max();
+    if (std::numeric_limits<T>::is_integer) {
+      overlap_range += 1;
+      mbr_range += 1;
+    } else {
+      if (overlap_range == 0)
+        overlap_range = std::nextafter(overlap_range, max);
+      if (mbr_range == 0)
+        mbr_range = std::nextafter(mbr_range, max);
+    }
+
+    ratio_ = (double)overlap_range / mbr_range;
+  }
+};
+
+}  // namespace
+
 /* ****************************** */
 /*   CONSTRUCTORS & DESTRUCTORS   */
 /* ****************************** */
@@ -91,13 +230,46 @@ RTree& RTree::operator=(RTree&& rtree) noexcept {
 /*               API              */
 /* ****************************** */
 
+Status RTree::add_leaves(const std::vector<NDRange>& mbrs) {
+  if (levels_.empty()) {
+    RETURN_NOT_OK(set_leaves(mbrs));
+    return build_tree();
+  }
+
+  if (mbrs.empty())
+    return Status::Ok();
+
+  // Append the leaves, with the levels ordered from the leaves up
+  std::reverse(std::begin(levels_), std::end(levels_));
+  auto first = levels_[0].mbr_num_;
+  resize_level(&levels_[0], first + mbrs.size());
+  for (uint64_t m = 0; m < mbrs.size(); ++m)
+    set_mbr(&levels_[0], first + m, mbrs[m]);
+
+  // Recompute the MBRs from the parent of the first new leaf upwards,
+  // adding a level on top while the top level has more than one MBR
+  for (size_t l = 0; levels_[l].mbr_num_ > 1; ++l) {
+    if (l + 1 == levels_.size())
+      levels_.emplace_back(create_level(0));
+    auto mbr_num = (uint64_t)ceil((double)levels_[l].mbr_num_ / fanout_);
+    resize_level(&levels_[l + 1], mbr_num);
+    first /= fanout_;
+    build_level(levels_[l], first, &levels_[l + 1]);
+  }
+
+  // Make the root as the first level
+  std::reverse(std::begin(levels_), std::end(levels_));
+
+  return Status::Ok();
+}
+
 Status RTree::build_tree() {
   if (levels_.empty())
     return Status::Ok();
 
   assert(levels_.size() == 1);
 
-  auto leaf_num = levels_[0].size();
+  auto leaf_num = levels_[0].mbr_num_;
   assert(leaf_num >= 1);
   if (leaf_num == 1)
     return Status::Ok();
@@ -106,7 +278,7 @@ Status RTree::build_tree() {
   auto height = (size_t)ceil(utils::math::log(fanout_, leaf_num)) + 1;
   for (size_t i = 0; i < height - 1; ++i) {
     auto new_level = build_level(levels_.back());
-    levels_.emplace_back(new_level);
+    levels_.emplace_back(std::move(new_level));
   }
 
   // Make the root as the first level
@@ -128,69 +300,64 @@ unsigned RTree::fanout() const {
 }
 
 TileOverlap RTree::get_tile_overlap(const NDRange& range) const {
-  TileOverlap overlap;
+  return get_tile_overlap(std::vector<NDRange>(1, range))[0];
+}
+
+std::vector<TileOverlap> RTree::get_tile_overlap(
+    const std::vector<NDRange>& ranges) const {
+  std::vector<TileOverlap> overlaps(ranges.size());
 
   // Empty tree
-  if (domain_ == nullptr || levels_.empty())
-    return overlap;
-
-  // This will keep track of the traversal
-  std::list<Entry> traversal;
-  traversal.push_front({0, 0});
-  auto leaf_num = levels_.back().size();
-  auto height = this->height();
-
-  while (!traversal.empty()) {
-    // Get next entry
-    auto entry = traversal.front();
-    traversal.pop_front();
-    const auto& mbr = levels_[entry.level_][entry.mbr_idx_];
-
-    // Get overlap ratio
-    auto ratio = domain_->overlap_ratio(range, mbr);
-
-    // If there is overlap
-    if (ratio != 0.0) {
-      // If there is full overlap
-      if (ratio == 1.0) {
-        auto subtree_leaf_num = this->subtree_leaf_num(entry.level_);
-        assert(subtree_leaf_num > 0);
-        uint64_t start = entry.mbr_idx_ * subtree_leaf_num;
-        uint64_t end = start + std::min(subtree_leaf_num, leaf_num - start) - 1;
-        auto tile_range = std::pair<uint64_t, uint64_t>(start, end);
-        overlap.tile_ranges_.emplace_back(tile_range);
-      } else {  // Partial overlap
-        // If this is the leaf level, insert into results
-        if (entry.level_ == height - 1) {
-          auto mbr_idx_ratio =
-              std::pair<uint64_t, double>(entry.mbr_idx_, ratio);
-          overlap.tiles_.emplace_back(mbr_idx_ratio);
-        } else {  // Insert all "children" to traversal
-          auto next_mbr_num = (uint64_t)levels_[entry.level_ + 1].size();
-          auto start = entry.mbr_idx_ * fanout_;
-          auto end = std::min(start + fanout_ - 1, next_mbr_num - 1);
-          for (uint64_t i = start; i <= end; ++i)
-            traversal.push_front({entry.level_ + 1, end - (i - start)});
-        }
-      }
-    }
-  }
+  if (domain_ == nullptr || levels_.empty() || ranges.empty())
+    return overlaps;
+
+  std::vector<uint64_t> range_ids(ranges.size());
+  std::iota(range_ids.begin(), range_ids.end(), 0);
+  get_tile_overlap({0, 0}, ranges, range_ids, &overlaps);
 
-  return overlap;
+  return overlaps;
+}
+
+std::vector<uint64_t> RTree::get_point_tiles(
+    const std::vector<const void*>& coords,
+    const std::vector<uint64_t>& points) const {
+  std::vector<uint64_t> tiles;
+
+  // Empty tree
+  if (domain_ == nullptr || levels_.empty() || points.empty())
+    return tiles;
+
+  get_point_tiles({0, 0}, coords, points, &tiles);
+
+  return tiles;
 }
 
 unsigned RTree::height() const {
   return (unsigned)levels_.size();
 }
 
-const NDRange& RTree::leaf(uint64_t leaf_idx) const {
-  assert(leaf_idx < levels_.back().size());
-  return levels_.back()[leaf_idx];
+NDRange RTree::leaf(uint64_t leaf_idx) const {
+  assert(leaf_idx < leaf_num());
+  return get_mbr(levels_.back(), leaf_idx);
 }
 
-const std::vector<NDRange>& RTree::leaves() const {
-  assert(!levels_.empty());
-  return levels_.back();
+uint64_t RTree::leaf_num() const {
+  return levels_.empty() ? 0 : levels_.back().mbr_num_;
+}
+
+uint64_t RTree::memory_size() const {
+  uint64_t size = 0;
+  for (const auto& level : levels_) {
+    for (const auto& lo : level.lo_)
+      size += lo.size();
+    for (const auto& hi : level.hi_)
+      size += hi.size();
+    for (const auto& ranges : level.ranges_) {
+      for (const auto& r : ranges)
+        size += sizeof(Range) + r.size();
+    }
+  }
+  return size;
 }
 
 uint64_t RTree::subtree_leaf_num(uint64_t level) const {
@@ -213,17 +380,22 @@ Status RTree::serialize(Buffer* buff) const {
   auto dim_num = domain_->dim_num();
 
   for (unsigned l = 0; l < level_num; ++l) {
-    auto mbr_num = (uint64_t)levels_[l].size();
+    const auto& level = levels_[l];
+    auto mbr_num = level.mbr_num_;
     RETURN_NOT_OK(buff->write(&mbr_num, sizeof(uint64_t)));
     for (uint64_t m = 0; m < mbr_num; ++m) {
       for (unsigned d = 0; d < dim_num; ++d) {
-        const auto& r = levels_[l][m][d];
         auto dim = domain_->dimension(d);
         if (!dim->var_size()) {  // Fixed-sized
           // Just write the plain range
-          RETURN_NOT_OK(buff->write(r.data(), r.size()));
+          auto coord_size = dim->coord_size();
+          RETURN_NOT_OK(
+              buff->write(&level.lo_[d][m * coord_size], coord_size));
+          RETURN_NOT_OK(
+              buff->write(&level.hi_[d][m * coord_size], coord_size));
         } else {  // Var-sized
           // range_size | start_size | range
+          const auto& r = level.ranges_[d][m];
           auto size = r.size();
           auto start_size = r.start_size();
           RETURN_NOT_OK(buff->write(&size, sizeof(uint64_t)));
@@ -242,33 +414,36 @@ Status RTree::set_leaf(uint64_t leaf_id, const NDRange& mbr) {
     return LOG_STATUS(Status::RTreeError(
         "Cannot set leaf; There are more than one levels in the tree"));
 
-  if (leaf_id >= levels_[0].size())
+  if (leaf_id >= levels_[0].mbr_num_)
     return LOG_STATUS(
         Status::RTreeError("Cannot set leaf; Invalid lead index"));
 
-  levels_[0][leaf_id] = mbr;
+  set_mbr(&levels_[0], leaf_id, mbr);
 
   return Status::Ok();
 }
 
 Status RTree::set_leaves(const std::vector<NDRange>& mbrs) {
   levels_.clear();
-  levels_.resize(1);
-  levels_[0] = mbrs;
+  levels_.emplace_back(create_level(mbrs.size()));
+  for (uint64_t m = 0; m < mbrs.size(); ++m)
+    set_mbr(&levels_[0], m, mbrs[m]);
   return Status::Ok();
 }
 
 Status RTree::set_leaf_num(uint64_t num) {
   // There should be exactly one level (the leaf level)
-  if (levels_.size() != 1)
+  if (levels_.empty())
+    levels_.emplace_back(create_level(0));
+  else if (levels_.size() != 1)
     levels_.resize(1);
 
-  if (num < levels_[0].size())
+  if (num < levels_[0].mbr_num_)
     return LOG_STATUS(
         Status::RTreeError("Cannot set number of leaves; provided number "
                            "cannot be smaller than the current leaf number"));
 
-  levels_[0].resize(num);
+  resize_level(&levels_[0], num);
   return Status::Ok();
 }
 
@@ -284,20 +459,43 @@ Status RTree::deserialize(
 /* ****************************** */
 
 RTree::Level RTree::build_level(const Level& level) {
-  auto cur_mbr_num = (uint64_t)level.size();
-  Level new_level((uint64_t)ceil((double)cur_mbr_num / fanout_));
-  auto new_mbr_num = (uint64_t)new_level.size();
-
-  uint64_t mbrs_visited = 0;
-  for (uint64_t i = 0; i < new_mbr_num; ++i) {
-    auto mbr_num = std::min((uint64_t)fanout_, cur_mbr_num - mbrs_visited);
-    for (uint64_t j = 0; j < mbr_num; ++j, ++mbrs_visited)
-      domain_->expand_ndrange(level[mbrs_visited], &new_level[i]);
-  }
-
+  auto mbr_num = (uint64_t)ceil((double)level.mbr_num_ / fanout_);
+  auto new_level = create_level(mbr_num);
+  build_level(level, 0, &new_level);
   return new_level;
 }
 
+void RTree::build_level(const Level& level, uint64_t start, Level* new_level) {
+  auto cur_mbr_num = level.mbr_num_;
+  auto new_mbr_num = new_level->mbr_num_;
+
+  auto dim_num = domain_->dim_num();
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto dim = domain_->dimension(d);
+    if (!dim->var_size()) {
+      BuildBounds f = {&level.lo_[d],
+                       &level.hi_[d],
+                       cur_mbr_num,
+                       fanout_,
+                       start,
+                       &new_level->lo_[d],
+                       &new_level->hi_[d]};
+      dim->dispatch_fixed(&f);
+      continue;
+    }
+
+    const auto& ranges = level.ranges_[d];
+    auto& new_ranges = new_level->ranges_[d];
+    uint64_t mbrs_visited = start * fanout_;
+    for (uint64_t i = start; i < new_mbr_num; ++i) {
+      auto mbr_num = std::min((uint64_t)fanout_, cur_mbr_num - mbrs_visited);
+      new_ranges[i] = ranges[mbrs_visited++];
+      for (uint64_t j = 1; j < mbr_num; ++j, ++mbrs_visited)
+        dim->expand_range_var(ranges[mbrs_visited], &new_ranges[i]);
+    }
+  }
+}
+
 RTree RTree::clone() const {
   RTree clone;
   clone.domain_ = domain_;
@@ -307,6 +505,16 @@ RTree RTree::clone() const {
   return clone;
 }
 
+RTree::Level RTree::create_level(uint64_t mbr_num) const {
+  auto dim_num = domain_->dim_num();
+  Level level;
+  level.lo_.resize(dim_num);
+  level.hi_.resize(dim_num);
+  level.ranges_.resize(dim_num);
+  resize_level(&level, mbr_num);
+  return level;
+}
+
 Status RTree::deserialize_v1_v4(ConstBuffer* cbuff, const Domain* domain) {
   // For backwards compatibility, they will be ignored
   unsigned dim_num_i;
@@ -318,25 +526,23 @@ Status RTree::deserialize_v1_v4(ConstBuffer* cbuff, const Domain* domain) {
   unsigned level_num;
   RETURN_NOT_OK(cbuff->read(&level_num, sizeof(level_num)));
 
+  domain_ = domain;
   levels_.clear();
-  levels_.resize(level_num);
+  levels_.reserve(level_num);
   auto dim_num = domain->dim_num();
   uint64_t mbr_num;
   for (unsigned l = 0; l < level_num; ++l) {
     RETURN_NOT_OK(cbuff->read(&mbr_num, sizeof(uint64_t)));
-    levels_[l].resize(mbr_num);
+    levels_.emplace_back(create_level(mbr_num));
     for (uint64_t m = 0; m < mbr_num; ++m) {
-      levels_[l][m].resize(dim_num);
       for (unsigned d = 0; d < dim_num; ++d) {
         auto r_size = 2 * domain->dimension(d)->coord_size();
-        levels_[l][m][d].set_range(cbuff->cur_data(), r_size);
+        set_mbr_range(&levels_[l], m, d, cbuff->cur_data(), r_size, 0);
         cbuff->advance_offset(r_size);
       }
     }
   }
 
-  domain_ = domain;
-
   return Status::Ok();
 }
 
@@ -348,38 +554,242 @@ Status RTree::deserialize_v5(ConstBuffer* cbuff, const Domain* domain) {
   if (level_num == 0)
     return Status::Ok();
 
+  domain_ = domain;
   levels_.clear();
-  levels_.resize(level_num);
+  levels_.reserve(level_num);
   auto dim_num = domain->dim_num();
   uint64_t mbr_num;
   for (unsigned l = 0; l < level_num; ++l) {
     RETURN_NOT_OK(cbuff->read(&mbr_num, sizeof(uint64_t)));
-    levels_[l].resize(mbr_num);
+    levels_.emplace_back(create_level(mbr_num));
     for (uint64_t m = 0; m < mbr_num; ++m) {
-      levels_[l][m].resize(dim_num);
       for (unsigned d = 0; d < dim_num; ++d) {
-        auto dim = domain_->dimension(d);
+        auto dim = domain->dimension(d);
         if (!dim->var_size()) {  // Fixed-sized
-          auto r_size = 2 * domain->dimension(d)->coord_size();
-          levels_[l][m][d].set_range(cbuff->cur_data(), r_size);
+          auto r_size = 2 * dim->coord_size();
+          set_mbr_range(&levels_[l], m, d, cbuff->cur_data(), r_size, 0);
           cbuff->advance_offset(r_size);
         } else {  // Var-sized
           // range_size | start_size | range
           uint64_t r_size, start_size;
           RETURN_NOT_OK(cbuff->read(&r_size, sizeof(uint64_t)));
           RETURN_NOT_OK(cbuff->read(&start_size, sizeof(uint64_t)));
-          levels_[l][m][d].set_range(cbuff->cur_data(), r_size, start_size);
+          set_mbr_range(
+              &levels_[l], m, d, cbuff->cur_data(), r_size, start_size);
           cbuff->advance_offset(r_size);
         }
       }
     }
   }
 
-  domain_ = domain;
-
   return Status::Ok();
 }
 
+NDRange RTree::get_mbr(const Level& level, uint64_t mbr_idx) const {
+  auto dim_num = domain_->dim_num();
+  NDRange mbr(dim_num);
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto dim = domain_->dimension(d);
+    if (dim->var_size()) {
+      mbr[d] = level.ranges_[d][mbr_idx];
+      continue;
+    }
+
+    auto coord_size = dim->coord_size();
+    uint8_t r[2 * sizeof(uint64_t)];
+    assert(coord_size <= sizeof(uint64_t));
+    std::memcpy(r, &level.lo_[d][mbr_idx * coord_size], coord_size);
+    std::memcpy(
+        r + coord_size, &level.hi_[d][mbr_idx * coord_size], coord_size);
+    mbr[d].set_range(r, 2 * coord_size);
+  }
+
+  return mbr;
+}
+
+void RTree::get_point_tiles(
+    const Entry& entry,
+    const std::vector<const void*>& coords,
+    const std::vector<uint64_t>& points,
+    std::vector<uint64_t>* tiles) const {
+  const auto& level = levels_[entry.level_];
+  auto start = entry.mbr_idx_;
+  auto mbr_num = std::min((uint64_t)fanout_, level.mbr_num_ - start);
+  auto dim_num = this->dim_num();
+
+  // Find the points that fall inside every MBR of the node, checking all
+  // the MBRs of the node a dimension at a time
+  std::vector<std::vector<uint64_t>> inside(mbr_num);
+  Bitmap in(mbr_num, true);
+  for (auto p : points) {
+    for (unsigned d = 0; d < dim_num && !in.none(); ++d) {
+      auto dim = domain_->dimension(d);
+      assert(!dim->var_size());
+      auto coord = (const uint8_t*)coords[d] + p * dim->coord_size();
+      PointBits f = {
+          &level.lo_[d], &level.hi_[d], start, mbr_num, coord, &in};
+      dim->dispatch_fixed(&f);
+    }
+    in.for_each(0, mbr_num, [&](uint64_t m) { inside[m].push_back(p); });
+    in.set_range(0, mbr_num);
+  }
+
+  // Visit the MBRs in order, so that the leaves are sorted
+  auto leaf = (entry.level_ == height() - 1);
+  for (uint64_t m = 0; m < mbr_num; ++m) {
+    if (inside[m].empty())
+      continue;
+
+    // If this is the leaf level, insert into results
+    if (leaf)
+      tiles->push_back(start + m);
+    else
+      get_point_tiles(
+          {entry.level_ + 1, (start + m) * fanout_}, coords, inside[m], tiles);
+  }
+}
+
+void RTree::get_tile_overlap(
+    const Entry& entry,
+    const std::vector<NDRange>& ranges,
+    const std::vector<uint64_t>& range_ids,
+    std::vector<TileOverlap>* overlaps) const {
+  const auto& level = levels_[entry.level_];
+  auto start = entry.mbr_idx_;
+  auto mbr_num = std::min((uint64_t)fanout_, level.mbr_num_ - start);
+  auto dim_num = this->dim_num();
+
+  // Find the ranges that overlap every MBR of the node, and whether they
+  // cover it, checking all the MBRs of the node a dimension at a time
+  std::vector<std::vector<std::pair<uint64_t, bool>>> hits(mbr_num);
+  Bitmap overlap(mbr_num, true), covered(mbr_num, true);
+  for (auto r : range_ids) {
+    for (unsigned d = 0; d < dim_num && !overlap.none(); ++d) {
+      auto dim = domain_->dimension(d);
+      if (!dim->var_size()) {
+        OverlapBits f = {&level.lo_[d],
+                         &level.hi_[d],
+                         start,
+                         mbr_num,
+                         &ranges[r][d],
+                         &overlap,
+                         &covered};
+        dim->dispatch_fixed(&f);
+      } else {
+        // Coverage is determined by the overlap ratio
+        const auto& mbr_ranges = level.ranges_[d];
+        for (uint64_t m = 0; m < mbr_num; ++m) {
+          overlap.and_bit(m, dim->overlap(ranges[r][d], mbr_ranges[start + m]));
+          covered.clear(m);
+        }
+      }
+    }
+    overlap.for_each(0, mbr_num, [&](uint64_t m) {
+      hits[m].emplace_back(r, covered.get(m));
+    });
+    overlap.set_range(0, mbr_num);
+    covered.set_range(0, mbr_num);
+  }
+
+  // Visit the MBRs in order, so that the results of every range are
+  // sorted on the leaf index
+  auto leaf = (entry.level_ == height() - 1);
+  auto leaf_num = this->leaf_num();
+  auto subtree_leaf_num = this->subtree_leaf_num(entry.level_);
+  assert(subtree_leaf_num > 0);
+  std::vector<uint64_t> partial_ids;
+  for (uint64_t m = 0; m < mbr_num; ++m) {
+    auto mbr_idx = start + m;
+    partial_ids.clear();
+    for (const auto& hit : hits[m]) {
+      auto r = hit.first;
+      auto ratio = hit.second ? 1.0 : overlap_ratio(ranges[r], level, mbr_idx);
+      auto& overlap = (*overlaps)[r];
+      if (ratio == 1.0) {  // Full overlap
+        uint64_t first = mbr_idx * subtree_leaf_num;
+        uint64_t last =
+            first + std::min(subtree_leaf_num, leaf_num - first) - 1;
+        overlap.tile_ranges_.emplace_back(first, last);
+      } else if (leaf) {  // Partial overlap with a leaf
+        overlap.tiles_.emplace_back(mbr_idx, ratio);
+      } else {  // Partial overlap, check the children
+        partial_ids.push_back(r);
+      }
+    }
+
+    if (!partial_ids.empty())
+      get_tile_overlap(
+          {entry.level_ + 1, mbr_idx * fanout_}, ranges, partial_ids, overlaps);
+  }
+}
+
+double RTree::overlap_ratio(
+    const NDRange& range, const Level& level, uint64_t mbr_idx) const {
+  double ratio = 1.0;
+  auto dim_num = domain_->dim_num();
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto dim = domain_->dimension(d);
+    if (!dim->var_size()) {
+      OverlapRatio f = {
+          &level.lo_[d], &level.hi_[d], mbr_idx, &range[d], 0.0};
+      dim->dispatch_fixed(&f);
+      ratio *= f.ratio_;
+    } else {
+      ratio *= dim->overlap_ratio(range[d], level.ranges_[d][mbr_idx]);
+    }
+
+    // The ranges are known to overlap, see `Domain::overlap_ratio`
+    auto max = std::numeric_limits<double>::max();
+    if (ratio == 0)
+      ratio = std::nextafter(0, max);
+  }
+
+  return ratio;
+}
+
+void RTree::resize_level(Level* level, uint64_t mbr_num) const {
+  auto dim_num = domain_->dim_num();
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto dim = domain_->dimension(d);
+    if (!dim->var_size()) {
+      level->lo_[d].resize(mbr_num * dim->coord_size());
+      level->hi_[d].resize(mbr_num * dim->coord_size());
+    } else {
+      level->ranges_[d].resize(mbr_num);
+    }
+  }
+  level->mbr_num_ = mbr_num;
+}
+
+void RTree::set_mbr(Level* level, uint64_t mbr_idx, const NDRange& mbr) const {
+  for (unsigned d = 0; d < mbr.size(); ++d) {
+    if (domain_->dimension(d)->var_size())
+      level->ranges_[d][mbr_idx] = mbr[d];
+    else
+      set_mbr_range(level, mbr_idx, d, mbr[d].data(), mbr[d].size(), 0);
+  }
+}
+
+void RTree::set_mbr_range(
+    Level* level,
+    uint64_t mbr_idx,
+    unsigned d,
+    const void* range,
+    uint64_t range_size,
+    uint64_t start_size) const {
+  auto dim = domain_->dimension(d);
+  if (dim->var_size()) {
+    level->ranges_[d][mbr_idx].set_range(range, range_size, start_size);
+    return;
+  }
+
+  auto coord_size = dim->coord_size();
+  assert(range_size == 2 * coord_size);
+  auto r = (const uint8_t*)range;
+  std::memcpy(&level->lo_[d][mbr_idx * coord_size], r, coord_size);
+  std::memcpy(&level->hi_[d][mbr_idx * coord_size], r + coord_size, coord_size);
+}
+
 void RTree::swap(RTree& rtree) {
   std::swap(domain_, rtree.domain_);
   std::swap(fanout_, rtree.fanout_);
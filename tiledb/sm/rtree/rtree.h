@@ -54,6 +54,9 @@ enum class Layout : uint8_t;
  * A simple RTree implementation. It supports storing only n-dimensional
  * MBRs (not points). Also it only offers bottom-up bulk-loading
  * (without incremental updates), and range and point queries.
+ *
+ * The MBRs are stored per dimension rather than as `NDRange` objects; see
+ * `Level`. The `NDRange` of an MBR is built only when it is requested.
  */
 class RTree {
  public:
@@ -86,6 +89,14 @@ class RTree {
   /*                 API               */
   /* ********************************* */
 
+  /**
+   * Appends the input MBRs as leaves of a tree that has been built (or has
+   * no levels), and updates the upper levels as `build_tree` would. Only
+   * the last node of each level and the new nodes are computed, so the
+   * cost is proportional to the number of new leaves.
+   */
+  Status add_leaves(const std::vector<NDRange>& mbrs);
+
   /** Builds the RTree bottom-up on the current leaf level. */
   Status build_tree();
 
@@ -104,14 +115,44 @@ class RTree {
    */
   TileOverlap get_tile_overlap(const NDRange& range) const;
 
+  /**
+   * Returns the tile overlap of each of the input ranges with the MBRs
+   * stored in the RTree, in the same order as the ranges. The tree is
+   * traversed once for all the ranges: every node is visited at most once,
+   * and its MBR is checked only against the ranges that partially overlap
+   * the MBR of its parent. The ranges that overlap the same nodes should
+   * therefore be adjacent, as is the case for ranges sorted on the layout
+   * of a subarray.
+   */
+  std::vector<TileOverlap> get_tile_overlap(
+      const std::vector<NDRange>& ranges) const;
+
+  /**
+   * Returns the sorted indices of the leaf MBRs that contain at least one
+   * of the input points. All the points are looked up in a single traversal
+   * of the tree, where each node is visited at most once, with the subset
+   * of the points that fall inside the MBR of its parent.
+   *
+   * @param coords The point coordinates, one buffer per dimension. Applicable
+   *     only to fixed-sized dimensions.
+   * @param points The positions of the points to look up in `coords`.
+   * @return The leaf indices.
+   */
+  std::vector<uint64_t> get_point_tiles(
+      const std::vector<const void*>& coords,
+      const std::vector<uint64_t>& points) const;
+
   /** Returns the tree height. */
   unsigned height() const;
 
   /** Returns the leaf MBR with the input index. */
-  const NDRange& leaf(uint64_t leaf_idx) const;
+  NDRange leaf(uint64_t leaf_idx) const;
 
-  /** Returns the leaves of the tree. */
-  const std::vector<NDRange>& leaves() const;
+  /** Returns the number of leaves of the tree. */
+  uint64_t leaf_num() const;
+
+  /** Returns the number of bytes the MBRs of the tree occupy in memory. */
+  uint64_t memory_size() const;
 
   /**
    * Returns the number of leaves that are stored in a (full) subtree
@@ -177,11 +218,27 @@ class RTree {
    * left-to-right complete, we can easily infer which MBRs
    * in the `Level` object correspond to which node of that level.
    *
+   * The MBRs are stored a dimension at a time. For a fixed-sized
+   * dimension `d`, the lower and upper bounds of all the MBRs are packed
+   * into the contiguous arrays `lo_[d]` and `hi_[d]`, so that the MBRs of
+   * a node are checked against a range with a few vectorized passes and
+   * no memory is allocated per MBR. For a var-sized dimension `d`, the
+   * ranges of the MBRs are stored in `ranges_[d]`.
+   *
    * Note that the `Level` objects are stored in a simple vector
    * `levels_`, where the first level is the root. This is how
    * we can infer which tree level each `Level` object corresponds to.
    */
-  typedef std::vector<NDRange> Level;
+  struct Level {
+    /** The number of MBRs. */
+    uint64_t mbr_num_ = 0;
+    /** The lower bounds of the MBRs, per fixed-sized dimension. */
+    std::vector<ByteVec> lo_;
+    /** The upper bounds of the MBRs, per fixed-sized dimension. */
+    std::vector<ByteVec> hi_;
+    /** The ranges of the MBRs, per var-sized dimension. */
+    std::vector<std::vector<Range>> ranges_;
+  };
 
   /**
    * Defines an R-Tree level entry, which corresponds to a node
@@ -219,9 +276,18 @@ class RTree {
   /** Builds a single tree level on top of the input level. */
   Level build_level(const Level& level);
 
+  /**
+   * Computes the MBRs of `new_level` from index `start` onwards as the
+   * unions of `fanout_` consecutive MBRs of `level`, which lies below it.
+   */
+  void build_level(const Level& level, uint64_t start, Level* new_level);
+
   /** Returns a deep copy of this RTree. */
   RTree clone() const;
 
+  /** Returns a level of `mbr_num` MBRs. */
+  Level create_level(uint64_t mbr_num) const;
+
   /**
    * Deserializes the contents of the object from the input buffer based
    * on the format version.
@@ -240,6 +306,62 @@ class RTree {
    */
   Status deserialize_v5(ConstBuffer* cbuff, const Domain* domain);
 
+  /** Builds the `NDRange` of MBR `mbr_idx` of the input level. */
+  NDRange get_mbr(const Level& level, uint64_t mbr_idx) const;
+
+  /**
+   * Appends to `tiles` the leaves in the subtrees rooted at the MBRs of the
+   * node `entry` that contain at least one of the input points. See
+   * `get_point_tiles`.
+   */
+  void get_point_tiles(
+      const Entry& entry,
+      const std::vector<const void*>& coords,
+      const std::vector<uint64_t>& points,
+      std::vector<uint64_t>* tiles) const;
+
+  /**
+   * Appends to `overlaps` the tile overlap of the input ranges with the
+   * subtrees rooted at the MBRs of the node `entry`. See `get_tile_overlap`.
+   *
+   * @param entry The node.
+   * @param ranges All the ranges.
+   * @param range_ids The indices of the ranges in `ranges` to check.
+   * @param overlaps The tile overlap of every range in `ranges`.
+   */
+  void get_tile_overlap(
+      const Entry& entry,
+      const std::vector<NDRange>& ranges,
+      const std::vector<uint64_t>& range_ids,
+      std::vector<TileOverlap>* overlaps) const;
+
+  /**
+   * Returns the overlap ratio of the input range with MBR `mbr_idx` of the
+   * input level, which are known to overlap. Same as
+   * `Domain::overlap_ratio`.
+   */
+  double overlap_ratio(
+      const NDRange& range, const Level& level, uint64_t mbr_idx) const;
+
+  /** Resizes the input level to `mbr_num` MBRs. */
+  void resize_level(Level* level, uint64_t mbr_num) const;
+
+  /** Sets MBR `mbr_idx` of the input level to `mbr`. */
+  void set_mbr(Level* level, uint64_t mbr_idx, const NDRange& mbr) const;
+
+  /**
+   * Sets dimension `d` of MBR `mbr_idx` of the input level to the
+   * serialized `range` of size `range_size`. `start_size` is the size of
+   * the range start, applicable only to var-sized dimensions.
+   */
+  void set_mbr_range(
+      Level* level,
+      uint64_t mbr_idx,
+      unsigned d,
+      const void* range,
+      uint64_t range_size,
+      uint64_t start_size) const;
+
   /**
    * Swaps the contents (all field values) of this RTree with the
    * given ``rtree``.
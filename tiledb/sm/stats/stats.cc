@@ -68,6 +68,15 @@ void Stats::add_timer(TimerType stat, double count) {
   it->second += count;
 }
 
+Stats::CacheShardCounters* Stats::cache_shard_counters(
+    const std::string& cache, unsigned shard) {
+  std::unique_lock<std::mutex> lck(cache_mtx_);
+  auto& shards = cache_shard_counters_[cache];
+  while (shards.size() <= shard)
+    shards.emplace_back(new CacheShardCounters());
+  return shards[shard].get();
+}
+
 bool Stats::enabled() const {
   return enabled_;
 }
@@ -82,6 +91,16 @@ void Stats::reset() {
   counter_stats_.clear();
   for (uint64_t i = 0; i != static_cast<uint64_t>(CounterType::__SIZE); ++i)
     counter_stats_[static_cast<CounterType>(i)] = 0;
+
+  // The cache shards keep pointers to their counters, so zero them in place
+  std::unique_lock<std::mutex> cache_lck(cache_mtx_);
+  for (auto& cache : cache_shard_counters_) {
+    for (auto& counters : cache.second) {
+      counters->hits_ = 0;
+      counters->misses_ = 0;
+      counters->evictions_ = 0;
+    }
+  }
 }
 
 void Stats::dump(FILE* out) const {
@@ -102,6 +121,8 @@ void Stats::dump(std::string* out) const {
   ss << dump_consolidate();
   ss << "\n";
   ss << dump_vfs();
+  ss << "\n";
+  ss << dump_caches();
 
   auto dbg_secs = timer_stats_.find(TimerType::DBG)->second;
   if (dbg_secs != 0)
@@ -147,6 +168,18 @@ void Stats::raw_dump(std::string* out) const {
        << "\": " << counter_stats_.find(static_cast<CounterType>(i))->second;
   }
 
+  // Dump cache shard stats
+  std::unique_lock<std::mutex> cache_lck(cache_mtx_);
+  for (const auto& cache : cache_shard_counters_) {
+    for (size_t i = 0; i < cache.second.size(); ++i) {
+      const auto& counters = *cache.second[i];
+      const auto prefix = cache.first + "_SHARD_" + std::to_string(i);
+      ss << ",\n  \"" << prefix << "_HITS\": " << counters.hits_;
+      ss << ",\n  \"" << prefix << "_MISSES\": " << counters.misses_;
+      ss << ",\n  \"" << prefix << "_EVICTIONS\": " << counters.evictions_;
+    }
+  }
+
   ss << "\n}\n";
 
   *out = ss.str();
@@ -441,6 +474,8 @@ std::string Stats::dump_read() const {
   auto read_byte_num = counter_stats_.find(CounterType::READ_BYTE_NUM)->second;
   auto read_unfiltered_byte_num =
       counter_stats_.find(CounterType::READ_UNFILTERED_BYTE_NUM)->second;
+  auto read_unfiltered_cache_hit_num =
+      counter_stats_.find(CounterType::READ_UNFILTERED_CACHE_HIT_NUM)->second;
   auto read_attr_fixed_num =
       counter_stats_.find(CounterType::READ_ATTR_FIXED_NUM)->second;
   auto read_attr_var_num =
@@ -525,6 +560,10 @@ std::string Stats::dump_read() const {
         "- Unfiltering inflation factor: ",
         read_unfiltered_byte_num,
         read_byte_num);
+    write(
+        &ss,
+        "- Number of tiles read from the unfiltered tile cache: ",
+        read_unfiltered_cache_hit_num);
     ss << "\n";
 
     if (read_compute_est_result_size != 0) {
@@ -692,11 +731,44 @@ std::string Stats::dump_consolidate() const {
 std::string Stats::dump_vfs() const {
   auto s3_slow_down_retries =
       counter_stats_.find(CounterType::VFS_S3_SLOW_DOWN_RETRIES)->second;
+  auto disk_cache_hits =
+      counter_stats_.find(CounterType::VFS_DISK_CACHE_HIT_NUM)->second;
+  auto disk_cache_misses =
+      counter_stats_.find(CounterType::VFS_DISK_CACHE_MISS_NUM)->second;
   std::stringstream ss;
 
-  if (s3_slow_down_retries > 0) {
+  if (s3_slow_down_retries > 0 || disk_cache_hits > 0 ||
+      disk_cache_misses > 0) {
     ss << "==== VFS ====\n\n";
     write(&ss, "- S3 SLOW_DOWN retries: ", s3_slow_down_retries);
+    write(&ss, "- Disk cache hits: ", disk_cache_hits);
+    write(&ss, "- Disk cache misses: ", disk_cache_misses);
+  }
+
+  return ss.str();
+}
+
+std::string Stats::dump_caches() const {
+  std::stringstream ss;
+  std::unique_lock<std::mutex> lck(cache_mtx_);
+
+  bool header = false;
+  for (const auto& cache : cache_shard_counters_) {
+    for (size_t i = 0; i < cache.second.size(); ++i) {
+      const auto& counters = *cache.second[i];
+      uint64_t hits = counters.hits_;
+      uint64_t misses = counters.misses_;
+      uint64_t evictions = counters.evictions_;
+      if (hits == 0 && misses == 0 && evictions == 0)
+        continue;
+
+      if (!header) {
+        ss << "==== CACHES ====\n\n";
+        header = true;
+      }
+      ss << "- " << cache.first << ", shard " << i << ": " << hits
+         << " hits, " << misses << " misses, " << evictions << " evictions\n";
+    }
   }
 
   return ss.str();
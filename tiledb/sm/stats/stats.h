@@ -40,6 +40,8 @@
 #include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <thread>
@@ -149,6 +151,7 @@ class Stats {
       READ_NUM,
       READ_BYTE_NUM,
       READ_UNFILTERED_BYTE_NUM,
+      READ_UNFILTERED_CACHE_HIT_NUM,
       READ_ATTR_FIXED_NUM,
       READ_ATTR_VAR_NUM,
       READ_DIM_FIXED_NUM,
@@ -179,7 +182,31 @@ class Stats {
       WRITE_CELL_NUM,
       WRITE_ARRAY_META_SIZE,
       WRITE_OPS_NUM,
-      VFS_S3_SLOW_DOWN_RETRIES);
+      VFS_S3_SLOW_DOWN_RETRIES,
+      VFS_DISK_CACHE_HIT_NUM,
+      VFS_DISK_CACHE_MISS_NUM);
+
+  /**
+   * The counters of one shard of a sharded cache. They are updated without
+   * taking the stats mutex, so that the cache shards do not contend on it.
+   */
+  struct CacheShardCounters {
+    /** Constructor. */
+    CacheShardCounters()
+        : hits_(0)
+        , misses_(0)
+        , evictions_(0) {
+    }
+
+    /** Number of lookups that found the requested item. */
+    std::atomic<uint64_t> hits_;
+
+    /** Number of lookups that did not find the requested item. */
+    std::atomic<uint64_t> misses_;
+
+    /** Number of items evicted to make room for new items. */
+    std::atomic<uint64_t> evictions_;
+  };
 
   /* ****************************** */
   /*   CONSTRUCTORS & DESTRUCTORS   */
@@ -201,6 +228,14 @@ class Stats {
   /** Adds `count` to the input counter stat. */
   void add_counter(CounterType stat, uint64_t count);
 
+  /**
+   * Returns the counters of shard `shard` of the cache named `cache`. The
+   * counters live as long as the stats, and caches with the same name (e.g.
+   * the tile caches of different contexts) share them.
+   */
+  CacheShardCounters* cache_shard_counters(
+      const std::string& cache, unsigned shard);
+
   /** Returns true if statistics are currently enabled. */
   bool enabled() const;
 
@@ -251,6 +286,13 @@ class Stats {
   /** Mutex to protext in multi-threading scenarios. */
   std::mutex mtx_;
 
+  /** The per-shard counters of each cache, mapped by cache name. */
+  std::map<std::string, std::vector<std::unique_ptr<CacheShardCounters>>>
+      cache_shard_counters_;
+
+  /** Protects `cache_shard_counters_`. */
+  mutable std::mutex cache_mtx_;
+
   /* ****************************** */
   /*       PRIVATE FUNCTIONS        */
   /* ****************************** */
@@ -267,6 +309,9 @@ class Stats {
   /** Dump the current vfs stats. */
   std::string dump_vfs() const;
 
+  /** Dump the current per-shard cache stats. */
+  std::string dump_caches() const;
+
   /** Parse a comma-separated string of enum names. */
   std::vector<std::string> parse_enum_names(
       const std::string& enum_names) const;
@@ -384,6 +429,11 @@ extern Stats all_stats;
   if (stats::all_stats.enabled())  \
     stats::all_stats.add_counter(stat, c);
 
+/** Adds `c` to the input atomic counter of a cache shard. */
+#define STATS_ADD_CACHE_COUNTER(counter, c) \
+  if (stats::all_stats.enabled())           \
+    (counter).fetch_add(c, std::memory_order_relaxed);
+
 #else
 
 #define STATS_START_TIMER(stat) (void)stat;
@@ -391,6 +441,9 @@ extern Stats all_stats;
 #define STATS_ADD_COUNTER(stat, c) \
   (void)stat;                      \
   (void)c;
+#define STATS_ADD_CACHE_COUNTER(counter, c) \
+  (void)(counter);                          \
+  (void)c;
 
 #endif
 
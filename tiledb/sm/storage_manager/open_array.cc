@@ -33,10 +33,12 @@
 
 #include "tiledb/sm/storage_manager/open_array.h"
 #include "tiledb/sm/array_schema/array_schema.h"
+#include "tiledb/sm/buffer/buffer.h"
 #include "tiledb/sm/filesystem/vfs.h"
 #include "tiledb/sm/misc/constants.h"
 
 #include <cassert>
+#include <unordered_set>
 
 using namespace tiledb::common;
 
@@ -56,9 +58,7 @@ OpenArray::OpenArray(const URI& array_uri, QueryType query_type)
 }
 
 OpenArray::~OpenArray() {
-  delete array_schema_;
-  for (auto& fragment : fragment_metadata_)
-    delete fragment;
+  clear();
 }
 
 /* ****************************** */
@@ -77,6 +77,17 @@ Status OpenArray::set_encryption_key(const EncryptionKey& encryption_key) {
   return key_validation_.check_encryption_key(encryption_key);
 }
 
+void OpenArray::clear() {
+  std::lock_guard<std::mutex> lock(local_mtx_);
+  delete array_schema_;
+  array_schema_ = nullptr;
+  for (auto& fragment : fragment_metadata_)
+    delete fragment;
+  fragment_metadata_.clear();
+  fragment_metadata_set_.clear();
+  array_metadata_.clear();
+}
+
 uint64_t OpenArray::cnt() const {
   return cnt_;
 }
@@ -124,6 +135,19 @@ std::shared_ptr<Buffer> OpenArray::array_metadata(const URI& uri) const {
   return (it == array_metadata_.end()) ? nullptr : it->second;
 }
 
+uint64_t OpenArray::memory_size() const {
+  std::lock_guard<std::mutex> lock(local_mtx_);
+  uint64_t size = sizeof(OpenArray);
+  if (array_schema_ != nullptr)
+    size += sizeof(ArraySchema);
+  for (auto& fragment : fragment_metadata_)
+    size += fragment->memory_size();
+  for (const auto& meta : array_metadata_)
+    size += meta.second->size();
+
+  return size;
+}
+
 void OpenArray::mtx_lock() {
   mtx_.lock();
 }
@@ -136,6 +160,25 @@ QueryType OpenArray::query_type() const {
   return query_type_;
 }
 
+void OpenArray::retain_fragment_metadata(
+    const std::vector<URI>& fragment_uris) {
+  std::lock_guard<std::mutex> lock(local_mtx_);
+  std::unordered_set<std::string> to_retain;
+  for (const auto& uri : fragment_uris)
+    to_retain.insert(uri.to_string());
+
+  for (auto it = fragment_metadata_.begin(); it != fragment_metadata_.end();) {
+    const auto& uri = (*it)->fragment_uri().to_string();
+    if (to_retain.count(uri) == 0) {
+      fragment_metadata_set_.erase(uri);
+      delete *it;
+      it = fragment_metadata_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void OpenArray::set_array_schema(ArraySchema* array_schema) {
   array_schema_ = array_schema;
 }
@@ -98,6 +98,13 @@ class OpenArray {
    */
   Status set_encryption_key(const EncryptionKey& encryption_key);
 
+  /**
+   * Deletes the array schema, fragment metadata and array metadata, so
+   * that they are loaded anew. This must be called only while no query
+   * uses the array.
+   */
+  void clear();
+
   /** Returns the counter. */
   uint64_t cnt() const;
 
@@ -131,6 +138,12 @@ class OpenArray {
    */
   std::shared_ptr<Buffer> array_metadata(const URI& uri) const;
 
+  /**
+   * Returns an estimate of the number of bytes the array schema, fragment
+   * metadata and array metadata occupy in memory.
+   */
+  uint64_t memory_size() const;
+
   /** Locks the array mutex. */
   void mtx_lock();
 
@@ -154,6 +167,13 @@ class OpenArray {
   void insert_array_metadata(
       const URI& uri, const std::shared_ptr<Buffer>& metadata);
 
+  /**
+   * Deletes the fragment metadata whose URIs are not in `fragment_uris`,
+   * i.e., of the fragments that have been vacuumed since they were loaded.
+   * This must be called only while no query uses the array.
+   */
+  void retain_fragment_metadata(const std::vector<URI>& fragment_uris);
+
   /** Sets an array schema. */
   void set_array_schema(ArraySchema* array_schema);
 
@@ -32,14 +32,16 @@
  */
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 #include "tiledb/common/logger.h"
 #include "tiledb/sm/array/array.h"
 #include "tiledb/sm/array_schema/array_schema.h"
-#include "tiledb/sm/cache/buffer_lru_cache.h"
+#include "tiledb/sm/cache/sharded_buffer_cache.h"
 #include "tiledb/sm/enums/layout.h"
 #include "tiledb/sm/enums/object_type.h"
 #include "tiledb/sm/enums/query_type.h"
@@ -73,9 +75,12 @@ namespace sm {
 StorageManager::StorageManager(
     ThreadPool* const compute_tp, ThreadPool* const io_tp)
     : cancellation_in_progress_(false)
+    , closed_arrays_for_reads_size_(0)
+    , fragment_metadata_cache_size_(0)
     , queries_in_progress_(0)
     , compute_tp_(compute_tp)
     , io_tp_(io_tp)
+    , cache_filtered_whole_tiles_(true)
     , vfs_(nullptr) {
 }
 
@@ -91,6 +96,10 @@ StorageManager::~StorageManager() {
     delete open_array_it.second;
   }
 
+  // Delete all the arrays retained after they were closed for reads
+  for (auto& closed_array : closed_arrays_for_reads_)
+    delete closed_array.first;
+
   // Delete all opened arrays for writes
   for (auto& open_array_it : open_arrays_for_writes_)
     delete open_array_it.second;
@@ -143,10 +152,10 @@ Status StorageManager::array_close_for_reads(const URI& array_uri) {
       open_array->mtx_unlock();
       return st;
     }
-    // Remove open array entry
+    // Remove open array entry, retaining its metadata for the next opening
     open_array->mtx_unlock();
-    delete open_array;
     open_arrays_for_reads_.erase(it);
+    cache_closed_array(open_array);
   } else {  // Just unlock the array mutex
     open_array->mtx_unlock();
   }
@@ -215,24 +224,21 @@ Status StorageManager::array_open_for_reads(
   std::vector<TimestampedURI> fragments_to_load;
   std::vector<URI> fragment_uris;
   URI meta_uri;
-  RETURN_NOT_OK(get_fragment_uris(array_uri, &fragment_uris, &meta_uri));
+  RETURN_NOT_OK(
+      get_fragment_uris(array_uri, &fragment_uris, &meta_uri, open_array));
   RETURN_NOT_OK(get_sorted_uris(fragment_uris, timestamp, &fragments_to_load));
 
-  // Get the consolidated fragment metadata
-  Buffer f_buff;
-  std::unordered_map<std::string, uint64_t> offsets;
-  uint32_t meta_version = 0;
-  RETURN_NOT_OK(load_consolidated_fragment_meta(
-      meta_uri, enc_key, &f_buff, &offsets, &meta_version));
+  // Drop the metadata of the fragments vacuumed since the array was last
+  // open, unless the array is also open by other handles
+  if (open_array->cnt() == 1)
+    open_array->retain_fragment_metadata(fragment_uris);
 
   // Get fragment metadata in the case of reads, if not fetched already
   Status st = load_fragment_metadata(
       open_array,
       enc_key,
       fragments_to_load,
-      &f_buff,
-      offsets,
-      meta_version,
+      meta_uri,
       fragment_metadata);
   if (!st.ok()) {
     open_array->mtx_unlock();
@@ -278,21 +284,12 @@ Status StorageManager::array_open_for_reads(
   RETURN_NOT_OK(vfs_->ls(array_uri.add_trailing_slash(), &uris));
   RETURN_NOT_OK(get_consolidated_fragment_meta_uri(uris, &meta_uri));
 
-  // Get the consolidated fragment metadata
-  Buffer f_buff;
-  std::unordered_map<std::string, uint64_t> offsets;
-  uint32_t meta_version = 0;
-  RETURN_NOT_OK(load_consolidated_fragment_meta(
-      meta_uri, enc_key, &f_buff, &offsets, &meta_version));
-
   // Get fragment metadata in the case of reads, if not fetched already
   Status st = load_fragment_metadata(
       open_array,
       enc_key,
       fragments_to_load,
-      &f_buff,
-      offsets,
-      meta_version,
+      meta_uri,
       fragment_metadata);
   if (!st.ok()) {
     open_array->mtx_unlock();
@@ -415,24 +412,16 @@ Status StorageManager::array_reopen(
   std::vector<TimestampedURI> fragments_to_load;
   std::vector<URI> fragment_uris;
   URI meta_uri;
-  RETURN_NOT_OK(get_fragment_uris(array_uri, &fragment_uris, &meta_uri));
+  RETURN_NOT_OK(
+      get_fragment_uris(array_uri, &fragment_uris, &meta_uri, open_array));
   RETURN_NOT_OK(get_sorted_uris(fragment_uris, timestamp, &fragments_to_load));
 
-  // Get the consolidated fragment metadata
-  Buffer f_buff;
-  std::unordered_map<std::string, uint64_t> offsets;
-  uint32_t meta_version = 0;
-  RETURN_NOT_OK(load_consolidated_fragment_meta(
-      meta_uri, enc_key, &f_buff, &offsets, &meta_version));
-
   // Get fragment metadata in the case of reads, if not fetched already
   auto st = load_fragment_metadata(
       open_array,
       enc_key,
       fragments_to_load,
-      &f_buff,
-      offsets,
-      meta_version,
+      meta_uri,
       fragment_metadata);
   if (!st.ok()) {
     open_array->mtx_unlock();
@@ -1114,7 +1103,7 @@ void StorageManager::decrement_in_progress() {
   queries_in_progress_cv_.notify_all();
 }
 
-Status StorageManager::object_remove(const char* path) const {
+Status StorageManager::object_remove(const char* path) {
   auto uri = URI(path);
   if (uri.is_invalid())
     return LOG_STATUS(Status::StorageManagerError(
@@ -1127,11 +1116,12 @@ Status StorageManager::object_remove(const char* path) const {
         std::string("Cannot remove object '") + path +
         "'; Invalid TileDB object"));
 
+  evict_closed_arrays(uri);
   return vfs_->remove_dir(uri);
 }
 
 Status StorageManager::object_move(
-    const char* old_path, const char* new_path) const {
+    const char* old_path, const char* new_path) {
   auto old_uri = URI(old_path);
   if (old_uri.is_invalid())
     return LOG_STATUS(Status::StorageManagerError(
@@ -1149,6 +1139,8 @@ Status StorageManager::object_move(
         std::string("Cannot move object '") + old_path +
         "'; Invalid TileDB object"));
 
+  evict_closed_arrays(old_uri);
+  evict_closed_arrays(new_uri);
   return vfs_->move_dir(old_uri, new_uri);
 }
 
@@ -1207,7 +1199,8 @@ Status StorageManager::get_fragment_info(
 Status StorageManager::get_fragment_uris(
     const URI& array_uri,
     std::vector<URI>* fragment_uris,
-    URI* meta_uri) const {
+    URI* meta_uri,
+    const OpenArray* open_array) const {
   // Get all uris in the array directory
   std::vector<URI> uris;
   RETURN_NOT_OK(vfs_->ls(array_uri.add_trailing_slash(), &uris));
@@ -1229,7 +1222,8 @@ Status StorageManager::get_fragment_uris(
   auto statuses = parallel_for(compute_tp_, 0, uris.size(), [&](size_t i) {
     if (utils::parse::starts_with(uris[i].last_path_part(), "."))
       return Status::Ok();
-    RETURN_NOT_OK(this->is_fragment(uris[i], ok_uris, &is_fragment[i]));
+    RETURN_NOT_OK(
+        this->is_fragment(uris[i], ok_uris, &is_fragment[i], open_array));
     return Status::Ok();
   });
   for (const auto& st : statuses)
@@ -1353,8 +1347,47 @@ Status StorageManager::init(const Config* config) {
       config_.get<uint64_t>("sm.tile_cache_size", &tile_cache_size, &found));
   assert(found);
 
-  tile_cache_ =
-      std::unique_ptr<BufferLRUCache>(new BufferLRUCache(tile_cache_size));
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.fragment_metadata_cache_size",
+      &fragment_metadata_cache_size_,
+      &found));
+  assert(found);
+
+  uint32_t tile_cache_shards = 0;
+  RETURN_NOT_OK(config_.get<uint32_t>(
+      "sm.tile_cache_shards", &tile_cache_shards, &found));
+  assert(found);
+  if (tile_cache_shards == 0)
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot initialize storage manager; The number of tile cache shards "
+        "must be at least 1"));
+
+  tile_cache_ = std::unique_ptr<ShardedBufferCache>(
+      new ShardedBufferCache("TILE_CACHE", tile_cache_size, tile_cache_shards));
+
+  // Set up the unfiltered tier of the tile cache
+  uint64_t tile_cache_unfiltered_size = 0;
+  RETURN_NOT_OK(config_.get<uint64_t>(
+      "sm.tile_cache_unfiltered_size", &tile_cache_unfiltered_size, &found));
+  assert(found);
+  const char* tile_cache_policy = nullptr;
+  RETURN_NOT_OK(config_.get("sm.tile_cache_policy", &tile_cache_policy));
+  if (tile_cache_policy == nullptr)
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot initialize storage manager; Tile cache policy cannot be null"));
+  std::string policy(tile_cache_policy);
+  if (policy != "filtered" && policy != "unfiltered" && policy != "both")
+    return LOG_STATUS(Status::StorageManagerError(
+        "Cannot initialize storage manager; Invalid tile cache policy '" +
+        policy + "'"));
+  if (policy != "filtered" && tile_cache_unfiltered_size > 0)
+    unfiltered_tile_cache_ =
+        std::unique_ptr<ShardedBufferCache>(new ShardedBufferCache(
+            "UNFILTERED_TILE_CACHE",
+            tile_cache_unfiltered_size,
+            tile_cache_shards));
+  cache_filtered_whole_tiles_ =
+      policy != "unfiltered" || unfiltered_tile_cache_ == nullptr;
 
   // GlobalState must be initialized before `vfs->init` because S3::init calls
   // GetGlobalState
@@ -1404,7 +1437,10 @@ Status StorageManager::is_file(const URI& uri, bool* is_file) const {
 }
 
 Status StorageManager::is_fragment(
-    const URI& uri, const std::set<URI>& ok_uris, int* is_fragment) const {
+    const URI& uri,
+    const std::set<URI>& ok_uris,
+    int* is_fragment,
+    const OpenArray* open_array) const {
   // If the URI name has a suffix, then it is not a fragment
   auto name = uri.remove_trailing_slash().last_path_part();
   if (name.find_first_of('.') != std::string::npos) {
@@ -1427,7 +1463,11 @@ Status StorageManager::is_fragment(
     return Status::Ok();
   }
 
-  // Versions < 5
+  // Versions < 5, where the loaded fragments are known to exist
+  if (open_array != nullptr && open_array->fragment_metadata(uri) != nullptr) {
+    *is_fragment = 1;
+    return Status::Ok();
+  }
   bool is_file;
   RETURN_NOT_OK(vfs_->is_file(
       uri.join_path(constants::fragment_metadata_filename), &is_file));
@@ -1757,6 +1797,35 @@ Status StorageManager::read_from_cache(
   return Status::Ok();
 }
 
+Status StorageManager::read_from_unfiltered_cache(
+    const URI& uri, uint64_t offset, Tile* tile, bool* in_cache) const {
+  *in_cache = false;
+  if (unfiltered_tile_cache_ == nullptr)
+    return Status::Ok();
+
+  std::stringstream key;
+  key << uri.to_string() << "+" << offset;
+  Buffer buffer;
+  RETURN_NOT_OK(unfiltered_tile_cache_->read(key.str(), &buffer, in_cache));
+  if (!*in_cache)
+    return Status::Ok();
+
+  // Hand the copied bytes over to the tile as a single contiguous buffer.
+  // `Buffer` allocates with `malloc()`, as `ChunkedBuffer` expects.
+  auto chunked_buffer = tile->chunked_buffer();
+  assert(chunked_buffer->capacity() == 0);
+  const uint64_t size = buffer.size();
+  const uint32_t chunk_size = (uint32_t)std::min<uint64_t>(
+      size, std::numeric_limits<uint32_t>::max());
+  RETURN_NOT_OK(chunked_buffer->init_fixed_size(
+      ChunkedBuffer::BufferAddressing::CONTIGUOUS, size, chunk_size));
+  RETURN_NOT_OK(chunked_buffer->set_contiguous(buffer.data()));
+  buffer.disown_data();
+  RETURN_NOT_OK(chunked_buffer->set_size(size));
+
+  return Status::Ok();
+}
+
 Status StorageManager::read(
     const URI& uri, uint64_t offset, Buffer* buffer, uint64_t nbytes) const {
   RETURN_NOT_OK(buffer->realloc(nbytes));
@@ -1930,6 +1999,37 @@ Status StorageManager::write_to_cache(
   return Status::Ok();
 }
 
+bool StorageManager::cache_filtered_tile(bool unfiltered_whole) const {
+  return cache_filtered_whole_tiles_ || !unfiltered_whole;
+}
+
+Status StorageManager::write_to_unfiltered_cache(
+    const URI& uri, uint64_t offset, const Tile& tile) const {
+  if (unfiltered_tile_cache_ == nullptr)
+    return Status::Ok();
+
+  // Partially unfiltered tiles are stored in discrete chunks
+  auto chunked_buffer = tile.chunked_buffer();
+  if (chunked_buffer->buffer_addressing() !=
+          ChunkedBuffer::BufferAddressing::CONTIGUOUS ||
+      chunked_buffer->size() == 0)
+    return Status::Ok();
+
+  // Generate key (uri + offset)
+  std::stringstream key;
+  key << uri.to_string() << "+" << offset;
+
+  // Insert to cache
+  void* data = nullptr;
+  RETURN_NOT_OK(chunked_buffer->get_contiguous(&data));
+  Buffer cached_buffer;
+  RETURN_NOT_OK(cached_buffer.write(data, chunked_buffer->size()));
+  RETURN_NOT_OK(unfiltered_tile_cache_->insert(
+      key.str(), std::move(cached_buffer), false));
+
+  return Status::Ok();
+}
+
 Status StorageManager::write(const URI& uri, Buffer* buffer) const {
   return vfs_->write(uri, buffer->data(), buffer->size());
 }
@@ -1951,6 +2051,7 @@ Status StorageManager::array_open_without_fragments(
         "Cannot open array; URI scheme unsupported."));
 
   // Lock mutexes
+  bool reused = false;
   {
     std::lock_guard<std::mutex> lock{open_array_for_reads_mtx_};
     std::lock_guard<std::mutex> xlock{xlock_mtx_};
@@ -1960,11 +2061,24 @@ Status StorageManager::array_open_without_fragments(
     if (it != open_arrays_for_reads_.end()) {
       RETURN_NOT_OK(it->second->set_encryption_key(encryption_key));
       *open_array = it->second;
-    } else {  // Create a new entry
-      *open_array = new OpenArray(array_uri, QueryType::READ);
-      RETURN_NOT_OK_ELSE(
-          (*open_array)->set_encryption_key(encryption_key),
-          delete *open_array);
+    } else {
+      // Reuse the array if it was retained after it was closed. A key that
+      // does not match may belong to an array re-created with the same URI,
+      // so the retained array is then discarded rather than reported.
+      *open_array = take_closed_array(array_uri.to_string());
+      if (*open_array != nullptr) {
+        reused = (*open_array)->set_encryption_key(encryption_key).ok();
+        if (!reused)
+          delete *open_array;
+      }
+
+      // Create a new entry
+      if (!reused) {
+        *open_array = new OpenArray(array_uri, QueryType::READ);
+        RETURN_NOT_OK_ELSE(
+            (*open_array)->set_encryption_key(encryption_key),
+            delete *open_array);
+      }
       open_arrays_for_reads_[array_uri.to_string()] = *open_array;
     }
     // Lock the array and increment counter
@@ -1980,6 +2094,16 @@ Status StorageManager::array_open_without_fragments(
     return st;
   }
 
+  // Check that a reused array has not been re-created since it was closed
+  if (reused) {
+    auto st = check_array_schema(array_uri, *open_array, encryption_key);
+    if (!st.ok()) {
+      (*open_array)->mtx_unlock();
+      array_close_for_reads(array_uri);
+      return st;
+    }
+  }
+
   // Load array schema if not fetched already
   if ((*open_array)->array_schema() == nullptr) {
     auto st = load_array_schema(array_uri, *open_array, encryption_key);
@@ -1993,6 +2117,87 @@ Status StorageManager::array_open_without_fragments(
   return Status::Ok();
 }
 
+void StorageManager::cache_closed_array(OpenArray* open_array) {
+  // Arrays whose schema failed to load are not worth retaining
+  auto size = open_array->memory_size();
+  if (open_array->array_schema() == nullptr ||
+      size > fragment_metadata_cache_size_) {
+    delete open_array;
+    return;
+  }
+
+  closed_arrays_for_reads_.emplace_back(open_array, size);
+  closed_arrays_for_reads_map_[open_array->array_uri().to_string()] =
+      std::prev(closed_arrays_for_reads_.end());
+  closed_arrays_for_reads_size_ += size;
+
+  // Evict the least recently closed arrays
+  while (closed_arrays_for_reads_size_ > fragment_metadata_cache_size_) {
+    auto& lru = closed_arrays_for_reads_.front();
+    closed_arrays_for_reads_size_ -= lru.second;
+    closed_arrays_for_reads_map_.erase(lru.first->array_uri().to_string());
+    delete lru.first;
+    closed_arrays_for_reads_.pop_front();
+  }
+}
+
+Status StorageManager::check_array_schema(
+    const URI& array_uri,
+    OpenArray* open_array,
+    const EncryptionKey& encryption_key) {
+  if (open_array->array_schema() == nullptr)
+    return Status::Ok();
+
+  // The array schema is small, so it is reloaded and compared
+  // in its serialized form
+  auto array_schema = (ArraySchema*)nullptr;
+  RETURN_NOT_OK(load_array_schema(array_uri, encryption_key, &array_schema));
+  Buffer retained, loaded;
+  RETURN_NOT_OK_ELSE(
+      open_array->array_schema()->serialize(&retained), delete array_schema);
+  RETURN_NOT_OK_ELSE(array_schema->serialize(&loaded), delete array_schema);
+
+  if (retained.size() == loaded.size() &&
+      std::memcmp(retained.data(), loaded.data(), loaded.size()) == 0) {
+    delete array_schema;
+  } else {
+    open_array->clear();
+    open_array->set_array_schema(array_schema);
+  }
+
+  return Status::Ok();
+}
+
+void StorageManager::evict_closed_arrays(const URI& uri) {
+  std::lock_guard<std::mutex> lock{open_array_for_reads_mtx_};
+  auto prefix = uri.remove_trailing_slash().to_string();
+  for (auto it = closed_arrays_for_reads_.begin();
+       it != closed_arrays_for_reads_.end();) {
+    auto array_uri = it->first->array_uri().remove_trailing_slash();
+    if (array_uri.to_string() == prefix ||
+        utils::parse::starts_with(array_uri.to_string(), prefix + "/")) {
+      closed_arrays_for_reads_size_ -= it->second;
+      closed_arrays_for_reads_map_.erase(it->first->array_uri().to_string());
+      delete it->first;
+      it = closed_arrays_for_reads_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+OpenArray* StorageManager::take_closed_array(const std::string& array_uri) {
+  auto it = closed_arrays_for_reads_map_.find(array_uri);
+  if (it == closed_arrays_for_reads_map_.end())
+    return nullptr;
+
+  auto open_array = it->second->first;
+  closed_arrays_for_reads_size_ -= it->second->second;
+  closed_arrays_for_reads_.erase(it->second);
+  closed_arrays_for_reads_map_.erase(it);
+  return open_array;
+}
+
 Status StorageManager::get_array_metadata_uris(
     const URI& array_uri, std::vector<URI>* array_metadata_uris) const {
   // Get all uris in the array metadata directory
@@ -2091,12 +2296,22 @@ Status StorageManager::load_fragment_metadata(
     OpenArray* open_array,
     const EncryptionKey& encryption_key,
     const std::vector<TimestampedURI>& fragments_to_load,
-    Buffer* meta_buff,
-    const std::unordered_map<std::string, uint64_t>& offsets,
-    uint32_t meta_version,
+    const URI& meta_uri,
     std::vector<FragmentMetadata*>* fragment_metadata) {
   STATS_START_TIMER(stats::Stats::TimerType::READ_LOAD_FRAG_META)
 
+  // Get the consolidated fragment metadata, only if some fragments are new
+  Buffer meta_buff;
+  std::unordered_map<std::string, uint64_t> offsets;
+  uint32_t meta_version = 0;
+  for (const auto& sf : fragments_to_load) {
+    if (open_array->fragment_metadata(sf.uri_) == nullptr) {
+      RETURN_NOT_OK(load_consolidated_fragment_meta(
+          meta_uri, encryption_key, &meta_buff, &offsets, &meta_version));
+      break;
+    }
+  }
+
   // Load the metadata for each fragment, only if they are not already loaded
   auto fragment_num = fragments_to_load.size();
   fragment_metadata->resize(fragment_num);
@@ -2131,7 +2346,7 @@ Status StorageManager::load_fragment_metadata(
       uint64_t offset = 0;
       auto it = offsets.find(sf.uri_.to_string());
       if (it != offsets.end()) {
-        f_buff = meta_buff;
+        f_buff = &meta_buff;
         offset = it->second;
       }
 
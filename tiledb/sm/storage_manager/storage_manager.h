@@ -65,7 +65,7 @@ namespace sm {
 class Array;
 class ArraySchema;
 class Buffer;
-class BufferLRUCache;
+class ShardedBufferCache;
 class ChunkedBuffer;
 class Consolidator;
 class EncryptionKey;
@@ -74,6 +74,7 @@ class Metadata;
 class OpenArray;
 class Query;
 class RestClient;
+class Tile;
 class VFS;
 
 enum class EncryptionType : uint8_t;
@@ -525,12 +526,14 @@ class StorageManager {
 
   /**
    * Retrieves all the fragment URIs of an array, along with the latest
-   * consolidated fragment metadata URI `meta_uri`.
+   * consolidated fragment metadata URI `meta_uri`. See `is_fragment`
+   * for `open_array`.
    */
   Status get_fragment_uris(
       const URI& array_uri,
       std::vector<URI>* fragment_uris,
-      URI* meta_uri) const;
+      URI* meta_uri,
+      const OpenArray* open_array = nullptr) const;
 
   /** Returns the current map of any set tags. */
   const std::unordered_map<std::string, std::string>& tags() const;
@@ -589,16 +592,22 @@ class StorageManager {
    * in `ok_uris`. For versions < 5, `ok_uris` is empty so the function
    * checks for the existence of the fragment metadata file in the fragment
    * URI directory. Therefore, the function is more expensive for earlier
-   * fragment versions.
+   * fragment versions, unless the fragment metadata are already loaded in
+   * `open_array`.
    *
    * @param The URI to be checked.
    * @param ok_uris For checking URI existence of versions >= 5.
    * @param is_fragment Set to `1` if the URI is a fragment and `0`
    *     otherwise.
+   * @param open_array An open array whose loaded fragments are known to
+   *     exist for versions < 5, or `nullptr`.
    * @return Status
    */
   Status is_fragment(
-      const URI& uri, const std::set<URI>& ok_uris, int* is_fragment) const;
+      const URI& uri,
+      const std::set<URI>& ok_uris,
+      int* is_fragment,
+      const OpenArray* open_array = nullptr) const;
 
   /**
    * Checks if the input URI represents a group.
@@ -651,13 +660,13 @@ class StorageManager {
       Metadata* metadata);
 
   /** Removes a TileDB object (group, array). */
-  Status object_remove(const char* path) const;
+  Status object_remove(const char* path);
 
   /**
    * Renames a TileDB object (group, array). If
    * `new_path` exists, `new_path` will be overwritten.
    */
-  Status object_move(const char* old_path, const char* new_path) const;
+  Status object_move(const char* old_path, const char* new_path);
 
   /**
    * Creates a new object iterator for the input path. The iteration
@@ -775,6 +784,21 @@ class StorageManager {
       uint64_t nbytes,
       bool* in_cache) const;
 
+  /**
+   * Reads a tile from the unfiltered tier of the tile cache, keyed like in
+   * `read_from_cache()`. On a hit, the unfiltered bytes are stored in the
+   * (empty) chunked buffer of `tile`, which then needs no unfiltering.
+   *
+   * @param uri The URI of the cached tile.
+   * @param offset The offset of the cached tile.
+   * @param tile The tile to store the unfiltered bytes into.
+   * @param in_cache This is set to `true` if the tile is in the cache,
+   *     and `false` otherwise.
+   * @return Status.
+   */
+  Status read_from_unfiltered_cache(
+      const URI& uri, uint64_t offset, Tile* tile, bool* in_cache) const;
+
   /**
    * Reads from a file into the input buffer.
    *
@@ -857,6 +881,28 @@ class StorageManager {
    */
   Status write_to_cache(const URI& uri, uint64_t offset, Buffer* buffer) const;
 
+  /**
+   * Returns `true` if a tile read from disk must be stored in the filtered
+   * tier of the tile cache, based on "sm.tile_cache_policy".
+   *
+   * @param unfiltered_whole Whether the tile will be unfiltered whole, and
+   *     may thus be stored in the unfiltered tier instead.
+   */
+  bool cache_filtered_tile(bool unfiltered_whole) const;
+
+  /**
+   * Writes an unfiltered tile into the unfiltered tier of the tile cache,
+   * keyed like in `write_to_cache()`. This is a no-op if the tier is
+   * disabled or if the tile was only partially unfiltered.
+   *
+   * @param uri The URI of the cached tile.
+   * @param offset The offset of the cached tile.
+   * @param tile The unfiltered tile whose contents will be cached.
+   * @return Status.
+   */
+  Status write_to_unfiltered_cache(
+      const URI& uri, uint64_t offset, const Tile& tile) const;
+
   /**
    * Writes the contents of a buffer into a URI file.
    *
@@ -945,6 +991,27 @@ class StorageManager {
   /** Stores the currently open arrays for writes. */
   std::map<std::string, OpenArray*> open_arrays_for_writes_;
 
+  /**
+   * The arrays that have been closed for reads, along with the number of
+   * bytes they occupy in memory, from the least to the most recently
+   * closed. Their array schema and fragment metadata are retained, so that
+   * opening them again loads only the metadata of new fragments. Guarded
+   * by `open_array_for_reads_mtx_`.
+   */
+  std::list<std::pair<OpenArray*, uint64_t>> closed_arrays_for_reads_;
+
+  /** Maps array URI strings to their `closed_arrays_for_reads_` entries. */
+  std::unordered_map<
+      std::string,
+      std::list<std::pair<OpenArray*, uint64_t>>::iterator>
+      closed_arrays_for_reads_map_;
+
+  /** The number of bytes the arrays in `closed_arrays_for_reads_` occupy. */
+  uint64_t closed_arrays_for_reads_size_;
+
+  /** The maximum number of bytes of `closed_arrays_for_reads_`. */
+  uint64_t fragment_metadata_cache_size_;
+
   /** Count of the number of queries currently in progress. */
   uint64_t queries_in_progress_;
 
@@ -968,7 +1035,19 @@ class StorageManager {
   std::unordered_map<std::string, std::string> tags_;
 
   /** A tile cache. */
-  std::unique_ptr<BufferLRUCache> tile_cache_;
+  std::unique_ptr<ShardedBufferCache> tile_cache_;
+
+  /**
+   * The tier of the tile cache storing unfiltered tiles. It is null if
+   * the tier is disabled.
+   */
+  std::unique_ptr<ShardedBufferCache> unfiltered_tile_cache_;
+
+  /**
+   * If `true`, the tiles that are unfiltered whole are also stored in
+   * `tile_cache_`. Otherwise they are stored only in `unfiltered_tile_cache_`.
+   */
+  bool cache_filtered_whole_tiles_;
 
   /**
    * Virtual filesystem handler. It directs queries to the appropriate
@@ -1001,9 +1080,39 @@ class StorageManager {
       const EncryptionKey& encryption_key,
       OpenArray** open_array);
 
+  /**
+   * Retains an array that has just been closed for reads in
+   * `closed_arrays_for_reads_`, deleting the least recently closed arrays
+   * that exceed the fragment metadata cache size. The array is deleted
+   * instead if it exceeds the cache size alone. The caller must hold
+   * `open_array_for_reads_mtx_`.
+   */
+  void cache_closed_array(OpenArray* open_array);
+
+  /**
+   * Reloads the array schema of an array retained after it was closed for
+   * reads. If the array has been re-created with a different schema since,
+   * the retained schema and metadata are replaced by the reloaded schema.
+   *
+   * @param array_uri The array URI.
+   * @param open_array The open array object.
+   * @param encryption_key The encryption key to use.
+   * @return Status
+   */
+  Status check_array_schema(
+      const URI& array_uri,
+      OpenArray* open_array,
+      const EncryptionKey& encryption_key);
+
   /** Decrement the count of in-progress queries. */
   void decrement_in_progress();
 
+  /**
+   * Deletes the arrays in `closed_arrays_for_reads_` whose URI is `uri` or
+   * lies under `uri`.
+   */
+  void evict_closed_arrays(const URI& uri);
+
   /** Retrieves all the array metadata URI's of an array. */
   Status get_array_metadata_uris(
       const URI& array_uri, std::vector<URI>* array_metadata_uris) const;
@@ -1011,6 +1120,13 @@ class StorageManager {
   /** Increment the count of in-progress queries. */
   void increment_in_progress();
 
+  /**
+   * Removes the array with the input URI from `closed_arrays_for_reads_`
+   * and returns it, or returns `nullptr` if it is not there. The caller
+   * must hold `open_array_for_reads_mtx_`.
+   */
+  OpenArray* take_closed_array(const std::string& array_uri);
+
   /**
    * Loads the array schema into an open array.
    *
@@ -1055,13 +1171,9 @@ class StorageManager {
    * @param open_array The open array object.
    * @param encryption_key The encryption key to use.
    * @param fragments_to_load The fragments whose metadata to load.
-   * @param meta_buff A buffer that contains the consolidated fragment
-   *     metadata.
-   * @param offsets A map from a fragment name to an offset in `meta_buff`
-   *     where the basic metadata can be found. If the offset cannot be
-   *     found, then the metadata of that fragment will be loaded from
-   *     storage instead.
-   * @param meta_version The version of the consolidated fragment metadata.
+   * @param meta_uri The URI of the consolidated fragment metadata, where
+   *     the basic metadata of the fragments are looked up first. It is
+   *     read only if some fragment metadata are not already loaded.
    * @param fragment_metadata The fragment metadata retrieved in a
    *     vector.
    * @return Status
@@ -1070,9 +1182,7 @@ class StorageManager {
       OpenArray* open_array,
       const EncryptionKey& encryption_key,
       const std::vector<TimestampedURI>& fragments_to_load,
-      Buffer* meta_buff,
-      const std::unordered_map<std::string, uint64_t>& offsets,
-      uint32_t meta_version,
+      const URI& meta_uri,
       std::vector<FragmentMetadata*>* fragment_metadata);
 
   /**
@@ -77,6 +77,9 @@ Subarray::Subarray(const Array* array, Layout layout, bool coalesce_ranges)
   est_result_size_computed_ = false;
   tile_overlap_computed_ = false;
   cell_order_ = array_->array_schema()->cell_order();
+  // The ranges of arrays with a Hilbert cell order are sorted in row-major
+  if (cell_order_ == Layout::HILBERT)
+    cell_order_ = Layout::ROW_MAJOR;
   add_default_ranges();
   set_add_or_coalesce_range_func();
 }
@@ -1795,19 +1798,37 @@ void Subarray::swap(Subarray& subarray) {
 Status Subarray::compute_relevant_fragments(ThreadPool* const compute_tp) {
   STATS_START_TIMER(stats::Stats::TimerType::READ_COMPUTE_RELEVANT_FRAGS)
 
-  auto meta = array_->fragment_metadata();
-  auto fragment_num = meta.size();
+  auto fragment_num = array_->fragment_metadata().size();
+  const auto& fragment_index = array_->fragment_index();
   auto range_num = this->range_num();
   std::vector<uint8_t> frag_bitmap(fragment_num, 0);
 
-  // Compute the relevant fragments
-  auto statuses = parallel_for_2d(
-      compute_tp, 0, fragment_num, 0, range_num, [&](unsigned f, uint64_t r) {
-        if (frag_bitmap[f] == 0 &&
-            meta[f]->overlaps_non_empty_domain(this->ndrange(r)))
+  // Compute the relevant fragments, looking up the adjacent ranges of each
+  // thread in the R-tree of the fragment non-empty domains at once
+  auto num_threads = compute_tp->concurrency_level();
+  auto ranges_per_thread = (uint64_t)ceil((double)range_num / num_threads);
+  auto statuses = parallel_for(compute_tp, 0, num_threads, [&](uint64_t t) {
+    auto r_start = t * ranges_per_thread;
+    auto r_end = std::min((t + 1) * ranges_per_thread, range_num);
+    if (r_start >= r_end)
+      return Status::Ok();
+
+    std::vector<NDRange> ranges;
+    ranges.reserve(r_end - r_start);
+    for (uint64_t r = r_start; r < r_end; ++r)
+      ranges.emplace_back(this->ndrange(r));
+    for (const auto& overlap : fragment_index.get_tile_overlap(ranges)) {
+      for (const auto& tile : overlap.tiles_)
+        frag_bitmap[tile.first] = 1;
+      for (const auto& tile_range : overlap.tile_ranges_) {
+        for (auto f = tile_range.first; f <= tile_range.second; ++f)
           frag_bitmap[f] = 1;
-        return Status::Ok();
-      });
+      }
+    }
+    return Status::Ok();
+  });
+  for (const auto& st : statuses)
+    RETURN_NOT_OK(st);
 
   // Copy to the result
   relevant_fragments_.reserve(fragment_num);
@@ -1874,16 +1895,27 @@ Status Subarray::compute_relevant_fragment_tile_overlap(
   auto statuses = parallel_for(compute_tp, 0, num_threads, [&](uint64_t t) {
     auto r_start = t * ranges_per_thread;
     auto r_end = std::min((t + 1) * ranges_per_thread - 1, range_num - 1);
-    for (uint64_t r = r_start; r <= r_end; ++r) {
-      if (dense) {  // Dense fragment
+    if (r_start > r_end)
+      return Status::Ok();
+
+    // Dense fragment
+    if (dense) {
+      for (uint64_t r = r_start; r <= r_end; ++r)
         tile_overlap_[frag_idx][r] = get_tile_overlap(r, frag_idx);
-      } else {  // Sparse fragment
-        const auto& range = this->ndrange(r);
-        RETURN_NOT_OK(
-            meta->get_tile_overlap(range, &(tile_overlap_[frag_idx][r])));
-      }
+      return Status::Ok();
     }
 
+    // Sparse fragment. The ranges of the thread are adjacent in the
+    // subarray layout, and are looked up in a single R-tree traversal.
+    std::vector<NDRange> ranges;
+    ranges.reserve(r_end - r_start + 1);
+    for (uint64_t r = r_start; r <= r_end; ++r)
+      ranges.emplace_back(this->ndrange(r));
+    std::vector<TileOverlap> tile_overlaps;
+    RETURN_NOT_OK(meta->get_tile_overlap(ranges, &tile_overlaps));
+    for (uint64_t r = r_start; r <= r_end; ++r)
+      tile_overlap_[frag_idx][r] = std::move(tile_overlaps[r - r_start]);
+
     return Status::Ok();
   });
   for (const auto& st : statuses)
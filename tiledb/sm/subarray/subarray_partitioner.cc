@@ -37,6 +37,7 @@
 #include "tiledb/sm/array_schema/dimension.h"
 #include "tiledb/sm/array_schema/domain.h"
 #include "tiledb/sm/enums/layout.h"
+#include "tiledb/sm/misc/hilbert.h"
 #include "tiledb/sm/stats/stats.h"
 
 #include <iomanip>
@@ -428,6 +429,7 @@ void SubarrayPartitioner::calibrate_current_start_end(bool* must_split_slab) {
 
   auto layout = subarray_.layout();
   auto cell_order = subarray_.array()->array_schema()->cell_order();
+  cell_order = (cell_order == Layout::HILBERT) ? Layout::ROW_MAJOR : cell_order;
   layout = (layout == Layout::UNORDERED) ? cell_order : layout;
   assert(layout == Layout::ROW_MAJOR || layout == Layout::COL_MAJOR);
 
@@ -620,8 +622,10 @@ void SubarrayPartitioner::compute_splitting_value_single_range(
     unsigned* splitting_dim,
     ByteVecValue* splitting_value,
     bool* unsplittable) {
-  // Special case for global order
-  if (subarray_.layout() == Layout::GLOBAL_ORDER) {
+  // Special case for global order. The space tiles do not participate in
+  // the Hilbert order.
+  if (subarray_.layout() == Layout::GLOBAL_ORDER &&
+      subarray_.array()->array_schema()->cell_order() != Layout::HILBERT) {
     compute_splitting_value_on_tiles(
         range, splitting_dim, splitting_value, unsplittable);
 
@@ -637,6 +641,7 @@ void SubarrayPartitioner::compute_splitting_value_single_range(
   auto array_schema = subarray_.array()->array_schema();
   auto dim_num = array_schema->dim_num();
   auto cell_order = array_schema->cell_order();
+  cell_order = (cell_order == Layout::HILBERT) ? Layout::ROW_MAJOR : cell_order;
   assert(!range.is_unary());
   auto layout = subarray_.layout();
   layout = (layout == Layout::UNORDERED || layout == Layout::GLOBAL_ORDER) ?
@@ -673,6 +678,75 @@ void SubarrayPartitioner::compute_splitting_value_single_range(
   assert(*splitting_dim != UINT32_MAX);
 }
 
+void SubarrayPartitioner::compute_splitting_value_hilbert(
+    const Subarray& range,
+    unsigned* splitting_dim,
+    ByteVecValue* splitting_value,
+    bool* upper_first,
+    bool* unsplittable) {
+  *upper_first = false;
+
+  // For easy reference
+  auto array_schema = subarray_.array()->array_schema();
+  auto dim_num = array_schema->dim_num();
+  Hilbert hilbert(dim_num);
+  auto bits = hilbert.bits();
+  auto max_bucket_val = hilbert.max_bucket_val();
+
+  // Compute the buckets of the range bounds
+  std::vector<uint64_t> bucket_lo(dim_num), bucket_hi(dim_num);
+  const Range* r;
+  for (unsigned d = 0; d < dim_num; ++d) {
+    auto dim = array_schema->dimension(d);
+    range.get_range(d, 0, &r);
+    bucket_lo[d] = dim->map_to_uint64(r->start(), max_bucket_val);
+    bucket_hi[d] = dim->map_to_uint64(r->end(), max_bucket_val);
+  }
+
+  // Every run of Hilbert values `[h, h + 2^m)` aligned to `2^m` covers a
+  // box of buckets, and its two halves are the halves of the box along a
+  // single dimension. Descend these halves from the whole grid until the
+  // range straddles two of them. The dimension and the order of the two
+  // halves are found from the last cell of the first half and the first
+  // cell of the second, which are adjacent on the curve.
+  std::vector<uint64_t> box_lo(dim_num, 0), last(dim_num), first(dim_num);
+  std::vector<unsigned> box_bits(dim_num, bits);
+  uint64_t h = 0;
+  for (unsigned m = bits * dim_num; m > 0; --m) {
+    auto mid = h + ((uint64_t)1 << (m - 1));
+    hilbert.hilbert_to_coords(mid - 1, &last[0]);
+    hilbert.hilbert_to_coords(mid, &first[0]);
+    unsigned d = 0;
+    while (d < dim_num && last[d] == first[d])
+      ++d;
+    assert(d < dim_num && box_bits[d] > 0);
+    auto bucket = box_lo[d] + ((uint64_t)1 << (box_bits[d] - 1));
+    bool lower_first = last[d] < first[d];
+    --box_bits[d];
+
+    if (bucket_hi[d] < bucket) {
+      // The range lies in the lower half
+      h = lower_first ? h : mid;
+    } else if (bucket_lo[d] >= bucket) {
+      // The range lies in the upper half
+      box_lo[d] = bucket;
+      h = lower_first ? mid : h;
+    } else {
+      range.get_range(d, 0, &r);
+      array_schema->dimension(d)->hilbert_splitting_value(
+          *r, bucket, max_bucket_val, splitting_value);
+      *splitting_dim = d;
+      *upper_first = !lower_first;
+      *unsplittable = false;
+      return;
+    }
+  }
+
+  // The range lies in a single bucket
+  compute_splitting_value_single_range(
+      range, splitting_dim, splitting_value, unsplittable);
+}
+
 void SubarrayPartitioner::compute_splitting_value_multi_range(
     unsigned* splitting_dim,
     uint64_t* splitting_range,
@@ -692,6 +766,7 @@ void SubarrayPartitioner::compute_splitting_value_multi_range(
   auto array_schema = subarray_.array()->array_schema();
   auto dim_num = array_schema->dim_num();
   auto cell_order = array_schema->cell_order();
+  cell_order = (cell_order == Layout::HILBERT) ? Layout::ROW_MAJOR : cell_order;
   layout = (layout == Layout::UNORDERED) ? cell_order : layout;
   *splitting_dim = UINT32_MAX;
   uint64_t range_num;
@@ -840,8 +915,14 @@ Status SubarrayPartitioner::split_top_single_range(bool* unsplittable) {
   // Finding splitting value
   ByteVecValue splitting_value;
   unsigned splitting_dim;
-  compute_splitting_value_single_range(
-      range, &splitting_dim, &splitting_value, unsplittable);
+  bool upper_first = false;
+  if (subarray_.layout() == Layout::GLOBAL_ORDER &&
+      subarray_.array()->array_schema()->cell_order() == Layout::HILBERT)
+    compute_splitting_value_hilbert(
+        range, &splitting_dim, &splitting_value, &upper_first, unsplittable);
+  else
+    compute_splitting_value_single_range(
+        range, &splitting_dim, &splitting_value, unsplittable);
 
   if (*unsplittable)
     return Status::Ok();
@@ -849,6 +930,8 @@ Status SubarrayPartitioner::split_top_single_range(bool* unsplittable) {
   // Split remaining range into two ranges
   Subarray r1, r2;
   RETURN_NOT_OK(range.split(splitting_dim, splitting_value, &r1, &r2));
+  if (upper_first)
+    std::swap(r1, r2);
 
   // Update list
   state_.single_range_.pop_front();
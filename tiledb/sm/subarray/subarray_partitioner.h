@@ -367,6 +367,23 @@ class SubarrayPartitioner {
       ByteVecValue* splitting_value,
       bool* unsplittable);
 
+  /**
+   * Computes the splitting value and dimension for the input range of a
+   * global order read on an array with a Hilbert cell order. The range is
+   * split along the boundary of two runs of Hilbert values, so that all
+   * the cells of one half precede all the cells of the other in the
+   * global order. `upper_first` is set to `true` if the half above the
+   * splitting value comes first. Ranges within a single Hilbert bucket
+   * are split in row-major order, which breaks the ties of the Hilbert
+   * values.
+   */
+  void compute_splitting_value_hilbert(
+      const Subarray& range,
+      unsigned* splitting_dim,
+      ByteVecValue* splitting_value,
+      bool* upper_first,
+      bool* unsplittable);
+
   /**
    * Computes the splitting value and dimension for
    * ``state_.multi_range_.front()``. In case of real domains, if this
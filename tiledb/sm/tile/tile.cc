@@ -251,10 +251,6 @@ void Tile::advance_offset(uint64_t nbytes) {
   offset_ += nbytes;
 }
 
-ChunkedBuffer* Tile::chunked_buffer() const {
-  return chunked_buffer_;
-}
-
 Tile Tile::clone(bool deep_copy) const {
   Tile clone;
   clone.cell_size_ = cell_size_;
@@ -227,7 +227,9 @@ class Tile {
   void advance_offset(uint64_t nbytes);
 
   /** Returns the internal chunked buffer. */
-  ChunkedBuffer* chunked_buffer() const;
+  inline ChunkedBuffer* chunked_buffer() const {
+    return chunked_buffer_;
+  }
 
   /** Returns the cell size. */
   uint64_t cell_size() const;
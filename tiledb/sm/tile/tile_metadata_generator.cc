@@ -0,0 +1,304 @@
+/**
+ * @file   tile_metadata_generator.cc
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file implements class TileMetadataGenerator.
+ */
+
+
+#include "tiledb/sm/tile/tile_metadata_generator.h"
+#include "tiledb/common/logger.h"
+#include "tiledb/sm/enums/datatype.h"
+#include "tiledb/sm/misc/utils.h"
+#include "tiledb/sm/tile/tile.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+namespace {
+
+/** Returns `true` if `v` is NaN; always `false` for non-real types. */
+template <class T>
+inline typename std::enable_if<std::is_floating_point<T>::value, bool>::type
+is_nan(T v) {
+  return std::isnan(v);
+}
+
+template <class T>
+inline typename std::enable_if<!std::is_floating_point<T>::value, bool>::type
+is_nan(T) {
+  return false;
+}
+
+/**
+ * Returns `true` if the integer sum `v` is at a limit of its type, i.e.,
+ * it may have saturated; always `false` for real sums.
+ */
+template <class T>
+inline typename std::enable_if<std::is_integral<T>::value, bool>::type
+is_saturated(T v) {
+  return v == std::numeric_limits<T>::max() ||
+         (std::is_signed<T>::value && v == std::numeric_limits<T>::min());
+}
+
+template <class T>
+inline typename std::enable_if<!std::is_integral<T>::value, bool>::type
+is_saturated(T) {
+  return false;
+}
+
+/**
+ * Lexicographically compares `lhs` (of size `lhs_size`) with `rhs` (of
+ * size `rhs_size`), returning `true` if `lhs` precedes `rhs`.
+ */
+inline bool str_less(
+    const char* lhs, uint64_t lhs_size, const char* rhs, uint64_t rhs_size) {
+  const uint64_t min_size = std::min(lhs_size, rhs_size);
+  const int r = (min_size == 0) ? 0 : std::memcmp(lhs, rhs, min_size);
+  return (r != 0) ? (r < 0) : (lhs_size < rhs_size);
+}
+
+}  // namespace
+
+/* ****************************** */
+/*           STATIC API           */
+/* ****************************** */
+
+bool TileMetadataGenerator::has_min_max_metadata(
+    Datatype type, bool var_size, uint32_t cell_val_num) {
+  if (var_size)
+    return datatype_is_string(type) || type == Datatype::CHAR;
+
+  return cell_val_num == 1 && type != Datatype::ANY &&
+         !datatype_is_string(type);
+}
+
+bool TileMetadataGenerator::has_sum_metadata(
+    Datatype type, bool var_size, uint32_t cell_val_num) {
+  return !var_size && cell_val_num == 1 &&
+         (datatype_is_integer(type) || datatype_is_real(type) ||
+          datatype_is_datetime(type));
+}
+
+/* ****************************** */
+/*   CONSTRUCTORS & DESTRUCTORS   */
+/* ****************************** */
+
+TileMetadataGenerator::TileMetadataGenerator(
+    Datatype type, bool var_size, uint32_t cell_val_num)
+    : type_(type) {
+  has_min_max_ = has_min_max_metadata(type, var_size, cell_val_num);
+  has_sum_ = has_sum_metadata(type, var_size, cell_val_num);
+}
+
+/* ****************************** */
+/*               API              */
+/* ****************************** */
+
+Status TileMetadataGenerator::process_tile(const Tile& tile) {
+  min_.clear();
+  max_.clear();
+  sum_.clear();
+
+  const auto cell_num = tile.cell_num();
+  if (!has_min_max_ || cell_num == 0)
+    return Status::Ok();
+
+  // The chunked buffers in the write path are always contiguous.
+  void* data = nullptr;
+  RETURN_NOT_OK(tile.chunked_buffer()->get_contiguous(&data));
+  assert(data != nullptr);
+
+  switch (type_) {
+    case Datatype::INT8:
+      process_values<int8_t, int64_t>(data, cell_num);
+      break;
+    case Datatype::UINT8:
+      process_values<uint8_t, uint64_t>(data, cell_num);
+      break;
+    case Datatype::INT16:
+      process_values<int16_t, int64_t>(data, cell_num);
+      break;
+    case Datatype::UINT16:
+      process_values<uint16_t, uint64_t>(data, cell_num);
+      break;
+    case Datatype::INT32:
+      process_values<int32_t, int64_t>(data, cell_num);
+      break;
+    case Datatype::UINT32:
+      process_values<uint32_t, uint64_t>(data, cell_num);
+      break;
+    case Datatype::INT64:
+      process_values<int64_t, int64_t>(data, cell_num);
+      break;
+    case Datatype::UINT64:
+      process_values<uint64_t, uint64_t>(data, cell_num);
+      break;
+    case Datatype::FLOAT32:
+      process_values<float, double>(data, cell_num);
+      break;
+    case Datatype::FLOAT64:
+      process_values<double, double>(data, cell_num);
+      break;
+    case Datatype::CHAR:
+      process_values<char, int64_t>(data, cell_num);
+      break;
+    case Datatype::DATETIME_YEAR:
+    case Datatype::DATETIME_MONTH:
+    case Datatype::DATETIME_WEEK:
+    case Datatype::DATETIME_DAY:
+    case Datatype::DATETIME_HR:
+    case Datatype::DATETIME_MIN:
+    case Datatype::DATETIME_SEC:
+    case Datatype::DATETIME_MS:
+    case Datatype::DATETIME_US:
+    case Datatype::DATETIME_NS:
+    case Datatype::DATETIME_PS:
+    case Datatype::DATETIME_FS:
+    case Datatype::DATETIME_AS:
+      process_values<int64_t, int64_t>(data, cell_num);
+      break;
+    default:
+      return LOG_STATUS(Status::TileError(
+          "Cannot compute tile metadata; Unsupported datatype " +
+          datatype_str(type_)));
+  }
+
+  return Status::Ok();
+}
+
+Status TileMetadataGenerator::process_tile_var(
+    const Tile& tile_off, const Tile& tile_val) {
+  min_.clear();
+  max_.clear();
+  sum_.clear();
+
+  const auto cell_num = tile_off.cell_num();
+  if (!has_min_max_ || cell_num == 0)
+    return Status::Ok();
+
+  // The chunked buffers in the write path are always contiguous.
+  void* buffer_off = nullptr;
+  void* buffer_val = nullptr;
+  RETURN_NOT_OK(tile_off.chunked_buffer()->get_contiguous(&buffer_off));
+  if (tile_val.size() > 0)
+    RETURN_NOT_OK(tile_val.chunked_buffer()->get_contiguous(&buffer_val));
+  const auto offsets = static_cast<const uint64_t*>(buffer_off);
+  const auto values = static_cast<const char*>(buffer_val);
+  const uint64_t val_size = tile_val.size();
+
+  // Track the positions of the minimum and maximum values
+  uint64_t min_start = offsets[0];
+  uint64_t min_size = (cell_num == 1) ? val_size : offsets[1];
+  uint64_t max_start = min_start, max_size = min_size;
+  for (uint64_t c = 1; c < cell_num; ++c) {
+    const uint64_t start = offsets[c];
+    const uint64_t size =
+        ((c == cell_num - 1) ? val_size : offsets[c + 1]) - start;
+    if (str_less(values + start, size, values + min_start, min_size)) {
+      min_start = start;
+      min_size = size;
+    } else if (str_less(values + max_start, max_size, values + start, size)) {
+      max_start = start;
+      max_size = size;
+    }
+  }
+
+  if (min_size > 0)
+    min_.assign(
+        (const uint8_t*)values + min_start,
+        (const uint8_t*)values + min_start + min_size);
+  if (max_size > 0)
+    max_.assign(
+        (const uint8_t*)values + max_start,
+        (const uint8_t*)values + max_start + max_size);
+
+  return Status::Ok();
+}
+
+const std::vector<uint8_t>& TileMetadataGenerator::min() const {
+  return min_;
+}
+
+const std::vector<uint8_t>& TileMetadataGenerator::max() const {
+  return max_;
+}
+
+const std::vector<uint8_t>& TileMetadataGenerator::sum() const {
+  return sum_;
+}
+
+/* ****************************** */
+/*         PRIVATE METHODS        */
+/* ****************************** */
+
+template <class T, class SumT>
+void TileMetadataGenerator::process_values(
+    const void* data, uint64_t cell_num) {
+  const auto values = static_cast<const T*>(data);
+
+  // NaN values do not participate in the minimum/maximum computation,
+  // unless the tile stores only NaN values
+  uint64_t c = 0;
+  while (c < cell_num - 1 && is_nan(values[c]))
+    ++c;
+
+  T min = values[c], max = values[c];
+  for (++c; c < cell_num; ++c) {
+    const T v = values[c];
+    if (v < min)
+      min = v;
+    else if (v > max)
+      max = v;
+  }
+
+  min_.resize(sizeof(T));
+  max_.resize(sizeof(T));
+  std::memcpy(min_.data(), &min, sizeof(T));
+  std::memcpy(max_.data(), &max, sizeof(T));
+
+  // A saturated sum stays saturated, so that it is never mistaken for
+  // an exact one
+  if (has_sum_) {
+    SumT sum = 0;
+    for (c = 0; c < cell_num && !is_saturated(sum); ++c)
+      sum = utils::math::safe_add(sum, (SumT)values[c]);
+    sum_.resize(sizeof(SumT));
+    std::memcpy(sum_.data(), &sum, sizeof(SumT));
+  }
+}
+
+}  // namespace sm
+}  // namespace tiledb
@@ -0,0 +1,168 @@
+/**
+ * @file   tile_metadata_generator.h
+ *
+ * @section LICENSE
+ *
+ * The MIT License
+ *
+ * @copyright Copyright (c) 2017-2020 TileDB, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * @section DESCRIPTION
+ *
+ * This file defines class TileMetadataGenerator.
+ */
+
+
+#ifndef TILEDB_TILE_METADATA_GENERATOR_H
+#define TILEDB_TILE_METADATA_GENERATOR_H
+
+#include "tiledb/common/status.h"
+
+#include <cinttypes>
+#include <vector>
+
+using namespace tiledb::common;
+
+namespace tiledb {
+namespace sm {
+
+class Tile;
+
+enum class Datatype : uint8_t;
+
+/**
+ * Computes the per-tile metadata (minimum, maximum and sum of the cell
+ * values) that is stored in the fragment metadata, so that readers can
+ * reason about the contents of a tile without fetching it.
+ *
+ * The metadata is computed on the unfiltered tiles in the write path.
+ * Minimum/maximum values are computed for fixed-sized attributes storing a
+ * single value per cell and for var-sized string attributes (compared
+ * lexicographically). NaN values are ignored, unless a tile stores only NaN
+ * values. Sums are computed only for numeric attributes storing
+ * a single value per cell; integer sums are stored as `int64_t` or
+ * `uint64_t` and real sums as `double`. An integer sum that overflows, or
+ * merely reaches a limit of its type, saturates to that limit.
+ */
+class TileMetadataGenerator {
+ public:
+  /* ********************************* */
+  /*           STATIC API              */
+  /* ********************************* */
+
+  /**
+   * Returns `true` if minimum/maximum values are computed for a field with
+   * the input properties.
+   */
+  static bool has_min_max_metadata(
+      Datatype type, bool var_size, uint32_t cell_val_num);
+
+  /** Returns `true` if sums are computed for a field with the input type. */
+  static bool has_sum_metadata(
+      Datatype type, bool var_size, uint32_t cell_val_num);
+
+  /* ********************************* */
+  /*     CONSTRUCTORS & DESTRUCTORS    */
+  /* ********************************* */
+
+  /**
+   * Constructor.
+   *
+   * @param type The datatype of the field.
+   * @param var_size Whether the field is var-sized.
+   * @param cell_val_num The number of values per cell of the field.
+   */
+  TileMetadataGenerator(Datatype type, bool var_size, uint32_t cell_val_num);
+
+  /** Destructor. */
+  ~TileMetadataGenerator() = default;
+
+  /* ********************************* */
+  /*                API                */
+  /* ********************************* */
+
+  /**
+   * Computes the metadata of the input unfiltered fixed-sized tile,
+   * replacing any previously computed metadata.
+   */
+  Status process_tile(const Tile& tile);
+
+  /**
+   * Computes the metadata of the input unfiltered var-sized tile pair,
+   * replacing any previously computed metadata.
+   *
+   * @param tile_off The offsets tile.
+   * @param tile_val The values tile.
+   * @return Status
+   */
+  Status process_tile_var(const Tile& tile_off, const Tile& tile_val);
+
+  /** Returns the minimum value of the last processed tile (raw bytes). */
+  const std::vector<uint8_t>& min() const;
+
+  /** Returns the maximum value of the last processed tile (raw bytes). */
+  const std::vector<uint8_t>& max() const;
+
+  /**
+   * Returns the sum of the last processed tile (8 raw bytes), or an empty
+   * vector if sums are not computed for this field.
+   */
+  const std::vector<uint8_t>& sum() const;
+
+ private:
+  /* ********************************* */
+  /*         PRIVATE ATTRIBUTES        */
+  /* ********************************* */
+
+  /** The datatype of the field. */
+  Datatype type_;
+
+  /** Whether minimum/maximum values are computed. */
+  bool has_min_max_;
+
+  /** Whether sums are computed. */
+  bool has_sum_;
+
+  /** The minimum value of the last processed tile. */
+  std::vector<uint8_t> min_;
+
+  /** The maximum value of the last processed tile. */
+  std::vector<uint8_t> max_;
+
+  /** The sum of the last processed tile. */
+  std::vector<uint8_t> sum_;
+
+  /* ********************************* */
+  /*          PRIVATE METHODS          */
+  /* ********************************* */
+
+  /**
+   * Computes the metadata of `cell_num` contiguous values of type `T`,
+   * accumulating the sum in type `SumT`.
+   */
+  template <class T, class SumT>
+  void process_values(const void* data, uint64_t cell_num);
+};
+
+}  // namespace sm
+}  // namespace tiledb
+
+#endif  // TILEDB_TILE_METADATA_GENERATOR_H